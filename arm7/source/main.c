@@ -0,0 +1,92 @@
+/**
+ * File: main.c
+ * ------------
+ * Description: ARM7 program of the ITEMS_ON_ARM7 build. Does what the stock
+ *              libnds ARM7 binary does for the game (WiFi, maxmod, touch and
+ *              keys, clock, power button) and also runs the item world
+ *              (source/gameplay/items/items_world.c): each step the ARM9 sends
+ *              over FIFO_ITEMS is run from the main loop, and its hits and
+ *              pickups go back in datamsg chunks (items_link.h).
+ *
+ * Built by arm7/Makefile only when the game is built with ITEMS_ON_ARM7=1;
+ * the default build ships the libnds ARM7 binary.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include <nds.h>
+#include <dswifi7.h>
+#include <maxmod7.h>
+
+#include "gameplay/items/items_link.h"
+
+//=============================================================================
+// STATE
+//=============================================================================
+static volatile bool exitflag = false;
+
+//=============================================================================
+// HANDLERS
+//=============================================================================
+
+static void VblankHandler(void) {
+    Wifi_Update();
+}
+
+static void VcountHandler(void) {
+    inputGetAndSend();
+}
+
+static void powerButtonCB(void) {
+    exitflag = true;
+}
+
+//=============================================================================
+// MAIN
+//=============================================================================
+
+int main(void) {
+    // Clear the sound registers and power the speakers, as the stock ARM7 does
+    dmaFillWords(0, (void*)0x04000400, 0x100);
+    REG_SOUNDCNT |= SOUND_ENABLE;
+    writePowerManagement(PM_CONTROL_REG,
+                         (readPowerManagement(PM_CONTROL_REG) & ~PM_SOUND_MUTE) |
+                             PM_SOUND_AMP);
+    powerOn(POWER_SOUND);
+
+    readUserSettings();
+    ledBlink(0);
+
+    irqInit();
+    initClockIRQ();  // RTC tracking
+    fifoInit();
+    touchInit();
+
+    mmInstall(FIFO_MAXMOD);
+
+    SetYtrigger(80);
+
+    installWifiFIFO();
+    installSoundFIFO();
+    installSystemFIFO();
+    ItemLink_InitArm7();
+
+    irqSet(IRQ_VCOUNT, VcountHandler);
+    irqSet(IRQ_VBLANK, VblankHandler);
+    irqEnable(IRQ_VBLANK | IRQ_VCOUNT | IRQ_NETWORK);
+
+    setPowerButtonCB(powerButtonCB);
+
+    while (!exitflag) {
+        if (0 == (REG_KEYINPUT & (KEY_SELECT | KEY_START | KEY_L | KEY_R)))
+            exitflag = true;
+
+        // Sleep until the next frame or FIFO message; a step that arrived
+        // while the last one ran is waiting in the flags, so none is missed
+        swiIntrWait(0, IRQ_VBLANK | IRQ_FIFO_NOT_EMPTY);
+        ItemLink_RunStep();
+    }
+    return 0;
+}
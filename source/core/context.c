@@ -29,6 +29,7 @@ void GameContext_InitDefaults(void) {
     gGameContext.currentGameState = HOME_PAGE;
     gGameContext.SelectedMap = NONEMAP;
     gGameContext.isMultiplayerMode = false;
+    gGameContext.isReplayMode = false;
 }
 
 //=============================================================================
@@ -73,3 +74,11 @@ void GameContext_SetMultiplayerMode(bool isMultiplayer) {
 bool GameContext_IsMultiplayerMode(void) {
     return gGameContext.isMultiplayerMode;
 }
+
+void GameContext_SetReplayMode(bool isReplay) {
+    gGameContext.isReplayMode = isReplay;
+}
+
+bool GameContext_IsReplayMode(void) {
+    return gGameContext.isReplayMode;
+}
@@ -30,6 +30,7 @@
  *   currentGameState           - Current screen/state (HOME_PAGE, GAMEPLAY, etc.)
  *   SelectedMap                - Currently selected map for gameplay
  *   isMultiplayerMode          - True if in multiplayer, false for singleplayer
+ *   isReplayMode               - True if the next race plays the last replay
  */
 typedef struct {
     struct {
@@ -41,6 +42,7 @@ typedef struct {
     GameState currentGameState;
     Map SelectedMap;
     bool isMultiplayerMode;
+    bool isReplayMode;
 } GameContext;
 
 //=============================================================================
@@ -67,6 +69,7 @@ GameContext* GameContext_Get(void);
  *   - Game state: HOME_PAGE
  *   - Map: NONEMAP
  *   - Multiplayer mode: false
+ *   - Replay mode: false
  */
 void GameContext_InitDefaults(void);
 
@@ -150,4 +153,24 @@ void GameContext_SetMultiplayerMode(bool isMultiplayer);
  */
 bool GameContext_IsMultiplayerMode(void);
 
+/**
+ * Function: GameContext_SetReplayMode
+ * -----------------------------------
+ * Sets whether the next race plays the last race's replay instead of a new
+ * race.
+ *
+ * Parameters:
+ *   isReplay - true to watch the replay, false for a normal race
+ */
+void GameContext_SetReplayMode(bool isReplay);
+
+/**
+ * Function: GameContext_IsReplayMode
+ * ----------------------------------
+ * Checks if the race being started is a replay.
+ *
+ * Returns: true if replay mode, false for a normal race
+ */
+bool GameContext_IsReplayMode(void);
+
 #endif
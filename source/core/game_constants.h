@@ -36,6 +36,8 @@
 
 #define MAX_CARS 8          // Maximum number of cars in a race
 #define MAX_CHECKPOINTS 16  // Maximum number of checkpoints
+#define SIM_RNG_SEED 0x4B4D5241u  // First seed of the race random generator ("KMRA")
+#define SIM_STATE_DTCM_BUDGET 4096  // Max SimState bytes in DTCM (TCM=1, see tcm.h)
 
 //=============================================================================
 // Rendering & Display Constants
@@ -188,6 +190,20 @@
 #define QUAD_BOUNDARY_LOW 256   // First quadrant boundary
 #define QUAD_BOUNDARY_HIGH 512  // Second quadrant boundary
 
+// Background edge streaming (wrapping 64x64 tile window, see bg_stream.h)
+#define BG_STREAM_SIZE_TILES 64                       // Window size in tiles
+#define BG_STREAM_MASK (BG_STREAM_SIZE_TILES - 1)     // Wrap mask for tile coords
+#define BG_STREAM_SIZE_PX (BG_STREAM_SIZE_TILES * TILE_SIZE)  // 512 px
+#define BG_STREAM_MARGIN_X_TILES \
+    ((BG_STREAM_SIZE_TILES - (TILES_PER_SCREEN_WIDTH + 1)) / 2)  // 15 cols
+#define BG_STREAM_MARGIN_Y_TILES \
+    ((BG_STREAM_SIZE_TILES - (TILES_PER_SCREEN_HEIGHT + 1)) / 2)  // 19 rows
+#define BG_STREAM_MAX_STAGED 8  // Rows/cols staged per frame before full refill
+
+// Render command buffer (see render_cmd.h). One frame's list must hold a full
+// BG window refill (8 KB) plus a whole OAM (1 KB) and the sub-screen patches.
+#define RENDER_CMD_ARENA_BYTES (12 * 1024)
+
 //=============================================================================
 // Color & Graphics Constants
 //=============================================================================
@@ -214,6 +230,7 @@
 #define SECONDS_PER_MINUTE 60  // Seconds per minute
 #define CHRONO_FREQ_HZ 1000    // Chronometer frequency in Hz
 #define RACE_TICK_FREQ 60      // Race physics tick rate in Hz
+#define RENDER_INTERP_MAX_STEP 32  // Px per tick; longer jumps (respawn) snap
 
 //=============================================================================
 // Race Display & UI Timing
@@ -265,6 +282,7 @@
 //=============================================================================
 
 #define DEBOUNCE_DELAY 15  // ~250ms at 60Hz for button debouncing
+#define KEY_EVENT_QUEUE_SIZE 16  // Key ISR -> main loop events (power of two)
 
 //=============================================================================
 // Network Constants
@@ -282,4 +300,99 @@
 
 #define WAYPOINT_REACHED_DIST IntToFixed(25)  // 25 pixels = waypoint reached threshold
 
+//=============================================================================
+// Profiler (make PROFILE=1)
+//=============================================================================
+
+#define PROFILER_MAX_DEPTH 8        // Nested zones (main loop + ISR on top)
+#define PROFILER_OVERLAY_FRAMES 30  // Overlay window: 0.5 seconds at 60Hz
+#define PROFILER_TRACE_FILE "/kart-mania/profile.folded"  // Written after a race
+#define PROFILER_STATS_FILE "/kart-mania/profile.txt"     // Zone min/avg/max, same time
+
+//=============================================================================
+// Ghost (source/gameplay/ghost.h)
+//=============================================================================
+
+#define GHOST_MAGIC 0x48474D4B         // "KMGH"
+#define GHOST_VERSION 1
+#define GHOST_FILE_FORMAT "/kart-mania/ghost_%d.kmg"  // Best lap of a map (Map value)
+#define GHOST_TMP_FILE "/kart-mania/ghost.tmp"
+#define GHOST_LAP_BYTES 16384          // Recording buffer per lap (~2 min at 2 B/tick)
+#define GHOST_WINDOW_BYTES 512         // Playback window streamed from the card
+#define GHOST_BLEND_EVA 7              // Ghost kart weight (of 16)
+#define GHOST_BLEND_EVB 9              // Background weight (of 16)
+
+//=============================================================================
+// Replay (source/gameplay/replay.h)
+//=============================================================================
+
+#define REPLAY_FILE "/kart-mania/last.kmr"      // Last race, all karts and items
+#define REPLAY_TMP_FILE "/kart-mania/replay.tmp"
+#define REPLAY_KEYFRAME_TICKS 120   // 2 s: most re-simulated by a seek
+#define REPLAY_MAX_KEYFRAMES 512    // Index entries (17 min at 120 ticks)
+#define REPLAY_QUEUE_WORDS 1024     // Race tick <-> replay task words (power of two)
+#define REPLAY_BUFFER_BYTES 8192    // Each of 2 write buffers / read window (a keyframe)
+#define REPLAY_FLUSH_BYTES 2048     // Buffered bytes that queue a write
+#define REPLAY_LEAD_TICKS 64        // Decoded ticks queued ahead of playback
+#define REPLAY_SEEK_TICKS 300       // LEFT/RIGHT step during playback (5 s)
+
+//=============================================================================
+// Telemetry (make TELEMETRY=1, source/gameplay/telemetry.h)
+//=============================================================================
+
+#define TELEMETRY_FILE "/kart-mania/race.kmt"  // Last race (telemetry_report.py)
+#define TELEMETRY_QUEUE_WORDS 512     // Race tick -> task words (power of two, 32 ticks)
+#define TELEMETRY_BUFFER_BYTES 4096   // Each of the two write buffers (1 to 2 s of race)
+
+//=============================================================================
+// Record Store (source/storage/record_store.h)
+//=============================================================================
+
+#define RECORDS_MAGIC 0x43524D4B   // "KMRC"
+#define RECORDS_VERSION 1
+#define RECORDS_MAP_SLOTS 8        // Best time slots (indexed by Map, room for tracks)
+#define RECORDS_WRITE_DELAY 30     // Frames a change waits before the write-behind
+
+//=============================================================================
+// Memory Budgets (source/core/mem_budget.h)
+//=============================================================================
+
+#define MEM_MAX_BLOCKS 128                // Live OAM + heap blocks tracked at once
+#define MEM_MAX_STATES 8                  // GameState values with per-state peaks
+#define MEM_PALETTE_BANKS 16              // 16-color banks per sprite palette
+#define MEM_HEAP_BUDGET (2 * 1024 * 1024)  // Heap we plan for (4 MB RAM - code, data)
+
+//=============================================================================
+// Binary Log (make LOG_LEVEL=n)
+//=============================================================================
+
+#define KMLOG_RING_WORDS 1024  // 4 KB ring, power of two (~128 typical records)
+#define KMLOG_FLUSH_WORDS 256  // Words queued per write of the log task
+#define KMLOG_SYNC_FLUSHES 30  // Writes between flushes to the card (IO_SYNC)
+#define LOG_FILE "/kart-mania/log.kml"  // Decode with tools/debug/kmlog_decode.py
+
+//=============================================================================
+// Frame Scheduler (budgets in scanlines: 263 per frame, ~63.5 us each)
+//=============================================================================
+
+#define SCHED_MAX_TASKS 11
+#define SCHED_LINES_PER_FRAME 263     // 192 visible + 71 VBlank lines
+#define SCHED_FRAME_BUDGET_LINES 230  // Main loop work before shedding starts
+#define SCHED_DEGRADE_FRAMES 2        // Consecutive overruns before degrading
+#define SCHED_RECOVER_FRAMES 60       // Calm frames before undoing one level
+#define SCHED_MAX_LOAD_LEVEL 2        // Low-priority periods stretch up to x4
+
+// Task periods and budgets (scanlines per run)
+#define SCHED_NET_SYNC_PERIOD 4   // Ticks between car state exchanges (15Hz)
+#define SCHED_BUDGET_WIFI 24
+#define SCHED_BUDGET_NET_SYNC 16
+#define SCHED_BUDGET_RETARGET 4   // Lock-on scan of all homing items
+#define SCHED_BUDGET_HUD 8
+#define SCHED_BUDGET_PRELOAD 64   // One pack read or decompress of the next track
+#define SCHED_BUDGET_LOG 8        // Copy of KMLOG_FLUSH_WORDS, queued for the io task
+#define SCHED_BUDGET_STORE 4      // Record file checksum, queued for the io task
+#define SCHED_BUDGET_REPLAY 48    // Encode or decode a frame of ticks, one FAT write
+#define SCHED_BUDGET_IO 24        // One FAT step: open, 512-byte write, close or rename
+#define SCHED_BUDGET_TELEMETRY 4  // Copy a frame of ticks, queue a full buffer
+
 #endif  // GAME_CONSTANTS_H
@@ -87,4 +87,16 @@ typedef enum {
     QUAD_BR = 8   // Bottom-Right
 } QuadrantID;
 
+//=============================================================================
+// INTERRUPT EVENTS
+//=============================================================================
+
+/**
+ * Event types interrupt handlers post to the main loop (type field of
+ * SPSC_EVENT, see spsc_queue.h).
+ */
+typedef enum {
+    EVENT_KEY_DOWN = 1  // Payload: keys held when the key interrupt fired
+} IrqEventType;
+
 #endif  // GAME_TYPES_H
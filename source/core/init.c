@@ -15,8 +15,17 @@
 #include <dswifi9.h>
 
 #include "../audio/sound.h"
+#include "../graphics/residency.h"
+#include "../storage/assets.h"
+#include "../storage/io_queue.h"
+#include "../storage/record_store.h"
 #include "../storage/storage.h"
 #include "context.h"
+#include "game_constants.h"
+#include "kmlog.h"
+#include "mem_budget.h"
+#include "profiler.h"
+#include "scheduler.h"
 #include "state_machine.h"
 
 //=============================================================================
@@ -27,19 +36,32 @@
  * Function: init_storage_and_context
  * -----------------------------------
  * Initializes storage system and game context. Loads saved settings from
- * storage if available, otherwise uses hardcoded defaults.
+ * storage if available, otherwise uses hardcoded defaults. Opens the NitroFS
+ * asset pack (index only; screens load their graphics on demand).
  */
 static void init_storage_and_context(void) {
     // Initialize FAT filesystem first (required for loading saved settings)
     bool storageAvailable = Storage_Init();
 
+    // NitroFS locates the ROM through FAT on flashcarts, so mount it after
+    Assets_Init(ASSETS_PACK_PATH);
+
     // Initialize context with hardcoded defaults (WiFi on, music on, etc.)
     GameContext_InitDefaults();
 
-    // If SD card available, load saved settings to overwrite defaults
+    // If SD card available, load saved settings to overwrite defaults; later
+    // saves are queued from the record cache and written in idle time
     if (storageAvailable) {
         Storage_LoadSettings();
+        Scheduler_Register("store", RecordStore_Flush, SCHED_PRIO_LOW, 1,
+                           SCHED_BUDGET_STORE);
+    }
+
+    // Binary log stream (records logged so far are waiting in the ring)
+    if (storageAvailable) {
+        KmLog_Open(LOG_FILE);
     }
+    LOG_INFO("boot storage=%d", storageAvailable);
 }
 
 /**
@@ -73,9 +95,13 @@ static void init_audio_system(void) {
  *
  * IMPORTANT: DO NOT call Wifi_InitDefault() anywhere else in the code!
  * See wifi.md for details on why re-initialization breaks multiplayer.
+ *
+ * The DSWifi state machine is then updated every frame as a critical
+ * scheduler task.
  */
 static void init_wifi_stack(void) {
     Wifi_InitDefault(false);
+    Scheduler_Register("wifi", Wifi_Update, SCHED_PRIO_CRITICAL, 1, SCHED_BUDGET_WIFI);
 }
 
 //=============================================================================
@@ -83,16 +109,35 @@ static void init_wifi_stack(void) {
 //=============================================================================
 
 void InitGame(void) {
-    // 1. Initialize storage and load settings
+#ifdef PROFILER_ENABLED
+    // 0. Start the profiler clock before anything opens a zone
+    Profiler_Init();
+#endif
+
+    // 1. Frame scheduler (subsystems register their tasks while initializing),
+    //    the SD card write queue, run in the idle time of each frame, and the
+    //    log ring it writes to the card
+    Scheduler_Init();
+    IoQueue_Init(NULL);
+    Scheduler_Register("io", IoQueue_Service, SCHED_PRIO_IDLE, 1, SCHED_BUDGET_IO);
+    KmLog_Init();
+    MemBudget_Init();  // Before the first allocation (asset index, OAM)
+    Scheduler_Register("log", KmLog_Flush, SCHED_PRIO_LOW, 1, SCHED_BUDGET_LOG);
+
+    // 2. Initialize storage and load settings
     init_storage_and_context();
 
-    // 2. Initialize audio system
+    // 3. Initialize audio system
     init_audio_system();
 
-    // 3. Initialize WiFi stack (CRITICAL - only once!)
+    // 4. Initialize WiFi stack (CRITICAL - only once!)
     init_wifi_stack();
 
-    // 4. Initialize starting game state (HOME_PAGE)
+    // 5. Clear VRAM and palettes, forget resident asset sets
+    Residency_Init();
+
+    // 6. Initialize starting game state (HOME_PAGE)
     GameContext* ctx = GameContext_Get();
+    MemBudget_BeginState(ctx->currentGameState);
     StateMachine_Init(ctx->currentGameState);
 }
@@ -0,0 +1,244 @@
+/**
+ * File: kmlog.c
+ * -------------
+ * Description: Implementation of the binary logging channel. Records are
+ *              pushed whole into an SPSC ring (interrupts disabled around the
+ *              push, since the tick ISR and the main loop both log) and the
+ *              flush task, the only consumer, stages words for the sink: the
+ *              log file through the io queue (one write in flight), or
+ *              stdout directly.
+ *
+ * Stream (little-endian 32-bit words):
+ *   header  KMLOG_MAGIC, KMLOG_VERSION, clock, kmlog_fmt section size
+ *   record  offset << 8 | level << 4 | argc, timestamp, argc argument words
+ *
+ * `offset` is the format string's offset in the kmlog_fmt section, or
+ * KMLOG_DROP_OFFSET for a marker whose argument is the number of records
+ * dropped since the previous marker. Timestamps are frame << 9 | scanline on
+ * the DS (clock 0) and microseconds on the host (clock 1).
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "kmlog.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ARM9
+#include "scheduler.h"
+#else
+#include <time.h>
+typedef uint64_t u64;
+#endif
+
+#include "../storage/io_queue.h"
+#include "game_constants.h"
+#include "spsc_queue.h"
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define KMLOG_MAGIC 0x474C4D4Bu  // "KMLG"
+#define KMLOG_VERSION 1
+#define KMLOG_DROP_OFFSET 0xFFFFFFu
+#define KMLOG_HEADER_WORDS 2      // Record header + timestamp
+#define KMLOG_RECORD_MAX (KMLOG_HEADER_WORDS + KMLOG_MAX_ARGS)
+
+#ifdef ARM9
+#define KMLOG_CLOCK 0  // frame << 9 | scanline
+#else
+#define KMLOG_CLOCK 1  // Microseconds
+#endif
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+
+// Section bounds, provided by the linker
+extern const char __start_kmlog_fmt[];
+extern const char __stop_kmlog_fmt[];
+
+// Keeps the section (and its bounds) in builds where every call compiled out
+static const char kmlogAnchor[] KMLOG_FMT_SECTION = "";
+
+static u32 ringSlots[KMLOG_RING_WORDS];
+static SpscQueue ring;
+
+static FILE* sink = NULL;            // stdout (host)
+static const char* logPath = NULL;   // Log file, written through the io queue
+static bool fileStarted = false;     // The header write truncated the file
+static bool writing = false;         // Staged words queued, not written yet
+static int recordLeft = 0;      // Words of the record being flushed
+static u32 reportedDropped = 0;  // Drops already written as markers
+static int unsyncedFlushes = 0;
+
+// Words of the current write: a batch of the ring and a drop marker
+static u32 staging[KMLOG_FLUSH_WORDS + KMLOG_HEADER_WORDS + 1];
+static int stagedWords = 0;
+
+//=============================================================================
+// PRIVATE HELPERS
+//=============================================================================
+
+#ifdef ARM9
+static inline u32 KmLog_Now(void) {
+    return (Scheduler_GetStats()->frames << 9) | REG_VCOUNT;
+}
+
+static inline int KmLog_Lock(void) {
+    return enterCriticalSection();
+}
+
+static inline void KmLog_Unlock(int oldIme) {
+    leaveCriticalSection(oldIme);
+}
+#else
+static inline u32 KmLog_Now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (u32)((u64)now.tv_sec * 1000000u + (u64)now.tv_nsec / 1000u);
+}
+
+static inline int KmLog_Lock(void) {
+    return 0;  // No interrupts on the host
+}
+
+static inline void KmLog_Unlock(int oldIme) {
+    (void)oldIme;
+}
+#endif
+
+static void KmLog_Stage(const u32* words, int count) {
+    memcpy(staging + stagedWords, words, (size_t)count * sizeof(u32));
+    stagedWords += count;
+}
+
+static void KmLog_WriteDone(bool ok) {
+    writing = false;
+    stagedWords = 0;
+    if (!ok)
+        logPath = NULL;  // Card gone or full: discard from now on, as without one
+}
+
+// Hands the staged words to the sink (without one, they are discarded)
+static void KmLog_WriteStaged(void) {
+    if (stagedWords == 0)
+        return;
+
+    if (sink != NULL) {
+        fwrite(staging, sizeof(u32), (size_t)stagedWords, sink);
+        if (++unsyncedFlushes >= KMLOG_SYNC_FLUSHES) {
+            fflush(sink);
+            unsyncedFlushes = 0;
+        }
+    }
+    if (logPath == NULL) {
+        stagedWords = 0;
+        return;
+    }
+
+    // Push buffered data to the card now and then, not on every write
+    bool sync = unsyncedFlushes + 1 >= KMLOG_SYNC_FLUSHES;
+    IoWrite write = {logPath, NULL,
+                     (u8)(IO_KEEP_OPEN | (fileStarted ? IO_APPEND : 0) |
+                          (sync ? IO_SYNC : 0)),
+                     {{staging, (u32)stagedWords * sizeof(u32)}},
+                     KmLog_WriteDone};
+    if (IoQueue_Write(&write) == IO_NO_REQUEST)
+        return;  // Queue full: the words stay staged for the next run
+    writing = true;
+    fileStarted = true;
+    unsyncedFlushes = sync ? 0 : unsyncedFlushes + 1;
+}
+
+// Reports drops between two records so the stream stays parseable
+static void KmLog_StageDropMarker(void) {
+    u32 dropped = SpscQueue_GetDropped(&ring);
+    if (dropped == reportedDropped)
+        return;
+
+    u32 marker[KMLOG_HEADER_WORDS + 1] = {
+        (KMLOG_DROP_OFFSET << 8) | ((u32)KMLOG_LEVEL_WARN << 4) | 1u,
+        KmLog_Now(),
+        dropped - reportedDropped,
+    };
+    KmLog_Stage(marker, KMLOG_HEADER_WORDS + 1);
+    reportedDropped = dropped;
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void KmLog_Init(void) {
+    SpscQueue_Init(&ring, ringSlots, KMLOG_RING_WORDS);
+    sink = NULL;
+    logPath = NULL;
+    fileStarted = false;
+    writing = false;
+    stagedWords = 0;
+    recordLeft = 0;
+    reportedDropped = 0;
+    unsyncedFlushes = 0;
+}
+
+bool KmLog_Open(const char* path) {
+    if (path != NULL)
+        logPath = path;
+    else
+        sink = stdout;
+
+    u32 header[4] = {
+        KMLOG_MAGIC,
+        KMLOG_VERSION,
+        KMLOG_CLOCK,
+        (u32)(__stop_kmlog_fmt - __start_kmlog_fmt),
+    };
+    (void)kmlogAnchor;
+    KmLog_Stage(header, 4);
+    KmLog_WriteStaged();
+    return true;
+}
+
+void KmLog_Write(int level, const char* fmt, const u32* args, int argc) {
+    u32 record[KMLOG_RECORD_MAX];
+    record[0] =
+        ((u32)(fmt - __start_kmlog_fmt) << 8) | ((u32)level << 4) | (u32)argc;
+    record[1] = KmLog_Now();
+    for (int i = 0; i < argc; i++)
+        record[KMLOG_HEADER_WORDS + i] = args[i];
+
+    // Several producers (main loop, tick ISR): one push at a time
+    int oldIme = KmLog_Lock();
+    SpscQueue_PushBatch(&ring, record, KMLOG_HEADER_WORDS + argc);
+    KmLog_Unlock(oldIme);
+}
+
+void KmLog_Flush(void) {
+    if (writing)
+        return;  // The io task has not written the previous batch yet
+    if (stagedWords > 0) {
+        KmLog_WriteStaged();  // Retry a batch the full queue refused
+        return;
+    }
+
+    int count = SpscQueue_PopBatch(&ring, staging, KMLOG_FLUSH_WORDS);
+
+    // Track record boundaries: a batch may end inside a record
+    for (int i = 0; i < count; i++) {
+        if (recordLeft == 0)
+            recordLeft = KMLOG_HEADER_WORDS + (int)(staging[i] & 0xF);
+        recordLeft--;
+    }
+    stagedWords = count;
+    if (recordLeft == 0)
+        KmLog_StageDropMarker();
+    KmLog_WriteStaged();
+}
+
+u32 KmLog_GetDropped(void) {
+    return SpscQueue_GetDropped(&ring);
+}
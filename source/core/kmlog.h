@@ -0,0 +1,155 @@
+/**
+ * File: kmlog.h
+ * -------------
+ * Description: Binary logging channel. A log call copies its arguments as raw
+ *              32-bit words into a ring buffer; nothing is formatted on the
+ *              DS. Format strings are only referenced: they are linked once
+ *              into their own `kmlog_fmt` section and a record carries the
+ *              string's offset in it. A low-priority scheduler task queues the
+ *              ring for LOG_FILE on the SD card (stdout in the host build), and
+ *              tools/debug/kmlog_decode.py turns the stream back into text
+ *              using the ELF the stream was produced by.
+ *
+ * Levels are chosen at compile time (make LOG_LEVEL=n, default INFO): calls
+ * below KMLOG_LEVEL expand to nothing, so neither their arguments nor their
+ * format strings are in the binary.
+ *
+ * Arguments are integers (up to KMLOG_MAX_ARGS), formatted by the decoder
+ * with %d %i %u %x %X %c and the usual flags and widths. %s is not supported:
+ * a pointer means nothing outside the DS.
+ *
+ * Usage:
+ *   LOG_INFO("race start map=%d laps=%d", map, laps);
+ *   LOG_WARN("item link full (%u dropped)", ItemLink_GetDropped());
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef KMLOG_H
+#define KMLOG_H
+
+#include <stdbool.h>
+
+#ifdef ARM9
+#include <nds.h>
+#else
+#include <stdint.h>
+typedef uint32_t u32;
+#endif
+
+//=============================================================================
+// PUBLIC CONSTANTS
+//=============================================================================
+
+#define KMLOG_LEVEL_DEBUG 0
+#define KMLOG_LEVEL_INFO 1
+#define KMLOG_LEVEL_WARN 2
+#define KMLOG_LEVEL_ERROR 3
+#define KMLOG_LEVEL_NONE 4  // Compiles every call out
+
+#ifndef KMLOG_LEVEL
+#define KMLOG_LEVEL KMLOG_LEVEL_INFO
+#endif
+
+#define KMLOG_MAX_ARGS 6
+
+//=============================================================================
+// MACROS
+//=============================================================================
+
+// Format strings: one copy each, in a section the decoder reads from the ELF
+#define KMLOG_FMT_SECTION __attribute__((section("kmlog_fmt"), used, aligned(1)))
+
+// Number of variadic arguments (0 to 8; more is caught by the assert below)
+#define KMLOG_NARGS(...) KMLOG_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define KMLOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
+
+#define KMLOG_WRITE(level, fmt, ...)                                              \
+    do {                                                                          \
+        _Static_assert(KMLOG_NARGS(__VA_ARGS__) <= KMLOG_MAX_ARGS,                \
+                       "Too many log arguments");                                 \
+        static const char kmlogFmt[] KMLOG_FMT_SECTION = fmt;                     \
+        const u32 kmlogArgs[KMLOG_NARGS(__VA_ARGS__) + 1] = {0, ##__VA_ARGS__}; \
+        KmLog_Write((level), kmlogFmt, kmlogArgs + 1, KMLOG_NARGS(__VA_ARGS__));  \
+    } while (0)
+
+#if KMLOG_LEVEL <= KMLOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) KMLOG_WRITE(KMLOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if KMLOG_LEVEL <= KMLOG_LEVEL_INFO
+#define LOG_INFO(...) KMLOG_WRITE(KMLOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if KMLOG_LEVEL <= KMLOG_LEVEL_WARN
+#define LOG_WARN(...) KMLOG_WRITE(KMLOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if KMLOG_LEVEL <= KMLOG_LEVEL_ERROR
+#define LOG_ERROR(...) KMLOG_WRITE(KMLOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: KmLog_Init
+ * --------------------
+ * Empties the ring. Records written before KmLog_Open() wait in the ring.
+ * Call once at boot, before anything logs.
+ */
+void KmLog_Init(void);
+
+/**
+ * Function: KmLog_Open
+ * --------------------
+ * Starts the stream: queues the stream header for `path` (NULL: writes it
+ * to stdout). `path` must stay valid. Without a sink (no SD card), or once a
+ * write to the file failed, the flush task discards records.
+ *
+ * Returns: true
+ */
+bool KmLog_Open(const char* path);
+
+/**
+ * Function: KmLog_Write
+ * ---------------------
+ * Appends one record. Called by the LOG_* macros; safe from interrupt
+ * handlers. A record that does not fit is dropped and counted.
+ *
+ * Parameters:
+ *   level - KMLOG_LEVEL_*
+ *   fmt   - Format string in the kmlog_fmt section
+ *   args  - `argc` argument words
+ *   argc  - 0 to KMLOG_MAX_ARGS
+ */
+void KmLog_Write(int level, const char* fmt, const u32* args, int argc);
+
+/**
+ * Function: KmLog_Flush
+ * ---------------------
+ * Hands up to KMLOG_FLUSH_WORDS words of the ring to the sink: queued for
+ * the io task (io_queue.h), at most one write in flight, or written to
+ * stdout. Registered as the low-priority "log" task.
+ */
+void KmLog_Flush(void);
+
+/**
+ * Function: KmLog_GetDropped
+ * --------------------------
+ * Gets how many records were dropped on a full ring since KmLog_Init().
+ */
+u32 KmLog_GetDropped(void);
+
+#endif  // KMLOG_H
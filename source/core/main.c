@@ -10,11 +10,14 @@
  */
 
 #include <nds.h>
-#include <dswifi9.h>
 
-#include "../graphics/graphics.h"
+#include "../graphics/residency.h"
 #include "context.h"
 #include "init.h"
+#include "kmlog.h"
+#include "mem_budget.h"
+#include "profiler.h"
+#include "scheduler.h"
 #include "state_machine.h"
 
 int main(void) {
@@ -25,20 +28,41 @@ int main(void) {
 
     // Main game loop
     while (true) {
-        // Update DSWifi state machine every frame (critical for multiplayer)
-        Wifi_Update();
+        // Frame tasks: DSWifi state machine (critical for multiplayer), ...
+        Scheduler_RunFrame();
 
         // Run current state's update logic (returns next state)
         GameState nextState = StateMachine_Update(ctx->currentGameState);
 
         // Handle state transitions
         if (nextState != ctx->currentGameState) {
+            PROF_BEGIN(PROF_ZONE_TRANSITION);
+            LOG_INFO("state %d -> %d", ctx->currentGameState, nextState);
             StateMachine_Cleanup(ctx->currentGameState, nextState);
+            MemBudget_EndState(ctx->currentGameState);  // Reports what it leaked
             ctx->currentGameState = nextState;
-            video_nuke();
+            // Clear only what the next state needs cleared (see residency.h)
+            Residency_BeginTransition(nextState);
+            MemBudget_BeginState(nextState);
             StateMachine_Init(nextState);
+            Residency_EndTransition();
+            PROF_END(PROF_ZONE_TRANSITION);
+#ifdef PROFILER_ENABLED
+            // Follows the "state" line above (PLAYAGAIN -> GAMEPLAY is 4 -> 3)
+            LOG_INFO("transition %u us, cleared %u kept %u bytes",
+                     (u32)Profiler_GetLastMicros(PROF_ZONE_TRANSITION),
+                     Residency_GetStats()->lastClearedBytes,
+                     Residency_GetStats()->lastKeptBytes);
+#endif
+            Scheduler_ResetLoad();  // Screen loading is not sustained load
         }
 
+        // Idle tasks (SD card writes) in what is left of the frame budget
+        Scheduler_RunIdle();
+
+        // Measure the frame; sustained overruns degrade low-priority tasks
+        Scheduler_EndFrame();
+
         // Wait for vertical blank (60Hz synchronization)
         swiWaitForVBlank();
     }
@@ -0,0 +1,310 @@
+/**
+ * File: mem_budget.c
+ * ------------------
+ * Description: Implementation of the memory pool accounting. Live OAM and
+ *              heap blocks are kept in a fixed table (pointer, size, pool,
+ *              owner, state) so a free knows what to refund and a state's
+ *              cleanup can list what it left behind. Palette pools keep one
+ *              bank mask per owner; extent pools keep the highest offset
+ *              written.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "mem_budget.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "game_constants.h"
+#include "kmlog.h"
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define NO_STATE 0xFF
+
+static const char* const poolNames[MEM_POOL_COUNT] = {
+    [MEM_POOL_OAM_MAIN] = "oam_main",
+    [MEM_POOL_OAM_SUB] = "oam_sub",
+    [MEM_POOL_BG_MAIN] = "bg_main",
+    [MEM_POOL_BG_SUB] = "bg_sub",
+    [MEM_POOL_PAL_MAIN] = "pal_main",
+    [MEM_POOL_PAL_SUB] = "pal_sub",
+    [MEM_POOL_HEAP] = "heap",
+};
+
+static const u32 poolCapacity[MEM_POOL_COUNT] = {
+    [MEM_POOL_OAM_MAIN] = VRAM_BANK_SIZE,
+    [MEM_POOL_OAM_SUB] = VRAM_BANK_SIZE,
+    [MEM_POOL_BG_MAIN] = VRAM_BANK_SIZE,
+    [MEM_POOL_BG_SUB] = VRAM_BANK_SIZE,
+    [MEM_POOL_PAL_MAIN] = MEM_PALETTE_BANKS,
+    [MEM_POOL_PAL_SUB] = MEM_PALETTE_BANKS,
+    [MEM_POOL_HEAP] = MEM_HEAP_BUDGET,
+};
+
+// Owners whose blocks are meant to outlive the state that made them
+static const bool ownerOutlivesState[MEM_OWNER_COUNT] = {
+    [MEM_OWNER_TRACK] = true,
+    [MEM_OWNER_ASSETS] = true,
+};
+
+//=============================================================================
+// PRIVATE TYPES
+//=============================================================================
+typedef struct {
+    uintptr_t addr;  // Block address, 0: free slot
+    u32 bytes;
+    u8 pool;
+    u8 owner;
+    u8 state;
+    bool reported;  // Already counted as a leak
+} MemBlock;
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static MemBlock blocks[MEM_MAX_BLOCKS];
+static MemPoolStats pools[MEM_POOL_COUNT];
+static u32 ownerUsage[MEM_POOL_COUNT][MEM_OWNER_COUNT];
+static u16 paletteMasks[MEM_POOL_COUNT][MEM_OWNER_COUNT];  // Palette pools only
+static u32 statePeak[MEM_MAX_STATES][MEM_POOL_COUNT];
+static MemBudgetStats stats;
+static u8 currentState = NO_STATE;
+
+//=============================================================================
+// PRIVATE HELPERS
+//=============================================================================
+
+static void MemBudget_SetUsed(MemPool pool, u32 used) {
+    MemPoolStats* p = &pools[pool];
+    p->used = used;
+    if (used > p->peak)
+        p->peak = used;
+    if (currentState < MEM_MAX_STATES && used > statePeak[currentState][pool])
+        statePeak[currentState][pool] = used;
+}
+
+// Blocks are keyed by address: the block itself is never read, and a pointer
+// to fresh malloc memory makes gcc warn that it may be used uninitialized
+static void MemBudget_Track(uintptr_t addr, u32 bytes, MemPool pool, MemOwner owner) {
+    for (int i = 0; i < MEM_MAX_BLOCKS; i++) {
+        if (blocks[i].addr == 0) {
+            blocks[i] = (MemBlock){addr, bytes, (u8)pool, (u8)owner, currentState, false};
+            ownerUsage[pool][owner] += bytes;
+            pools[pool].live++;
+            MemBudget_SetUsed(pool, pools[pool].used + bytes);
+            return;
+        }
+    }
+    stats.untracked++;  // Not charged: its free could not be refunded
+}
+
+static void MemBudget_Untrack(MemBlock* block) {
+    MemPool pool = (MemPool)block->pool;
+    ownerUsage[pool][block->owner] -= block->bytes;
+    pools[pool].live--;
+    MemBudget_SetUsed(pool, pools[pool].used - block->bytes);
+    block->addr = 0;
+}
+
+static MemBlock* MemBudget_Find(uintptr_t addr, MemPool pool) {
+    for (int i = 0; i < MEM_MAX_BLOCKS; i++) {
+        if (blocks[i].addr == addr && blocks[i].pool == pool)
+            return &blocks[i];
+    }
+    return NULL;
+}
+
+static void MemBudget_ReportLeak(MemBlock* block) {
+    if (block->reported || ownerOutlivesState[block->owner])
+        return;
+    block->reported = true;
+    stats.leaks++;
+    stats.leakedBytes += block->bytes;
+    LOG_WARN("mem leak: pool=%d owner=%d bytes=%u state=%d", block->pool, block->owner,
+             block->bytes, block->state);
+}
+
+static void MemBudget_Failed(MemPool pool, MemOwner owner, u32 bytes) {
+    (void)owner;  // Only logged: unused when KMLOG_LEVEL compiles LOG_ERROR out
+    (void)bytes;
+    pools[pool].failures++;
+    LOG_ERROR("mem alloc failed: pool=%d owner=%d bytes=%u used=%u", pool, owner, bytes,
+              pools[pool].used);
+}
+
+static u32 MemBudget_CountBanks(u16 mask) {
+    u32 count = 0;
+    for (; mask != 0; mask &= (u16)(mask - 1))
+        count++;
+    return count;
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void MemBudget_Init(void) {
+    memset(blocks, 0, sizeof(blocks));
+    memset(pools, 0, sizeof(pools));
+    memset(ownerUsage, 0, sizeof(ownerUsage));
+    memset(paletteMasks, 0, sizeof(paletteMasks));
+    memset(statePeak, 0, sizeof(statePeak));
+    memset(&stats, 0, sizeof(stats));
+    for (int i = 0; i < MEM_POOL_COUNT; i++) {
+        pools[i].name = poolNames[i];
+        pools[i].capacity = poolCapacity[i];
+    }
+    currentState = NO_STATE;
+}
+
+void MemBudget_BeginState(int state) {
+    currentState = (state >= 0 && state < MEM_MAX_STATES) ? (u8)state : NO_STATE;
+    for (int i = 0; i < MEM_POOL_COUNT; i++)
+        MemBudget_SetUsed((MemPool)i, pools[i].used);  // Resident data counts
+}
+
+void MemBudget_EndState(int state) {
+    for (int i = 0; i < MEM_MAX_BLOCKS; i++) {
+        if (blocks[i].addr != 0 && blocks[i].state == state)
+            MemBudget_ReportLeak(&blocks[i]);
+    }
+    currentState = NO_STATE;
+}
+
+void* MemBudget_Malloc(size_t bytes, MemOwner owner) {
+    void* ptr = malloc(bytes);
+    if (ptr == NULL) {
+        MemBudget_Failed(MEM_POOL_HEAP, owner, (u32)bytes);
+        return NULL;
+    }
+    MemBudget_Track((uintptr_t)ptr, (u32)bytes, MEM_POOL_HEAP, owner);
+    return ptr;
+}
+
+void* MemBudget_Calloc(size_t count, size_t size, MemOwner owner) {
+    void* ptr = calloc(count, size);
+    if (ptr == NULL) {
+        MemBudget_Failed(MEM_POOL_HEAP, owner, (u32)(count * size));
+        return NULL;
+    }
+    MemBudget_Track((uintptr_t)ptr, (u32)(count * size), MEM_POOL_HEAP, owner);
+    return ptr;
+}
+
+void MemBudget_Free(void* ptr) {
+    if (ptr == NULL)
+        return;
+    MemBlock* block = MemBudget_Find((uintptr_t)ptr, MEM_POOL_HEAP);
+    if (block != NULL)
+        MemBudget_Untrack(block);
+    free(ptr);
+}
+
+void MemBudget_ClaimPalette(MemPool pool, MemOwner owner, int firstBank, int count) {
+    u16 mask = (u16)(((1u << count) - 1) << firstBank);
+    for (int o = 0; o < MEM_OWNER_COUNT; o++) {
+        if (o != (int)owner && (paletteMasks[pool][o] & mask)) {
+            stats.paletteConflicts++;
+            LOG_WARN("palette conflict: pool=%d banks=%04x owners %d and %d", pool,
+                     paletteMasks[pool][o] & mask, o, owner);
+        }
+    }
+
+    paletteMasks[pool][owner] |= mask;
+    u16 all = 0;
+    for (int o = 0; o < MEM_OWNER_COUNT; o++)
+        all |= paletteMasks[pool][o];
+    ownerUsage[pool][owner] = MemBudget_CountBanks(paletteMasks[pool][owner]);
+    MemBudget_SetUsed(pool, MemBudget_CountBanks(all));
+}
+
+void MemBudget_ReleasePool(MemPool pool) {
+    memset(ownerUsage[pool], 0, sizeof(ownerUsage[pool]));
+    memset(paletteMasks[pool], 0, sizeof(paletteMasks[pool]));
+    MemBudget_SetUsed(pool, 0);
+}
+
+#ifdef ARM9
+static inline MemPool MemBudget_OamPool(const OamState* oam) {
+    return (oam == &oamSub) ? MEM_POOL_OAM_SUB : MEM_POOL_OAM_MAIN;
+}
+
+void MemBudget_OamInit(OamState* oam, SpriteMapping mapping, bool extPalette) {
+    MemPool pool = MemBudget_OamPool(oam);
+    for (int i = 0; i < MEM_MAX_BLOCKS; i++) {
+        if (blocks[i].addr != 0 && blocks[i].pool == pool) {
+            if (blocks[i].state != currentState)
+                MemBudget_ReportLeak(&blocks[i]);
+            MemBudget_Untrack(&blocks[i]);
+        }
+    }
+    oamInit(oam, mapping, extPalette);
+}
+
+u16* MemBudget_AllocGfx(OamState* oam, SpriteSize size, SpriteColorFormat format,
+                        MemOwner owner) {
+    MemPool pool = MemBudget_OamPool(oam);
+    u32 pixels = SPRITE_SIZE_PIXELS(size);
+    u32 bytes = (format == SpriteColorFormat_16Color)    ? pixels / 2
+                : (format == SpriteColorFormat_256Color) ? pixels
+                                                         : pixels * 2;
+
+    u16* gfx = oamAllocateGfx(oam, size, format);
+    if (gfx == NULL) {
+        MemBudget_Failed(pool, owner, bytes);
+        return NULL;
+    }
+    MemBudget_Track((uintptr_t)gfx, bytes, pool, owner);
+    return gfx;
+}
+
+void MemBudget_FreeGfx(OamState* oam, u16* gfx) {
+    MemBlock* block = MemBudget_Find((uintptr_t)gfx, MemBudget_OamPool(oam));
+    if (block != NULL)
+        MemBudget_Untrack(block);
+    oamFreeGfx(oam, gfx);
+}
+
+void MemBudget_MarkVram(const void* dst, u32 bytes) {
+    uintptr_t addr = (uintptr_t)dst;
+    MemPool pool;
+    uintptr_t base;
+    if (addr >= (uintptr_t)BG_GFX && addr < (uintptr_t)BG_GFX + VRAM_BANK_SIZE) {
+        pool = MEM_POOL_BG_MAIN;
+        base = (uintptr_t)BG_GFX;
+    } else if (addr >= (uintptr_t)BG_GFX_SUB &&
+               addr < (uintptr_t)BG_GFX_SUB + VRAM_BANK_SIZE) {
+        pool = MEM_POOL_BG_SUB;
+        base = (uintptr_t)BG_GFX_SUB;
+    } else {
+        return;
+    }
+
+    u32 extent = (u32)(addr - base) + bytes;
+    if (extent > VRAM_BANK_SIZE)
+        extent = VRAM_BANK_SIZE;
+    if (extent > pools[pool].used)
+        MemBudget_SetUsed(pool, extent);
+}
+#endif
+
+const MemPoolStats* MemBudget_GetPool(MemPool pool) {
+    return &pools[pool];
+}
+
+u32 MemBudget_GetOwnerUsage(MemPool pool, MemOwner owner) {
+    return ownerUsage[pool][owner];
+}
+
+u32 MemBudget_GetStatePeak(int state, MemPool pool) {
+    return (state >= 0 && state < MEM_MAX_STATES) ? statePeak[state][pool] : 0;
+}
+
+const MemBudgetStats* MemBudget_GetStats(void) {
+    return &stats;
+}
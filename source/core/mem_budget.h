@@ -0,0 +1,186 @@
+/**
+ * File: mem_budget.h
+ * ------------------
+ * Description: Central accounting of the DS memory pools: OAM sprite graphics
+ *              (main and sub), the BG VRAM banks, the 16-color sprite palette
+ *              banks and the heap. Allocations go through wrappers that record
+ *              the owning subsystem and the game state they were made in, so
+ *              every pool has a current usage, a high-water mark (per session
+ *              and per state) and a capacity, and a state that leaves
+ *              allocations behind at cleanup is reported.
+ *
+ * Three kinds of pools:
+ *   Allocation pools (OAM_MAIN, OAM_SUB, HEAP) - MemBudget_AllocGfx/Malloc
+ *     and their frees; per owner usage, leak checks
+ *   Extent pools (BG_MAIN, BG_SUB) - highest byte written into the bank
+ *     (MemBudget_MarkVram, done by Assets_CopyTo/DecompressTo)
+ *   Palette pools (PAL_MAIN, PAL_SUB) - 16-color sprite palette banks
+ *     claimed per owner (MemBudget_ClaimPalette); overlaps are reported
+ *
+ * Extent and palette pools describe VRAM contents: they are released when
+ * residency clears the region (see residency.h).
+ *
+ * The accounting itself builds on the host (heap, claims, statistics); the
+ * OAM and VRAM wrappers are DS-only.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef MEM_BUDGET_H
+#define MEM_BUDGET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef ARM9
+#include <nds.h>
+#else
+#include <stdint.h>
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+#endif
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+typedef enum {
+    MEM_POOL_OAM_MAIN,  // Main sprite graphics (VRAM B), bytes
+    MEM_POOL_OAM_SUB,   // Sub sprite graphics (VRAM D), bytes
+    MEM_POOL_BG_MAIN,   // Main BG bank (VRAM A), bytes up to the last written
+    MEM_POOL_BG_SUB,    // Sub BG bank (VRAM C), bytes up to the last written
+    MEM_POOL_PAL_MAIN,  // Main sprite palette, 16-color banks
+    MEM_POOL_PAL_SUB,   // Sub sprite palette, 16-color banks
+    MEM_POOL_HEAP,      // malloc, bytes
+    MEM_POOL_COUNT
+} MemPool;
+
+typedef enum {
+    MEM_OWNER_SCREEN,    // Menu screens (home, settings, map selection, ...)
+    MEM_OWNER_HUD,       // Race sub screen (held item display)
+    MEM_OWNER_KART,      // Kart frames and palette
+    MEM_OWNER_ITEMS,     // Item sprites and palettes
+    MEM_OWNER_TRACK,     // Decoded world map (kept for rematches and preloads)
+    MEM_OWNER_ASSETS,    // Asset pack index and resident cache
+    MEM_OWNER_COUNT
+} MemOwner;
+
+/**
+ * One pool since MemBudget_Init().
+ */
+typedef struct {
+    const char* name;
+    u32 used;      // Bytes, or palette banks
+    u32 peak;      // High-water mark of `used`
+    u32 capacity;
+    u32 live;      // Live allocations (allocation pools)
+    u32 failures;  // Allocations refused by the allocator
+} MemPoolStats;
+
+/**
+ * Problems found since MemBudget_Init().
+ */
+typedef struct {
+    u32 leaks;             // Allocations still live when their state ended
+    u32 leakedBytes;
+    u32 untracked;         // Allocations made while the table was full
+    u32 paletteConflicts;  // Banks claimed by two owners at once
+} MemBudgetStats;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: MemBudget_Init
+ * ------------------------
+ * Clears all pools and counters. Call once at boot, before the first
+ * allocation.
+ */
+void MemBudget_Init(void);
+
+/**
+ * Function: MemBudget_BeginState / MemBudget_EndState
+ * ---------------------------------------------------
+ * Bracket a game state. Allocations are tagged with the current state, and
+ * its per-state peaks start from what is already resident. EndState (after
+ * the state's cleanup) reports allocations of the state that are still live,
+ * except those of owners that outlive states (track, assets).
+ */
+void MemBudget_BeginState(int state);
+void MemBudget_EndState(int state);
+
+/**
+ * Function: MemBudget_Malloc / MemBudget_Calloc / MemBudget_Free
+ * --------------------------------------------------------------
+ * malloc/calloc/free charged to `owner` in MEM_POOL_HEAP. Free accepts NULL.
+ */
+void* MemBudget_Malloc(size_t bytes, MemOwner owner);
+void* MemBudget_Calloc(size_t count, size_t size, MemOwner owner);
+void MemBudget_Free(void* ptr);
+
+/**
+ * Function: MemBudget_ClaimPalette
+ * --------------------------------
+ * Records that `owner` uses `count` 16-color banks from `firstBank` of a
+ * palette pool (idempotent: claiming again after a reload changes nothing).
+ */
+void MemBudget_ClaimPalette(MemPool pool, MemOwner owner, int firstBank, int count);
+
+/**
+ * Function: MemBudget_ReleasePool
+ * -------------------------------
+ * Forgets the contents of an extent or palette pool (its region was cleared).
+ */
+void MemBudget_ReleasePool(MemPool pool);
+
+#ifdef ARM9
+/**
+ * Function: MemBudget_OamInit
+ * ---------------------------
+ * oamInit() for a tracked OAM. The allocator forgets every block, so blocks
+ * still allocated are dropped (and reported if their state had not ended).
+ */
+void MemBudget_OamInit(OamState* oam, SpriteMapping mapping, bool extPalette);
+
+/**
+ * Function: MemBudget_AllocGfx / MemBudget_FreeGfx
+ * ------------------------------------------------
+ * oamAllocateGfx()/oamFreeGfx() charged to `owner`.
+ *
+ * Returns: The graphics block, or NULL when the bank is full (counted)
+ */
+u16* MemBudget_AllocGfx(OamState* oam, SpriteSize size, SpriteColorFormat format,
+                        MemOwner owner);
+void MemBudget_FreeGfx(OamState* oam, u16* gfx);
+
+/**
+ * Function: MemBudget_MarkVram
+ * ----------------------------
+ * Records a write of `bytes` at `dst`. Writes into a BG bank extend its
+ * extent; other addresses are ignored.
+ */
+void MemBudget_MarkVram(const void* dst, u32 bytes);
+#endif
+
+/**
+ * Function: MemBudget_GetPool / MemBudget_GetOwnerUsage / MemBudget_GetStatePeak
+ * ------------------------------------------------------------------------------
+ * Pool counters, what one owner holds in a pool, and the highest usage of a
+ * pool seen while `state` was current.
+ */
+const MemPoolStats* MemBudget_GetPool(MemPool pool);
+u32 MemBudget_GetOwnerUsage(MemPool pool, MemOwner owner);
+u32 MemBudget_GetStatePeak(int state, MemPool pool);
+
+/**
+ * Function: MemBudget_GetStats
+ * ----------------------------
+ * Gets the leak and conflict counters.
+ */
+const MemBudgetStats* MemBudget_GetStats(void);
+
+#endif  // MEM_BUDGET_H
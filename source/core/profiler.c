@@ -0,0 +1,352 @@
+/**
+ * File: profiler.c
+ * ----------------
+ * Description: Implementation of the zone profiler. Open zones live on a small
+ *              stack; closing one adds its time to the zone below, so a
+ *              zone's self time excludes its children and any interrupt zone
+ *              that ran inside it. Stack updates are done with interrupts
+ *              disabled because the tick and VBlank ISRs open zones too.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "profiler.h"
+
+#ifdef PROFILER_ENABLED
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ARM9
+#include <nds.h>
+#else
+#include <stdint.h>
+#include <time.h>
+typedef uint32_t u32;
+typedef uint64_t u64;
+#endif
+
+#include "game_constants.h"
+#include "mem_budget.h"
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define NO_ZONE (-1)
+#define NO_PARENT (-2)  // Zone not opened yet
+
+#ifdef ARM9
+#define TICKS_PER_SECOND BUS_CLOCK
+#else
+#define TICKS_PER_SECOND 1000000000u
+#endif
+
+static const char* const zoneNames[PROF_ZONE_COUNT] = {
+    [PROF_ZONE_TICK] = "race_tick",
+    [PROF_ZONE_INPUT] = "input",
+    [PROF_ZONE_TERRAIN] = "terrain",
+    [PROF_ZONE_ITEMS] = "items_update",
+    [PROF_ZONE_COLLISIONS] = "collisions",
+    [PROF_ZONE_ITEM_EVENTS] = "item_events",
+    [PROF_ZONE_CAR] = "car_update",
+    [PROF_ZONE_NETWORK] = "network",
+    [PROF_ZONE_VBLANK] = "vblank",
+    [PROF_ZONE_HOME_UPDATE] = "home_update",
+    [PROF_ZONE_SETTINGS_UPDATE] = "settings_update",
+    [PROF_ZONE_MAPSELECT_UPDATE] = "mapselect_update",
+    [PROF_ZONE_LOBBY_UPDATE] = "lobby_update",
+    [PROF_ZONE_GAMEPLAY_UPDATE] = "gameplay_update",
+    [PROF_ZONE_PLAYAGAIN_UPDATE] = "playagain_update",
+    [PROF_ZONE_BUILD_FRAME] = "build_frame",
+    [PROF_ZONE_TRANSITION] = "transition",
+};
+
+//=============================================================================
+// PRIVATE TYPES
+//=============================================================================
+typedef struct {
+    int zone;
+    u32 start;
+    u32 children;  // Time of zones closed while this one was open
+} OpenZone;
+
+typedef struct {
+    // Current overlay window (inclusive time)
+    u32 min;
+    u32 max;
+    u32 total;
+    u32 calls;
+    u32 last;  // Last closed call
+    // Whole session (inclusive time), for the stats file
+    u32 sessionMin;
+    u32 sessionMax;
+    u64 sessionTotal;
+    u32 sessionCalls;
+    // Whole session (self time), for the trace
+    u64 selfTotal;
+    int parent;  // Zone it was first opened in (NO_ZONE for roots, NO_PARENT)
+} ZoneStats;
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static OpenZone stack[PROFILER_MAX_DEPTH];
+static int depth = 0;
+static ZoneStats zones[PROF_ZONE_COUNT];
+static ZoneStats shown[PROF_ZONE_COUNT];  // Last finished window
+static u32 sinceTake[PROF_ZONE_COUNT];    // Inclusive time for the telemetry
+static int overlayFrames = 0;
+
+//=============================================================================
+// PRIVATE HELPERS
+//=============================================================================
+
+#ifdef ARM9
+static inline u32 Profiler_Now(void) {
+    // Re-read the low half if the high half moved in between
+    u16 high = TIMER_DATA(2);
+    u16 low = TIMER_DATA(1);
+    u16 check = TIMER_DATA(2);
+    if (check != high) {
+        high = check;
+        low = TIMER_DATA(1);
+    }
+    return ((u32)high << 16) | low;
+}
+
+// Ticks between two readings (the pair wraps every ~128 s)
+static inline u32 Profiler_Elapsed(u32 start, u32 end) {
+    return end - start;
+}
+
+static inline int Profiler_Lock(void) {
+    return enterCriticalSection();
+}
+
+static inline void Profiler_Unlock(int oldIme) {
+    leaveCriticalSection(oldIme);
+}
+#else
+static inline u32 Profiler_Now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (u32)((u64)now.tv_sec * TICKS_PER_SECOND + (u64)now.tv_nsec);
+}
+
+static inline u32 Profiler_Elapsed(u32 start, u32 end) {
+    return end - start;
+}
+
+static inline int Profiler_Lock(void) {
+    return 0;  // No interrupts on the host
+}
+
+static inline void Profiler_Unlock(int oldIme) {
+    (void)oldIme;
+}
+#endif
+
+static inline bool Profiler_IsRoot(ProfZone zone) {
+    // Entry points of the ISRs: whatever they interrupted is not their parent
+    return zone == PROF_ZONE_TICK || zone == PROF_ZONE_VBLANK;
+}
+
+static u32 Profiler_ToMicros(u64 ticks) {
+    return (u32)(ticks * 1000000u / TICKS_PER_SECOND);
+}
+
+static void Profiler_ClearWindow(void) {
+    for (int i = 0; i < PROF_ZONE_COUNT; i++) {
+        zones[i].min = 0xFFFFFFFFu;
+        zones[i].max = 0;
+        zones[i].total = 0;
+        zones[i].calls = 0;
+    }
+}
+
+// Writes "root;...;zone" into buf
+static void Profiler_StackName(int zone, char* buf, int size) {
+    int path[PROF_ZONE_COUNT];
+    int count = 0;
+    for (int z = zone; z >= 0 && count < PROF_ZONE_COUNT; z = zones[z].parent)
+        path[count++] = z;
+
+    int len = 0;
+    buf[0] = '\0';
+    for (int i = count - 1; i >= 0 && len < size; i--)
+        len += snprintf(buf + len, size - len, (i == count - 1) ? "%s" : ";%s",
+                        zoneNames[path[i]]);
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void Profiler_Init(void) {
+#ifdef ARM9
+    TIMER_DATA(1) = 0;
+    TIMER_DATA(2) = 0;
+    TIMER2_CR = TIMER_ENABLE | TIMER_CASCADE;
+    TIMER1_CR = TIMER_ENABLE | TIMER_DIV_1;
+#endif
+    depth = 0;
+    overlayFrames = 0;
+    memset(zones, 0, sizeof(zones));
+    memset(shown, 0, sizeof(shown));
+    memset(sinceTake, 0, sizeof(sinceTake));
+    for (int i = 0; i < PROF_ZONE_COUNT; i++) {
+        zones[i].parent = NO_PARENT;
+        zones[i].sessionMin = 0xFFFFFFFFu;
+    }
+    Profiler_ClearWindow();
+}
+
+void Profiler_Begin(ProfZone zone) {
+    int oldIme = Profiler_Lock();
+    if (depth < PROFILER_MAX_DEPTH) {
+        if (zones[zone].parent == NO_PARENT)
+            zones[zone].parent =
+                (depth > 0 && !Profiler_IsRoot(zone)) ? stack[depth - 1].zone : NO_ZONE;
+        stack[depth].zone = zone;
+        stack[depth].children = 0;
+        stack[depth].start = Profiler_Now();
+    }
+    depth++;  // Counted past the limit so Begin/End stay paired
+    Profiler_Unlock(oldIme);
+}
+
+void Profiler_End(ProfZone zone) {
+    u32 now = Profiler_Now();
+    int oldIme = Profiler_Lock();
+    depth--;
+    if (depth >= 0 && depth < PROFILER_MAX_DEPTH && stack[depth].zone == (int)zone) {
+        const OpenZone* open = &stack[depth];
+        u32 elapsed = Profiler_Elapsed(open->start, now);
+        ZoneStats* stats = &zones[zone];
+
+        if (elapsed < stats->min)
+            stats->min = elapsed;
+        if (elapsed > stats->max)
+            stats->max = elapsed;
+        stats->total += elapsed;
+        stats->calls++;
+        stats->last = elapsed;
+        if (elapsed < stats->sessionMin)
+            stats->sessionMin = elapsed;
+        if (elapsed > stats->sessionMax)
+            stats->sessionMax = elapsed;
+        stats->sessionTotal += elapsed;
+        stats->sessionCalls++;
+        sinceTake[zone] += elapsed;
+        stats->selfTotal += (elapsed > open->children) ? elapsed - open->children : 0;
+
+        if (depth > 0)
+            stack[depth - 1].children += elapsed;
+    }
+    if (depth < 0)
+        depth = 0;  // Unbalanced End: ignore
+    Profiler_Unlock(oldIme);
+}
+
+void Profiler_PrintOverlay(void) {
+    if (++overlayFrames < PROFILER_OVERLAY_FRAMES)
+        return;
+    overlayFrames = 0;
+
+    int oldIme = Profiler_Lock();
+    memcpy(shown, zones, sizeof(shown));
+    Profiler_ClearWindow();
+    Profiler_Unlock(oldIme);
+
+    printf("\x1b[2J");
+    printf("ZONE (us)         MIN  AVG  MAX\n");
+    for (int i = 0; i < PROF_ZONE_COUNT; i++) {
+        const ZoneStats* stats = &shown[i];
+        if (stats->calls == 0)
+            continue;
+        printf("%-16.16s %4lu %4lu %4lu\n", zoneNames[i],
+               (unsigned long)Profiler_ToMicros(stats->min),
+               (unsigned long)Profiler_ToMicros(stats->total / stats->calls),
+               (unsigned long)Profiler_ToMicros(stats->max));
+    }
+
+    // Memory headroom (palettes in 16-color banks, the rest in KB)
+    printf("POOL       USED PEAK  CAP\n");
+    for (int i = 0; i < MEM_POOL_COUNT; i++) {
+        const MemPoolStats* pool = MemBudget_GetPool((MemPool)i);
+        bool banks = (i == MEM_POOL_PAL_MAIN || i == MEM_POOL_PAL_SUB);
+        u32 scale = banks ? 1 : 1024;
+        printf("%-9s %5lu %4lu %4lu %s\n", pool->name,
+               (unsigned long)(pool->used / scale), (unsigned long)(pool->peak / scale),
+               (unsigned long)(pool->capacity / scale), banks ? "bk" : "KB");
+    }
+}
+
+uint32_t Profiler_GetLastMicros(ProfZone zone) {
+    int oldIme = Profiler_Lock();
+    u32 last = zones[zone].last;
+    Profiler_Unlock(oldIme);
+    return Profiler_ToMicros(last);
+}
+
+bool Profiler_DumpTrace(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL)
+        return false;
+
+    char name[128];
+    for (int i = 0; i < PROF_ZONE_COUNT; i++) {
+        if (zones[i].selfTotal == 0)
+            continue;
+        Profiler_StackName(i, name, sizeof(name));
+        fprintf(file, "%s %lu\n", name,
+                (unsigned long)Profiler_ToMicros(zones[i].selfTotal));
+    }
+    fclose(file);
+    return true;
+}
+
+bool Profiler_DumpStats(const char* path) {
+    ZoneStats copy[PROF_ZONE_COUNT];
+    int oldIme = Profiler_Lock();
+    memcpy(copy, zones, sizeof(copy));
+    Profiler_Unlock(oldIme);
+
+    FILE* file = fopen(path, "w");
+    if (file == NULL)
+        return false;
+
+    fprintf(file, "zone calls min_us avg_us max_us\n");
+    for (int i = 0; i < PROF_ZONE_COUNT; i++) {
+        const ZoneStats* stats = &copy[i];
+        if (stats->sessionCalls == 0)
+            continue;
+        u64 avg = stats->sessionTotal / stats->sessionCalls;
+        fprintf(file, "%s %lu %lu %lu %lu\n", zoneNames[i],
+                (unsigned long)stats->sessionCalls,
+                (unsigned long)Profiler_ToMicros(stats->sessionMin),
+                (unsigned long)Profiler_ToMicros(avg),
+                (unsigned long)Profiler_ToMicros(stats->sessionMax));
+    }
+    fclose(file);
+    return true;
+}
+
+void Profiler_TakeFrameTimes(uint32_t* micros) {
+    u32 taken[PROF_ZONE_COUNT];
+    int oldIme = Profiler_Lock();
+    memcpy(taken, sinceTake, sizeof(taken));
+    memset(sinceTake, 0, sizeof(sinceTake));
+    Profiler_Unlock(oldIme);
+
+    for (int i = 0; i < PROF_ZONE_COUNT; i++)
+        micros[i] = Profiler_ToMicros(taken[i]);
+}
+
+const char* Profiler_GetZoneName(ProfZone zone) {
+    return zoneNames[zone];
+}
+
+#endif  // PROFILER_ENABLED
@@ -0,0 +1,157 @@
+/**
+ * File: profiler.h
+ * ----------------
+ * Description: Zone profiler for the hot paths. PROF_BEGIN/PROF_END bracket a
+ *              zone; each zone keeps min/avg/max of its inclusive time over a
+ *              short window (shown on the sub-screen debug console) and its
+ *              self time over the whole session (dumped as a flamegraph trace).
+ *              Everything compiles out unless PROFILER_ENABLED is defined
+ *              (make PROFILE=1).
+ *
+ * Clock:
+ *   DS:   TIMER1 free-running at BUS_CLOCK, cascaded into TIMER2 (32 bits)
+ *   Host: clock_gettime(CLOCK_MONOTONIC)
+ *
+ * Usage:
+ *   PROF_BEGIN(PROF_ZONE_ITEMS);
+ *   Items_Update();
+ *   PROF_END(PROF_ZONE_ITEMS);
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+typedef enum {
+    // Physics tick (TIMER0 ISR)
+    PROF_ZONE_TICK,
+    PROF_ZONE_INPUT,
+    PROF_ZONE_TERRAIN,
+    PROF_ZONE_ITEMS,
+    PROF_ZONE_COLLISIONS,
+    PROF_ZONE_ITEM_EVENTS,
+    PROF_ZONE_CAR,
+    PROF_ZONE_NETWORK,
+    // Interrupt handlers
+    PROF_ZONE_VBLANK,
+    // State updates (main loop)
+    PROF_ZONE_HOME_UPDATE,
+    PROF_ZONE_SETTINGS_UPDATE,
+    PROF_ZONE_MAPSELECT_UPDATE,
+    PROF_ZONE_LOBBY_UPDATE,
+    PROF_ZONE_GAMEPLAY_UPDATE,
+    PROF_ZONE_PLAYAGAIN_UPDATE,
+    PROF_ZONE_BUILD_FRAME,
+    PROF_ZONE_TRANSITION,
+    PROF_ZONE_COUNT
+} ProfZone;
+
+//=============================================================================
+// MACROS
+//=============================================================================
+
+#ifdef PROFILER_ENABLED
+#define PROF_BEGIN(zone) Profiler_Begin(zone)
+#define PROF_END(zone) Profiler_End(zone)
+#else
+#define PROF_BEGIN(zone) ((void)0)
+#define PROF_END(zone) ((void)0)
+#endif
+
+#ifdef PROFILER_ENABLED
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: Profiler_Init
+ * -----------------------
+ * Starts the profiler clock and clears all zones. Call once at boot.
+ */
+void Profiler_Init(void);
+
+/**
+ * Function: Profiler_Begin
+ * ------------------------
+ * Opens a zone. Zones nest: a zone opened inside another is its child in the
+ * trace. The tick and VBlank zones are roots even when they interrupt a main
+ * loop zone, and their time is not counted as the interrupted zone's self time.
+ */
+void Profiler_Begin(ProfZone zone);
+
+/**
+ * Function: Profiler_End
+ * ----------------------
+ * Closes the innermost zone, which must be `zone`.
+ */
+void Profiler_End(ProfZone zone);
+
+/**
+ * Function: Profiler_GetLastMicros
+ * --------------------------------
+ * Inclusive time of the last closed call of a zone, in microseconds (0 before
+ * the first one). Lets a caller log a single call, such as one transition.
+ */
+uint32_t Profiler_GetLastMicros(ProfZone zone);
+
+/**
+ * Function: Profiler_PrintOverlay
+ * -------------------------------
+ * Prints per-zone min/avg/max (microseconds) of the last window to the active
+ * console and starts a new window. Call once per frame; it only prints every
+ * PROFILER_OVERLAY_FRAMES frames.
+ */
+void Profiler_PrintOverlay(void);
+
+/**
+ * Function: Profiler_DumpTrace
+ * ----------------------------
+ * Writes the session's self time per zone stack in collapsed-stack format
+ * ("race_tick;items_update 1234", microseconds), which flamegraph.pl and
+ * speedscope read directly.
+ *
+ * Returns: true if the file was written
+ */
+bool Profiler_DumpTrace(const char* path);
+
+/**
+ * Function: Profiler_DumpStats
+ * ----------------------------
+ * Writes calls and min/avg/max inclusive time (microseconds) of every zone
+ * since Profiler_Init(), one "zone calls min avg max" line each. Unlike the
+ * overlay it needs no console, so the HUD keeps running while it is measured.
+ *
+ * Returns: true if the file was written
+ */
+bool Profiler_DumpStats(const char* path);
+
+/**
+ * Function: Profiler_TakeFrameTimes
+ * ---------------------------------
+ * Copies each zone's inclusive time since the previous call (microseconds,
+ * PROF_ZONE_COUNT values) and starts over. Used by the race telemetry to
+ * attribute a frame's cost to zones.
+ */
+void Profiler_TakeFrameTimes(uint32_t* micros);
+
+/**
+ * Function: Profiler_GetZoneName
+ * ------------------------------
+ * Name of a zone as it appears in the trace ("race_tick").
+ */
+const char* Profiler_GetZoneName(ProfZone zone);
+
+#endif  // PROFILER_ENABLED
+
+#endif  // PROFILER_H
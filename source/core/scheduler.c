@@ -0,0 +1,262 @@
+/**
+ * File: scheduler.c
+ * -----------------
+ * Description: Implementation of the cooperative frame scheduler. A frame is
+ *              the main loop work between Scheduler_RunFrame() and
+ *              Scheduler_EndFrame(); its length is the scanline distance from
+ *              the line where it started, extended by a whole frame each time
+ *              a reading comes out lower than the previous one (the frame ran
+ *              past the next VBlank). Work polled while no frame is open runs
+ *              in idle time and always has room.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "scheduler.h"
+
+#include <string.h>
+
+#include "game_constants.h"
+#include "kmlog.h"
+
+//=============================================================================
+// PRIVATE TYPES
+//=============================================================================
+typedef struct {
+    bool used;
+    SchedTaskFn fn;     // NULL for polled tasks
+    u16 phase;          // Period units since the last run
+    u16 startLine;      // REG_VCOUNT when the current run started
+    SchedTaskStats stats;
+} SchedTask;
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static SchedTask tasks[SCHED_MAX_TASKS];
+static SchedStats frameStats;
+
+static volatile bool frameOpen = false;  // Between RunFrame and EndFrame
+static u16 frameStartLine = 0;
+static int wrapLines = 0;   // Whole frames the current frame has run past
+static int lastLines = 0;   // Last length read, to notice a wrap
+static bool skipFrame = false;
+static int hotFrames = 0;   // Consecutive frames over budget
+static int calmFrames = 0;  // Consecutive frames within budget
+
+//=============================================================================
+// PRIVATE HELPERS
+//=============================================================================
+
+static inline int Scheduler_LinesSince(u16 line) {
+    int lines = (int)REG_VCOUNT - (int)line;
+    return (lines < 0) ? lines + SCHED_LINES_PER_FRAME : lines;
+}
+
+// Scanlines spent in the current frame (0 while the main loop is idle)
+static int Scheduler_FrameLines(void) {
+    int oldIme = enterCriticalSection();
+    int lines = 0;
+    if (frameOpen) {
+        lines = wrapLines + Scheduler_LinesSince(frameStartLine);
+        if (lines < lastLines) {
+            wrapLines += SCHED_LINES_PER_FRAME;
+            lines += SCHED_LINES_PER_FRAME;
+        }
+        lastLines = lines;
+    }
+    leaveCriticalSection(oldIme);
+    return lines;
+}
+
+static inline bool Scheduler_IsValid(SchedTaskId id) {
+    return id >= 0 && id < SCHED_MAX_TASKS && tasks[id].used;
+}
+
+// Advances a task by one period unit; true if it runs now. Due runs that the
+// load holds back are counted once per base period.
+static bool Scheduler_Due(SchedTask* task) {
+    SchedTaskStats* stats = &task->stats;
+    if (task->phase < 0xFFFF)
+        task->phase++;
+    if (task->phase < stats->period)
+        return false;
+
+    int lines = Scheduler_FrameLines();
+    bool run;
+    switch (stats->priority) {
+        case SCHED_PRIO_CRITICAL:
+            run = true;
+            break;
+        case SCHED_PRIO_NORMAL:
+            run = lines <= SCHED_FRAME_BUDGET_LINES ||
+                  task->phase >= (stats->period << SCHED_MAX_LOAD_LEVEL);
+            break;
+        case SCHED_PRIO_IDLE:
+            run = lines + stats->budget <= SCHED_FRAME_BUDGET_LINES;
+            break;
+        default:
+            run = task->phase >= (stats->period << frameStats.loadLevel) &&
+                  lines + stats->budget <= SCHED_FRAME_BUDGET_LINES;
+            break;
+    }
+
+    if (!run) {
+        if (task->phase % stats->period == 0)
+            stats->shed++;
+        return false;
+    }
+
+    task->phase = 0;
+    task->startLine = REG_VCOUNT;
+    stats->runs++;
+    return true;
+}
+
+static void Scheduler_MeasureRun(SchedTask* task) {
+    int lines = Scheduler_LinesSince(task->startLine);
+    SchedTaskStats* stats = &task->stats;
+    if (lines > stats->worstLines)
+        stats->worstLines = (u16)lines;
+    // An idle run may take all the spare lines: its budget is what it needs to start
+    if (lines > stats->budget && stats->priority != SCHED_PRIO_IDLE)
+        stats->overBudget++;
+}
+
+static void Scheduler_RunTasks(SchedPriority first, SchedPriority last) {
+    for (int priority = first; priority <= last; priority++) {
+        for (int i = 0; i < SCHED_MAX_TASKS; i++) {
+            SchedTask* task = &tasks[i];
+            if (!task->used || task->fn == NULL ||
+                task->stats.priority != (SchedPriority)priority)
+                continue;
+            if (!Scheduler_Due(task))
+                continue;
+            task->fn();
+            Scheduler_MeasureRun(task);
+        }
+    }
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void Scheduler_Init(void) {
+    memset(tasks, 0, sizeof(tasks));
+    memset(&frameStats, 0, sizeof(frameStats));
+    frameOpen = false;
+    skipFrame = false;
+    hotFrames = 0;
+    calmFrames = 0;
+}
+
+SchedTaskId Scheduler_Register(const char* name, SchedTaskFn fn, SchedPriority priority,
+                               int period, int budget) {
+    for (int i = 0; i < SCHED_MAX_TASKS; i++) {
+        if (tasks[i].used)
+            continue;
+
+        SchedTask* task = &tasks[i];
+        memset(task, 0, sizeof(*task));
+        task->fn = fn;
+        task->phase = (u16)((period > 1) ? period - 1 : 0);  // First unit is due
+        task->stats.name = name;
+        task->stats.priority = priority;
+        task->stats.period = (u16)((period > 1) ? period : 1);
+        task->stats.budget = (u16)budget;
+        task->used = true;  // Last: an ISR may poll as soon as the id exists
+        return i;
+    }
+    return SCHED_NO_TASK;
+}
+
+void Scheduler_Unregister(SchedTaskId id) {
+    if (id < 0 || id >= SCHED_MAX_TASKS)
+        return;
+    int oldIme = enterCriticalSection();
+    tasks[id].used = false;
+    leaveCriticalSection(oldIme);
+}
+
+void Scheduler_RunFrame(void) {
+    int oldIme = enterCriticalSection();
+    frameStartLine = REG_VCOUNT;
+    wrapLines = 0;
+    lastLines = 0;
+    frameOpen = true;
+    leaveCriticalSection(oldIme);
+
+    Scheduler_RunTasks(SCHED_PRIO_CRITICAL, SCHED_PRIO_LOW);
+}
+
+void Scheduler_RunIdle(void) {
+    Scheduler_RunTasks(SCHED_PRIO_IDLE, SCHED_PRIO_IDLE);
+}
+
+int Scheduler_GetSpareLines(void) {
+    int spare = SCHED_FRAME_BUDGET_LINES - Scheduler_FrameLines();
+    return (spare > 0) ? spare : 0;
+}
+
+void Scheduler_EndFrame(void) {
+    int lines = Scheduler_FrameLines();
+    frameOpen = false;
+
+    if (skipFrame) {
+        skipFrame = false;
+        return;
+    }
+
+    frameStats.frames++;
+    frameStats.lastFrameLines = (u16)lines;
+    if (lines > frameStats.worstFrameLines)
+        frameStats.worstFrameLines = (u16)lines;
+
+    if (lines > SCHED_FRAME_BUDGET_LINES) {
+        frameStats.overFrames++;
+        calmFrames = 0;
+        if (++hotFrames >= SCHED_DEGRADE_FRAMES &&
+            frameStats.loadLevel < SCHED_MAX_LOAD_LEVEL) {
+            frameStats.loadLevel++;
+            frameStats.degradations++;
+            hotFrames = 0;
+            LOG_WARN("sched load level %d (frame %d lines)", frameStats.loadLevel,
+                     lines);
+        }
+    } else {
+        hotFrames = 0;
+        if (++calmFrames >= SCHED_RECOVER_FRAMES && frameStats.loadLevel > 0) {
+            frameStats.loadLevel--;
+            calmFrames = 0;
+        }
+    }
+}
+
+void Scheduler_ResetLoad(void) {
+    frameStats.loadLevel = 0;
+    hotFrames = 0;
+    calmFrames = 0;
+    skipFrame = true;
+}
+
+bool Scheduler_Poll(SchedTaskId id) {
+    if (!Scheduler_IsValid(id))
+        return true;  // Unscheduled work runs every time
+    return Scheduler_Due(&tasks[id]);
+}
+
+void Scheduler_Done(SchedTaskId id) {
+    if (Scheduler_IsValid(id))
+        Scheduler_MeasureRun(&tasks[id]);
+}
+
+const SchedStats* Scheduler_GetStats(void) {
+    return &frameStats;
+}
+
+const SchedTaskStats* Scheduler_GetTaskStats(SchedTaskId id) {
+    return Scheduler_IsValid(id) ? &tasks[id].stats : NULL;
+}
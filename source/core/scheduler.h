@@ -0,0 +1,196 @@
+/**
+ * File: scheduler.h
+ * -----------------
+ * Description: Cooperative frame scheduler. Subsystems register their periodic
+ *              work as tasks with a priority, a period and a CPU budget, and
+ *              the scheduler keeps every frame of the main loop inside
+ *              SCHED_FRAME_BUDGET_LINES. When frames overrun, low-priority
+ *              work is degraded (its period stretched, or the run skipped when
+ *              the frame has no room left) and every degradation is counted.
+ *
+ * Time is measured in scanlines (REG_VCOUNT): the display counts 263 per
+ * frame, always running, so no hardware timer is needed.
+ *
+ * Two kinds of tasks:
+ *   Frame tasks (fn != NULL)  - run by Scheduler_RunFrame() at the start of
+ *                               each main loop iteration (idle tasks by
+ *                               Scheduler_RunIdle() after the frame's work)
+ *   Polled tasks (fn == NULL) - the owner asks Scheduler_Poll() once per
+ *                               period unit of its own clock (a frame, or a
+ *                               physics tick in the TIMER0 ISR) and runs the
+ *                               work itself when it returns true
+ *
+ * Priorities:
+ *   SCHED_PRIO_CRITICAL - runs whenever due
+ *   SCHED_PRIO_NORMAL   - deferred while the frame is over budget (at most
+ *                         period << SCHED_MAX_LOAD_LEVEL)
+ *   SCHED_PRIO_LOW      - period doubled per load level, skipped when its
+ *                         budget no longer fits in the frame
+ *   SCHED_PRIO_IDLE     - frame tasks only; run after the frame's work, and
+ *                         only when their budget fits in what is left of it
+ *                         (a run may go on while Scheduler_GetSpareLines()
+ *                         has room for another step)
+ *
+ * Usage:
+ *   hudTask = Scheduler_Register("hud", NULL, SCHED_PRIO_LOW, 1, 8);
+ *   ...
+ *   if (Scheduler_Poll(hudTask)) {
+ *       UpdateHud();
+ *       Scheduler_Done(hudTask);  // optional: checks the run against its budget
+ *   }
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <nds.h>
+#include <stdbool.h>
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+typedef enum {
+    SCHED_PRIO_CRITICAL,
+    SCHED_PRIO_NORMAL,
+    SCHED_PRIO_LOW,
+    SCHED_PRIO_IDLE
+} SchedPriority;
+
+typedef void (*SchedTaskFn)(void);
+typedef int SchedTaskId;
+
+#define SCHED_NO_TASK (-1)
+
+/**
+ * Counters of one task since it was registered.
+ */
+typedef struct {
+    const char* name;
+    SchedPriority priority;
+    u16 period;      // Base period (frames, or Poll calls)
+    u16 budget;      // Scanlines per run
+    u16 worstLines;  // Longest measured run
+    u32 runs;
+    u32 overBudget;  // Measured runs longer than the budget
+    u32 shed;        // Due runs skipped or deferred under load
+} SchedTaskStats;
+
+/**
+ * Frame counters since Scheduler_Init().
+ */
+typedef struct {
+    u32 frames;
+    u32 overFrames;       // Frames longer than SCHED_FRAME_BUDGET_LINES
+    u32 degradations;     // Times the load level was raised
+    u16 lastFrameLines;
+    u16 worstFrameLines;
+    u8 loadLevel;         // 0 = nominal ... SCHED_MAX_LOAD_LEVEL
+} SchedStats;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: Scheduler_Init
+ * ------------------------
+ * Removes all tasks and clears the counters. Call once at boot.
+ */
+void Scheduler_Init(void);
+
+/**
+ * Function: Scheduler_Register
+ * ----------------------------
+ * Adds a periodic task.
+ *
+ * Parameters:
+ *   name     - Label for the stats (string literal)
+ *   fn       - Work run by Scheduler_RunFrame(), or NULL for a polled task
+ *   priority - How the task is treated under load
+ *   period   - Runs every `period` frames (or Poll calls) at load level 0
+ *   budget   - Expected scanlines per run
+ *
+ * Returns: Task id, or SCHED_NO_TASK if the table is full
+ */
+SchedTaskId Scheduler_Register(const char* name, SchedTaskFn fn, SchedPriority priority,
+                               int period, int budget);
+
+/**
+ * Function: Scheduler_Unregister
+ * ------------------------------
+ * Removes a task. Its id may be handed out again.
+ */
+void Scheduler_Unregister(SchedTaskId id);
+
+/**
+ * Function: Scheduler_RunFrame
+ * ----------------------------
+ * Starts a frame and runs the frame tasks that are due, highest priority
+ * first. Call at the top of the main loop, right after the VBlank wait.
+ */
+void Scheduler_RunFrame(void);
+
+/**
+ * Function: Scheduler_RunIdle
+ * ---------------------------
+ * Runs the idle tasks that are due and whose budget fits in the rest of the
+ * frame budget. Call after the frame's work, before Scheduler_EndFrame().
+ */
+void Scheduler_RunIdle(void);
+
+/**
+ * Function: Scheduler_GetSpareLines
+ * ---------------------------------
+ * Scanlines left before the current frame reaches SCHED_FRAME_BUDGET_LINES
+ * (the whole budget while no frame is open, 0 once it is spent). Lets an idle
+ * task do as many small steps as fit.
+ */
+int Scheduler_GetSpareLines(void);
+
+/**
+ * Function: Scheduler_EndFrame
+ * ----------------------------
+ * Measures the frame and raises or lowers the load level. Call just before
+ * swiWaitForVBlank().
+ */
+void Scheduler_EndFrame(void);
+
+/**
+ * Function: Scheduler_ResetLoad
+ * -----------------------------
+ * Drops the load level back to 0 and ignores the current frame. Call after a
+ * state transition: loading a screen is not a sign of sustained load.
+ */
+void Scheduler_ResetLoad(void);
+
+/**
+ * Function: Scheduler_Poll
+ * ------------------------
+ * Advances a polled task by one period unit. Safe to call from an ISR.
+ *
+ * Returns: true if the task should run now (always true for SCHED_NO_TASK)
+ */
+bool Scheduler_Poll(SchedTaskId id);
+
+/**
+ * Function: Scheduler_Done
+ * ------------------------
+ * Ends a run started by a true Scheduler_Poll() and checks it against the
+ * task budget. Optional.
+ */
+void Scheduler_Done(SchedTaskId id);
+
+/**
+ * Function: Scheduler_GetStats / Scheduler_GetTaskStats
+ * -----------------------------------------------------
+ * Read-only counters. Scheduler_GetTaskStats returns NULL for a free id.
+ */
+const SchedStats* Scheduler_GetStats(void);
+const SchedTaskStats* Scheduler_GetTaskStats(SchedTaskId id);
+
+#endif  // SCHEDULER_H
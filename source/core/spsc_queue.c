@@ -0,0 +1,105 @@
+/**
+ * File: spsc_queue.c
+ * ------------------
+ * Description: Implementation of the single-producer / single-consumer event
+ *              ring. Each side reads the other side's index once (acquire),
+ *              works on the slots it owns, then publishes its own index
+ *              (release). On the DS both are plain volatile accesses fenced
+ *              by a compiler barrier; on the host they are __atomic builtins.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "spsc_queue.h"
+
+//=============================================================================
+// PRIVATE HELPERS
+//=============================================================================
+
+#ifdef ARM9
+// One core: an interrupt only ever sees whole instructions, so keeping the
+// compiler from reordering slot and index accesses is enough
+#define SPSC_BARRIER() __asm__ volatile("" ::: "memory")
+
+static inline u32 SpscQueue_LoadAcquire(const volatile u32* index) {
+    u32 value = *index;
+    SPSC_BARRIER();
+    return value;
+}
+
+static inline void SpscQueue_StoreRelease(volatile u32* index, u32 value) {
+    SPSC_BARRIER();
+    *index = value;
+}
+#else
+static inline u32 SpscQueue_LoadAcquire(const volatile u32* index) {
+    return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+}
+
+static inline void SpscQueue_StoreRelease(volatile u32* index, u32 value) {
+    __atomic_store_n(index, value, __ATOMIC_RELEASE);
+}
+#endif
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void SpscQueue_Init(SpscQueue* queue, u32* slots, u32 capacity) {
+    queue->slots = slots;
+    queue->mask = capacity - 1;
+    queue->head = 0;
+    queue->tail = 0;
+    queue->dropped = 0;
+}
+
+bool SpscQueue_Push(SpscQueue* queue, u32 event) {
+    u32 head = queue->head;  // Own index: no ordering needed
+    u32 tail = SpscQueue_LoadAcquire(&queue->tail);
+    if (head - tail > queue->mask) {
+        queue->dropped++;
+        return false;
+    }
+
+    queue->slots[head & queue->mask] = event;
+    SpscQueue_StoreRelease(&queue->head, head + 1);
+    return true;
+}
+
+bool SpscQueue_PushBatch(SpscQueue* queue, const u32* events, int count) {
+    u32 head = queue->head;
+    u32 tail = SpscQueue_LoadAcquire(&queue->tail);
+    if ((u32)count > queue->mask + 1 - (head - tail)) {
+        queue->dropped++;
+        return false;
+    }
+
+    for (int i = 0; i < count; i++)
+        queue->slots[(head + (u32)i) & queue->mask] = events[i];
+    SpscQueue_StoreRelease(&queue->head, head + (u32)count);
+    return true;
+}
+
+int SpscQueue_PopBatch(SpscQueue* queue, u32* out, int max) {
+    u32 tail = queue->tail;  // Own index: no ordering needed
+    u32 head = SpscQueue_LoadAcquire(&queue->head);
+
+    int count = 0;
+    while (tail != head && count < max) {
+        out[count++] = queue->slots[tail & queue->mask];
+        tail++;
+    }
+
+    SpscQueue_StoreRelease(&queue->tail, tail);
+    return count;
+}
+
+bool SpscQueue_IsEmpty(const SpscQueue* queue) {
+    return SpscQueue_LoadAcquire(&queue->head) == queue->tail;
+}
+
+u32 SpscQueue_GetDropped(const SpscQueue* queue) {
+    return queue->dropped;
+}
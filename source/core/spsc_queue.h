@@ -0,0 +1,130 @@
+/**
+ * File: spsc_queue.h
+ * ------------------
+ * Description: Wait-free single-producer / single-consumer ring of 32-bit
+ *              events, for interrupt handlers to hand work to the main loop
+ *              without sharing ad-hoc volatiles. The producer only writes
+ *              `head`, the consumer only writes `tail`; neither side ever
+ *              waits, locks or disables interrupts. A push into a full queue
+ *              fails and is counted instead of overwriting unread events.
+ *
+ * One queue per producer: two interrupt handlers that can nest must not push
+ * into the same queue. The consumer drains a batch once per frame.
+ *
+ * Ordering:
+ *   DS:   single core, so a compiler barrier keeps the slot write before the
+ *         head update (an ISR runs to completion between two main loop
+ *         instructions)
+ *   Host: __atomic acquire/release, so producer and consumer can be threads
+ *
+ * Usage:
+ *   static u32 slots[16];            // power of two
+ *   static SpscQueue keyEvents;
+ *   SpscQueue_Init(&keyEvents, slots, 16);
+ *
+ *   // ISR (producer)
+ *   SpscQueue_Push(&keyEvents, SPSC_EVENT(EVENT_KEY_DOWN, KEY_START));
+ *
+ *   // Main loop (consumer)
+ *   u32 batch[8];
+ *   int n = SpscQueue_PopBatch(&keyEvents, batch, 8);
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdbool.h>
+
+#ifdef ARM9
+#include <nds.h>
+#else
+#include <stdint.h>
+typedef uint32_t u32;
+#endif
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+/**
+ * Indices run freely and wrap at 2^32; `head - tail` is the fill level and
+ * `index & mask` the slot. Capacity is a power of two so the wrap is exact.
+ */
+typedef struct {
+    u32* slots;
+    u32 mask;              // Capacity - 1
+    volatile u32 head;     // Next slot to write (producer only)
+    volatile u32 tail;     // Next slot to read (consumer only)
+    volatile u32 dropped;  // Pushes refused because the queue was full
+} SpscQueue;
+
+// Compact events: 8-bit type, 24-bit payload
+#define SPSC_EVENT(type, payload) \
+    (((u32)(type) << 24) | ((u32)(payload) & 0x00FFFFFFu))
+#define SPSC_EVENT_TYPE(event) ((u32)(event) >> 24)
+#define SPSC_EVENT_PAYLOAD(event) ((u32)(event) & 0x00FFFFFFu)
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: SpscQueue_Init
+ * ------------------------
+ * Empties a queue and attaches its storage. Call while neither side runs
+ * (before the producer's interrupt is enabled).
+ *
+ * Parameters:
+ *   queue    - Queue to set up
+ *   slots    - Storage for `capacity` events, owned by the caller
+ *   capacity - Number of slots, a power of two
+ */
+void SpscQueue_Init(SpscQueue* queue, u32* slots, u32 capacity);
+
+/**
+ * Function: SpscQueue_Push
+ * ------------------------
+ * Appends an event (producer side).
+ *
+ * Returns: false if the queue was full (the event is dropped and counted)
+ */
+bool SpscQueue_Push(SpscQueue* queue, u32 event);
+
+/**
+ * Function: SpscQueue_PushBatch
+ * -----------------------------
+ * Appends `count` events as one unit (producer side): the consumer sees all
+ * of them or none, so multi-word messages are never split.
+ *
+ * Returns: false if they did not all fit (nothing is pushed; counted once)
+ */
+bool SpscQueue_PushBatch(SpscQueue* queue, const u32* events, int count);
+
+/**
+ * Function: SpscQueue_PopBatch
+ * ----------------------------
+ * Removes up to `max` events in the order they were pushed (consumer side).
+ *
+ * Returns: number of events written to `out`
+ */
+int SpscQueue_PopBatch(SpscQueue* queue, u32* out, int max);
+
+/**
+ * Function: SpscQueue_IsEmpty
+ * ---------------------------
+ * Whether the consumer has read every event pushed so far (consumer side).
+ */
+bool SpscQueue_IsEmpty(const SpscQueue* queue);
+
+/**
+ * Function: SpscQueue_GetDropped
+ * ------------------------------
+ * Gets how many pushes were refused since SpscQueue_Init().
+ */
+u32 SpscQueue_GetDropped(const SpscQueue* queue);
+
+#endif  // SPSC_QUEUE_H
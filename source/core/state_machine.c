@@ -21,36 +21,54 @@
 #include "../ui/play_again.h"
 #include "../ui/settings.h"
 #include "context.h"
+#include "profiler.h"
 #include "timer.h"
 
 //=============================================================================
 // STATE UPDATE DISPATCH
 //=============================================================================
 
+// Runs one state's update inside its profiler zone
+#define PROFILED_UPDATE(zone, call) \
+    do {                            \
+        PROF_BEGIN(zone);           \
+        next = call;                \
+        PROF_END(zone);             \
+    } while (0)
+
 GameState StateMachine_Update(GameState state) {
+    GameState next = state;  // Unknown state, stay in current state
+
     switch (state) {
         case HOME_PAGE:
         case REINIT_HOME:  // REINIT_HOME treated same as HOME_PAGE
-            return HomePage_Update();
+            PROFILED_UPDATE(PROF_ZONE_HOME_UPDATE, HomePage_Update());
+            break;
 
         case SETTINGS:
-            return Settings_Update();
+            PROFILED_UPDATE(PROF_ZONE_SETTINGS_UPDATE, Settings_Update());
+            break;
 
         case MAPSELECTION:
-            return MapSelection_Update();
+            PROFILED_UPDATE(PROF_ZONE_MAPSELECT_UPDATE, MapSelection_Update());
+            break;
 
         case MULTIPLAYER_LOBBY:
-            return MultiplayerLobby_Update();
+            PROFILED_UPDATE(PROF_ZONE_LOBBY_UPDATE, MultiplayerLobby_Update());
+            break;
 
         case GAMEPLAY:
-            return Gameplay_Update();
+            PROFILED_UPDATE(PROF_ZONE_GAMEPLAY_UPDATE, Gameplay_Update());
+            break;
 
         case PLAYAGAIN:
-            return PlayAgain_Update();
+            PROFILED_UPDATE(PROF_ZONE_PLAYAGAIN_UPDATE, PlayAgain_Update());
+            break;
 
         default:
-            return state;  // Unknown state, stay in current state
+            break;
     }
+    return next;
 }
 
 //=============================================================================
@@ -111,9 +129,13 @@ void StateMachine_Cleanup(GameState state, GameState nextState) {
             break;
 
         case GAMEPLAY:
-            RaceTick_TimerStop();  // Stop TIMER0 (physics) and TIMER1 (chronometer)
+            RaceTick_TimerStop();  // Stop TIMER0 (physics tick and chronometer)
             Gameplay_Cleanup();    // Clean up gameplay graphics/resources
             Race_Stop();           // Stop race logic
+#ifdef PROFILER_ENABLED
+            Profiler_DumpTrace(PROFILER_TRACE_FILE);
+            Profiler_DumpStats(PROFILER_STATS_FILE);
+#endif
 
             // Only cleanup multiplayer if we were in multiplayer mode
             if (GameContext_IsMultiplayerMode()) {
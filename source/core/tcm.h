@@ -0,0 +1,51 @@
+/**
+ * File: tcm.h
+ * -----------
+ * Description: Placement of the race tick hot path in the ARM9 tightly coupled
+ *              memories. ITCM (32 KB) and DTCM (16 KB) answer in one cycle and
+ *              never miss; main RAM sits behind a 16-bit bus and costs wait
+ *              states on every cache miss, and the race tick runs from a timer
+ *              interrupt, so it often starts with cold caches.
+ *
+ *              TCM_CODE puts a function in ITCM, compiled as ARM (even in a
+ *              Thumb build); TCM_DATA and TCM_BSS put initialized and zeroed
+ *              data in DTCM. All three expand to nothing unless TCM_ENABLED is
+ *              defined (make TCM=1), so the default build links the same
+ *              code to main RAM; compare the two with the profiler.
+ *
+ * What goes where (see docs/tcm.md):
+ *   ITCM - Race_Tick and its helpers, Car physics, wall and terrain queries,
+ *          fixedmath, item update and collision
+ *   DTCM - simState (cars, items, item boxes), sin_lut, the wall segments
+ *
+ * Rules:
+ *   - DMA cannot reach DTCM: never dmaCopy to or from TCM_DATA / TCM_BSS
+ *   - DTCM also holds the stacks (growing down from the top); keep DTCM data
+ *     well under half of it
+ *   - Only code that runs every tick belongs in ITCM
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef TCM_H
+#define TCM_H
+
+#ifdef TCM_ENABLED
+
+#include <nds/ndstypes.h>
+
+#define TCM_CODE ITCM_CODE __attribute__((target("arm")))
+#define TCM_DATA DTCM_DATA
+#define TCM_BSS DTCM_BSS
+
+#else
+
+#define TCM_CODE
+#define TCM_DATA
+#define TCM_BSS
+
+#endif  // TCM_ENABLED
+
+#endif  // TCM_H
@@ -2,8 +2,9 @@
  * File: timer.c
  * --------------
  * Description: Implementation of timer ISRs for graphics updates and gameplay ticks.
- *              VBlank ISR runs at 60Hz for all animated screens, while hardware
- *              timers (TIMER0/TIMER1) handle physics and chronometer during races.
+ *              VBlank ISR runs at 60Hz for all animated screens, while TIMER0
+ *              drives physics during races; its tick count and counter also
+ *              give the race chronometer.
  *
  * Authors: Bahey Shalash, Hugo Svolgaard
  * Version: 1.0
@@ -16,17 +17,31 @@
 
 #include "../gameplay/gameplay.h"
 #include "../gameplay/gameplay_logic.h"
+#include "../gameplay/race_snapshot.h"
+#include "../gameplay/replay.h"
 #include "../ui/home_page.h"
 #include "../ui/map_selection.h"
 #include "../ui/play_again.h"
 #include "context.h"
 #include "game_types.h"
+#include "profiler.h"
 
 //=============================================================================
 // Private Prototypes
 //=============================================================================
 static void RaceTick_ISR(void);
-static void ChronoTick_ISR(void);
+
+//=============================================================================
+// Private State
+//=============================================================================
+// Race chrono in TIMER0 counts (BUS_CLOCK / 1024): counts banked before the
+// current run (pauses) plus the ticks and counter phase of the current run
+#define TICK_RELOAD ((u16)TIMER_FREQ_1024(RACE_TICK_FREQ))
+#define TICK_PERIOD (0x10000u - TICK_RELOAD)
+
+static volatile u32 runTicks = 0;  // TIMER0 overflows since the run started
+static u32 bankedCounts = 0;
+static bool chronoRunning = false;
 
 //=============================================================================
 // VBlank ISR - 60Hz Graphics Updates
@@ -42,8 +57,8 @@ void initTimer(void) {
 }
 
 void timerISRVblank(void) {
+    PROF_BEGIN(PROF_ZONE_VBLANK);
     GameContext* ctx = GameContext_Get();
-    Race_UpdatePauseDebounce();  // Update pause button state every frame
 
     switch (ctx->currentGameState) {
         case HOME_PAGE:
@@ -59,70 +74,115 @@ void timerISRVblank(void) {
             break;
 
         case GAMEPLAY:
-            if (Race_IsCountdownActive()) {
-                Race_CountdownTick();  // Countdown timer (network sync, no movement)
-            }
-            Gameplay_OnVBlank();  // Sprite updates and final time display
-
-            // Update lap/time displays only during active racing
-            if (!Race_IsCountdownActive() && !Race_IsCompleted()) {
-                Gameplay_UpdateChronoDisplay(Gameplay_GetRaceMin(),
-                                             Gameplay_GetRaceSec(),
-                                             Gameplay_GetRaceMsec());
-                const RaceState* state = Race_GetState();
-                Gameplay_UpdateLapDisplay(Gameplay_GetCurrentLap(), state->totalLaps);
-            }
+            // Replay the render commands Gameplay_Update() recorded (sprites,
+            // scroll, HUD, final time); all race logic runs in the main loop
+            Gameplay_OnVBlank();
             break;
 
         default:
             break;
     }
+    PROF_END(PROF_ZONE_VBLANK);
 }
 
 //=============================================================================
 // Race Tick Timers
 //=============================================================================
-void RaceTick_TimerInit(void) {
-    // TIMER0: Physics tick at RACE_TICK_FREQ Hz (60Hz default)
-    TIMER_DATA(0) = TIMER_FREQ_1024(RACE_TICK_FREQ);
+// Counts of the current run; call with interrupts disabled
+static u32 RaceTick_RunCounts(void) {
+    u32 ticks = runTicks;
+    u16 counter = TIMER_DATA(0);
+    if (REG_IF & IRQ_TIMER0) {
+        // Overflowed but the ISR has not run yet: count it, re-read the phase
+        ticks++;
+        counter = TIMER_DATA(0);
+    }
+    return ticks * TICK_PERIOD + (u16)(counter - TICK_RELOAD);
+}
+
+// (Re)starts TIMER0 from its reload value: a new run with no ticks yet
+static void RaceTick_StartRun(void) {
+    TIMER0_CR = 0;
+    TIMER_DATA(0) = TICK_RELOAD;
+    REG_IF = IRQ_TIMER0;  // Drop an overflow left from the previous run
+    runTicks = 0;
     TIMER0_CR = TIMER_ENABLE | TIMER_DIV_1024 | TIMER_IRQ_REQ;
+    chronoRunning = true;
+}
+
+// Banks the current run into the chrono and stops TIMER0
+static void RaceTick_EndRun(void) {
+    int oldIme = enterCriticalSection();
+    if (chronoRunning)
+        bankedCounts += RaceTick_RunCounts();
+    chronoRunning = false;
+    TIMER0_CR = 0;
+    leaveCriticalSection(oldIme);
+}
+
+void RaceTick_TimerInit(void) {
+    // TIMER0: Physics tick at RACE_TICK_FREQ Hz (60Hz default); its counter is
+    // also the race chrono (RaceTick_GetElapsedMs)
+    int oldIme = enterCriticalSection();
+    bankedCounts = 0;
+    RaceTick_StartRun();
     irqSet(IRQ_TIMER0, RaceTick_ISR);
     irqEnable(IRQ_TIMER0);
-
-    // TIMER1: Chronometer tick at 1000Hz (1ms precision for race time)
-    TIMER_DATA(1) = TIMER_FREQ_1024(1000);
-    TIMER1_CR = TIMER_ENABLE | TIMER_DIV_1024 | TIMER_IRQ_REQ;
-    irqSet(IRQ_TIMER1, ChronoTick_ISR);
-    irqEnable(IRQ_TIMER1);
+    leaveCriticalSection(oldIme);
 }
 
 void RaceTick_TimerStop(void) {
-    // Disable and clear both timers
+    // Disable and clear the tick; the chrono keeps its last value
     irqDisable(IRQ_TIMER0);
     irqClear(IRQ_TIMER0);
-    irqDisable(IRQ_TIMER1);
-    irqClear(IRQ_TIMER1);
+    RaceTick_EndRun();
 }
 
 void RaceTick_TimerPause(void) {
-    // Pause both timers (state preserved for resume)
+    // Snapshot the chrono and stop counting until resumed
     irqDisable(IRQ_TIMER0);
-    irqDisable(IRQ_TIMER1);
+    RaceTick_EndRun();
 }
 
 void RaceTick_TimerEnable(void) {
-    // Resume both timers from paused state
+    // Resume: a new run starts on top of the banked time
+    int oldIme = enterCriticalSection();
+    RaceTick_StartRun();
     irqEnable(IRQ_TIMER0);
-    irqEnable(IRQ_TIMER1);
+    leaveCriticalSection(oldIme);
+}
+
+u32 RaceTick_GetElapsedMs(void) {
+    int oldIme = enterCriticalSection();
+    u32 counts = bankedCounts;
+    if (chronoRunning)
+        counts += RaceTick_RunCounts();
+    leaveCriticalSection(oldIme);
+
+    // One count is 1024 bus cycles
+    return (u32)(((u64)counts * 1024 * MS_PER_SECOND) / BUS_CLOCK);
+}
+
+Q16_8 RaceTick_GetAlpha(void) {
+    if (!(REG_IE & IRQ_TIMER0) || (REG_IF & IRQ_TIMER0))
+        return FIXED_ONE;  // Stopped/paused, or the tick is already overdue
+
+    // TIMER0 counts up from the reload value and fires on overflow
+    u32 elapsed = (u16)(TIMER_DATA(0) - TICK_RELOAD);
+    return (Q16_8)((elapsed << FIXED_SHIFT) / TICK_PERIOD);
 }
 
 //=============================================================================
 // Private ISRs
 //=============================================================================
 static void RaceTick_ISR(void) {
-    Race_Tick();  // Physics update: movement, collisions, item logic
-}
-
-static void ChronoTick_ISR(void) {
-    Gameplay_IncrementTimer();  // Increment race time by 1ms
+    PROF_BEGIN(PROF_ZONE_TICK);
+    runTicks++;  // Chrono: one more tick period elapsed
+
+    // Physics update: movement, collisions, item logic (a replay at 4x or 16x
+    // runs that many ticks per period)
+    for (int i = Replay_GetSpeed(); i > 0; i--)
+        Race_Tick();
+    RaceSnapshot_Publish();  // Hand the finished tick to the renderers
+    PROF_END(PROF_ZONE_TICK);
 }
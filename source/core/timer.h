@@ -3,8 +3,8 @@
  * --------------
  * Description: Timer and interrupt service routine (ISR) management for the game.
  *              Provides two timer systems: VBlank ISR for 60Hz graphics updates,
- *              and hardware timers for physics ticks (RACE_TICK_FREQ=60Hz) and race
- *              chronometer (1000Hz) during gameplay.
+ *              and a hardware timer for physics ticks (RACE_TICK_FREQ=60Hz) during
+ *              gameplay, from which the race chronometer is derived on demand.
  *
  * Authors: Bahey Shalash, Hugo Svolgaard
  * Version: 1.0
@@ -14,6 +14,10 @@
 #ifndef TIMER_H
 #define TIMER_H
 
+#include <nds.h>
+
+#include "../math/fixedmath.h"
+
 //=============================================================================
 // Configuration
 //=============================================================================
@@ -45,7 +49,7 @@ void initTimer(void);
  *   HOME_PAGE    - HomePage_OnVBlank() for animated kart sprites
  *   MAPSELECTION - MapSelection_OnVBlank() for cloud animations
  *   PLAYAGAIN    - PlayAgain_OnVBlank() for UI updates
- *   GAMEPLAY     - Gameplay_OnVBlank() + lap/time display updates
+ *   GAMEPLAY     - Gameplay_OnVBlank() replays the recorded render commands
  *
  * Called: Automatically by hardware at 60Hz when VBlank IRQ is enabled
  */
@@ -58,9 +62,11 @@ void timerISRVblank(void);
 /**
  * Function: RaceTick_TimerInit
  * ----------------------------
- * Initializes hardware timers for gameplay. Sets up two timers:
+ * Starts the gameplay timer and resets the race chrono:
  *   - TIMER0: RACE_TICK_FREQ Hz physics tick (calls Race_Tick() for game tick updates)
- *   - TIMER1: 1000Hz chronometer (calls Gameplay_IncrementTimer() for race time)
+ *
+ * The chrono has no interrupt of its own: RaceTick_GetElapsedMs() derives it
+ * from the TIMER0 tick count and counter when asked.
  *
  * Called: At the start of gameplay when entering GAMEPLAY state
  */
@@ -69,8 +75,8 @@ void RaceTick_TimerInit(void);
 /**
  * Function: RaceTick_TimerStop
  * ----------------------------
- * Stops and disables both race timers (TIMER0 and TIMER1). Clears pending
- * interrupts to prevent stray ISR calls.
+ * Stops and disables the race tick (TIMER0) and removes its handler. The
+ * chrono keeps the time it had when stopped.
  *
  * Called: When exiting gameplay or transitioning to non-racing states
  */
@@ -79,8 +85,8 @@ void RaceTick_TimerStop(void);
 /**
  * Function: RaceTick_TimerPause
  * -----------------------------
- * Temporarily disables both race timers without clearing their state.
- * Used for pause functionality where timers can be resumed later.
+ * Stops the race tick and snapshots the chrono, so paused time is not
+ * counted. Used for pause functionality where the race can be resumed later.
  *
  * Called: When the game is paused during gameplay
  */
@@ -89,11 +95,34 @@ void RaceTick_TimerPause(void);
 /**
  * Function: RaceTick_TimerEnable
  * ------------------------------
- * Re-enables both race timers after being paused. Resumes physics ticks
- * and chronometer updates from their previous state.
+ * Restarts the race tick after a pause. The chrono continues from the time
+ * snapshotted by RaceTick_TimerPause().
  *
  * Called: When unpausing the game to resume gameplay
  */
 void RaceTick_TimerEnable(void);
 
+/**
+ * Function: RaceTick_GetAlpha
+ * ---------------------------
+ * How far the physics tick period has advanced since the last tick, read from
+ * the TIMER0 counter. Renderers blend the previous and current tick poses with
+ * it, so motion stays smooth whatever RACE_TICK_FREQ is.
+ *
+ * Returns: 0 (tick just ran) to FIXED_ONE (next tick due); FIXED_ONE while the
+ *          tick timer is stopped or paused
+ */
+Q16_8 RaceTick_GetAlpha(void);
+
+/**
+ * Function: RaceTick_GetElapsedMs
+ * -------------------------------
+ * Race chrono: time since RaceTick_TimerInit() excluding pauses, computed
+ * from TIMER0 (tick count * tick period + counter phase, ~31 us resolution).
+ * Exact even if tick interrupts are served late.
+ *
+ * Returns: Elapsed race time in milliseconds
+ */
+u32 RaceTick_GetElapsedMs(void);
+
 #endif  // TIMER_H
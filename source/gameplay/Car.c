@@ -22,6 +22,7 @@
 #include <string.h>
 
 #include "../core/game_constants.h"
+#include "../core/tcm.h"
 
 //=============================================================================
 // Private Function Prototypes
@@ -55,7 +56,7 @@ static void copy_name(char destination[32], const char* name) {
  * -------------------------
  * Clamps friction value to valid range [0, FIXED_ONE].
  */
-static Q16_8 clamp_friction(Q16_8 friction) {
+static TCM_CODE Q16_8 clamp_friction(Q16_8 friction) {
     if (friction < 0) {
         return 0;
     }
@@ -70,7 +71,7 @@ static Q16_8 clamp_friction(Q16_8 friction) {
  * -------------------------
  * Builds a velocity vector from car's current facing angle and speed magnitude.
  */
-static Vec2 build_velocity(const Car* car) {
+static TCM_CODE Vec2 build_velocity(const Car* car) {
     if (car == NULL || car->speed == 0) {
         return Vec2_Zero();
     }
@@ -84,7 +85,7 @@ static Vec2 build_velocity(const Car* car) {
  * Converts a velocity vector into the car's internal speed/angle representation.
  * Speed is capped to maxSpeed.
  */
-static void apply_velocity(Car* car, const Vec2* velocity) {
+static TCM_CODE void apply_velocity(Car* car, const Vec2* velocity) {
     if (car == NULL) {
         return;
     }
@@ -160,7 +161,7 @@ void Car_Reset(Car* car, const Vec2* spawnPos) {
  * -------------------------
  * Increases car speed by accelRate in the current facing direction.
  */
-void Car_Accelerate(Car* car) {
+TCM_CODE void Car_Accelerate(Car* car) {
     if (car == NULL) {
         return;
     }
@@ -178,7 +179,7 @@ void Car_Accelerate(Car* car) {
  * -------------------
  * Decreases car speed by accelRate. Speed cannot go negative.
  */
-void Car_Brake(Car* car) {
+TCM_CODE void Car_Brake(Car* car) {
     if (car == NULL) {
         return;
     }
@@ -201,7 +202,7 @@ void Car_Brake(Car* car) {
  * Rotates the car's facing angle. Movement direction follows the facing
  * angle since speed is scalar.
  */
-void Car_Steer(Car* car, int deltaAngle512) {
+TCM_CODE void Car_Steer(Car* car, int deltaAngle512) {
     if (car == NULL) {
         return;
     }
@@ -216,7 +217,7 @@ void Car_Steer(Car* car, int deltaAngle512) {
  * Updates car physics for one frame. Applies friction, snaps low speeds to
  * zero, and integrates velocity into position. Call once per physics tick (60Hz).
  */
-void Car_Update(Car* car) {
+TCM_CODE void Car_Update(Car* car) {
     if (car == NULL) {
         return;
     }
@@ -286,7 +287,7 @@ bool Car_IsMoving(const Car* car) {
  * ----------------------
  * Returns the car's current speed magnitude.
  */
-Q16_8 Car_GetSpeed(const Car* car) {
+TCM_CODE Q16_8 Car_GetSpeed(const Car* car) {
     if (car == NULL) {
         return 0;
     }
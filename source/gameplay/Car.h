@@ -7,7 +7,7 @@
  *              manipulation. Uses a scalar speed + angle representation for
  *              simplified physics and tight control.
  *
- * Ownership: Cars are owned by RaceState in gameplay_logic.c
+ * Ownership: Cars are owned by RaceState, inside the race SimState
  * Access Rules:
  *   - Read: Direct member access (car->position.x, car->speed, etc.)
  *   - Modify: Use Car_* functions to maintain invariants
@@ -54,7 +54,9 @@
  *   lastCheckpoint - Last checkpoint crossed (-1 = none)
  *   item           - Currently held item
  *   carname        - Car name string (max 31 chars + null terminator)
- *   gfx            - Sprite graphics pointer
+ *
+ * Holds no pointers: sprites are picked by the renderer, so a Car can be
+ * copied, saved and restored as plain bytes (sim_state.h).
  */
 typedef struct Car {
     Vec2 position;
@@ -68,7 +70,6 @@ typedef struct Car {
     int lastCheckpoint;
     Item item;
     char carname[32];
-    u16* gfx;
 } Car;
 //=============================================================================
 // Constructors (Inline Helpers)
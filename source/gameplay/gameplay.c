@@ -2,10 +2,11 @@
  * File: gameplay.c
  * ----------------
  * Description: Main gameplay screen implementation for racing. Handles graphics
- *              initialization, VBlank rendering updates, camera management,
- *              quadrant loading/switching, timer updates, sub-screen display
- *              (lap counter, chrono, item display), and final time rendering.
- *              Coordinates with gameplay_logic.c for race state.
+ *              initialization, per-frame render command recording, camera
+ *              management, track background streaming, timer updates,
+ *              sub-screen display (lap counter, chrono, item display), and
+ *              final time rendering. Coordinates with gameplay_logic.c for
+ *              race state.
  *
  * Authors: Bahey Shalash, Hugo Svolgaard
  * Version: 1.0
@@ -21,28 +22,35 @@
 #include "../core/context.h"
 #include "../core/game_constants.h"
 #include "../core/game_types.h"
+#include "../core/kmlog.h"
+#include "../core/mem_budget.h"
+#include "../core/profiler.h"
+#include "../core/scheduler.h"
+#include "../core/timer.h"
+#include "../graphics/bg_stream.h"
+#include "../graphics/render_cmd.h"
+#include "../graphics/residency.h"
+#include "../graphics/rot_sprite.h"
+#include "../graphics/sprite_batch.h"
 #include "../graphics/color.h"
 #include "../network/multiplayer.h"
+#include "../storage/assets.h"
 #include "../storage/storage_pb.h"
 #include "../ui/play_again.h"
 #include "data/items/banana.h"
 #include "data/items/bomb.h"
 #include "gameplay_logic.h"
+#include "ghost.h"
+#include "race_snapshot.h"
+#include "replay.h"
+#include "telemetry.h"
 #include "data/items/green_shell.h"
-#include "data/sprites/kart_sprite.h"
+#include "data/sprites/kart_sprite_rot.h"
 #include "data/items/missile.h"
 #include "data/sprites/numbers.h"
 #include "data/items/oil_slick.h"
 #include "data/items/red_shell.h"
-#include "data/tracks/scorching_sands_BC.h"
-#include "data/tracks/scorching_sands_BL.h"
-#include "data/tracks/scorching_sands_BR.h"
-#include "data/tracks/scorching_sands_MC.h"
-#include "data/tracks/scorching_sands_ML.h"
-#include "data/tracks/scorching_sands_MR.h"
-#include "data/tracks/scorching_sands_TC.h"
-#include "data/tracks/scorching_sands_TL.h"
-#include "data/tracks/scorching_sands_TR.h"
+#include "track_map.h"
 #include "wall_collision.h"
 
 //=============================================================================
@@ -50,34 +58,71 @@
 //=============================================================================
 
 //! DEBUGGING FLAG
-// #define console_on_debug  // Uncomment to enable debug console on sub screen
+// The sub screen debug console only hosts the profiler overlay; debug output
+// goes to the binary log instead (make LOG_LEVEL=0, see kmlog.h). PROFILE=1
+// alone keeps the HUD, so profiled frames do the same work as normal ones
+#ifdef PROFILER_OVERLAY
+#define console_on_debug  // The profiler overlay prints to the debug console
+#endif
 //! DEBUGGING FLAG
 
+// Sub-screen digit glyphs (numbers.png: 4x8 tiles per digit, ':' and '.' 2x8)
+#define GLYPH_ROWS 8
+#define GLYPH_COLS 4
+#define GLYPH_COLON 10
+#define GLYPH_DOT 11
+#define GLYPH_BLANK 12
+#define GLYPH_COUNT 13
+#define GLYPH_NONE (-1)     // Number with no glyph (nothing drawn)
+#define HUD_GLYPH_UNKNOWN (-1)  // Slot content unknown, next print redraws
+
+// Sub-screen BG0 map (32x32 entries), drawn into a RAM copy first
+#define SUB_MAP_TILES 32
+#define SUB_MAP_BLANK 32  // Empty tile of numbers.png
+
 //=============================================================================
-// PRIVATE STATE
+// PRIVATE TYPES
 //=============================================================================
-static int raceMin = 0;
-static int raceSec = 0;
-static int raceMsec = 0;
-static int currentLap = 1;
 
+// Fixed digit positions of the race HUD, each with a cached glyph
+typedef enum {
+    HUD_CHRONO_MIN_TENS,
+    HUD_CHRONO_MIN_UNITS,
+    HUD_CHRONO_COLON,
+    HUD_CHRONO_SEC_TENS,
+    HUD_CHRONO_SEC_UNITS,
+    HUD_CHRONO_DOT,
+    HUD_CHRONO_MSEC_HUNDREDS,
+    HUD_CHRONO_MSEC_TENS,
+    HUD_CHRONO_MSEC_UNITS,
+    HUD_LAP_CURRENT,
+    HUD_LAP_SEPARATOR,
+    HUD_LAP_TOTAL_TENS,  // Also the single total digit when totalLaps < 10
+    HUD_LAP_TOTAL_UNITS,
+    HUD_SLOT_COUNT
+} HudSlot;
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
 static int scrollX = 0;
 static int scrollY = 0;
-static QuadrantID currentQuadrant = QUAD_BR;
+static Q16_8 renderAlpha = FIXED_ONE;  // Blend of this frame between two ticks
 
 // Sprite graphics pointer (allocated during configureSprite)
-static u16* kartGfx = NULL;
+static RotSprite kartFrames;  // 32 directions, half-turn symmetry
 #ifndef console_on_debug
 static u16* itemDisplayGfx_Sub = NULL;
 #endif
 
 static bool countdownCleared = false;
+static int shownCountdown = -1;       // CountdownState on the sub screen
+static bool finalTimeShown = false;
+#ifndef console_on_debug
+static Item shownItem = ITEM_NONE;    // Item whose tiles are in itemDisplayGfx_Sub
+#endif
 static int finishDisplayCounter = 0;  // NEW: Count frames showing final time
 
-static int totalRaceMin = 0;
-static int totalRaceSec = 0;
-static int totalRaceMsec = 0;
-
 static int bestRaceMin = -1;  // -1 means no best time exists
 static int bestRaceSec = -1;
 static int bestRaceMsec = -1;
@@ -85,36 +130,22 @@ static bool isNewRecord = false;
 
 static bool hasSavedBestTime = false;
 
-//=============================================================================
-// PRIVATE TYPES - Quadrant Data
-//=============================================================================
-typedef struct {
-    const unsigned int* tiles;
-    const unsigned short* map;
-    const unsigned short* palette;  // ADDED: Each quadrant has its own palette
-    unsigned int tilesLen;
-    unsigned int paletteLen;  // ADDED: Palette length
-} QuadrantData;
-
-static const QuadrantData quadrantData[9] = {
-    {scorching_sands_TLTiles, scorching_sands_TLMap, scorching_sands_TLPal,
-     scorching_sands_TLTilesLen, scorching_sands_TLPalLen},
-    {scorching_sands_TCTiles, scorching_sands_TCMap, scorching_sands_TCPal,
-     scorching_sands_TCTilesLen, scorching_sands_TCPalLen},
-    {scorching_sands_TRTiles, scorching_sands_TRMap, scorching_sands_TRPal,
-     scorching_sands_TRTilesLen, scorching_sands_TRPalLen},
-    {scorching_sands_MLTiles, scorching_sands_MLMap, scorching_sands_MLPal,
-     scorching_sands_MLTilesLen, scorching_sands_MLPalLen},
-    {scorching_sands_MCTiles, scorching_sands_MCMap, scorching_sands_MCPal,
-     scorching_sands_MCTilesLen, scorching_sands_MCPalLen},
-    {scorching_sands_MRTiles, scorching_sands_MRMap, scorching_sands_MRPal,
-     scorching_sands_MRTilesLen, scorching_sands_MRPalLen},
-    {scorching_sands_BLTiles, scorching_sands_BLMap, scorching_sands_BLPal,
-     scorching_sands_BLTilesLen, scorching_sands_BLPalLen},
-    {scorching_sands_BCTiles, scorching_sands_BCMap, scorching_sands_BCPal,
-     scorching_sands_BCTilesLen, scorching_sands_BCPalLen},
-    {scorching_sands_BRTiles, scorching_sands_BRMap, scorching_sands_BRPal,
-     scorching_sands_BRTilesLen, scorching_sands_BRPalLen}};
+// Sub-screen HUD: map entries of every glyph, laid out row by row, and the
+// glyph last drawn in each HUD slot so unchanged digits are skipped
+static u16 glyphBlocks[GLYPH_COUNT][GLYPH_ROWS][GLYPH_COLS];
+static bool glyphBlocksReady = false;
+static s8 hudGlyphs[HUD_SLOT_COUNT];
+static SchedTaskId hudTask = SCHED_NO_TASK;  // Chrono/lap refresh (polled per frame)
+
+// Sub-screen map copy; each row remembers the column span changed this frame
+static u16 subMap[SUB_MAP_TILES * SUB_MAP_TILES] ALIGN(4);
+static s8 subDirtyMin[SUB_MAP_TILES];
+static s8 subDirtyMax[SUB_MAP_TILES];
+
+static const u8 hudSlotPos[HUD_SLOT_COUNT][2] = {
+    {0, 8},  {4, 8},  {8, 8}, {10, 8}, {14, 8}, {18, 8}, {20, 8},
+    {24, 8}, {28, 8}, {0, 0}, {4, 0},  {6, 0},  {10, 0},
+};
 
 //=============================================================================
 // PRIVATE HELPER PROTOTYPES
@@ -126,73 +157,60 @@ static void Gameplay_FreeSprites(void);
 #ifdef console_on_debug
 static void Gameplay_ConfigureConsole(void);
 #endif
-static void Gameplay_LoadQuadrant(QuadrantID quad);
-static QuadrantID Gameplay_DetermineQuadrant(int x, int y);
 static void Gameplay_RenderCountdown(CountdownState state);
 static void Gameplay_ClearCountdownDisplay(void);
 static void Gameplay_DisplayFinalTime(int min, int sec, int msec);
-static void Gameplay_UpdateChronoDisp(u16* map, int min, int sec, int msec);
+static void Gameplay_InvalidateHud(void);
+static void Gameplay_ClearSubMap(void);
+static void Gameplay_ClearSubRect(int x, int y, int w, int h);
+#ifndef console_on_debug
+static void Gameplay_FlushSubMap(void);
+#endif
+static void Gameplay_BuildFrame(void);
 #ifndef console_on_debug
 static void Gameplay_LoadItemDisplay_Sub(void);
-static void Gameplay_UpdateItemDisplay_Sub(void);
+static void Gameplay_UpdateItemDisplay_Sub(Item held);
+static void Gameplay_HideItemDisplay_Sub(void);
 #endif
-// VBlank rendering helpers
-static void Gameplay_UpdateCameraPosition(const Car* player);
+// Frame rendering helpers (read the published race snapshot)
+static void Gameplay_UpdateCameraPosition(const KartPose* player);
 static void Gameplay_ApplyCameraScroll(void);
-static void Gameplay_RenderSinglePlayerCar(const Car* player, int carX, int carY);
-static void Gameplay_RenderMultiplayerCars(const RaceState* state);
-static void Gameplay_HandleFinishLineCrossing(const Car* player);
-static bool Gameplay_HandleFinishDisplay(const RaceState* state);
-#ifdef console_on_debug
-static void Gameplay_DebugPrintRedShells(const Car* player);
+static void Gameplay_RenderSinglePlayerCar(const KartPose* player, int carX, int carY);
+static void Gameplay_RenderMultiplayerCars(const RaceSnapshot* snap);
+static void Gameplay_RenderGhost(const RaceSnapshot* snap);
+static bool Gameplay_HandleFinishDisplay(const RaceSnapshot* snap);
+#if KMLOG_LEVEL <= KMLOG_LEVEL_DEBUG
+static void Gameplay_LogRedShells(const Car* player);
 #endif
-static bool Gameplay_HandleCountdownPhase(const Car* player, const RaceState* state);
+static bool Gameplay_HandleCountdownPhase(const RaceSnapshot* snap);
 static void Gameplay_ClearCountdownDisplayOnce(void);
-static void Gameplay_HandleRacePhase(const Car* player, const RaceState* state);
-static void Gameplay_RenderCarsForMode(const RaceState* state, const Car* player,
+static void Gameplay_HandleRacePhase(const RaceSnapshot* snap);
+static void Gameplay_RenderCarsForMode(const RaceSnapshot* snap, const KartPose* player,
                                        int carX, int carY);
 
 //=============================================================================
 // PUBLIC API - Timer Access
 //=============================================================================
-int Gameplay_GetRaceMin(void) {
-    return raceMin;
-}
-
-int Gameplay_GetRaceSec(void) {
-    return raceSec;
-}
-
-int Gameplay_GetRaceMsec(void) {
-    return raceMsec;
+// Helper: Split a chrono reading into minutes, seconds and milliseconds
+static void Gameplay_SplitTime(u32 ms, int* min, int* sec, int* msec) {
+    u32 seconds = ms / MS_PER_SECOND;
+    *msec = (int)(ms % MS_PER_SECOND);
+    *sec = (int)(seconds % SECONDS_PER_MINUTE);
+    *min = (int)(seconds / SECONDS_PER_MINUTE);
 }
 
 int Gameplay_GetCurrentLap(void) {
-    return currentLap;
+    return Race_GetCurrentLap();
 }
 
-void Gameplay_IncrementTimer(void) {
-    if (Race_IsCompleted()) {
-        return;
-    }
-
-    // Increment lap time
-    raceMsec = (raceMsec + 1) % MS_PER_SECOND;
-    if (raceMsec == 0) {
-        raceSec = (raceSec + 1) % SECONDS_PER_MINUTE;
-        if (raceSec == 0) {
-            raceMin++;
-        }
-    }
-
-    // Increment total time
-    totalRaceMsec = (totalRaceMsec + 1) % MS_PER_SECOND;
-    if (totalRaceMsec == 0) {
-        totalRaceSec = (totalRaceSec + 1) % SECONDS_PER_MINUTE;
-        if (totalRaceSec == 0) {
-            totalRaceMin++;
-        }
-    }
+void Gameplay_GetLapTime(int* min, int* sec, int* msec) {
+    u32 nowMs = Replay_GetClockMs();
+    u32 lapStartMs = Race_GetLapStartMs();
+    // A replay's clock counts ticks; its recorded lap start can be a tick ahead
+    u32 lapMs = (nowMs > lapStartMs) ? nowMs - lapStartMs : 0;
+    if (Race_IsCompleted())
+        lapMs = 0;  // The lap chrono is not shown after the finish
+    Gameplay_SplitTime(lapMs, min, sec, msec);
 }
 
 //=============================================================================
@@ -200,14 +218,9 @@ void Gameplay_IncrementTimer(void) {
 //=============================================================================
 // Helper: Reset all race state variables
 static void Gameplay_ResetRaceState(void) {
-    raceMin = 0;
-    raceSec = 0;
-    raceMsec = 0;
-    totalRaceMin = 0;
-    totalRaceSec = 0;
-    totalRaceMsec = 0;
-    currentLap = 1;
     countdownCleared = false;
+    shownCountdown = -1;
+    finalTimeShown = false;
     finishDisplayCounter = 0;
     hasSavedBestTime = false;
     isNewRecord = false;
@@ -236,11 +249,17 @@ static void Gameplay_InitializeCamera(const Car* player) {
     if (scrollY > MAX_SCROLL_Y)
         scrollY = MAX_SCROLL_Y;
 
-    currentQuadrant = Gameplay_DetermineQuadrant(scrollX, scrollY);
-    Gameplay_LoadQuadrant(currentQuadrant);
+    // Setup runs with the display blank: write VRAM and registers directly
+    BgStream_Reset(scrollX, scrollY);
+    BG_OFFSET[0].x = scrollX & (BG_STREAM_SIZE_PX - 1);
+    BG_OFFSET[0].y = scrollY & (BG_STREAM_SIZE_PX - 1);
 }
 
 void Gameplay_Initialize(void) {
+    // Drop commands left over from a previous race; setup below may record
+    // sub-screen changes that go out with the first frame
+    RenderCmd_Reset();
+
     // Configure graphics and background
     Gameplay_ConfigureGraphics();
     Gameplay_ConfigureBackground();
@@ -258,44 +277,71 @@ void Gameplay_Initialize(void) {
 
     // Clear sub screen display
 #ifndef console_on_debug
-    u16* map = BG_MAP_RAM_SUB(0);
-    memset(map, 32, 32 * 32 * 2);
+    Gameplay_ClearSubMap();
     Gameplay_ChangeDisplayColor(BLACK);
 #endif
 
-    // Initialize race logic and configure sprites
+    // Initialize race logic (or the replay that replaces it) and configure sprites
     Race_Init(selectedMap, mode);
+    bool replaying = GameContext_IsReplayMode() && Replay_BeginPlayback(selectedMap);
+    if (!replaying) {
+        if (mode == SinglePlayer)
+            Ghost_Init(selectedMap);
+        Replay_BeginRecording(selectedMap, mode);
+    }
+#ifdef TELEMETRY_ENABLED
+    Telemetry_Begin(replaying);
+#endif
     Gameplay_ConfigureSprite();
+    RaceSnapshot_Reset();
+    RaceSnapshot_Publish();
 
     // Initialize camera to follow player
     const Car* player = Race_GetPlayerCar();
     Gameplay_InitializeCamera(player);
+
+    // Low priority: under load the HUD digits refresh every 2nd or 4th frame
+    if (hudTask == SCHED_NO_TASK)
+        hudTask = Scheduler_Register("hud", NULL, SCHED_PRIO_LOW, 1, SCHED_BUDGET_HUD);
+
+    // A replay starts after the countdown (its first keyframe)
+    if (replaying)
+        RaceTick_TimerInit();
 }
 
 GameState Gameplay_Update(void) {
     scanKeys();
     int keysdown = keysDown();
+    Race_UpdatePause();  // START presses posted by the key ISR
 
     // Handle SELECT to exit anytime
     if (keysdown & KEY_SELECT) {
         Race_Stop();
         return HOME_PAGE;
     }
+    Replay_Update(keysdown);  // Playback speed and seeking
 
     const RaceState* state = Race_GetState();
 
     // CHANGED: Fixed best time saving and display logic
-    // Save best time once when race finishes (NOT in VBlank - safe here!)
-    if (state->raceFinished && !hasSavedBestTime) {
+    // Save best time once when race finishes (NOT in VBlank - safe here!); a
+    // replay is not a new time
+    if (state->raceFinished && !hasSavedBestTime && !Replay_IsPlaying()) {
         Map currentMap = GameContext_GetMap();
+        int totalRaceMin, totalRaceSec, totalRaceMsec;
+        Race_GetFinalTime(&totalRaceMin, &totalRaceSec, &totalRaceMsec);
+#ifndef console_on_debug
+        // Hide item sprite when race finishes
+        Gameplay_HideItemDisplay_Sub();
+#endif
 
         // Try to save the time (returns true if it's a new record)
         isNewRecord = StoragePB_SaveBestTime(currentMap, totalRaceMin, totalRaceSec,
                                              totalRaceMsec);
 
-        // CHANGED: Load the actual best time from file instead of always using current
-        // time This ensures we display the real best time, not just the current race
-        // time
+        // CHANGED: Load the actual best time from the record cache instead of always
+        // using current time This ensures we display the real best time, not just the
+        // current race time
         if (!StoragePB_LoadBestTime(currentMap, &bestRaceMin, &bestRaceSec,
                                     &bestRaceMsec)) {
             // No best time exists (shouldn't happen after save, but handle it)
@@ -307,6 +353,18 @@ GameState Gameplay_Update(void) {
         hasSavedBestTime = true;
     }
 
+    if (Race_IsCountdownActive()) {
+        // Network sync during the countdown (no movement yet); the tick timer
+        // is not running, so the spawn poses are published from here
+        Race_CountdownTick();
+        RaceSnapshot_Publish();
+    }
+    // Laps and the finish are counted by the race tick (Race_Tick)
+
+    // Record this frame's screen changes; the VBlank ISR replays them
+    Gameplay_BuildFrame();
+    RenderCmd_Publish();
+
     // Check if race finished and counting display frames
     if (state->raceFinished && state->finishDelayTimer == 0) {
         finishDisplayCounter++;
@@ -324,12 +382,20 @@ GameState Gameplay_Update(void) {
     return GAMEPLAY;
 }
 
+//=============================================================================
+// Helper: Kart position between the previous and the snapshot tick
+//=============================================================================
+static inline Vec2 Gameplay_KartPosition(const KartPose* kart) {
+    return Vec2_Lerp(kart->prevPosition, kart->position, renderAlpha);
+}
+
 //=============================================================================
 // Helper: Update Camera Position
 //=============================================================================
-static void Gameplay_UpdateCameraPosition(const Car* player) {
-    int carX = FixedToInt(player->position.x) + CAR_SPRITE_CENTER_OFFSET;
-    int carY = FixedToInt(player->position.y) + CAR_SPRITE_CENTER_OFFSET;
+static void Gameplay_UpdateCameraPosition(const KartPose* player) {
+    Vec2 position = Gameplay_KartPosition(player);
+    int carX = FixedToInt(position.x) + CAR_SPRITE_CENTER_OFFSET;
+    int carY = FixedToInt(position.y) + CAR_SPRITE_CENTER_OFFSET;
 
     scrollX = carX - (SCREEN_WIDTH / 2);
     scrollY = carY - (SCREEN_HEIGHT / 2);
@@ -348,147 +414,133 @@ static void Gameplay_UpdateCameraPosition(const Car* player) {
 // Helper: Apply Camera Scroll to Background
 //=============================================================================
 static void Gameplay_ApplyCameraScroll(void) {
-    QuadrantID newQuadrant = Gameplay_DetermineQuadrant(scrollX, scrollY);
-    if (newQuadrant != currentQuadrant) {
-        Gameplay_LoadQuadrant(newQuadrant);
-        currentQuadrant = newQuadrant;
-        Race_SetLoadedQuadrant(newQuadrant);
-    }
+    // Stream in the rows/columns the camera exposed, then wrap the scroll
+    // registers into the 512x512 window (world tile N always sits in cell N&63)
+    BgStream_Prepare(scrollX, scrollY);
+    BgStream_Commit();
 
-    int col = currentQuadrant % 3;
-    int row = currentQuadrant / 3;
-    BG_OFFSET[0].x = scrollX - (col * QUAD_OFFSET);
-    BG_OFFSET[0].y = scrollY - (row * QUAD_OFFSET);
+    RenderCmd_Write16(&BG_OFFSET[0].x, scrollX & (BG_STREAM_SIZE_PX - 1));
+    RenderCmd_Write16(&BG_OFFSET[0].y, scrollY & (BG_STREAM_SIZE_PX - 1));
 }
 
 //=============================================================================
-// Helper: Render Single Player Car
+// Helper: Submit a kart sprite (pre-rotated frame, in front of items)
 //=============================================================================
-static void Gameplay_RenderSinglePlayerCar(const Car* player, int carX, int carY) {
-    int screenX = carX - scrollX - 16;
-    int screenY = carY - scrollY - 16;
-
-    int dsAngle = -(player->angle512 << 6);
-    oamRotateScale(&oamMain, 0, dsAngle, (1 << 8), (1 << 8));
-
-    oamSet(&oamMain, 41, screenX, screenY, OBJPRIORITY_0, 0, SpriteSize_32x32,
-           SpriteColorFormat_16Color, player->gfx, 0, true, false, false, false,
-           false);
+// The kart's centre is position + CAR_SPRITE_CENTER_OFFSET, like the camera
+// and the wall, checkpoint and finish line checks
+static void Gameplay_SubmitCar(const KartPose* kart, int centerX, int centerY) {
+    SpriteDesc sprite = {.format = SpriteColorFormat_16Color,
+                         .priority = OBJPRIORITY_0};
+    int angle = Angle_Lerp(kart->prevAngle512, kart->angle512, renderAlpha);
+    RotSprite_Place(&kartFrames, angle, centerX, centerY, &sprite);
+    SpriteBatch_Submit(&sprite);
 }
 
 //=============================================================================
-// Helper: Render Multiplayer Cars
+// Helper: Render Single Player Car
 //=============================================================================
-static void Gameplay_RenderMultiplayerCars(const RaceState* state) {
-    for (int i = 0; i < state->carCount; i++) {
-        int oamSlot = 41 + i;
-
-        if (!Multiplayer_IsPlayerConnected(i)) {
-            oamSet(&oamMain, oamSlot, 0, 192, OBJPRIORITY_0, 0, SpriteSize_32x32,
-                   SpriteColorFormat_16Color, NULL, -1, true, false, false, false,
-                   false);
-            continue;
-        }
-
-        const Car* car = &state->cars[i];
-        int carWorldX = FixedToInt(car->position.x);
-        int carWorldY = FixedToInt(car->position.y);
-        int carScreenX = carWorldX - scrollX - 16;
-        int carScreenY = carWorldY - scrollY - 16;
+static void Gameplay_RenderSinglePlayerCar(const KartPose* player, int carX, int carY) {
+    Gameplay_SubmitCar(player, carX + CAR_SPRITE_CENTER_OFFSET - scrollX,
+                       carY + CAR_SPRITE_CENTER_OFFSET - scrollY);
+}
 
-        int dsAngle = -(car->angle512 << 6);
-        oamRotateScale(&oamMain, i, dsAngle, (1 << 8), (1 << 8));
+//=============================================================================
+// Helper: Render the time trial ghost (translucent, behind the player)
+//=============================================================================
+static void Gameplay_RenderGhost(const RaceSnapshot* snap) {
+    if (snap->multiplayer || snap->finished)
+        return;
 
-        bool onScreen = (carScreenX >= -32 && carScreenX < SCREEN_WIDTH &&
-                         carScreenY >= -32 && carScreenY < SCREEN_HEIGHT);
+    Vec2 position;
+    int angle;
+    if (!Ghost_GetPose(snap->lapTicks, renderAlpha, &position, &angle))
+        return;
 
-        if (onScreen) {
-            oamSet(&oamMain, oamSlot, carScreenX, carScreenY, OBJPRIORITY_0, 0,
-                   SpriteSize_32x32, SpriteColorFormat_16Color, car->gfx, i, true,
-                   false, false, false, false);
-        } else {
-            oamSet(&oamMain, oamSlot, -64, -64, OBJPRIORITY_0, 0, SpriteSize_32x32,
-                   SpriteColorFormat_16Color, car->gfx, i, true, false, false, false,
-                   false);
-        }
-    }
+    SpriteDesc sprite = {.format = SpriteColorFormat_16Color,
+                         .priority = OBJPRIORITY_0,
+                         .blended = true};
+    // Same placement as the player's kart: the pose is the kart's top-left
+    RotSprite_Place(&kartFrames, angle,
+                    FixedToInt(position.x) + CAR_SPRITE_CENTER_OFFSET - scrollX,
+                    FixedToInt(position.y) + CAR_SPRITE_CENTER_OFFSET - scrollY,
+                    &sprite);
+    SpriteBatch_Submit(&sprite);
 }
 
 //=============================================================================
-// Helper: Handle Finish Line Crossing
+// Helper: Render Multiplayer Cars
 //=============================================================================
-static void Gameplay_HandleFinishLineCrossing(const Car* player) {
-    if (!Race_CheckFinishLineCross(player))
-        return;
+static void Gameplay_RenderMultiplayerCars(const RaceSnapshot* snap) {
+    for (int i = 0; i < snap->carCount; i++) {
+        if (!snap->karts[i].visible)
+            continue;
 
-    if (currentLap < Race_GetLapCount()) {
-        // Normal lap completion - reset LAP timer (but total keeps running)
-        currentLap++;
-        raceMin = 0;
-        raceSec = 0;
-        raceMsec = 0;
-    } else {
-        // RACE COMPLETED!
-        Race_MarkAsCompleted(totalRaceMin, totalRaceSec, totalRaceMsec);
-        finishDisplayCounter = 0;
-#ifndef console_on_debug
-        // Hide item sprite when race finishes
-        oamSet(&oamSub, 0, 0, 192, 0, 0, SpriteSize_32x32, SpriteColorFormat_16Color,
-               itemDisplayGfx_Sub, -1, true, false, false, false, false);
-        oamUpdate(&oamSub);
-#endif
+        // Off-screen karts are culled by the batcher
+        const KartPose* kart = &snap->karts[i];
+        Vec2 position = Gameplay_KartPosition(kart);
+        int carScreenX = FixedToInt(position.x) + CAR_SPRITE_CENTER_OFFSET - scrollX;
+        int carScreenY = FixedToInt(position.y) + CAR_SPRITE_CENTER_OFFSET - scrollY;
+        Gameplay_SubmitCar(kart, carScreenX, carScreenY);
     }
 }
 
-static bool Gameplay_HandleFinishDisplay(const RaceState* state) {
-    if (state->raceFinished && finishDisplayCounter < FINISH_DISPLAY_FRAMES) {
-        Gameplay_DisplayFinalTime(totalRaceMin, totalRaceSec, totalRaceMsec);
+static bool Gameplay_HandleFinishDisplay(const RaceSnapshot* snap) {
+    if (snap->finished && finishDisplayCounter < FINISH_DISPLAY_FRAMES) {
+        if (!finalTimeShown) {
+            int min, sec, msec;
+            Race_GetFinalTime(&min, &sec, &msec);
+            Gameplay_DisplayFinalTime(min, sec, msec);
+            finalTimeShown = true;
+        }
         return true;
     }
 
     return false;
 }
 
-#ifdef console_on_debug
-static void Gameplay_DebugPrintRedShells(const Car* player) {
-    consoleClear();
-    printf("=== RED SHELL DEBUG ===\n");
+#if KMLOG_LEVEL <= KMLOG_LEVEL_DEBUG
+// Homing state of every red shell, once per frame while any is active
+static void Gameplay_LogRedShells(const Car* player) {
     int itemCount = 0;
     const TrackItem* items = Items_GetActiveItems(&itemCount);
     int redShellCount = 0;
-    for (int i = 0; i < itemCount; i++) {
+    for (int i = 0; i < MAX_TRACK_ITEMS; i++) {
         if (items[i].active && items[i].type == ITEM_RED_SHELL) {
-            printf("Shell %d: (%d, %d)\n", redShellCount,
-                   FixedToInt(items[i].position.x), FixedToInt(items[i].position.y));
-            printf("  Angle: %d, Target: %d, Waypoint: %d\n", items[i].angle512,
-                   items[i].targetCarIndex, items[i].currentWaypoint);
+            LOG_DEBUG("red shell %d: (%d, %d) angle=%d target=%d wp=%d", i,
+                      FixedToInt(items[i].position.x), FixedToInt(items[i].position.y),
+                      items[i].angle512, items[i].targetCarIndex,
+                      items[i].currentWaypoint);
             redShellCount++;
         }
     }
-    if (redShellCount == 0)
-        printf("No red shells active\n");
-    printf("\nPlayer: (%d, %d)\n", FixedToInt(player->position.x),
-           FixedToInt(player->position.y));
+    if (redShellCount > 0)
+        LOG_DEBUG("player: (%d, %d)", FixedToInt(player->position.x),
+                  FixedToInt(player->position.y));
 }
 #endif
 
-static void Gameplay_RenderCarsForMode(const RaceState* state, const Car* player,
+static void Gameplay_RenderCarsForMode(const RaceSnapshot* snap, const KartPose* player,
                                        int carX, int carY) {
-    if (state->gameMode == SinglePlayer) {
+    if (!snap->multiplayer) {
         Gameplay_RenderSinglePlayerCar(player, carX, carY);
     } else {
-        Gameplay_RenderMultiplayerCars(state);
+        Gameplay_RenderMultiplayerCars(snap);
     }
 }
 
-static bool Gameplay_HandleCountdownPhase(const Car* player, const RaceState* state) {
+static bool Gameplay_HandleCountdownPhase(const RaceSnapshot* snap) {
     if (!Race_IsCountdownActive()) {
         return false;
     }
 
     Race_UpdateCountdown();
-    Gameplay_RenderCountdown(Race_GetCountdownState());
+    CountdownState countdown = Race_GetCountdownState();
+    if ((int)countdown != shownCountdown) {
+        Gameplay_RenderCountdown(countdown);
+        shownCountdown = (int)countdown;
+    }
 
+    const KartPose* player = &snap->karts[snap->playerIndex];
     int carX = FixedToInt(player->position.x);
     int carY = FixedToInt(player->position.y);
     scrollX = carX - (SCREEN_WIDTH / 2);
@@ -503,9 +555,11 @@ static bool Gameplay_HandleCountdownPhase(const Car* player, const RaceState* st
         scrollY = MAX_SCROLL_Y;
 
     Gameplay_ApplyCameraScroll();
-    Gameplay_RenderCarsForMode(state, player, carX, carY);
 
-    oamUpdate(&oamMain);
+    SpriteBatch_Begin();
+    Gameplay_RenderCarsForMode(snap, player, carX, carY);
+    SpriteBatch_End();
+    SpriteBatch_Flush();
     return true;
 }
 
@@ -516,47 +570,89 @@ static void Gameplay_ClearCountdownDisplayOnce(void) {
     }
 }
 
-static void Gameplay_HandleRacePhase(const Car* player, const RaceState* state) {
-    Gameplay_HandleFinishLineCrossing(player);
+static void Gameplay_HandleRacePhase(const RaceSnapshot* snap) {
+    const KartPose* player = &snap->karts[snap->playerIndex];
     Gameplay_UpdateCameraPosition(player);
     Gameplay_ApplyCameraScroll();
 
-    int carX = FixedToInt(player->position.x);
-    int carY = FixedToInt(player->position.y);
-    Gameplay_RenderCarsForMode(state, player, carX, carY);
+    Vec2 position = Gameplay_KartPosition(player);
+    int carX = FixedToInt(position.x);
+    int carY = FixedToInt(position.y);
 
-    Items_Render(scrollX, scrollY);
+    SpriteBatch_Begin();
+    Gameplay_RenderCarsForMode(snap, player, carX, carY);
+    Gameplay_RenderGhost(snap);
+    Items_Render(snap, renderAlpha, scrollX, scrollY);
+    SpriteBatch_End();
 #ifndef console_on_debug
-    Gameplay_UpdateItemDisplay_Sub();
+    Gameplay_UpdateItemDisplay_Sub((Item)snap->heldItem);
 #endif
-    oamUpdate(&oamMain);
+    SpriteBatch_Flush();
 }
 
-void Gameplay_OnVBlank(void) {
-    const Car* player = Race_GetPlayerCar();
-    const RaceState* state = Race_GetState();
-
-    if (Gameplay_HandleFinishDisplay(state)) {
+// Draws one frame from a published snapshot (never the live race structs)
+static void Gameplay_BuildScene(const RaceSnapshot* snap) {
+    if (Gameplay_HandleFinishDisplay(snap)) {
         return;
     }
 
-#ifdef console_on_debug
-    Gameplay_DebugPrintRedShells(player);
+#ifdef PROFILER_OVERLAY
+    Profiler_PrintOverlay();
+#endif
+#if KMLOG_LEVEL <= KMLOG_LEVEL_DEBUG
+    Gameplay_LogRedShells(Race_GetPlayerCar());
 #endif
 
-    if (Gameplay_HandleCountdownPhase(player, state)) {
+    if (Gameplay_HandleCountdownPhase(snap)) {
         return;
     }
 
     Gameplay_ClearCountdownDisplayOnce();
-    Gameplay_HandleRacePhase(player, state);
+    Gameplay_HandleRacePhase(snap);
+
+    // Lap/time displays only during active racing
+    if (!snap->finished && Scheduler_Poll(hudTask)) {
+        Gameplay_UpdateChronoDisplay(snap->lapMin, snap->lapSec, snap->lapMsec);
+        Gameplay_UpdateLapDisplay(snap->currentLap, snap->totalLaps);
+        Scheduler_Done(hudTask);
+    }
+}
+
+// Records everything that changes on screen this frame (main loop only)
+static void Gameplay_BuildFrame(void) {
+    PROF_BEGIN(PROF_ZONE_BUILD_FRAME);
+    const RaceSnapshot* snap = RaceSnapshot_Acquire();
+    if (snap != NULL) {
+        // Tick phase first: it only applies if no newer tick landed since
+        Q16_8 alpha = RaceTick_GetAlpha();
+        renderAlpha = RaceSnapshot_IsLatest(snap) ? alpha : FIXED_ONE;
+        Gameplay_BuildScene(snap);
+    }
+    RaceSnapshot_Release();
+#ifndef console_on_debug
+    Gameplay_FlushSubMap();
+#endif
+    PROF_END(PROF_ZONE_BUILD_FRAME);
+}
+
+void Gameplay_OnVBlank(void) {
+    RenderCmd_Replay();
 }
 
 void Gameplay_Cleanup(void) {
+    BgStream_Stop();
+    Ghost_Cleanup();  // Saves a new best lap (the race tick is already stopped)
+    Replay_Cleanup();  // Finishes the recording
+#ifdef TELEMETRY_ENABLED
+    Telemetry_End();
+#endif
+    GameContext_SetReplayMode(false);
+    // The world map, tileset and sprite banks stay resident for a rematch on
+    // the same track (see residency.h); a race on another track replaces them
     Gameplay_FreeSprites();
 #ifndef console_on_debug
     if (itemDisplayGfx_Sub) {
-        oamFreeGfx(&oamSub, itemDisplayGfx_Sub);
+        MemBudget_FreeGfx(&oamSub, itemDisplayGfx_Sub);
         itemDisplayGfx_Sub = NULL;
     }
 #endif
@@ -567,38 +663,36 @@ void Gameplay_Cleanup(void) {
 //=============================================================================
 
 // Helper: Display time at given y position (format: MM:SS.D)
-static void Gameplay_PrintTime(u16* map, int min, int sec, int msec, int y) {
+static void Gameplay_PrintTime(int min, int sec, int msec, int y) {
     // Minutes
-    Gameplay_PrintDigit(map, min / 10, 0, y);
-    Gameplay_PrintDigit(map, min % 10, 4, y);
+    Gameplay_PrintDigit(min / 10, 0, y);
+    Gameplay_PrintDigit(min % 10, 4, y);
 
     // Separator ":"
-    Gameplay_PrintDigit(map, 10, 8, y);
+    Gameplay_PrintDigit(10, 8, y);
 
     // Seconds
-    Gameplay_PrintDigit(map, sec / 10, 10, y);
-    Gameplay_PrintDigit(map, sec % 10, 14, y);
+    Gameplay_PrintDigit(sec / 10, 10, y);
+    Gameplay_PrintDigit(sec % 10, 14, y);
 
     // Separator "."
-    Gameplay_PrintDigit(map, 11, 18, y);
+    Gameplay_PrintDigit(11, 18, y);
 
     // Milliseconds (only first digit)
-    Gameplay_PrintDigit(map, msec / 100, 20, y);
+    Gameplay_PrintDigit(msec / 100, 20, y);
 }
 
 static void Gameplay_DisplayFinalTime(int min, int sec, int msec) {
 #ifndef console_on_debug
-    u16* map = BG_MAP_RAM_SUB(0);
-
     // Clear screen
-    memset(map, 32, 32 * 32 * 2);
+    Gameplay_ClearSubMap();
 
     // Display FINAL TIME at top (y = 8)
-    Gameplay_PrintTime(map, min, sec, msec, 8);
+    Gameplay_PrintTime(min, sec, msec, 8);
 
     // Display PERSONAL BEST below (y = 16)
     if (bestRaceMin >= 0) {
-        Gameplay_PrintTime(map, bestRaceMin, bestRaceSec, bestRaceMsec, 16);
+        Gameplay_PrintTime(bestRaceMin, bestRaceSec, bestRaceMsec, 16);
     }
 
     // Set background color based on whether it's a new record
@@ -611,14 +705,8 @@ static void Gameplay_DisplayFinalTime(int min, int sec, int msec) {
 //=============================================================================
 static void Gameplay_RenderCountdown(CountdownState state) {
 #ifndef console_on_debug
-    u16* map = BG_MAP_RAM_SUB(0);
-
     // Clear previous countdown display
-    for (int i = 16; i < 24; i++) {
-        for (int j = 12; j < 20; j++) {
-            map[i * 32 + j] = 32;  // Empty tile
-        }
-    }
+    Gameplay_ClearSubRect(12, 16, 8, 8);
 
     // Center position for large countdown numbers
     int centerX = 14;
@@ -626,16 +714,16 @@ static void Gameplay_RenderCountdown(CountdownState state) {
 
     switch (state) {
         case COUNTDOWN_3:
-            Gameplay_PrintDigit(map, 3, centerX, centerY);
+            Gameplay_PrintDigit(3, centerX, centerY);
             break;
         case COUNTDOWN_2:
-            Gameplay_PrintDigit(map, 2, centerX, centerY);
+            Gameplay_PrintDigit(2, centerX, centerY);
             break;
         case COUNTDOWN_1:
-            Gameplay_PrintDigit(map, 1, centerX, centerY);
+            Gameplay_PrintDigit(1, centerX, centerY);
             break;
         case COUNTDOWN_GO:
-            Gameplay_PrintDigit(map, 0, centerX, centerY);
+            Gameplay_PrintDigit(0, centerX, centerY);
             break;
         case COUNTDOWN_FINISHED:
             break;
@@ -645,13 +733,7 @@ static void Gameplay_RenderCountdown(CountdownState state) {
 
 static void Gameplay_ClearCountdownDisplay(void) {
 #ifndef console_on_debug
-    u16* map = BG_MAP_RAM_SUB(0);
-
-    for (int i = 16; i < 24; i++) {
-        for (int j = 12; j < 20; j++) {
-            map[i * 32 + j] = 32;
-        }
-    }
+    Gameplay_ClearSubRect(12, 16, 8, 8);
 #endif
 }
 
@@ -663,6 +745,10 @@ static void Gameplay_ConfigureGraphics(void) {
     VRAM_A_CR = VRAM_ENABLE | VRAM_A_MAIN_BG;
     VRAM_B_CR = VRAM_ENABLE | VRAM_B_MAIN_SPRITE;
 
+    // Semi-transparent sprites (the ghost) blend over the track
+    REG_BLDCNT = BLEND_ALPHA | BLEND_DST_BG0;
+    REG_BLDALPHA = GHOST_BLEND_EVA | (GHOST_BLEND_EVB << 8);
+
 #ifdef console_on_debug
     // Debug mode: Set up console on sub screen
     REG_DISPCNT_SUB = MODE_0_2D | DISPLAY_BG0_ACTIVE;
@@ -678,12 +764,18 @@ static void Gameplay_ConfigureGraphics(void) {
 
 static void Gameplay_ConfigureBackground(void) {
     Map selectedMap = GameContext_GetMap();
-    if (selectedMap != ScorchingSands)
+    if (!TrackMap_Load(selectedMap))
         return;
 
-    // Priority 3 (lowest) so all sprites appear above the background
+    // Priority 3 (lowest) so all sprites appear above the background.
+    // The 64x64 map is a wrapping window filled by bg_stream.
     BGCTRL[0] =
         BG_64x64 | BG_COLOR_256 | BG_MAP_BASE(0) | BG_TILE_BASE(1) | BG_PRIORITY(3);
+    if (!Residency_Claim(RES_MAIN_BG, RES_TAG_TRACK(selectedMap)))
+        TrackMap_UploadGraphics();
+    BgStream_Init(BG_MAP_RAM(0), TrackMap_GetWidthTiles(), TrackMap_GetHeightTiles(),
+                  TrackMap_GetMapEntry);
+    MemBudget_MarkVram(BG_MAP_RAM(0), BG_STREAM_SIZE_TILES * BG_STREAM_SIZE_TILES * 2);
 
 #ifdef console_on_debug
     // Debug mode: Set up console
@@ -691,42 +783,37 @@ static void Gameplay_ConfigureBackground(void) {
 #else
     // Normal mode: Sub screen setup with numbers tileset
     BGCTRL_SUB[0] = BG_32x32 | BG_COLOR_256 | BG_MAP_BASE(0) | BG_TILE_BASE(1);
-    swiCopy(numbersTiles, BG_TILE_RAM_SUB(1), numbersTilesLen);
+    decompress(numbersTiles, BG_TILE_RAM_SUB(1), LZ77Vram);
+    MemBudget_MarkVram(BG_TILE_RAM_SUB(1), Assets_Lz77Size(numbersTiles));
     swiCopy(numbersPal, BG_PALETTE_SUB, numbersPalLen);
     BG_PALETTE_SUB[0] = BLACK;
     BG_PALETTE_SUB[255] = DARK_GRAY;  // neutral sub background
-    memset(BG_MAP_RAM_SUB(0), 32, 32 * 32 * 2);
+    Gameplay_ClearSubMap();
     Gameplay_UpdateChronoDisplay(-1, -1, -1);
     Gameplay_LoadItemDisplay_Sub();
 #endif
 }
 
 static void Gameplay_ConfigureSprite(void) {
-    oamInit(&oamMain, SpriteMapping_1D_32, false);
-
-    dmaCopy(kart_spritePal, SPRITE_PALETTE, kart_spritePalLen);
-
-    if (kartGfx) {
-        oamFreeGfx(&oamMain, kartGfx);
-    }
+    // Sheets are DMA copies from RAM and are copied again either way; a
+    // resident bank only saves its clear
+    Residency_Claim(RES_MAIN_SPRITE, RES_TAG_RACE_SPRITES);
+    MemBudget_OamInit(&oamMain, SpriteMapping_1D_32, false);
+    SpriteBatch_Init(&oamMain);
 
-    kartGfx = oamAllocateGfx(&oamMain, SpriteSize_32x32, SpriteColorFormat_16Color);
-    dmaCopy(kart_spriteTiles, kartGfx, kart_spriteTilesLen);
+    dmaCopy(kart_sprite_rotPal, SPRITE_PALETTE, kart_sprite_rotPalLen);
+    MemBudget_ClaimPalette(MEM_POOL_PAL_MAIN, MEM_OWNER_KART, 0, 1);
 
-    const RaceState* state = Race_GetState();
-    // Set graphics for ALL cars
-    for (int i = 0; i < (state->carCount); i++) {
-        Race_SetCarGfx(i, kartGfx);
-    }
+    // The OAM reset above cleared the allocator, so any previous frames are gone
+    // All cars share these frames; the renderer picks one by angle
+    RotSprite_Load(&kartFrames, 32, ROT_SYMMETRY_HALF, SpriteSize_32x32,
+                   kart_sprite_rotTiles, kart_sprite_rotTilesLen, MEM_OWNER_KART);
 
     Items_LoadGraphics();
 }
 
 static void Gameplay_FreeSprites(void) {
-    if (kartGfx) {
-        oamFreeGfx(&oamMain, kartGfx);
-        kartGfx = NULL;
-    }
+    RotSprite_Free(&kartFrames);
     Items_FreeGraphics();
 }
 
@@ -746,12 +833,14 @@ static void Gameplay_ConfigureConsole(void) {
 //=============================================================================
 #ifndef console_on_debug
 static void Gameplay_LoadItemDisplay_Sub(void) {
+    Residency_Claim(RES_SUB_SPRITE, RES_TAG_RACE_ITEM_SUB);
+
     // Initialize sub screen OAM
-    oamInit(&oamSub, SpriteMapping_1D_32, false);
+    MemBudget_OamInit(&oamSub, SpriteMapping_1D_32, false);
 
     // CHANGED: Allocate for largest sprite size (32x32) to handle oil slick
-    itemDisplayGfx_Sub =
-        oamAllocateGfx(&oamSub, SpriteSize_32x32, SpriteColorFormat_16Color);
+    itemDisplayGfx_Sub = MemBudget_AllocGfx(&oamSub, SpriteSize_32x32,
+                                            SpriteColorFormat_16Color, MEM_OWNER_HUD);
 
     // Copy all item palettes to sub screen sprite palette
     dmaCopy(bananaPal, &SPRITE_PALETTE_SUB[32], bananaPalLen);
@@ -760,12 +849,14 @@ static void Gameplay_LoadItemDisplay_Sub(void) {
     dmaCopy(red_shellPal, &SPRITE_PALETTE_SUB[80], red_shellPalLen);
     dmaCopy(missilePal, &SPRITE_PALETTE_SUB[96], missilePalLen);
     dmaCopy(oil_slickPal, &SPRITE_PALETTE_SUB[112], oil_slickPalLen);
+    MemBudget_ClaimPalette(MEM_POOL_PAL_SUB, MEM_OWNER_HUD, 2, 6);
 
     // Initially hide the item sprite
     oamSet(&oamSub, 0, 0, 192, 0, 0, SpriteSize_32x32,  // CHANGED: to 32x32
            SpriteColorFormat_16Color, itemDisplayGfx_Sub, -1, true, false, false,
            false, false);
     oamUpdate(&oamSub);
+    shownItem = ITEM_NONE;
 }
 
 // Helper: Get item sprite properties for a given item type
@@ -822,13 +913,26 @@ static void Gameplay_GetItemSpriteInfo(Item item, const unsigned int** outTiles,
     }
 }
 
-static void Gameplay_UpdateItemDisplay_Sub(void) {
-    const Car* player = Race_GetPlayerCar();
+// Records the item display entry (sub OAM entry 0) for the next VBlank.
+// Returns false if the command list was full.
+static bool Gameplay_CommitItemDisplay_Sub(void) {
+    return RenderCmd_Copy(OAM_SUB, &oamSub.oamMemory[0], sizeof(SpriteEntry));
+}
+
+static void Gameplay_HideItemDisplay_Sub(void) {
+    oamSet(&oamSub, 0, 0, 192, 0, 0, SpriteSize_32x32, SpriteColorFormat_16Color,
+           itemDisplayGfx_Sub, -1, true, false, false, false, false);
+    if (Gameplay_CommitItemDisplay_Sub())
+        shownItem = ITEM_NONE;  // Otherwise the next frame tries again
+}
+
+static void Gameplay_UpdateItemDisplay_Sub(Item held) {
+    if (held == shownItem)
+        return;  // Entry and tiles already match
 
-    if (player->item == ITEM_NONE) {
+    if (held == ITEM_NONE) {
         // Hide sprite when no item
-        oamSet(&oamSub, 0, 0, 192, 0, 0, SpriteSize_32x32, SpriteColorFormat_16Color,
-               itemDisplayGfx_Sub, -1, true, false, false, false, false);
+        Gameplay_HideItemDisplay_Sub();
     } else {
         // Get item sprite properties
         const unsigned int* itemTiles = NULL;
@@ -836,177 +940,182 @@ static void Gameplay_UpdateItemDisplay_Sub(void) {
         SpriteSize spriteSize = SpriteSize_16x16;
         int itemX = 0;
 
-        Gameplay_GetItemSpriteInfo(player->item, &itemTiles, &paletteNum, &spriteSize,
-                                   &itemX);
+        Gameplay_GetItemSpriteInfo(held, &itemTiles, &paletteNum, &spriteSize, &itemX);
 
         if (itemTiles != NULL) {
             // Copy item graphics to sub screen sprite memory
-            int tilesLen = (player->item == ITEM_MISSILE) ? missileTilesLen
-                           : (player->item == ITEM_OIL)   ? oil_slickTilesLen
-                                                          : bananaTilesLen;
-            dmaCopy(itemTiles, itemDisplayGfx_Sub, tilesLen);
+            int tilesLen = (held == ITEM_MISSILE) ? missileTilesLen
+                           : (held == ITEM_OIL)   ? oil_slickTilesLen
+                                                  : bananaTilesLen;
+            bool copied =
+                RenderCmd_CopyConst(itemDisplayGfx_Sub, itemTiles, tilesLen);
 
             // Display sprite with appropriate size
             oamSet(&oamSub, 0, itemX, 8, 0, paletteNum, spriteSize,
                    SpriteColorFormat_16Color, itemDisplayGfx_Sub, -1, false, false,
                    false, false, false);
+
+            // Either recording can fail on a full command list; keep the old
+            // shownItem so the next frame records both again
+            if (!copied || !Gameplay_CommitItemDisplay_Sub())
+                return;
         }
+        shownItem = held;
     }
-
-    oamUpdate(&oamSub);
 }
 #endif
 
 //=============================================================================
-// PRIVATE HELPERS - Quadrant Management
+// PRIVATE HELPERS - HUD Glyphs
 //=============================================================================
-static void Gameplay_LoadQuadrant(QuadrantID quad) {
-    const QuadrantData* data = &quadrantData[quad];
-    // CHANGED: Clear the entire palette first to avoid color pollution
-    memset(BG_PALETTE, 0, 512);  // 256 colors × 2 bytes = 512 bytes
-    // CHANGED: Load tiles for this quadrant
-    dmaCopy(data->tiles, BG_TILE_RAM(1), data->tilesLen);
 
-    // CHANGED: Load palette for this quadrant
-    dmaCopy(data->palette, BG_PALETTE, data->paletteLen);
+// Glyph index for a PrintDigit number: 0-9, 10 = ':', 11 = '.', <0 = blank
+static int Gameplay_GlyphFor(int number) {
+    if (number < 0)
+        return GLYPH_BLANK;
+    return (number < GLYPH_BLANK) ? number : GLYPH_NONE;
+}
 
-    // Load the map data for this quadrant
-    for (int i = 0; i < 32; i++) {
-        dmaCopy(&data->map[i * 64], &BG_MAP_RAM(0)[i * 32], 64);
-        dmaCopy(&data->map[i * 64 + 32], &BG_MAP_RAM(1)[i * 32], 64);
-        dmaCopy(&data->map[(i + 32) * 64], &BG_MAP_RAM(2)[i * 32], 64);
-        dmaCopy(&data->map[(i + 32) * 64 + 32], &BG_MAP_RAM(3)[i * 32], 64);
-    }
+static int Gameplay_GlyphWidth(int glyph) {
+    return (glyph == GLYPH_COLON || glyph == GLYPH_DOT) ? 2 : GLYPH_COLS;
 }
 
-static QuadrantID Gameplay_DetermineQuadrant(int x, int y) {
-    int col = (x < QUAD_OFFSET) ? 0 : (x < 2 * QUAD_OFFSET) ? 1 : 2;
-    int row = (y < QUAD_OFFSET) ? 0 : (y < 2 * QUAD_OFFSET) ? 1 : 2;
-    return (QuadrantID)(row * QUADRANT_GRID_SIZE + col);
+static void Gameplay_BuildGlyphBlocks(void) {
+    for (int i = 0; i < GLYPH_ROWS; i++) {
+        for (int j = 0; j < GLYPH_COLS; j++) {
+            for (int n = 0; n < 10; n++)
+                glyphBlocks[n][i][j] = (u16)(i * 4 + j) + 32 * n;
+            glyphBlocks[GLYPH_COLON][i][j] = (u16)(i * 4 + j) + 32 * 10 + 2;
+            glyphBlocks[GLYPH_DOT][i][j] = (u16)(i * 4 + j) + 32 * 10;
+            glyphBlocks[GLYPH_BLANK][i][j] = 32;
+        }
+    }
+    glyphBlocksReady = true;
 }
 
 //=============================================================================
-// PUBLIC API - Sub-Screen Display
+// PRIVATE HELPERS - Sub-Screen Map
 //=============================================================================
-void Gameplay_PrintDigit(u16* map, int number, int x, int y) {
-    int i, j;
-    if (number < 10) {
-        for (i = 0; i < 8; i++)
-            for (j = 0; j < 4; j++)
-                map[(i + y) * 32 + j + x] =
-                    (number >= 0) ? (u16)(i * 4 + j) + 32 * number : 32;
+
+static void Gameplay_MarkSubRow(int y, int x, int w) {
+    if (x < subDirtyMin[y])
+        subDirtyMin[y] = (s8)x;
+    if (x + w - 1 > subDirtyMax[y])
+        subDirtyMax[y] = (s8)(x + w - 1);
+}
+
+static void Gameplay_ClearSubRect(int x, int y, int w, int h) {
+    for (int i = y; i < y + h; i++) {
+        for (int j = x; j < x + w; j++)
+            subMap[i * SUB_MAP_TILES + j] = SUB_MAP_BLANK;
+        Gameplay_MarkSubRow(i, x, w);
     }
-    if (number == 10) {
-        for (i = 0; i < 8; i++)
-            for (j = 0; j < 2; j++)
-                map[(i + y) * 32 + j + x] = (u16)(i * 4 + j) + 32 * 10 + 2;
+    Gameplay_InvalidateHud();
+}
+
+static void Gameplay_ClearSubMap(void) {
+    Gameplay_ClearSubRect(0, 0, SUB_MAP_TILES, SUB_MAP_TILES);
+}
+
+#ifndef console_on_debug
+// Records the changed span of every dirty row as one map patch
+static void Gameplay_FlushSubMap(void) {
+    u16* vram = BG_MAP_RAM_SUB(0);
+    for (int y = 0; y < SUB_MAP_TILES; y++) {
+        if (subDirtyMax[y] < subDirtyMin[y])
+            continue;
+        int offset = y * SUB_MAP_TILES + subDirtyMin[y];
+        u32 bytes = (subDirtyMax[y] - subDirtyMin[y] + 1) * sizeof(u16);
+        if (!RenderCmd_Copy(&vram[offset], &subMap[offset], bytes))
+            return;  // List full: remaining rows stay dirty for next frame
+        subDirtyMin[y] = SUB_MAP_TILES;
+        subDirtyMax[y] = -1;
     }
-    if (number == 11) {
-        for (i = 0; i < 8; i++)
-            for (j = 0; j < 2; j++)
-                map[(i + y) * 32 + j + x] = (u16)(i * 4 + j) + 32 * 10;
+}
+#endif
+
+// Copies a glyph row by row into the sub map copy (32-bit writes when the
+// column is even)
+static void Gameplay_BlitGlyph(int glyph, int x, int y) {
+    if (!glyphBlocksReady)
+        Gameplay_BuildGlyphBlocks();
+
+    int width = Gameplay_GlyphWidth(glyph);
+    for (int i = 0; i < GLYPH_ROWS; i++) {
+        const u16* src = glyphBlocks[glyph][i];
+        u16* dst = &subMap[(i + y) * SUB_MAP_TILES + x];
+        if ((x & 1) == 0) {
+            for (int j = 0; j < width; j += 2)
+                *(u32*)&dst[j] = *(const u32*)&src[j];
+        } else {
+            for (int j = 0; j < width; j++)
+                dst[j] = src[j];
+        }
+        Gameplay_MarkSubRow(i + y, x, width);
     }
 }
 
-static void Gameplay_UpdateChronoDisp(u16* map, int min, int sec, int msec) {
-    int x = 0, y = 0;
-    int number;
+static void Gameplay_InvalidateHud(void) {
+    memset(hudGlyphs, HUD_GLYPH_UNKNOWN, sizeof(hudGlyphs));
+}
 
-    // Minutes
-    number = min;
-    if (min > 59)
-        min = number = -1;
-    x = 0;
-    y = 8;
-    if (min >= 0)
-        number = min / 10;
-    Gameplay_PrintDigit(map, number, x, y);
-    x = 4;
-    y = 8;
-    if (min >= 0)
-        number = min % 10;
-    Gameplay_PrintDigit(map, number, x, y);
+// Draws a HUD slot only if its glyph differs from what is on screen
+static void Gameplay_PrintHudDigit(HudSlot slot, int number) {
+    int glyph = Gameplay_GlyphFor(number);
+    if (glyph == GLYPH_NONE || hudGlyphs[slot] == glyph)
+        return;
 
-    // Separator ":"
-    x = 8;
-    y = 8;
-    number = 10;
-    Gameplay_PrintDigit(map, number, x, y);
+    Gameplay_BlitGlyph(glyph, hudSlotPos[slot][0], hudSlotPos[slot][1]);
+    hudGlyphs[slot] = (s8)glyph;
+}
 
-    // Seconds
-    number = sec;
-    if (sec > 59)
-        sec = number = -1;
-    x = 10;
-    y = 8;
-    if (sec >= 0)
-        number = sec / 10;
-    Gameplay_PrintDigit(map, number, x, y);
-    x = 14;
-    y = 8;
-    if (sec >= 0)
-        number = sec % 10;
-    Gameplay_PrintDigit(map, number, x, y);
+//=============================================================================
+// PUBLIC API - Sub-Screen Display
+//=============================================================================
+void Gameplay_PrintDigit(int number, int x, int y) {
+    int glyph = Gameplay_GlyphFor(number);
+    if (glyph == GLYPH_NONE)
+        return;
 
-    // Separator "."
-    x = 18;
-    y = 8;
-    number = 11;
-    Gameplay_PrintDigit(map, number, x, y);
-
-    // Milliseconds
-    number = msec;
-    if (msec > 999)
-        msec = number = -1;
-    x = 20;
-    y = 8;
-    if (msec >= 0)
-        number = msec / 100;
-    Gameplay_PrintDigit(map, number, x, y);
-    x = 24;
-    y = 8;
-    if (msec >= 0)
-        number = (msec % 100) / 10;
-    Gameplay_PrintDigit(map, number, x, y);
-    x = 28;
-    y = 8;
-    if (msec >= 0)
-        number = (msec % 10) % 10;
-    Gameplay_PrintDigit(map, number, x, y);
+    Gameplay_BlitGlyph(glyph, x, y);
+    // Arbitrary position: HUD slots it overlapped must redraw next time
+    Gameplay_InvalidateHud();
 }
 
 void Gameplay_UpdateChronoDisplay(int min, int sec, int msec) {
-    Gameplay_UpdateChronoDisp(BG_MAP_RAM_SUB(0), min, sec, msec);
+    // Out-of-range fields render blank
+    if (min < 0 || min > 59)
+        min = -1;
+    if (sec < 0 || sec > 59)
+        sec = -1;
+    if (msec < 0 || msec > 999)
+        msec = -1;
+
+    Gameplay_PrintHudDigit(HUD_CHRONO_MIN_TENS, min >= 0 ? min / 10 : -1);
+    Gameplay_PrintHudDigit(HUD_CHRONO_MIN_UNITS, min >= 0 ? min % 10 : -1);
+    Gameplay_PrintHudDigit(HUD_CHRONO_COLON, GLYPH_COLON);
+    Gameplay_PrintHudDigit(HUD_CHRONO_SEC_TENS, sec >= 0 ? sec / 10 : -1);
+    Gameplay_PrintHudDigit(HUD_CHRONO_SEC_UNITS, sec >= 0 ? sec % 10 : -1);
+    Gameplay_PrintHudDigit(HUD_CHRONO_DOT, GLYPH_DOT);
+    Gameplay_PrintHudDigit(HUD_CHRONO_MSEC_HUNDREDS, msec >= 0 ? msec / 100 : -1);
+    Gameplay_PrintHudDigit(HUD_CHRONO_MSEC_TENS, msec >= 0 ? (msec % 100) / 10 : -1);
+    Gameplay_PrintHudDigit(HUD_CHRONO_MSEC_UNITS, msec >= 0 ? msec % 10 : -1);
 }
 
 void Gameplay_ChangeDisplayColor(uint16 c) {
-    BG_PALETTE_SUB[0] = c;
+    RenderCmd_Write16(&BG_PALETTE_SUB[0], c);
 }
 
 void Gameplay_UpdateLapDisplay(int currentLap, int totalLaps) {
-    int x, y;
-
-    // Current lap
-    x = 0;
-    y = 0;
-    if (currentLap >= 0 && currentLap <= 9) {
-        Gameplay_PrintDigit(BG_MAP_RAM_SUB(0), currentLap, x, y);
-    }
+    if (currentLap >= 0 && currentLap <= 9)
+        Gameplay_PrintHudDigit(HUD_LAP_CURRENT, currentLap);
 
-    // Separator ":"
-    x = 4;
-    y = 0;
-    Gameplay_PrintDigit(BG_MAP_RAM_SUB(0), 10, x, y);
+    Gameplay_PrintHudDigit(HUD_LAP_SEPARATOR, GLYPH_COLON);
 
-    // Total laps
-    x = 6;
-    y = 0;
     if (totalLaps >= 0 && totalLaps <= 9) {
-        Gameplay_PrintDigit(BG_MAP_RAM_SUB(0), totalLaps, x, y);
+        Gameplay_PrintHudDigit(HUD_LAP_TOTAL_TENS, totalLaps);
     } else if (totalLaps >= 10) {
-        Gameplay_PrintDigit(BG_MAP_RAM_SUB(0), totalLaps / 10, x, y);
-        x = 10;
-        y = 0;
-        Gameplay_PrintDigit(BG_MAP_RAM_SUB(0), totalLaps % 10, x, y);
+        Gameplay_PrintHudDigit(HUD_LAP_TOTAL_TENS, totalLaps / 10);
+        Gameplay_PrintHudDigit(HUD_LAP_TOTAL_UNITS, totalLaps % 10);
     }
 }
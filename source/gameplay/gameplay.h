@@ -2,7 +2,7 @@
  * File: gameplay.h
  * ----------------
  * Description: Main gameplay screen interface for racing. Handles graphics
- *              initialization, VBlank rendering updates, timer management,
+ *              initialization, per-frame rendering, timer management,
  *              and sub-screen display updates (lap counter, chrono, item
  *              display). Coordinates with gameplay_logic for race state.
  *
@@ -33,7 +33,7 @@
  * Initializes all graphics, sprites, and race state for gameplay screen.
  *
  * Sets up:
- *   - Main screen background (race track quadrants)
+ *   - Main screen background (streamed race track)
  *   - Sub screen display (timer, lap counter, item display)
  *   - Kart sprites and OAM
  *   - Race state via Race_Init()
@@ -46,11 +46,18 @@ void Gameplay_Initialize(void);
 /**
  * Function: Gameplay_Update
  * -------------------------
- * Updates gameplay logic and handles input (non-rendering updates).
+ * Updates gameplay logic, handles input and records the frame's screen
+ * changes as render commands (see render_cmd.h), then publishes them for the
+ * next VBlank.
  *
  * Handles:
  *   - SELECT key to exit to home
  *   - Best time saving when race finishes
+ *   - Countdown (3, 2, 1, GO!) and its network sync
+ *   - Camera scroll and track background edge streaming
+ *   - Kart sprites (single or multiplayer) and items on track
+ *   - Final time display (2.5 seconds after finish)
+ *   - Sub-screen updates (timer, lap, item)
  *   - Finish display timer countdown
  *   - State transitions (GAMEPLAY → PLAYAGAIN/HOME_PAGE)
  *
@@ -64,16 +71,10 @@ GameState Gameplay_Update(void);
 /**
  * Function: Gameplay_OnVBlank
  * ---------------------------
- * VBlank interrupt handler for all rendering updates (60 Hz).
- *
- * Renders:
- *   - Camera scroll (follows player kart)
- *   - Quadrant loading and switching
- *   - Countdown display (3, 2, 1, GO!)
- *   - Kart sprites (single or multiplayer)
- *   - Items on track
- *   - Final time display (2.5 seconds after finish)
- *   - Sub-screen updates (timer, lap, item)
+ * VBlank interrupt handler (60 Hz). Only replays the render commands the
+ * last Gameplay_Update() published (OAM, scroll registers, map patches,
+ * palette entries); it reads no race state. If the main loop did not finish a
+ * frame in time, nothing is written and the previous frame stays on screen.
  *
  * Called automatically by VBlank interrupt.
  */
@@ -96,35 +97,28 @@ void Gameplay_Cleanup(void);
 //=============================================================================
 
 /**
- * Gets current lap minutes (resets each lap).
- */
-int Gameplay_GetRaceMin(void);
-
-/**
- * Gets current lap seconds (0-59, resets each lap).
- */
-int Gameplay_GetRaceSec(void);
-
-/**
- * Gets current lap milliseconds (0-999, resets each lap).
+ * Gets the current lap time (resets each lap), read from the race chrono
+ * (RaceTick_GetElapsedMs) in one go so the fields are consistent.
+ *
+ * Parameters:
+ *   min  - Minutes
+ *   sec  - Seconds (0-59)
+ *   msec - Milliseconds (0-999)
  */
-int Gameplay_GetRaceMsec(void);
+void Gameplay_GetLapTime(int* min, int* sec, int* msec);
 
 /**
  * Gets current lap number (1-based).
  */
 int Gameplay_GetCurrentLap(void);
 
-/**
- * Increments race timers (both lap and total time).
- * Called by timer interrupt at 1000 Hz.
- */
-void Gameplay_IncrementTimer(void);
-
 //=============================================================================
 // PUBLIC API - Sub-Screen Display
 //=============================================================================
 
+// Sub-screen drawing goes to a RAM copy of the map; Gameplay_Update() records
+// the changed rows as render commands at the end of the frame.
+
 /**
  * Updates lap display on sub-screen (e.g., "3:5" for lap 3 of 5).
  */
@@ -141,9 +135,9 @@ void Gameplay_UpdateChronoDisplay(int min, int sec, int msec);
 void Gameplay_ChangeDisplayColor(uint16 c);
 
 /**
- * Renders a single digit (0-9) or separator (:, .) to tilemap.
- * Used internally by chrono/lap display functions.
+ * Renders a single digit (0-9), separator (10 = ':', 11 = '.') or blank
+ * (negative) at tile position (x, y) of the sub-screen map.
  */
-void Gameplay_PrintDigit(u16* map, int number, int x, int y);
+void Gameplay_PrintDigit(int number, int x, int y);
 
 #endif  // GAMEPLAY_H
\ No newline at end of file
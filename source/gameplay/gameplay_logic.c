@@ -17,7 +17,16 @@
 
 #include "items/items_api.h"
 #include "../core/game_constants.h"
+#include "../core/kmlog.h"
+#include "../core/profiler.h"
+#include "../core/scheduler.h"
+#include "../core/spsc_queue.h"
+#include "../core/tcm.h"
+#include "ghost.h"
 #include "../network/multiplayer.h"
+#include "replay.h"
+#include "sim_state.h"
+#include "telemetry.h"
 #include "terrain_detection.h"
 #include "../core/timer.h"
 #include "wall_collision.h"
@@ -31,14 +40,6 @@
     60  // Frames per countdown number (moved from COUNTDOWN_FRAMES_PER_STEP)
 #define COUNTDOWN_GO_DURATION 60  // Frames for "GO!" display
 
-typedef enum {
-    CP_STATE_START = 0,
-    CP_STATE_NEED_LEFT,
-    CP_STATE_NEED_DOWN,
-    CP_STATE_NEED_RIGHT,
-    CP_STATE_READY_FOR_LAP
-} CheckpointProgressState;
-
 static const int MapLaps[] = {
     [NONEMAP] = LAPS_NONE,
     [ScorchingSands] = LAPS_SCORCHING_SANDS,
@@ -49,40 +50,34 @@ static const int MapLaps[] = {
 //=============================================================================
 // Module State
 //=============================================================================
-static RaceState KartMania;
-static bool wasAboveFinishLine[MAX_CARS] = {false};
-static bool hasCompletedFirstCrossing[MAX_CARS] = {false};
-static CheckpointProgressState cpState[MAX_CARS] = {CP_STATE_START};
-static bool wasOnLeftSide[MAX_CARS] = {false};
-static bool wasOnTopSide[MAX_CARS] = {false};
-static bool itemButtonHeldLast = false;
-
-static int collisionLockoutTimer[MAX_CARS] = {0};
-static QuadrantID loadedQuadrant = QUAD_BR;
-static int networkUpdateCounter = 0;
-static bool isMultiplayerRace = false;
-// Countdown state
-static CountdownState countdownState = COUNTDOWN_3;
-static int countdownTimer = 0;
-static bool raceCanStart = false;
+// All race state is simState.race (sim_state.h); KartMania is its short name
+#define KartMania (simState.race)
+
+static SimState raceStart;  // State at the end of Race_Init(), for Race_Reset()
+static SchedTaskId netSyncTask = SCHED_NO_TASK;  // Car state exchange (polled per tick)
 
 //=============================================================================
 // Private Prototypes
 //=============================================================================
 static void initCarAtSpawn(Car* car, int index);
 static void handlePlayerInput(Car* player, int carIndex);
-static void clampToMapBounds(Car* car, int carIndex);
+static bool clampToMapBounds(Car* car, int carIndex);
 static QuadrantID determineCarQuadrant(int x, int y);
 static void checkCheckpointProgression(const Car* car, int carIndex);
 static bool checkFinishLineCross(const Car* car, int carIndex);
-static void applyTerrainEffects(Car* car);
+static bool applyTerrainEffects(Car* car);
 static void updateCountdown(void);
+static void completeLap(void);
+
+static inline bool isMultiplayerRace(void) {
+    return KartMania.gameMode == MultiPlayer;
+}
 
 //=============================================================================
 // Public API - State Queries
 //=============================================================================
 RaceState* Race_GetState(void) {
-    return &KartMania;
+    return &simState.race;
 }
 
 const Car* Race_GetPlayerCar(void) {
@@ -97,20 +92,12 @@ int Race_GetLapCount(void) {
     return KartMania.totalLaps;
 }
 
-bool Race_CheckFinishLineCross(const Car* car) {
-    // In multiplayer, use the actual player index instead of hardcoded 0
-    return checkFinishLineCross(car, KartMania.playerIndex);
+int Race_GetCurrentLap(void) {
+    return KartMania.currentLap;
 }
 
-void Race_SetLoadedQuadrant(QuadrantID quad) {
-    loadedQuadrant = quad;
-}
-
-void Race_SetCarGfx(int index, u16* gfx) {
-    if (index < 0 || index >= KartMania.carCount) {
-        return;
-    }
-    KartMania.cars[index].gfx = gfx;
+u32 Race_GetLapStartMs(void) {
+    return KartMania.lapStartMs;
 }
 
 bool Race_IsCompleted(void) {
@@ -125,15 +112,15 @@ void Race_GetFinalTime(int* min, int* sec, int* msec) {
 
 // Countdown getters
 CountdownState Race_GetCountdownState(void) {
-    return countdownState;
+    return KartMania.countdownState;
 }
 
 bool Race_IsCountdownActive(void) {
-    return countdownState != COUNTDOWN_FINISHED;
+    return KartMania.countdownState != COUNTDOWN_FINISHED;
 }
 
 bool Race_CanRaceStart(void) {
-    return raceCanStart;
+    return KartMania.raceCanStart;
 }
 
 void Race_UpdateCountdown(void) {
@@ -144,31 +131,21 @@ void Race_UpdateCountdown(void) {
 // Private Helpers - Race Initialization
 //=============================================================================
 
-// Helper: Initialize race state variables
+// Helper: Initialize race state variables (the block is zeroed by the caller)
 static void Race_InitState(Map map, GameMode mode) {
     KartMania.currentMap = map;
     KartMania.gameMode = mode;
     KartMania.raceStarted = true;
     KartMania.raceFinished = false;
-    itemButtonHeldLast = false;
+    KartMania.currentLap = 1;
 
-    // Initialize finish tracking
-    KartMania.finishDelayTimer = 0;
-    KartMania.finalTimeMin = 0;
-    KartMania.finalTimeSec = 0;
-    KartMania.finalTimeMsec = 0;
-
-    // Initialize countdown
-    countdownState = COUNTDOWN_3;
-    countdownTimer = 0;
-    raceCanStart = false;
-
-    isMultiplayerRace = (mode == MultiPlayer);
+    // Countdown starts at 3; finish times, lap tracking and item edge are 0
+    KartMania.countdownState = COUNTDOWN_3;
 }
 
 // Helper: Set lap count based on map and mode
 static void Race_ConfigureLaps(Map map) {
-    if (isMultiplayerRace && map == ScorchingSands) {
+    if (isMultiplayerRace() && map == ScorchingSands) {
         KartMania.totalLaps = 5;  // Multiplayer Scorching Sands: 5 laps
     } else {
         KartMania.totalLaps = MapLaps[map];  // Use map defaults
@@ -205,7 +182,6 @@ static void Race_InitMultiplayerCars(void) {
         } else {
             initCarAtSpawn(&KartMania.cars[i], -1);  // Off-map
         }
-        collisionLockoutTimer[i] = 0;
     }
 }
 
@@ -216,7 +192,6 @@ static void Race_InitSinglePlayerCars(void) {
 
     for (int i = 0; i < KartMania.carCount; i++) {
         initCarAtSpawn(&KartMania.cars[i], i);
-        collisionLockoutTimer[i] = 0;
     }
 }
 
@@ -226,14 +201,22 @@ static void Race_InitSinglePlayerCars(void) {
 void Race_Init(Map map, GameMode mode) {
     Race_InitPauseInterrupt();
 
+    // Low priority: under load the exchange rate drops (15Hz -> 7.5 -> 3.75)
+    if (netSyncTask == SCHED_NO_TASK)
+        netSyncTask = Scheduler_Register("net_sync", NULL, SCHED_PRIO_LOW,
+                                         SCHED_NET_SYNC_PERIOD, SCHED_BUDGET_NET_SYNC);
+
     if (map == NONEMAP || map > NeonCircuit) {
         return;
     }
 
+    // One zeroed block: every car's lap tracking, the countdown and the items
+    // start from 0 without a reset list to keep in sync
+    SimState_Clear();
     Race_InitState(map, mode);
     Race_ConfigureLaps(map);
 
-    if (isMultiplayerRace) {
+    if (isMultiplayerRace()) {
         Race_InitMultiplayerCars();
     } else {
         Race_InitSinglePlayerCars();
@@ -241,37 +224,19 @@ void Race_Init(Map map, GameMode mode) {
 
     KartMania.checkpointCount = 0;
     Items_Init(map);
+    LOG_INFO("race init map=%d mode=%d cars=%d laps=%d", map, mode, KartMania.carCount,
+             KartMania.totalLaps);
+
+    SimState_Save(&raceStart);
 }
 
 void Race_Reset(void) {
-    if (KartMania.currentMap == NONEMAP) {
+    if (raceStart.race.currentMap == NONEMAP) {
         return;
     }
 
     RaceTick_TimerStop();
-
-    // Reset items
-    Items_Reset();
-
-    KartMania.raceStarted = true;
-    KartMania.raceFinished = false;
-    itemButtonHeldLast = false;
-
-    // Reset finish tracking
-    KartMania.finishDelayTimer = 0;
-    KartMania.finalTimeMin = 0;
-    KartMania.finalTimeSec = 0;
-    KartMania.finalTimeMsec = 0;
-
-    // Reset countdown
-    countdownState = COUNTDOWN_3;
-    countdownTimer = 0;
-    raceCanStart = false;
-
-    for (int i = 0; i < KartMania.carCount; i++) {
-        initCarAtSpawn(&KartMania.cars[i], i);
-        collisionLockoutTimer[i] = 0;
-    }
+    SimState_Restore(&raceStart);
 }
 
 void Race_Stop(void) {
@@ -286,10 +251,9 @@ void Race_MarkAsCompleted(int min, int sec, int msec) {
     KartMania.finalTimeMin = min;
     KartMania.finalTimeSec = sec;
     KartMania.finalTimeMsec = msec;
-
-    // Stop race timer
-    irqDisable(IRQ_TIMER1);
-    irqClear(IRQ_TIMER1);
+    LOG_INFO("race finished %d:%02d.%03d", min, sec, msec);
+    // The chrono needs no stopping: the final time was read at the line and
+    // the tick keeps running for the finish delay
 }
 
 //=============================================================================
@@ -297,7 +261,8 @@ void Race_MarkAsCompleted(int min, int sec, int msec) {
 //=============================================================================
 
 // Helper: Calculate scroll position for camera (clamped to map bounds)
-static void Race_CalculateScroll(const Car* player, int* outScrollX, int* outScrollY) {
+static TCM_CODE void Race_CalculateScroll(const Car* player, int* outScrollX,
+                                          int* outScrollY) {
     int carCenterX = FixedToInt(player->position.x) + CAR_SPRITE_CENTER_OFFSET;
     int carCenterY = FixedToInt(player->position.y) + CAR_SPRITE_CENTER_OFFSET;
 
@@ -316,21 +281,30 @@ static void Race_CalculateScroll(const Car* player, int* outScrollX, int* outScr
 
 // Helper: Update network synchronization (multiplayer only)
 static void Race_UpdateNetworkSync(Car* player) {
-    if (!isMultiplayerRace)
+    if (!isMultiplayerRace())
         return;
 
-    networkUpdateCounter++;
-    if (networkUpdateCounter >= 4) {  // Every 4 frames = 15Hz
-        Multiplayer_SendCarState(player);
-        Multiplayer_ReceiveCarStates(KartMania.cars, KartMania.carCount);
-        networkUpdateCounter = 0;
+    // Every 4 ticks = 15Hz at nominal load (a replay repeats the recorded polls)
+    if (Replay_Poll(REPLAY_POLL_NET_SYNC, netSyncTask)) {
+        if (!Replay_IsPlaying())
+            Multiplayer_SendCarState(player);
+        Replay_ReceiveCarStates(KartMania.cars, KartMania.carCount);
+        Scheduler_Done(netSyncTask);
     }
 }
 
+// Helper: Apply the item world's hits and pickups, then the player's effects
+static TCM_CODE void Race_ApplyItemEvents(Car* player) {
+    PROF_BEGIN(PROF_ZONE_ITEM_EVENTS);
+    Items_ApplyEvents(KartMania.cars, KartMania.carCount);
+    Items_UpdatePlayerEffects(player, Items_GetPlayerEffects());
+    PROF_END(PROF_ZONE_ITEM_EVENTS);
+}
+
 //=============================================================================
 // Public API - Game Loop
 //=============================================================================
-void Race_Tick(void) {
+TCM_CODE void Race_Tick(void) {
     // If race is finished, only count down the delay timer
     if (KartMania.raceFinished) {
         if (KartMania.finishDelayTimer > 0) {
@@ -342,33 +316,69 @@ void Race_Tick(void) {
     if (!Race_IsActive())
         return;
 
+    // Keys, polls and network input come live or from the replay being played
+    if (!Replay_BeginTick())
+        return;  // Playback has not decoded this tick yet
+
+    simState.tick++;
+    KartMania.lapTicks++;
     Car* player = &KartMania.cars[KartMania.playerIndex];
 
     // Handle player input and environment
+    PROF_BEGIN(PROF_ZONE_INPUT);
     handlePlayerInput(player, KartMania.playerIndex);
-    applyTerrainEffects(player);
+    PROF_END(PROF_ZONE_INPUT);
+    PROF_BEGIN(PROF_ZONE_TERRAIN);
+    bool onSand = applyTerrainEffects(player);
+    PROF_END(PROF_ZONE_TERRAIN);
+    PROF_BEGIN(PROF_ZONE_ITEMS);
     Items_Update();
+    PROF_END(PROF_ZONE_ITEMS);
 
     // Calculate scroll position for collision checks
     int scrollX, scrollY;
     Race_CalculateScroll(player, &scrollX, &scrollY);
 
     // Item collision and effects
+    PROF_BEGIN(PROF_ZONE_COLLISIONS);
     Items_CheckCollisions(KartMania.cars, KartMania.carCount, scrollX, scrollY);
-    Items_UpdatePlayerEffects(player, Items_GetPlayerEffects());
+    PROF_END(PROF_ZONE_COLLISIONS);
+#ifndef ITEMS_ON_ARM7
+    Race_ApplyItemEvents(player);
+#endif
 
     // Update car physics and check boundaries/checkpoints
+    PROF_BEGIN(PROF_ZONE_CAR);
     Car_Update(player);
-    clampToMapBounds(player, KartMania.playerIndex);
+    bool hitWall = clampToMapBounds(player, KartMania.playerIndex);
     checkCheckpointProgression(player, KartMania.playerIndex);
+    if (checkFinishLineCross(player, KartMania.playerIndex))
+        completeLap();
+    PROF_END(PROF_ZONE_CAR);
+
+    // Time trial ghost: the pose after this tick's movement
+    if (!isMultiplayerRace() && !KartMania.raceFinished)
+        Ghost_RecordTick(player);
 
     // Decrement collision lockout timer
-    if (collisionLockoutTimer[KartMania.playerIndex] > 0) {
-        collisionLockoutTimer[KartMania.playerIndex]--;
+    CarProgress* progress = &KartMania.progress[KartMania.playerIndex];
+    if (progress->collisionLockoutTimer > 0) {
+        progress->collisionLockoutTimer--;
     }
 
+#ifdef ITEMS_ON_ARM7
+    // The ARM7 stepped the item world while the car moved; its hits and
+    // pickups land now, after this tick's movement
+    Race_ApplyItemEvents(player);
+#endif
+
     // Network synchronization for multiplayer
+    PROF_BEGIN(PROF_ZONE_NETWORK);
     Race_UpdateNetworkSync(player);
+    PROF_END(PROF_ZONE_NETWORK);
+
+    TELEMETRY_TICK(player, onSand, hitWall);  // make TELEMETRY=1
+    Replay_EndTick();
 }
 
 //=============================================================================
@@ -376,13 +386,12 @@ void Race_Tick(void) {
 //=============================================================================
 void Race_CountdownTick(void) {
     // Only run during countdown in multiplayer
-    if (!Race_IsCountdownActive() || !isMultiplayerRace) {
+    if (!Race_IsCountdownActive() || !isMultiplayerRace()) {
         return;
     }
 
     // Network sync only - share spawn positions
-    networkUpdateCounter++;
-    if (networkUpdateCounter >= 4) {  // Every 4 frames = 15Hz
+    if (Scheduler_Poll(netSyncTask)) {  // Every 4 frames = 15Hz at nominal load
         Car* player = &KartMania.cars[KartMania.playerIndex];
 
         // Send my car's spawn position
@@ -391,43 +400,44 @@ void Race_CountdownTick(void) {
         // Receive others' spawn positions
         Multiplayer_ReceiveCarStates(KartMania.cars, KartMania.carCount);
 
-        networkUpdateCounter = 0;
+        Scheduler_Done(netSyncTask);
     }
 }
 //=============================================================================
 // Countdown System
 //=============================================================================
 static void updateCountdown(void) {
-    countdownTimer++;
+    KartMania.countdownTimer++;
 
-    switch (countdownState) {
+    switch (KartMania.countdownState) {
         case COUNTDOWN_3:
-            if (countdownTimer >= COUNTDOWN_NUMBER_DURATION) {
-                countdownState = COUNTDOWN_2;
-                countdownTimer = 0;
+            if (KartMania.countdownTimer >= COUNTDOWN_NUMBER_DURATION) {
+                KartMania.countdownState = COUNTDOWN_2;
+                KartMania.countdownTimer = 0;
             }
             break;
 
         case COUNTDOWN_2:
-            if (countdownTimer >= COUNTDOWN_NUMBER_DURATION) {
-                countdownState = COUNTDOWN_1;
-                countdownTimer = 0;
+            if (KartMania.countdownTimer >= COUNTDOWN_NUMBER_DURATION) {
+                KartMania.countdownState = COUNTDOWN_1;
+                KartMania.countdownTimer = 0;
             }
             break;
 
         case COUNTDOWN_1:
-            if (countdownTimer >= COUNTDOWN_NUMBER_DURATION) {
-                countdownState = COUNTDOWN_GO;
-                countdownTimer = 0;
+            if (KartMania.countdownTimer >= COUNTDOWN_NUMBER_DURATION) {
+                KartMania.countdownState = COUNTDOWN_GO;
+                KartMania.countdownTimer = 0;
             }
             break;
 
         case COUNTDOWN_GO:
-            if (countdownTimer >= COUNTDOWN_GO_DURATION) {
-                countdownState = COUNTDOWN_FINISHED;
-                countdownTimer = 0;
-                raceCanStart = true;
-                // Start the race timer now
+            if (KartMania.countdownTimer >= COUNTDOWN_GO_DURATION) {
+                KartMania.countdownState = COUNTDOWN_FINISHED;
+                KartMania.countdownTimer = 0;
+                KartMania.raceCanStart = true;
+                // The replay starts from this state; start the race timer now
+                Replay_MarkStart();
                 RaceTick_TimerInit();
             }
             break;
@@ -441,35 +451,36 @@ static void updateCountdown(void) {
 //=============================================================================
 // Checkpoint System
 //=============================================================================
-static void checkCheckpointProgression(const Car* car, int carIndex) {
+static TCM_CODE void checkCheckpointProgression(const Car* car, int carIndex) {
     int carX = FixedToInt(car->position.x) + CAR_SPRITE_CENTER_OFFSET;
     int carY = FixedToInt(car->position.y) + CAR_SPRITE_CENTER_OFFSET;
 
     bool isOnLeftSide = (carX < CHECKPOINT_DIVIDE_X);
     bool isOnTopSide = (carY < CHECKPOINT_DIVIDE_Y);
+    CarProgress* progress = &KartMania.progress[carIndex];
 
-    switch (cpState[carIndex]) {
+    switch (progress->cpState) {
         case CP_STATE_START:
-            if (!wasOnTopSide[carIndex] && isOnTopSide) {
-                cpState[carIndex] = CP_STATE_NEED_LEFT;
+            if (!progress->wasOnTopSide && isOnTopSide) {
+                progress->cpState = CP_STATE_NEED_LEFT;
             }
             break;
 
         case CP_STATE_NEED_LEFT:
-            if (!wasOnLeftSide[carIndex] && isOnLeftSide) {
-                cpState[carIndex] = CP_STATE_NEED_DOWN;
+            if (!progress->wasOnLeftSide && isOnLeftSide) {
+                progress->cpState = CP_STATE_NEED_DOWN;
             }
             break;
 
         case CP_STATE_NEED_DOWN:
-            if (wasOnTopSide[carIndex] && !isOnTopSide) {
-                cpState[carIndex] = CP_STATE_NEED_RIGHT;
+            if (progress->wasOnTopSide && !isOnTopSide) {
+                progress->cpState = CP_STATE_NEED_RIGHT;
             }
             break;
 
         case CP_STATE_NEED_RIGHT:
-            if (wasOnLeftSide[carIndex] && !isOnLeftSide) {
-                cpState[carIndex] = CP_STATE_READY_FOR_LAP;
+            if (progress->wasOnLeftSide && !isOnLeftSide) {
+                progress->cpState = CP_STATE_READY_FOR_LAP;
             }
             break;
 
@@ -477,50 +488,74 @@ static void checkCheckpointProgression(const Car* car, int carIndex) {
             break;
     }
 
-    wasOnLeftSide[carIndex] = isOnLeftSide;
-    wasOnTopSide[carIndex] = isOnTopSide;
+    progress->wasOnLeftSide = isOnLeftSide;
+    progress->wasOnTopSide = isOnTopSide;
 }
 
 //=============================================================================
 // Finish Line Detection
 //=============================================================================
-static bool checkFinishLineCross(const Car* car, int carIndex) {
+static TCM_CODE bool checkFinishLineCross(const Car* car, int carIndex) {
     int carX = FixedToInt(car->position.x) + CAR_SPRITE_CENTER_OFFSET;
     int carY = FixedToInt(car->position.y) + CAR_SPRITE_CENTER_OFFSET;
 
     bool isWithinFinishLineX = (carX >= FINISH_LINE_X_MIN && carX <= FINISH_LINE_X_MAX);
     bool isNowAbove = (carY < FINISH_LINE_Y);
-    bool crossedLine = !wasAboveFinishLine[carIndex] && isNowAbove && isWithinFinishLineX;
-    wasAboveFinishLine[carIndex] = isNowAbove;
+    CarProgress* progress = &KartMania.progress[carIndex];
+    bool crossedLine = !progress->wasAboveFinishLine && isNowAbove && isWithinFinishLineX;
+    progress->wasAboveFinishLine = isNowAbove;
 
-    if (crossedLine && !hasCompletedFirstCrossing[carIndex]) {
-        hasCompletedFirstCrossing[carIndex] = true;
+    if (crossedLine && !progress->hasCompletedFirstCrossing) {
+        progress->hasCompletedFirstCrossing = true;
         return false;
     }
 
-    if (crossedLine && cpState[carIndex] == CP_STATE_READY_FOR_LAP) {
-        cpState[carIndex] = CP_STATE_START;
+    if (crossedLine && progress->cpState == CP_STATE_READY_FOR_LAP) {
+        progress->cpState = CP_STATE_START;
         return true;
     }
 
     return false;
 }
+
+// The local player crossed the line after a full lap: next lap or finish
+static void completeLap(void) {
+    u32 nowMs = Replay_NowMs();
+    if (!isMultiplayerRace())
+        Ghost_EndLap(nowMs - KartMania.lapStartMs);
+
+    if (KartMania.currentLap < KartMania.totalLaps) {
+        // Restart the LAP chrono (the total keeps running)
+        KartMania.currentLap++;
+        KartMania.lapStartMs = nowMs;
+        KartMania.lapTicks = 0;  // This tick's pose is the ghost's first sample
+        return;
+    }
+
+    u32 seconds = nowMs / MS_PER_SECOND;
+    Race_MarkAsCompleted((int)(seconds / SECONDS_PER_MINUTE),
+                         (int)(seconds % SECONDS_PER_MINUTE),
+                         (int)(nowMs % MS_PER_SECOND));
+}
+
 //=============================================================================
 // Terrain Applications
 //=============================================================================
-static void applyTerrainEffects(Car* car) {
+// Returns whether the car is on sand (the terrain class the telemetry logs)
+static TCM_CODE bool applyTerrainEffects(Car* car) {
     int carX = FixedToInt(car->position.x) + CAR_SPRITE_CENTER_OFFSET;
     int carY = FixedToInt(car->position.y) + CAR_SPRITE_CENTER_OFFSET;
 
-    if (Terrain_IsOnSand(carX, carY, loadedQuadrant)) {
+    if (Terrain_IsOnSand(carX, carY)) {
         car->friction = SAND_FRICTION;
         if (car->speed > SAND_MAX_SPEED) {
             Q16_8 excessSpeed = car->speed - SAND_MAX_SPEED;
             car->speed -= (excessSpeed / SAND_SPEED_DIVISOR);
         }
-    } else {
-        car->friction = FRICTION_50CC;
+        return true;
     }
+    car->friction = FRICTION_50CC;
+    return false;
 }
 
 //=============================================================================
@@ -560,21 +595,15 @@ static void initCarAtSpawn(Car* car, int spawnPosition) {
     car->maxSpeed = SPEED_50CC;
     car->accelRate = ACCEL_50CC;
     car->friction = FRICTION_50CC;
-    wasAboveFinishLine[spawnPosition] = false;
-    hasCompletedFirstCrossing[spawnPosition] = false;
-    cpState[spawnPosition] = CP_STATE_START;
-    wasOnLeftSide[spawnPosition] = false;
-    wasOnTopSide[spawnPosition] = false;
 }
 
-static void handlePlayerInput(Car* player, int carIndex) {
+static TCM_CODE void handlePlayerInput(Car* player, int carIndex) {
     // CRITICAL: Block all input if race is finished
     if (KartMania.raceFinished) {
         return;
     }
 
-    scanKeys();
-    uint32 held = keysHeld();
+    uint32 held = Replay_GetKeys();  // Sampled by Replay_BeginTick()
 
     bool pressingA = held & KEY_A;
     bool pressingB = held & KEY_B;
@@ -582,8 +611,8 @@ static void handlePlayerInput(Car* player, int carIndex) {
     bool pressingRight = held & KEY_RIGHT;
     bool pressingDown = held & KEY_DOWN;
     bool pressingL = held & KEY_L;
-    bool itemPressed = pressingL && !itemButtonHeldLast;
-    itemButtonHeldLast = pressingL;
+    bool itemPressed = pressingL && !KartMania.itemButtonHeldLast;
+    KartMania.itemButtonHeldLast = pressingL;
 
     // Item usage
     if (itemPressed) {
@@ -606,7 +635,7 @@ static void handlePlayerInput(Car* player, int carIndex) {
         }
     }
 
-    bool isLockedOut = (collisionLockoutTimer[carIndex] > 0);
+    bool isLockedOut = (KartMania.progress[carIndex].collisionLockoutTimer > 0);
 
     if (pressingA && !pressingB && !isLockedOut) {
         Car_Accelerate(player);
@@ -615,12 +644,14 @@ static void handlePlayerInput(Car* player, int carIndex) {
     }
 }
 
-static void clampToMapBounds(Car* car, int carIndex) {
+// Returns whether a wall pushed the car back
+static TCM_CODE bool clampToMapBounds(Car* car, int carIndex) {
     // Get the visual center of the car (where it actually appears on screen)
     int carX = FixedToInt(car->position.x) + CAR_SPRITE_CENTER_OFFSET;
     int carY = FixedToInt(car->position.y) + CAR_SPRITE_CENTER_OFFSET;
 
     QuadrantID quad = determineCarQuadrant(carX, carY);
+    bool hitWall = false;
 
     if (Wall_CheckCollision(carX, carY, CAR_RADIUS, quad)) {
         int nx, ny;
@@ -632,7 +663,8 @@ static void clampToMapBounds(Car* car, int carIndex) {
             car->position.y += IntToFixed(ny * pushDistance);
 
             car->speed = 0;
-            collisionLockoutTimer[carIndex] = COLLISION_LOCKOUT_FRAMES;
+            KartMania.progress[carIndex].collisionLockoutTimer = COLLISION_LOCKOUT_FRAMES;
+            hitWall = true;
         }
     }
 
@@ -649,9 +681,10 @@ static void clampToMapBounds(Car* car, int carIndex) {
         car->position.x = maxPosX;
     if (car->position.y > maxPosY)
         car->position.y = maxPosY;
+    return hitWall;
 }
 
-static QuadrantID determineCarQuadrant(int x, int y) {
+static TCM_CODE QuadrantID determineCarQuadrant(int x, int y) {
     int col = (x < QUAD_OFFSET) ? 0 : (x < 2 * QUAD_OFFSET) ? 1 : 2;
     int row = (y < QUAD_OFFSET) ? 0 : (y < 2 * QUAD_OFFSET) ? 1 : 2;
     return (QuadrantID)(row * QUADRANT_GRID_SIZE + col);
@@ -660,12 +693,20 @@ static QuadrantID determineCarQuadrant(int x, int y) {
 //=============================================================================
 // Pause System with Key Interrupt
 //=============================================================================
-static volatile bool isPaused = false;
-static volatile int debounceFrames = 0;
+// The key ISR only posts START presses; the main loop owns the pause state,
+// the debounce counter and the race timer (Race_UpdatePause)
+static u32 keyEventSlots[KEY_EVENT_QUEUE_SIZE];
+static SpscQueue keyEvents;
+static bool isPaused = false;
+static int debounceFrames = 0;
 
 // Note: DEBOUNCE_DELAY moved to game_constants.h
 
 void Race_InitPauseInterrupt(void) {
+    SpscQueue_Init(&keyEvents, keyEventSlots, KEY_EVENT_QUEUE_SIZE);
+    isPaused = false;
+    debounceFrames = 0;
+
     // BIT(14) = enable key interrupt
     REG_KEYCNT = BIT(14) | KEY_START;  // Enable interrupt for START key
     irqSet(IRQ_KEYS, Race_PauseISR);
@@ -673,32 +714,31 @@ void Race_InitPauseInterrupt(void) {
 }
 
 void Race_PauseISR(void) {
-    // Check if we're in debounce period
-    if (debounceFrames > 0) {
-        return;  // Ignore bounces
-    }
-
-    // Check if START is actually pressed (not released)
-    scanKeys();
-    if (!(keysHeld() & KEY_START)) {
-        return;  // Button was released, ignore
-    }
-
-    // Toggle pause state
-    isPaused = !isPaused;
-    debounceFrames = DEBOUNCE_DELAY;
-
-    if (isPaused) {
-        RaceTick_TimerPause();
-    } else {
-        RaceTick_TimerEnable();
-    }
+    // REG_KEYINPUT is active low; the interrupt also fires on bounces
+    u32 held = ~REG_KEYINPUT & KEY_START;
+    if (held)
+        SpscQueue_Push(&keyEvents, SPSC_EVENT(EVENT_KEY_DOWN, held));
 }
 
-void Race_UpdatePauseDebounce(void) {
+void Race_UpdatePause(void) {
     if (debounceFrames > 0) {
         debounceFrames--;
     }
+
+    u32 events[KEY_EVENT_QUEUE_SIZE];
+    int count = SpscQueue_PopBatch(&keyEvents, events, KEY_EVENT_QUEUE_SIZE);
+    for (int i = 0; i < count; i++) {
+        if (SPSC_EVENT_TYPE(events[i]) != EVENT_KEY_DOWN || debounceFrames > 0)
+            continue;  // Bounce (or repeat) of a press already handled
+
+        isPaused = !isPaused;
+        debounceFrames = DEBOUNCE_DELAY;
+        if (isPaused) {
+            RaceTick_TimerPause();
+        } else {
+            RaceTick_TimerEnable();
+        }
+    }
 }
 
 bool IsPaused(void) {
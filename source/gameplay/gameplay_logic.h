@@ -52,6 +52,29 @@ typedef enum {
     COUNTDOWN_FINISHED  // Race started, countdown done
 } CountdownState;
 
+/**
+ * Checkpoint progression of one car around the four map quadrants.
+ */
+typedef enum {
+    CP_STATE_START = 0,
+    CP_STATE_NEED_LEFT,
+    CP_STATE_NEED_DOWN,
+    CP_STATE_NEED_RIGHT,
+    CP_STATE_READY_FOR_LAP
+} CheckpointProgressState;
+
+/**
+ * Per-car lap tracking (previous-tick sides of the dividers and finish line).
+ */
+typedef struct {
+    bool wasAboveFinishLine;
+    bool hasCompletedFirstCrossing;  // The start grid is behind the line
+    bool wasOnLeftSide;
+    bool wasOnTopSide;
+    CheckpointProgressState cpState;
+    int collisionLockoutTimer;  // Ticks without acceleration after a wall hit
+} CarProgress;
+
 /**
  * Axis-aligned bounding box for checkpoint detection.
  */
@@ -62,6 +85,7 @@ typedef struct {
 
 /**
  * Complete race state including all cars, lap tracking, and finish status.
+ * Part of the race SimState (sim_state.h): plain values only, no pointers.
  */
 typedef struct {
     bool raceStarted;   // Race has been initialized
@@ -73,8 +97,17 @@ typedef struct {
     int carCount;        // Number of cars in race (1 for single, up to 8 for multi)
     int playerIndex;     // Index of local player (0 for single, varies for multi)
     Car cars[MAX_CARS];  // All car states
+    CarProgress progress[MAX_CARS];
 
-    int totalLaps;  // Laps required to complete race
+    CountdownState countdownState;
+    int countdownTimer;  // Frames into the current countdown step
+    bool raceCanStart;
+    bool itemButtonHeldLast;  // L held on the previous tick (edge detection)
+
+    int totalLaps;   // Laps required to complete race
+    int currentLap;  // Local player's lap (1-based)
+    u32 lapStartMs;  // Race chrono when the local player's lap started
+    u32 lapTicks;    // Ticks since the local player's lap started (ghost sample)
 
     int checkpointCount;  // Number of checkpoints (currently unused)
     CheckpointBox checkpoints[MAX_CHECKPOINTS];
@@ -119,6 +152,7 @@ void Race_Init(Map map, GameMode mode);
  *   - Wall collision
  *   - Checkpoint progression
  *   - Item collisions and effects
+ *   - Finish line crossing, lap counting and race completion
  *   - Multiplayer network sync (every 4 frames)
  */
 void Race_Tick(void);
@@ -126,13 +160,9 @@ void Race_Tick(void);
 /**
  * Function: Race_Reset
  * --------------------
- * Resets race to initial state (restart same race).
- *
- * Resets:
- *   - Car positions to spawn
- *   - Timer state
- *   - Countdown sequence
- *   - Items on track
+ * Resets race to initial state (restart same race): stops the tick and
+ * restores the SimState saved at the end of Race_Init() (cars on the grid,
+ * countdown, items, laps) in one copy.
  */
 void Race_Reset(void);
 
@@ -166,7 +196,7 @@ void Race_MarkAsCompleted(int min, int sec, int msec);
 
 /**
  * Updates countdown sequence (3 → 2 → 1 → GO → FINISHED).
- * Called by Gameplay_OnVBlank() during countdown phase.
+ * Called by Gameplay_Update() during countdown phase.
  */
 void Race_UpdateCountdown(void);
 
@@ -221,23 +251,14 @@ void Race_GetFinalTime(int* min, int* sec, int* msec);
 int Race_GetLapCount(void);
 
 /**
- * Checks if player car crossed finish line (called by Gameplay_OnVBlank()).
+ * Gets the local player's current lap (1-based).
  */
-bool Race_CheckFinishLineCross(const Car* car);
-
-//=============================================================================
-// PUBLIC API - Graphics Integration
-//=============================================================================
+int Race_GetCurrentLap(void);
 
 /**
- * Sets sprite graphics pointer for a specific car.
+ * Gets the race chrono (ms) when the local player's current lap started.
  */
-void Race_SetCarGfx(int index, u16* gfx);
-
-/**
- * Updates currently loaded track quadrant (for terrain detection).
- */
-void Race_SetLoadedQuadrant(QuadrantID quad);
+u32 Race_GetLapStartMs(void);
 
 //=============================================================================
 // PUBLIC API - Pause System
@@ -249,14 +270,22 @@ void Race_SetLoadedQuadrant(QuadrantID quad);
 void Race_InitPauseInterrupt(void);
 
 /**
- * ISR for pause toggle (START key pressed).
+ * ISR for the START key: posts the press to the main loop's key event queue.
  */
 void Race_PauseISR(void);
 
 /**
- * Updates pause debounce timer (prevents button bounce).
+ * Consumes the START presses posted by Race_PauseISR() and toggles pause
+ * (stopping or resuming the race tick), ignoring presses within
+ * DEBOUNCE_DELAY frames of the last toggle. Call once per frame from the
+ * main loop.
+ */
+void Race_UpdatePause(void);
+
+/**
+ * Whether the race is paused (the race tick is stopped).
  */
-void Race_UpdatePauseDebounce(void);
+bool IsPaused(void);
 
 /**
  * Cleans up pause interrupt when exiting race.
@@ -0,0 +1,255 @@
+/**
+ * File: ghost.c
+ * -------------
+ * Description: Implementation of ghost recording and playback. Recording
+ *              alternates between two lap buffers: the lap being recorded and
+ *              the fastest lap of the race so far. Playback keeps the ghost
+ *              file open and decodes from a GHOST_WINDOW_BYTES window refilled
+ *              with one fread when fewer than a sample's worth of bytes is
+ *              left (roughly every 240 ticks). The fastest lap is saved
+ *              through the io queue straight from its lap buffer, which is
+ *              not reused until the write has completed.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "ghost.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../core/game_constants.h"
+#include "../core/kmlog.h"
+#include "../storage/io_queue.h"
+#include "gameplay_logic.h"
+#include "ghost_codec.h"
+
+//=============================================================================
+// PRIVATE TYPES
+//=============================================================================
+typedef struct {
+    u32 magic;  // GHOST_MAGIC
+    u16 version;
+    u16 map;
+    u32 lapMs;
+    u32 samples;
+    u32 bytes;  // Coded samples following the header
+} GhostFileHeader;
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static Map ghostMap = NONEMAP;
+
+// Recording (race tick)
+static u8 lapBuffers[2][GHOST_LAP_BYTES];
+static volatile bool recording = false;
+static int recBuffer = 0;      // Buffer of the lap being recorded
+static u32 recBytes = 0;
+static u32 recSamples = 0;
+static bool recOverflow = false;
+static GhostCodec encoder;
+
+static int bestBuffer = -1;  // Fastest lap of this race (-1: none beat the file)
+static u32 bestBytes = 0;
+static u32 bestSamples = 0;
+static u32 bestLapMs = 0;
+
+// Saving (io queue, main loop)
+static GhostFileHeader saveHeader;  // Header of the file being written
+static IoRequestId saveRequest = IO_NO_REQUEST;
+
+// Playback (main loop)
+static FILE* stream = NULL;
+static GhostFileHeader saved;  // Header of the playing file (lapMs 0: none)
+static u8 window[GHOST_WINDOW_BYTES];
+static int windowStart = 0;
+static int windowEnd = 0;
+static u32 streamRemaining = 0;  // Coded bytes not read into the window yet
+static GhostCodec decoder;
+static u32 decoded = 0;          // Samples decoded since the lap started
+static GhostPose prevPose, curPose;
+
+//=============================================================================
+// PRIVATE HELPERS - Recording
+//=============================================================================
+
+static void Ghost_ResetLap(void) {
+    recBytes = 0;
+    recSamples = 0;
+    recOverflow = false;
+    GhostCodec_Reset(&encoder);
+}
+
+static void Ghost_SaveDone(bool ok) {
+    saveRequest = IO_NO_REQUEST;
+    if (ok)
+        LOG_INFO("ghost saved map=%d lap=%u ms, %u bytes", saveHeader.map,
+                 saveHeader.lapMs, saveHeader.bytes);
+    else
+        LOG_WARN("ghost save failed map=%d", saveHeader.map);
+}
+
+static void Ghost_Save(void) {
+    GhostFileHeader header = {GHOST_MAGIC, GHOST_VERSION, (u16)ghostMap, bestLapMs,
+                              bestSamples, bestBytes};
+    saveHeader = header;
+    char path[48];
+    snprintf(path, sizeof(path), GHOST_FILE_FORMAT, (int)ghostMap);
+
+    IoWrite write = {path, GHOST_TMP_FILE, 0,
+                     {{&saveHeader, sizeof(saveHeader)},
+                      {lapBuffers[bestBuffer], bestBytes}},
+                     Ghost_SaveDone};
+    saveRequest = IoQueue_Write(&write);
+    if (saveRequest == IO_NO_REQUEST)
+        LOG_WARN("ghost save failed map=%d", ghostMap);
+}
+
+//=============================================================================
+// PRIVATE HELPERS - Playback
+//=============================================================================
+
+static void Ghost_CloseStream(void) {
+    if (stream != NULL)
+        fclose(stream);
+    stream = NULL;
+}
+
+static void Ghost_Rewind(void) {
+    fseek(stream, sizeof(GhostFileHeader), SEEK_SET);
+    windowStart = 0;
+    windowEnd = 0;
+    streamRemaining = saved.bytes;
+    GhostCodec_Reset(&decoder);
+    decoded = 0;
+}
+
+static void Ghost_Refill(void) {
+    int unread = windowEnd - windowStart;
+    memmove(window, window + windowStart, unread);
+    windowStart = 0;
+    windowEnd = unread;
+
+    u32 room = GHOST_WINDOW_BYTES - unread;
+    u32 want = (streamRemaining < room) ? streamRemaining : room;
+    size_t got = fread(window + windowEnd, 1, want, stream);
+    windowEnd += (int)got;
+    streamRemaining -= (u32)got;
+    if (got < want)
+        streamRemaining = 0;  // Short file: play what there is
+}
+
+static bool Ghost_DecodeNext(void) {
+    if (windowEnd - windowStart < GHOST_MAX_SAMPLE_BYTES && streamRemaining > 0)
+        Ghost_Refill();
+
+    GhostPose pose;
+    int used =
+        GhostCodec_Decode(&decoder, window + windowStart, windowEnd - windowStart, &pose);
+    if (used == 0)
+        return false;
+    windowStart += used;
+
+    prevPose = (decoded == 0) ? pose : curPose;
+    curPose = pose;
+    decoded++;
+    return true;
+}
+
+static void Ghost_OpenStream(Map map) {
+    char path[48];
+    snprintf(path, sizeof(path), GHOST_FILE_FORMAT, (int)map);
+    memset(&saved, 0, sizeof(saved));
+
+    stream = fopen(path, "rb");
+    if (stream == NULL)
+        return;  // No ghost for this map yet
+
+    GhostFileHeader header;
+    if (fread(&header, sizeof(header), 1, stream) != 1 || header.magic != GHOST_MAGIC ||
+        header.version != GHOST_VERSION || header.map != (u16)map ||
+        header.samples == 0) {
+        Ghost_CloseStream();
+        return;
+    }
+    saved = header;
+    Ghost_Rewind();
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void Ghost_Init(Map map) {
+    recording = false;
+    Ghost_CloseStream();
+
+    // The last save still owns a lap buffer, and may be this map's file
+    IoQueue_Wait(saveRequest);
+
+    ghostMap = map;
+    Ghost_OpenStream(map);
+
+    recBuffer = 0;
+    bestBuffer = -1;
+    Ghost_ResetLap();
+    recording = true;
+    Ghost_RecordTick(Race_GetPlayerCar());  // Lap 1 starts from the grid
+}
+
+void Ghost_RecordTick(const Car* car) {
+    if (!recording || recOverflow)
+        return;
+    if (recBytes + GHOST_MAX_SAMPLE_BYTES > GHOST_LAP_BYTES) {
+        recOverflow = true;  // Lap too long to keep
+        return;
+    }
+
+    GhostPose pose = {car->position, car->angle512, car->speed};
+    recBytes += GhostCodec_Encode(&encoder, &pose, &lapBuffers[recBuffer][recBytes]);
+    recSamples++;
+}
+
+void Ghost_EndLap(u32 lapMs) {
+    if (!recording)
+        return;
+
+    u32 target = (bestBuffer >= 0) ? bestLapMs : saved.lapMs;
+    if (!recOverflow && recSamples > 0 && (target == 0 || lapMs < target)) {
+        bestBuffer = recBuffer;
+        bestBytes = recBytes;
+        bestSamples = recSamples;
+        bestLapMs = lapMs;
+        recBuffer ^= 1;
+    }
+    Ghost_ResetLap();
+}
+
+bool Ghost_GetPose(u32 lapTick, Q16_8 alpha, Vec2* position, int* angle512) {
+    if (stream == NULL || lapTick >= saved.samples)
+        return false;
+
+    if (decoded > 0 && lapTick + 1 < decoded)
+        Ghost_Rewind();  // A new lap started
+    while (decoded <= lapTick) {
+        if (!Ghost_DecodeNext()) {
+            Ghost_CloseStream();  // Damaged file: no ghost for the rest of the race
+            return false;
+        }
+    }
+
+    *position = Vec2_Lerp(prevPose.position, curPose.position, alpha);
+    *angle512 = Angle_Lerp(prevPose.angle512, curPose.angle512, alpha);
+    return true;
+}
+
+void Ghost_Cleanup(void) {
+    recording = false;
+    Ghost_CloseStream();
+    if (bestBuffer >= 0)
+        Ghost_Save();
+    bestBuffer = -1;
+}
@@ -0,0 +1,90 @@
+/**
+ * File: ghost.h
+ * -------------
+ * Description: Time trial ghost. The race tick records the local kart's pose
+ *              every tick into a RAM buffer (ghost_codec.h, about 2 bytes per
+ *              tick); the fastest lap of a race is written to the map's ghost
+ *              file when the race is left, if it beats the lap already saved.
+ *              Later races on that map stream the saved lap from the SD card
+ *              through a small window and draw it as a translucent kart,
+ *              restarted at every lap and interpolated between ticks like the
+ *              real karts.
+ *
+ * Ghost file (GHOST_FILE_FORMAT, next to the record file):
+ *   header  magic, version, map, lap time (ms), samples, data bytes
+ *   data    coded samples; sample n is the pose n ticks into the lap
+ *
+ * Usage (single player):
+ *   Gameplay_Initialize:  Race_Init(); Ghost_Init(map);
+ *   Race tick:            Ghost_EndLap() at the line, Ghost_RecordTick()
+ *   Main loop:            Ghost_GetPose(snap->lapTicks, alpha, ...)
+ *   Gameplay_Cleanup:     Ghost_Cleanup();
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef GHOST_H
+#define GHOST_H
+
+#include <nds.h>
+#include <stdbool.h>
+
+#include "../core/game_types.h"
+#include "../math/fixedmath.h"
+#include "Car.h"
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: Ghost_Init
+ * --------------------
+ * Opens the ghost file of `map` for playback (if there is a valid one),
+ * starts recording and records the spawn pose of the player as the first
+ * sample of lap 1. Call after Race_Init(), before the tick timer runs.
+ */
+void Ghost_Init(Map map);
+
+/**
+ * Function: Ghost_RecordTick
+ * --------------------------
+ * Appends the pose of `car` to the lap being recorded (race tick). A lap
+ * that outgrows GHOST_LAP_BYTES stops recording and is not kept.
+ */
+void Ghost_RecordTick(const Car* car);
+
+/**
+ * Function: Ghost_EndLap
+ * ----------------------
+ * Closes the lap being recorded (race tick, when the player crosses the
+ * line). It is kept if it is the fastest so far, saved or of this race.
+ *
+ * Parameters:
+ *   lapMs - Time of the lap
+ */
+void Ghost_EndLap(u32 lapMs);
+
+/**
+ * Function: Ghost_GetPose
+ * -----------------------
+ * Pose of the ghost `lapTick` ticks into its lap, blended from the previous
+ * tick by `alpha` (main loop). Decodes forward from the card as needed and
+ * rewinds when a new lap starts.
+ *
+ * Returns: false if there is no ghost, or its lap is already over
+ */
+bool Ghost_GetPose(u32 lapTick, Q16_8 alpha, Vec2* position, int* angle512);
+
+/**
+ * Function: Ghost_Cleanup
+ * -----------------------
+ * Stops recording, closes the playback file and queues a write of the
+ * fastest lap of the race to the ghost file if it beat the saved one. The
+ * next Ghost_Init() waits for that write.
+ */
+void Ghost_Cleanup(void);
+
+#endif  // GHOST_H
@@ -0,0 +1,168 @@
+/**
+ * File: ghost_codec.c
+ * -------------------
+ * Description: Implementation of the ghost pose coder: quantization, zigzag
+ *              varints and the 4-bit change fields.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "ghost_codec.h"
+
+#include <string.h>
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define NIBBLE_BIAS 7
+#define NIBBLE_ESCAPE 15
+#define FIELD_COUNT 4
+
+//=============================================================================
+// PRIVATE HELPERS
+//=============================================================================
+
+static inline u32 GhostCodec_ZigZag(s32 value) {
+    return ((u32)value << 1) ^ (u32)(value >> 31);
+}
+
+static inline s32 GhostCodec_UnZigZag(u32 value) {
+    return (s32)(value >> 1) ^ -(s32)(value & 1);
+}
+
+static int GhostCodec_PutVarint(u8* out, s32 value) {
+    u32 v = GhostCodec_ZigZag(value);
+    int n = 0;
+    while (v >= 0x80) {
+        out[n++] = (u8)(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (u8)v;
+    return n;
+}
+
+// Returns bytes read, 0 if the varint runs past `avail`
+static int GhostCodec_GetVarint(const u8* in, int avail, s32* value) {
+    u32 v = 0;
+    for (int n = 0; n < avail && n < 5; n++) {
+        v |= (u32)(in[n] & 0x7F) << (7 * n);
+        if (!(in[n] & 0x80)) {
+            *value = GhostCodec_UnZigZag(v);
+            return n + 1;
+        }
+    }
+    return 0;
+}
+
+static inline u8 GhostCodec_Nibble(s32 value) {
+    return (value >= -NIBBLE_BIAS && value <= NIBBLE_BIAS) ? (u8)(value + NIBBLE_BIAS)
+                                                           : NIBBLE_ESCAPE;
+}
+
+static inline s32 GhostCodec_WrapAngle(s32 delta) {
+    return ((delta + ANGLE_HALF) & ANGLE_MASK) - ANGLE_HALF;
+}
+
+static void GhostCodec_ToPose(const GhostCodec* codec, GhostPose* pose) {
+    pose->position.x = codec->x * (1 << GHOST_POS_SHIFT);
+    pose->position.y = codec->y * (1 << GHOST_POS_SHIFT);
+    pose->angle512 = codec->angle;
+    pose->speed = codec->speed * (1 << GHOST_POS_SHIFT);
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void GhostCodec_Reset(GhostCodec* codec) {
+    memset(codec, 0, sizeof(*codec));
+}
+
+int GhostCodec_Encode(GhostCodec* codec, const GhostPose* pose, u8* out) {
+    s32 x = pose->position.x >> GHOST_POS_SHIFT;
+    s32 y = pose->position.y >> GHOST_POS_SHIFT;
+    s32 angle = pose->angle512 & ANGLE_MASK;
+    s32 speed = pose->speed >> GHOST_POS_SHIFT;
+    int n = 0;
+
+    if (codec->count == 0) {
+        n += GhostCodec_PutVarint(out + n, x);
+        n += GhostCodec_PutVarint(out + n, y);
+        n += GhostCodec_PutVarint(out + n, angle);
+        n += GhostCodec_PutVarint(out + n, speed);
+        codec->vx = 0;
+        codec->vy = 0;
+    } else {
+        s32 vx = x - codec->x;
+        s32 vy = y - codec->y;
+        s32 fields[FIELD_COUNT] = {vx - codec->vx, vy - codec->vy,
+                                   GhostCodec_WrapAngle(angle - codec->angle),
+                                   speed - codec->speed};
+        u8 nibbles[FIELD_COUNT];
+        for (int i = 0; i < FIELD_COUNT; i++)
+            nibbles[i] = GhostCodec_Nibble(fields[i]);
+
+        out[n++] = (u8)(nibbles[0] | (nibbles[1] << 4));
+        out[n++] = (u8)(nibbles[2] | (nibbles[3] << 4));
+        for (int i = 0; i < FIELD_COUNT; i++) {
+            if (nibbles[i] == NIBBLE_ESCAPE)
+                n += GhostCodec_PutVarint(out + n, fields[i]);
+        }
+        codec->vx = vx;
+        codec->vy = vy;
+    }
+
+    codec->x = x;
+    codec->y = y;
+    codec->angle = angle;
+    codec->speed = speed;
+    codec->count++;
+    return n;
+}
+
+int GhostCodec_Decode(GhostCodec* codec, const u8* in, int avail, GhostPose* pose) {
+    s32 fields[FIELD_COUNT];
+    int n = 0;
+
+    if (codec->count == 0) {
+        for (int i = 0; i < FIELD_COUNT; i++) {
+            int used = GhostCodec_GetVarint(in + n, avail - n, &fields[i]);
+            if (used == 0)
+                return 0;
+            n += used;
+        }
+        codec->x = fields[0];
+        codec->y = fields[1];
+        codec->vx = 0;
+        codec->vy = 0;
+        codec->angle = fields[2] & ANGLE_MASK;
+        codec->speed = fields[3];
+    } else {
+        if (avail < 2)
+            return 0;
+        u8 nibbles[FIELD_COUNT] = {in[0] & 0xF, in[0] >> 4, in[1] & 0xF, in[1] >> 4};
+        n = 2;
+        for (int i = 0; i < FIELD_COUNT; i++) {
+            if (nibbles[i] != NIBBLE_ESCAPE) {
+                fields[i] = (s32)nibbles[i] - NIBBLE_BIAS;
+                continue;
+            }
+            int used = GhostCodec_GetVarint(in + n, avail - n, &fields[i]);
+            if (used == 0)
+                return 0;
+            n += used;
+        }
+        codec->vx += fields[0];
+        codec->vy += fields[1];
+        codec->x += codec->vx;
+        codec->y += codec->vy;
+        codec->angle = (codec->angle + fields[2]) & ANGLE_MASK;
+        codec->speed += fields[3];
+    }
+
+    codec->count++;
+    GhostCodec_ToPose(codec, pose);
+    return n;
+}
@@ -0,0 +1,106 @@
+/**
+ * File: ghost_codec.h
+ * -------------------
+ * Description: Incremental delta + varint coding of kart poses (position,
+ *              angle, speed), one sample per race tick. Encoding a sample is
+ *              a few subtractions and two or three byte stores, so the race
+ *              tick can record the player every tick; decoding needs only
+ *              the bytes of the next sample, so a ghost streams from the SD
+ *              card through a small window.
+ *
+ * Sample encoding (positions and speed quantized to 1 / 2^GHOST_POS_SHIFT
+ * pixel; the angle is the binary angle):
+ *   First sample after a reset - zigzag varints of x, y, angle, speed
+ *   Other samples - two bytes of 4-bit fields, each the value + 7:
+ *     byte 0: x step change (low), y step change (high)
+ *     byte 1: angle change (low), speed change (high)
+ *   A field outside [-7, 7] is written as 15 and its value follows as a
+ *   zigzag varint, in field order.
+ *
+ * Coding the change of the position step (not the step) keeps straight and
+ * steadily curving driving at two bytes per tick.
+ *
+ * Builds on the host (no libnds) for tools and benchmarks.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef GHOST_CODEC_H
+#define GHOST_CODEC_H
+
+#ifdef ARM9
+#include <nds.h>
+#else
+#include <stdint.h>
+typedef uint8_t u8;
+typedef int32_t s32;
+typedef uint32_t u32;
+#endif
+
+#include "../math/fixedmath.h"
+
+//=============================================================================
+// PUBLIC CONSTANTS
+//=============================================================================
+
+#define GHOST_POS_SHIFT 4          // Q16.8 -> 1/16 pixel
+#define GHOST_MAX_SAMPLE_BYTES 22  // Two nibble bytes + four 5-byte varints
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+typedef struct {
+    Vec2 position;  // Q16.8 (quantized to 1 / 2^GHOST_POS_SHIFT pixel)
+    int angle512;
+    Q16_8 speed;    // Quantized like the position
+} GhostPose;
+
+/**
+ * Coder state: the last sample. An encoder and a decoder fed the same
+ * stream from a reset hold the same state.
+ */
+typedef struct {
+    s32 x, y;    // Quantized position
+    s32 vx, vy;  // Last position step
+    s32 angle;
+    s32 speed;
+    u32 count;   // Samples since the reset
+} GhostCodec;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: GhostCodec_Reset
+ * --------------------------
+ * Starts a new stream; the next sample is written in full.
+ */
+void GhostCodec_Reset(GhostCodec* codec);
+
+/**
+ * Function: GhostCodec_Encode
+ * ---------------------------
+ * Appends one sample.
+ *
+ * Parameters:
+ *   out - Room for GHOST_MAX_SAMPLE_BYTES bytes
+ *
+ * Returns: Bytes written
+ */
+int GhostCodec_Encode(GhostCodec* codec, const GhostPose* pose, u8* out);
+
+/**
+ * Function: GhostCodec_Decode
+ * ---------------------------
+ * Reads one sample from `avail` bytes at `in`. The state only changes when
+ * the whole sample was available.
+ *
+ * Returns: Bytes consumed, or 0 if `avail` ends inside the sample
+ */
+int GhostCodec_Decode(GhostCodec* codec, const u8* in, int avail, GhostPose* pose);
+
+#endif  // GHOST_CODEC_H
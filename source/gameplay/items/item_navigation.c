@@ -13,6 +13,7 @@
 #include "item_navigation.h"
 #include <stdlib.h>
 #include "../../core/game_constants.h"
+#include "../../core/tcm.h"
 
 //=============================================================================
 // Constants
@@ -167,7 +168,7 @@ static const int scorchingSands_waypointCount = 119;
 //=============================================================================
 // Internal Helpers
 //=============================================================================
-static const Waypoint* getWaypointsForMap(Map map, int* count) {
+static TCM_CODE const Waypoint* getWaypointsForMap(Map map, int* count) {
     switch (map) {
         case ScorchingSands:
             *count = scorchingSands_waypointCount;
@@ -208,7 +209,7 @@ int ItemNav_FindNearestWaypoint(const Vec2* position, Map map) {
     return nearestIndex;
 }
 
-Vec2 ItemNav_GetWaypointPosition(int waypointIndex, Map map) {
+TCM_CODE Vec2 ItemNav_GetWaypointPosition(int waypointIndex, Map map) {
     int count;
     const Waypoint* waypoints = getWaypointsForMap(map, &count);
 
@@ -219,7 +220,7 @@ Vec2 ItemNav_GetWaypointPosition(int waypointIndex, Map map) {
     return waypoints[waypointIndex].pos;
 }
 
-int ItemNav_GetNextWaypoint(int currentWaypoint, Map map) {
+TCM_CODE int ItemNav_GetNextWaypoint(int currentWaypoint, Map map) {
     int count;
     const Waypoint* waypoints = getWaypointsForMap(map, &count);
 
@@ -230,7 +231,7 @@ int ItemNav_GetNextWaypoint(int currentWaypoint, Map map) {
     return waypoints[currentWaypoint].next;
 }
 
-bool ItemNav_IsWaypointReached(const Vec2* itemPos, const Vec2* waypointPos) {
+TCM_CODE bool ItemNav_IsWaypointReached(const Vec2* itemPos, const Vec2* waypointPos) {
     Q16_8 dist = Vec2_Distance(itemPos, waypointPos);
     return (dist <= WAYPOINT_REACHED_DIST);
 }
@@ -31,6 +31,35 @@
 
 // Forward declaration to avoid circular include with Car.h
 typedef struct Car Car;
+typedef struct RaceSnapshot RaceSnapshot;  // race_snapshot.h
+
+//=============================================================================
+// Simulation State
+//=============================================================================
+
+// With ITEMS_ON_ARM7 the ARM7 writes activeItems to itemBoxCount in main RAM
+// while the ARM9 keeps writing around them: each side gets whole ARM9 cache
+// lines, so flushing and invalidating the world never touches the other's
+#ifdef ITEMS_ON_ARM7
+#define ITEMS_CACHE_ALIGN __attribute__((aligned(32)))
+#else
+#define ITEMS_CACHE_ALIGN
+#endif
+
+/**
+ * Struct: ItemsState
+ * ------------------
+ * Everything the items system simulates. Lives in the race SimState
+ * (sim_state.h) so it is saved and restored with the cars; holds no pointers.
+ * The item world (items_world.h) steps activeItems, itemBoxSpawns and
+ * itemBoxCount; playerEffects belongs to the car side.
+ */
+typedef struct {
+    TrackItem activeItems[MAX_TRACK_ITEMS] ITEMS_CACHE_ALIGN;
+    ItemBoxSpawn itemBoxSpawns[MAX_ITEM_BOX_SPAWNS];
+    int itemBoxCount;
+    PlayerItemEffects playerEffects ITEMS_CACHE_ALIGN;
+} ItemsState;
 
 //=============================================================================
 // Lifecycle Management
@@ -67,8 +96,9 @@ void Items_Update(void);
 /**
  * Function: Items_CheckCollisions
  * --------------------------------
- * Checks for collisions between items and cars. Processes item box pickups,
- * projectile hits, and hazard interactions.
+ * Checks for collisions between items and cars. Despawns the items that hit,
+ * deactivates picked-up boxes and posts each hit and pickup on the item link;
+ * the cars themselves are only changed by Items_ApplyEvents().
  *
  * Parameters:
  *   cars    - Array of cars to check collisions against
@@ -76,7 +106,21 @@ void Items_Update(void);
  *   scrollX - Horizontal scroll offset for culling
  *   scrollY - Vertical scroll offset for culling
  */
-void Items_CheckCollisions(Car* cars, int carCount, int scrollX, int scrollY);
+void Items_CheckCollisions(const Car* cars, int carCount, int scrollX, int scrollY);
+
+/**
+ * Function: Items_ApplyEvents
+ * ---------------------------
+ * Applies the hits and item box pickups posted by Items_Update() and
+ * Items_CheckCollisions() this tick (spins, stops, knockback, oil slow, item
+ * rolls, pickup sound and broadcast), in the order they were detected. With
+ * ITEMS_ON_ARM7 it first waits for the ARM7 to finish the step.
+ *
+ * Parameters:
+ *   cars     - Array of cars the events refer to
+ *   carCount - Number of cars in the array
+ */
+void Items_ApplyEvents(Car* cars, int carCount);
 
 //=============================================================================
 // Item Spawning
@@ -200,13 +244,15 @@ void Items_ApplyOilSlow(Car* player, PlayerItemEffects* effects);
 /**
  * Function: Items_Render
  * -----------------------
- * Renders all visible items (boxes and track items) to the screen.
+ * Renders the boxes and track items of a race snapshot to the screen.
  *
  * Parameters:
+ *   snap    - Snapshot published by the last physics tick
+ *   alpha   - Blend from the previous to the snapshot tick (FIXED_ONE = snap)
  *   scrollX - Horizontal scroll offset for camera
  *   scrollY - Vertical scroll offset for camera
  */
-void Items_Render(int scrollX, int scrollY);
+void Items_Render(const RaceSnapshot* snap, Q16_8 alpha, int scrollX, int scrollY);
 
 /**
  * Function: Items_LoadGraphics
@@ -20,13 +20,11 @@
 #include "items_types.h"
 
 //=============================================================================
-// Pool Sizes and OAM Allocation
+// Pool Sizes (OAM entries are assigned per frame by sprite_batch.c)
 //=============================================================================
 #define MAX_TRACK_ITEMS 32
 #define MAX_ITEM_BOX_SPAWNS 8
-
-#define ITEM_BOX_OAM_START 1
-#define TRACK_ITEM_OAM_START 9
+#define ITEM_LINK_CAPACITY 64  // Item world -> car messages per tick (power of two)
 
 //=============================================================================
 // Durations
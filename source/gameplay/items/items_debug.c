@@ -17,16 +17,16 @@
 //=============================================================================
 
 const ItemBoxSpawn* Items_GetBoxSpawns(int* count) {
-    *count = itemBoxCount;
-    return itemBoxSpawns;
+    *count = simState.items.itemBoxCount;
+    return simState.items.itemBoxSpawns;
 }
 
 const TrackItem* Items_GetActiveItems(int* count) {
     int activeCount = 0;
     for (int i = 0; i < MAX_TRACK_ITEMS; i++) {
-        if (activeItems[i].active)
+        if (simState.items.activeItems[i].active)
             activeCount++;
     }
     *count = activeCount;
-    return activeItems;
+    return simState.items.activeItems;
 }
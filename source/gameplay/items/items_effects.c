@@ -15,12 +15,13 @@
 
 #include "../Car.h"
 #include "../../core/game_constants.h"
+#include "../../core/tcm.h"
 
 //=============================================================================
 // Player Effects
 //=============================================================================
 
-void Items_UpdatePlayerEffects(Car* player, PlayerItemEffects* effects) {
+TCM_CODE void Items_UpdatePlayerEffects(Car* player, PlayerItemEffects* effects) {
     // Update confusion timer
     if (effects->confusionActive) {
         effects->confusionTimer--;
@@ -55,7 +56,7 @@ void Items_UpdatePlayerEffects(Car* player, PlayerItemEffects* effects) {
 }
 
 PlayerItemEffects* Items_GetPlayerEffects(void) {
-    return &playerEffects;
+    return &simState.items.playerEffects;
 }
 
 void Items_ApplyConfusion(PlayerItemEffects* effects) {
@@ -0,0 +1,167 @@
+/**
+ * File: items_events.c
+ * --------------------
+ * Description: Car side of the item link. Applies the hits and item box
+ *              pickups the item world posted during the tick: spins, stops
+ *              and knockbacks, the local player's oil slow, item rolls, the
+ *              pickup sound and the multiplayer pickup broadcast.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "items_internal.h"
+#include "items_api.h"
+#include "items_link.h"
+
+#include "../Car.h"
+#include "../gameplay_logic.h"
+#include "../../core/game_constants.h"
+#include "../../core/tcm.h"
+#include "../../audio/sound.h"
+#include "../../network/multiplayer.h"
+#include "../replay.h"
+#include "../telemetry.h"
+
+//=============================================================================
+// Private Constants
+//=============================================================================
+#define EVENT_BATCH 16
+
+//=============================================================================
+// Internal Helper Prototypes
+//=============================================================================
+static void applyHit(Car* car, int carIndex, Item type, const ItemMsg* msg);
+static void applyShellHitEffect(Car* car);
+static void applyBananaHitEffect(Car* car);
+static void applyOilHitEffect(Car* car, int carIndex);
+static void applyBombHitEffect(Car* car, const ItemMsg* msg);
+static void handleItemBoxPickup(Car* car, int carIndex, int boxIndex);
+
+//=============================================================================
+// Public API
+//=============================================================================
+
+TCM_CODE void Items_ApplyEvents(Car* cars, int carCount) {
+    ItemMsg batch[EVENT_BATCH];
+    int count;
+
+#ifdef ITEMS_ON_ARM7
+    ItemLink_WaitStep();  // Everything the ARM7 posted is in the link after this
+#endif
+
+    while ((count = ItemLink_Receive(batch, EVENT_BATCH)) > 0) {
+        for (int i = 0; i < count; i++) {
+            const ItemMsg* msg = &batch[i];
+            if (msg->car >= carCount)
+                continue;
+
+            Car* car = &cars[msg->car];
+            TELEMETRY_ITEM_EVENT(msg->type);
+            switch (msg->type) {
+                case ITEM_MSG_HIT:
+                    applyHit(car, msg->car, (Item)msg->item, msg);
+                    break;
+
+                case ITEM_MSG_BOX_PICKUP:
+                    handleItemBoxPickup(car, msg->car, msg->index);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+//=============================================================================
+// Private Implementation
+//=============================================================================
+
+static void applyHit(Car* car, int carIndex, Item type, const ItemMsg* msg) {
+    switch (type) {
+        case ITEM_GREEN_SHELL:
+        case ITEM_RED_SHELL:
+            applyShellHitEffect(car);
+            break;
+
+        case ITEM_MISSILE:
+            car->speed = 0;
+            break;
+
+        case ITEM_BANANA:
+            applyBananaHitEffect(car);
+            break;
+
+        case ITEM_OIL:
+            applyOilHitEffect(car, carIndex);
+            break;
+
+        case ITEM_BOMB:
+            applyBombHitEffect(car, msg);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void applyShellHitEffect(Car* car) {
+    // Stop car and spin it 45° in random direction
+    car->speed = 0;
+    int spinDirection =
+        (SimState_Random() % 2 == 0) ? SHELL_SPIN_ANGLE_POS : SHELL_SPIN_ANGLE_NEG;
+    car->angle512 = (car->angle512 + spinDirection) & ANGLE_MASK;
+}
+
+static void applyBananaHitEffect(Car* car) {
+    // Spin car 180° and keep speed reduction
+    car->speed = car->speed / BANANA_SPEED_DIVISOR;
+    car->angle512 = (car->angle512 + ANGLE_HALF) & ANGLE_MASK;  // 180° turn
+}
+
+static void applyOilHitEffect(Car* car, int carIndex) {
+    // Get race state to determine player index
+    const RaceState* state = Race_GetState();
+    int playerIndex = state->playerIndex;
+
+    // Apply oil slow to player only
+    if (carIndex == playerIndex) {
+        Items_ApplyOilSlow(car, &simState.items.playerEffects);
+    } else {
+        car->speed = car->speed / OIL_SPEED_DIVISOR;
+    }
+}
+
+static void applyBombHitEffect(Car* car, const ItemMsg* msg) {
+    // Stop car completely, flip it 180° and push it away from the bomb (the
+    // item world computed the knockback)
+    car->speed = 0;
+    car->angle512 = (car->angle512 + ANGLE_HALF) & ANGLE_MASK;
+    car->position.x += msg->dx;
+    car->position.y += msg->dy;
+}
+
+static void handleItemBoxPickup(Car* car, int carIndex, int boxIndex) {
+    // Get race state to determine player index
+    const RaceState* state = Race_GetState();
+    int playerIndex = state->playerIndex;
+
+    // Give item to the local player only (not AI or remote players); the item
+    // world already deactivated the box
+    if (carIndex == playerIndex) {
+        // PLAY SOUND - only for the local player who picked up the box
+        PlayBoxSFX();
+
+        if (car->item == ITEM_NONE) {
+            Item receivedItem = Items_GetRandomItem(car->rank);
+            car->item = receivedItem;
+        }
+
+        // In multiplayer, broadcast the pickup to other players (not replays)
+        if (state->gameMode == MultiPlayer && !Replay_IsPlaying()) {
+            Multiplayer_SendItemBoxPickup(boxIndex);
+        }
+    }
+}
@@ -16,14 +16,14 @@
 
 #include "items_types.h"
 #include "items_constants.h"
+#include "../sim_state.h"
+#include "../../core/scheduler.h"
 
 //=============================================================================
 // Shared Module State
 //=============================================================================
-extern TrackItem activeItems[MAX_TRACK_ITEMS];
-extern ItemBoxSpawn itemBoxSpawns[MAX_ITEM_BOX_SPAWNS];
-extern int itemBoxCount;
-extern PlayerItemEffects playerEffects;
+// Active items, item boxes and player effects are simState.items (sim_state.h)
+extern SchedTaskId retargetTask;  // Homing lock-on scan (polled once per tick)
 
 //=============================================================================
 // Graphics Pointers
@@ -73,13 +73,13 @@ void Items_UsePlayerItem(Car* player, bool fireForward) {
 
         case ITEM_MUSHROOM: {
             // Apply confusion to player
-            Items_ApplyConfusion(&playerEffects);
+            Items_ApplyConfusion(&simState.items.playerEffects);
             break;
         }
 
         case ITEM_SPEEDBOOST: {
             // Apply speed boost to player
-            Items_ApplySpeedBoost(player, &playerEffects);
+            Items_ApplySpeedBoost(player, &simState.items.playerEffects);
             break;
         }
 
@@ -140,7 +140,7 @@ Item Items_GetRandomItem(int playerRank) {
                 prob->redShell + prob->missile + prob->mushroom + prob->speedBoost;
 
     // Generate random number
-    int roll = rand() % total;
+    int roll = (int)(SimState_Random() % (u32)total);
 
     // Determine which item based on probability ranges
     int cumulative = 0;
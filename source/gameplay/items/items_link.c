@@ -0,0 +1,237 @@
+/**
+ * File: items_link.c
+ * ------------------
+ * Description: Item world -> car side message link, packed into an SPSC
+ *              event queue (two words per message, pushed as one unit so a
+ *              message is never split). With ITEMS_ON_ARM7 also the FIFO
+ *              protocol between the ARM9 and the ARM7 running the world; this
+ *              file is compiled into both programs.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "items_link.h"
+
+#include "items_constants.h"
+
+#ifdef ITEMS_ON_ARM7
+#include <stddef.h>
+#endif
+
+#include "../../core/spsc_queue.h"
+#ifdef ARM7
+#include "items_world.h"
+#else
+#include "../../core/kmlog.h"
+#endif
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define WORDS_PER_MSG 2
+#define LINK_WORDS (ITEM_LINK_CAPACITY * WORDS_PER_MSG)
+#define CHUNK_WORDS (1 + ITEM_CHUNK_MSGS * WORDS_PER_MSG)
+
+// Bomb knockback travels as s16 Q16.8
+_Static_assert((BOMB_KNOCKBACK_DISTANCE << FIXED_SHIFT) <= 0x7FFF,
+               "Bomb knockback does not fit the link's s16 fields");
+
+//=============================================================================
+// PRIVATE TYPES
+//=============================================================================
+#ifdef ITEMS_ON_ARM7
+
+// One step, ARM9 -> ARM7
+typedef struct {
+    u32 world;  // ItemsState* in main RAM
+    ItemWorldTick tick;
+} ItemStepMsg;
+
+// The part of ItemsState the ARM7 writes: whole cache lines (items_api.h)
+#define WORLD_OFFSET offsetof(ItemsState, activeItems)
+#define WORLD_BYTES (offsetof(ItemsState, playerEffects) - WORLD_OFFSET)
+
+_Static_assert(sizeof(ItemStepMsg) <= FIFO_MAX_DATA_BYTES,
+               "An item step does not fit one FIFO datamsg");
+_Static_assert(CHUNK_WORDS * sizeof(u32) <= FIFO_MAX_DATA_BYTES,
+               "An item message chunk does not fit one FIFO datamsg");
+_Static_assert(WORLD_OFFSET % 32 == 0 && WORLD_BYTES % 32 == 0,
+               "The item world must fill whole ARM9 cache lines");
+
+#endif  // ITEMS_ON_ARM7
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+#ifdef ARM7
+static ItemStepMsg pendingStep;
+static volatile bool stepPending;
+static u32 chunk[CHUNK_WORDS];
+static int chunkMsgs;
+#else
+static u32 linkSlots[LINK_WORDS];
+static SpscQueue link;
+#ifdef ITEMS_ON_ARM7
+static ItemsState* stepWorld;      // Pool the ARM7 is stepping (NULL: none)
+static volatile bool stepRunning;  // Cleared by the step's last chunk
+#endif
+#endif
+
+//=============================================================================
+// PRIVATE FUNCTIONS
+//=============================================================================
+
+static void ItemLink_Pack(const ItemMsg* msg, u32* words) {
+    words[0] = SPSC_EVENT(msg->type, ((u32)msg->car << 16) | ((u32)msg->item << 8) |
+                                         msg->index);
+    words[1] = ((u32)(u16)msg->dx << 16) | (u16)msg->dy;
+}
+
+#ifdef ARM7
+
+static void ItemLink_SendChunk(u32 flags) {
+    chunk[0] = (u32)chunkMsgs | flags;
+    int bytes = (1 + chunkMsgs * WORDS_PER_MSG) * (int)sizeof(u32);
+    // Never drop a chunk: the ARM9 waits for the last one
+    while (!fifoSendDatamsg(FIFO_ITEMS, bytes, (u8*)chunk))
+        ;
+    chunkMsgs = 0;
+}
+
+static void ItemLink_StepHandler(int bytes, void* userdata) {
+    (void)userdata;
+    fifoGetDatamsg(FIFO_ITEMS, bytes, (u8*)&pendingStep);
+    stepPending = true;
+}
+
+#else
+
+static void ItemLink_Unpack(const u32* words, ItemMsg* msg) {
+    u32 payload = SPSC_EVENT_PAYLOAD(words[0]);
+    msg->type = (u8)SPSC_EVENT_TYPE(words[0]);
+    msg->car = (u8)(payload >> 16);
+    msg->item = (u8)(payload >> 8);
+    msg->index = (u8)payload;
+    msg->dx = (s16)(words[1] >> 16);
+    msg->dy = (s16)(words[1] & 0xFFFF);
+}
+
+static bool ItemLink_Push(const u32* words) {
+    if (SpscQueue_PushBatch(&link, words, WORDS_PER_MSG))
+        return true;
+
+    LOG_WARN("item link full: type=%d car=%d dropped", SPSC_EVENT_TYPE(words[0]),
+             SPSC_EVENT_PAYLOAD(words[0]) >> 16);
+    return false;
+}
+
+#ifdef ITEMS_ON_ARM7
+// FIFO interrupt: a chunk of the ARM7's messages, in the order it posted them
+static void ItemLink_ChunkHandler(int bytes, void* userdata) {
+    (void)userdata;
+    u32 words[CHUNK_WORDS];
+    fifoGetDatamsg(FIFO_ITEMS, bytes, (u8*)words);
+
+    u32 count = words[0] & ~ITEM_CHUNK_LAST;
+    for (u32 i = 0; i < count && i < ITEM_CHUNK_MSGS; i++)
+        ItemLink_Push(&words[1 + i * WORDS_PER_MSG]);
+    if (words[0] & ITEM_CHUNK_LAST)
+        stepRunning = false;
+}
+#endif
+
+#endif  // ARM7
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+#ifdef ARM7
+
+void ItemLink_InitArm7(void) {
+    fifoSetDatamsgHandler(FIFO_ITEMS, ItemLink_StepHandler, NULL);
+}
+
+bool ItemLink_Post(const ItemMsg* msg) {
+    if (chunkMsgs == ITEM_CHUNK_MSGS)
+        ItemLink_SendChunk(0);
+    ItemLink_Pack(msg, &chunk[1 + chunkMsgs * WORDS_PER_MSG]);
+    chunkMsgs++;
+    return true;  // A full link is counted on the ARM9
+}
+
+void ItemLink_RunStep(void) {
+    if (!stepPending)
+        return;
+    stepPending = false;  // The ARM9 sends the next step after the last chunk
+
+    // The ARM7 has no data cache: it reads and writes the pool in main RAM
+    ItemsState* world = (ItemsState*)pendingStep.world;
+    ItemWorld_Update(world, &pendingStep.tick);
+    ItemWorld_CheckCollisions(world, &pendingStep.tick);
+    ItemLink_SendChunk(ITEM_CHUNK_LAST);
+}
+
+#else
+
+void ItemLink_Init(void) {
+    SpscQueue_Init(&link, linkSlots, LINK_WORDS);
+#ifdef ITEMS_ON_ARM7
+    fifoSetDatamsgHandler(FIFO_ITEMS, ItemLink_ChunkHandler, NULL);
+#endif
+}
+
+bool ItemLink_Post(const ItemMsg* msg) {
+    u32 words[WORDS_PER_MSG];
+    ItemLink_Pack(msg, words);
+    return ItemLink_Push(words);
+}
+
+int ItemLink_Receive(ItemMsg* out, int max) {
+    u32 words[WORDS_PER_MSG];
+    int count = 0;
+
+    // Messages are pushed whole, so the queue always holds complete pairs
+    while (count < max && SpscQueue_PopBatch(&link, words, WORDS_PER_MSG) ==
+                              WORDS_PER_MSG) {
+        ItemLink_Unpack(words, &out[count++]);
+    }
+    return count;
+}
+
+u32 ItemLink_GetDropped(void) {
+    return SpscQueue_GetDropped(&link);
+}
+
+#ifdef ITEMS_ON_ARM7
+
+void ItemLink_StartStep(ItemsState* world, const ItemWorldTick* tick) {
+    ItemStepMsg step = {.world = (u32)world, .tick = *tick};
+
+    // What the ARM9 spawned and despawned since the last step is in its cache
+    DC_FlushRange((u8*)world + WORLD_OFFSET, WORLD_BYTES);
+    stepWorld = world;
+    stepRunning = true;
+    while (!fifoSendDatamsg(FIFO_ITEMS, sizeof(step), (u8*)&step))
+        ;
+}
+
+void ItemLink_WaitStep(void) {
+    if (stepWorld == NULL)
+        return;
+
+    // Called from the race tick's timer interrupt: the FIFO interrupt nests
+    // into it and clears the flag
+    while (stepRunning)
+        ;
+
+    // Lines cached before the step hold the pool as the ARM9 left it
+    DC_InvalidateRange((u8*)stepWorld + WORLD_OFFSET, WORLD_BYTES);
+    stepWorld = NULL;
+}
+
+#endif  // ITEMS_ON_ARM7
+
+#endif  // ARM7
@@ -0,0 +1,153 @@
+/**
+ * File: items_link.h
+ * ------------------
+ * Description: Message link between the item world and the cars. The item
+ *              world (lifetimes, projectile movement and homing, box respawns,
+ *              collision detection) only reads car poses; everything it does
+ *              to a car is posted as a message, and the car side applies the
+ *              batch afterwards (Items_ApplyEvents). The world can run on
+ *              the ARM7 and send the same messages through the IPC FIFO.
+ *
+ * By default both sides run in Race_Tick on the ARM9 (loopback): the world
+ * posts during Items_Update/Items_CheckCollisions and the batch is applied in
+ * the same tick, so the link is always empty between ticks and is not part of
+ * SimState.
+ *
+ * With ITEMS_ON_ARM7 (make ITEMS_ON_ARM7=1) the world runs in the game's ARM7
+ * program (arm7/source/main.c). Items_CheckCollisions hands the step over
+ * with ItemLink_StartStep() and the ARM9 moves the cars meanwhile;
+ * Items_ApplyEvents waits for the end of the step with ItemLink_WaitStep().
+ * The item pool stays in main RAM and belongs to the ARM7 between the two
+ * calls. Both directions go over the FIFO_ITEMS channel as datamsgs:
+ *   ARM9 -> ARM7  one per step: pool address + ItemWorldTick
+ *   ARM7 -> ARM9  header word (message count, ITEM_CHUNK_LAST on the step's
+ *                 last chunk) + up to ITEM_CHUNK_MSGS messages, pushed into
+ *                 the link by the ARM9's FIFO handler
+ *
+ * Wire format: two 32-bit words per message
+ *   word 0  SPSC_EVENT(type, car << 16 | item << 8 | index)
+ *   word 1  dx << 16 | dy (u16 halves, Q16.8 knockback)
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef ITEMS_LINK_H
+#define ITEMS_LINK_H
+
+#include <nds.h>
+#include <stdbool.h>
+
+#ifdef ITEMS_ON_ARM7
+#include "items_world.h"
+#endif
+
+//=============================================================================
+// PUBLIC CONSTANTS
+//=============================================================================
+#define FIFO_ITEMS FIFO_USER_01      // Item world steps and their messages
+#define ITEM_CHUNK_MSGS 15           // Messages per datamsg (124 of 128 bytes)
+#define ITEM_CHUNK_LAST 0x80000000u  // Chunk header: the step is done
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+typedef enum {
+    ITEM_MSG_HIT = 1,        // `car` was hit by an item of type `item`
+    ITEM_MSG_BOX_PICKUP = 2  // `car` drove through item box `index`
+} ItemMsgType;
+
+typedef struct {
+    u8 type;   // ItemMsgType
+    u8 car;    // Car index
+    u8 item;   // Item type (ITEM_MSG_HIT)
+    u8 index;  // Item box index (ITEM_MSG_BOX_PICKUP)
+    s16 dx;    // Knockback to add to the car position (Q16.8, bomb hits)
+    s16 dy;
+} ItemMsg;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: ItemLink_Post
+ * -----------------------
+ * Sends a message from the item world to the car side. On the ARM7 the
+ * message goes out with the step's next chunk.
+ *
+ * Returns: false if the link was full (the message is dropped and counted)
+ */
+bool ItemLink_Post(const ItemMsg* msg);
+
+#ifdef ARM7
+
+/**
+ * Function: ItemLink_InitArm7
+ * ---------------------------
+ * Installs the FIFO_ITEMS handler that receives the ARM9's steps. Called once
+ * by the ARM7 main().
+ */
+void ItemLink_InitArm7(void);
+
+/**
+ * Function: ItemLink_RunStep
+ * --------------------------
+ * Runs the step the ARM9 sent, if there is one: ItemWorld_Update() and
+ * ItemWorld_CheckCollisions() on the ARM9's pool, then the last chunk of
+ * messages. Called from the ARM7 main loop.
+ */
+void ItemLink_RunStep(void);
+
+#else
+
+/**
+ * Function: ItemLink_Init
+ * -----------------------
+ * Empties the link and its counters. Called by Items_Init().
+ */
+void ItemLink_Init(void);
+
+/**
+ * Function: ItemLink_Receive
+ * --------------------------
+ * Takes up to `max` messages in the order they were posted.
+ *
+ * Returns: number of messages written to `out`
+ */
+int ItemLink_Receive(ItemMsg* out, int max);
+
+/**
+ * Function: ItemLink_GetDropped
+ * -----------------------------
+ * Gets how many messages were dropped on a full link since ItemLink_Init().
+ */
+u32 ItemLink_GetDropped(void);
+
+#ifdef ITEMS_ON_ARM7
+
+/**
+ * Function: ItemLink_StartStep
+ * ----------------------------
+ * Writes the pool back from the data cache and sends the step to the ARM7.
+ * The ARM9 must not touch `world` (activeItems to itemBoxCount) until
+ * ItemLink_WaitStep() returns.
+ */
+void ItemLink_StartStep(ItemsState* world, const ItemWorldTick* tick);
+
+/**
+ * Function: ItemLink_WaitStep
+ * ---------------------------
+ * Waits until the ARM7 sent the step's last chunk (all its messages are then
+ * in the link) and drops the pool's stale cache lines. Returns at once if no
+ * step was started.
+ */
+void ItemLink_WaitStep(void);
+
+#endif  // ITEMS_ON_ARM7
+
+#endif  // ARM7
+
+#endif  // ITEMS_LINK_H
@@ -2,8 +2,9 @@
  * File: items_render.c
  * --------------------
  * Description: Rendering system for items. Handles sprite allocation, graphics
- *              loading, and OAM management for item boxes and track items.
- *              Supports rotation for projectiles and visibility culling.
+ *              loading, and submits the item boxes and track items of a race
+ *              snapshot to the sprite batcher (which owns OAM, culling and
+ *              affine matrices).
  *
  * Authors: Bahey Shalash, Hugo Svolgaard
  * Version: 1.0
@@ -13,85 +14,103 @@
 #include "items_internal.h"
 #include "items_api.h"
 
+#include "../../core/mem_budget.h"
+#include "../../graphics/rot_sprite.h"
+#include "../../graphics/sprite_batch.h"
+#include "../race_snapshot.h"
+
 #include "data/items/banana.h"
 #include "data/items/bomb.h"
-#include "data/items/green_shell.h"
+#include "data/items/green_shell_rot.h"
 #include "data/items/item_box.h"
-#include "data/items/missile.h"
+#include "data/items/missile_rot.h"
 #include "data/items/oil_slick.h"
-#include "data/items/red_shell.h"
+#include "data/items/red_shell_rot.h"
 
 //=============================================================================
-// Rendering
+// Pre-rotated projectile frames (32 directions, mirror-symmetric sprites)
 //=============================================================================
-static void Items_RenderItemBoxes(int scrollX, int scrollY);
-static void Items_ClearTrackItemOam(void);
-static void Items_RenderTrackItems(int scrollX, int scrollY);
-
-void Items_Render(int scrollX, int scrollY) {
-    Items_RenderItemBoxes(scrollX, scrollY);
-    Items_ClearTrackItemOam();
-    Items_RenderTrackItems(scrollX, scrollY);
-}
-
-static void Items_RenderItemBoxes(int scrollX, int scrollY) {
-    for (int i = 0; i < itemBoxCount; i++) {
-        int oamSlot = ITEM_BOX_OAM_START + i;
-
-        if (!itemBoxSpawns[i].active) {
-            oamSet(&oamMain, oamSlot, 0, 192, OBJPRIORITY_2, 1, SpriteSize_8x8,
-                   SpriteColorFormat_16Color, itemBoxSpawns[i].gfx, 1, true, false,
-                   false, false, false);
-            continue;
-        }
-
-        int screenX =
-            FixedToInt(itemBoxSpawns[i].position.x) - scrollX - (ITEM_BOX_HITBOX / 2);
-        int screenY =
-            FixedToInt(itemBoxSpawns[i].position.y) - scrollY - (ITEM_BOX_HITBOX / 2);
-
-        if (screenX >= -16 && screenX < 256 && screenY >= -16 && screenY < 192) {
-            oamSet(&oamMain, oamSlot, screenX, screenY, OBJPRIORITY_2, 1,
-                   SpriteSize_8x8, SpriteColorFormat_16Color, itemBoxSpawns[i].gfx, 1,
-                   false, false, false, false, false);
-        } else {
-            oamSet(&oamMain, oamSlot, 0, 192, OBJPRIORITY_2, 1, SpriteSize_8x8,
-                   SpriteColorFormat_16Color, itemBoxSpawns[i].gfx, 1, true, false,
-                   false, false, false);
-        }
+static RotSprite greenShellFrames;
+static RotSprite redShellFrames;
+static RotSprite missileFrames;  // 32x32 frames so the 16x32 art never clips
+
+static const RotSprite* Items_GetRotSprite(Item type) {
+    switch (type) {
+        case ITEM_GREEN_SHELL:
+            return &greenShellFrames;
+        case ITEM_RED_SHELL:
+            return &redShellFrames;
+        case ITEM_MISSILE:
+            return &missileFrames;
+        default:
+            return NULL;
     }
 }
 
-static void Items_ClearTrackItemOam(void) {
-    for (int i = 0; i < MAX_TRACK_ITEMS; i++) {
-        int oamSlot = TRACK_ITEM_OAM_START + i;
-        oamSet(&oamMain, oamSlot, 0, 192, OBJPRIORITY_2, 0, SpriteSize_16x16,
-               SpriteColorFormat_16Color, NULL, -1, true, false, false, false, false);
+// Graphics of an unrotated item sprite (projectiles use their frames)
+static const u16* Items_GetGfx(Item type) {
+    switch (type) {
+        case ITEM_BANANA:
+            return bananaGfx;
+        case ITEM_BOMB:
+            return bombGfx;
+        case ITEM_OIL:
+            return oilSlickGfx;
+        case ITEM_GREEN_SHELL:
+            return greenShellGfx;
+        case ITEM_RED_SHELL:
+            return redShellGfx;
+        case ITEM_MISSILE:
+            return missileGfx;
+        default:
+            return NULL;
     }
 }
 
-static void Items_RenderTrackItems(int scrollX, int scrollY) {
-    for (int i = 0; i < MAX_TRACK_ITEMS; i++) {
-        if (!activeItems[i].active)
-            continue;
-
-        TrackItem* item = &activeItems[i];
-        int oamSlot = TRACK_ITEM_OAM_START + i;
+//=============================================================================
+// Rendering
+//=============================================================================
+// Sprites go through the batcher: it culls, assigns OAM entries and shares
+// affine matrices between projectiles, so nothing here owns a fixed slot.
+// Only the published snapshot is read, never the live item pool.
+static void Items_RenderItemBoxes(const RaceSnapshot* snap, int scrollX, int scrollY);
+static void Items_RenderTrackItems(const RaceSnapshot* snap, Q16_8 alpha, int scrollX,
+                                   int scrollY);
+
+void Items_Render(const RaceSnapshot* snap, Q16_8 alpha, int scrollX, int scrollY) {
+    Items_RenderItemBoxes(snap, scrollX, scrollY);
+    Items_RenderTrackItems(snap, alpha, scrollX, scrollY);
+}
 
-        int screenX =
-            FixedToInt(item->position.x) - scrollX - (item->hitbox_width / 2);
-        int screenY =
-            FixedToInt(item->position.y) - scrollY - (item->hitbox_height / 2);
+static void Items_RenderItemBoxes(const RaceSnapshot* snap, int scrollX, int scrollY) {
+    for (int i = 0; i < snap->boxCount; i++) {
+        int screenX = FixedToInt(snap->boxes[i].x) - scrollX - (ITEM_BOX_HITBOX / 2);
+        int screenY = FixedToInt(snap->boxes[i].y) - scrollY - (ITEM_BOX_HITBOX / 2);
+
+        SpriteDesc sprite = {
+            .x = screenX,
+            .y = screenY,
+            .size = SpriteSize_8x8,
+            .format = SpriteColorFormat_16Color,
+            .gfx = itemBoxGfx,
+            .palette = 1,
+            .priority = OBJPRIORITY_2};
+        SpriteBatch_Submit(&sprite);
+    }
+}
 
-        if (screenX < -32 || screenX > 256 || screenY < -32 || screenY > 192)
-            continue;
+static void Items_RenderTrackItems(const RaceSnapshot* snap, Q16_8 alpha, int scrollX,
+                                   int scrollY) {
+    for (int i = 0; i < snap->itemCount; i++) {
+        const ItemPose* item = &snap->items[i];
+        Vec2 position = Vec2_Lerp(item->prevPosition, item->position, alpha);
 
         SpriteSize spriteSize;
         int paletteNum;
 
         switch (item->type) {
             case ITEM_MISSILE:
-                spriteSize = SpriteSize_16x32;
+                spriteSize = SpriteSize_32x32;
                 paletteNum = 6;
                 break;
             case ITEM_OIL:
@@ -120,91 +139,88 @@ static void Items_RenderTrackItems(int scrollX, int scrollY) {
                 break;
         }
 
-        bool useRotation =
-            (item->type == ITEM_GREEN_SHELL || item->type == ITEM_RED_SHELL ||
-             item->type == ITEM_MISSILE);
-
-        if (useRotation) {
-            int affineSlot = 1 + (i % 4);
-            int rotation = -(item->angle512 << 6);
-
-            oamRotateScale(&oamMain, affineSlot, rotation, (1 << 8), (1 << 8));
-            oamSet(&oamMain, oamSlot, screenX, screenY, OBJPRIORITY_2, paletteNum,
-                   spriteSize, SpriteColorFormat_16Color, item->gfx, affineSlot, false,
-                   false, false, false, false);
-        } else {
-            oamSet(&oamMain, oamSlot, screenX, screenY, OBJPRIORITY_2, paletteNum,
-                   spriteSize, SpriteColorFormat_16Color, item->gfx, -1, false, false,
-                   false, false, false);
+        SpriteDesc sprite = {
+            .x = FixedToInt(position.x) - scrollX - (item->width / 2),
+            .y = FixedToInt(position.y) - scrollY - (item->height / 2),
+            .size = spriteSize,
+            .format = SpriteColorFormat_16Color,
+            .gfx = Items_GetGfx(item->type),
+            .palette = paletteNum,
+            .priority = OBJPRIORITY_2};
+
+        // Projectiles pick a pre-rotated frame instead of an affine matrix
+        const RotSprite* frames = Items_GetRotSprite(item->type);
+        if (frames != NULL) {
+            int centerX = FixedToInt(position.x) - scrollX;
+            int centerY = FixedToInt(position.y) - scrollY;
+            int angle = Angle_Lerp(item->prevAngle512, item->angle512, alpha);
+            RotSprite_Place(frames, angle, centerX, centerY, &sprite);
         }
+        SpriteBatch_Submit(&sprite);
     }
 }
 
 void Items_LoadGraphics(void) {
     // Allocate sprite graphics - NOTE: 16-color format!
-    itemBoxGfx = oamAllocateGfx(&oamMain, SpriteSize_8x8, SpriteColorFormat_16Color);
-    bananaGfx = oamAllocateGfx(&oamMain, SpriteSize_16x16, SpriteColorFormat_16Color);
-    bombGfx = oamAllocateGfx(&oamMain, SpriteSize_16x16, SpriteColorFormat_16Color);
-    greenShellGfx =
-        oamAllocateGfx(&oamMain, SpriteSize_16x16, SpriteColorFormat_16Color);
-    redShellGfx =
-        oamAllocateGfx(&oamMain, SpriteSize_16x16, SpriteColorFormat_16Color);
-    missileGfx = oamAllocateGfx(&oamMain, SpriteSize_16x32, SpriteColorFormat_16Color);
-    oilSlickGfx =
-        oamAllocateGfx(&oamMain, SpriteSize_32x32, SpriteColorFormat_16Color);
+    itemBoxGfx = MemBudget_AllocGfx(&oamMain, SpriteSize_8x8, SpriteColorFormat_16Color,
+                                    MEM_OWNER_ITEMS);
+    bananaGfx = MemBudget_AllocGfx(&oamMain, SpriteSize_16x16, SpriteColorFormat_16Color,
+                                   MEM_OWNER_ITEMS);
+    bombGfx = MemBudget_AllocGfx(&oamMain, SpriteSize_16x16, SpriteColorFormat_16Color,
+                                 MEM_OWNER_ITEMS);
+    oilSlickGfx = MemBudget_AllocGfx(&oamMain, SpriteSize_32x32,
+                                     SpriteColorFormat_16Color, MEM_OWNER_ITEMS);
 
     // Copy tile data (note: for 16-color, still divide by 2)
     dmaCopy(item_boxTiles, itemBoxGfx, item_boxTilesLen);
     dmaCopy(bananaTiles, bananaGfx, bananaTilesLen);
     dmaCopy(bombTiles, bombGfx, bombTilesLen);
-    dmaCopy(green_shellTiles, greenShellGfx, green_shellTilesLen);
-    dmaCopy(red_shellTiles, redShellGfx, red_shellTilesLen);
-    dmaCopy(missileTiles, missileGfx, missileTilesLen);
     dmaCopy(oil_slickTiles, oilSlickGfx, oil_slickTilesLen);
 
+    // Projectiles: frame sheets from tools/img/prerotate_sprite.py
+    RotSprite_Load(&greenShellFrames, 32, ROT_SYMMETRY_QUARTER_Y, SpriteSize_16x16,
+                   green_shell_rotTiles, green_shell_rotTilesLen, MEM_OWNER_ITEMS);
+    RotSprite_Load(&redShellFrames, 32, ROT_SYMMETRY_QUARTER_Y, SpriteSize_16x16,
+                   red_shell_rotTiles, red_shell_rotTilesLen, MEM_OWNER_ITEMS);
+    RotSprite_Load(&missileFrames, 32, ROT_SYMMETRY_QUARTER_Y, SpriteSize_32x32,
+                   missile_rotTiles, missile_rotTilesLen, MEM_OWNER_ITEMS);
+    greenShellGfx = greenShellFrames.frames[0];
+    redShellGfx = redShellFrames.frames[0];
+    missileGfx = missileFrames.frames[0];
+
     // Copy palettes to separate palette slots (like the example)
     // Start at palette slot 1 (slot 0 is for the kart)
     dmaCopy(item_boxPal, &SPRITE_PALETTE[16], item_boxPalLen);
     dmaCopy(bananaPal, &SPRITE_PALETTE[32], bananaPalLen);
     dmaCopy(bombPal, &SPRITE_PALETTE[48], bombPalLen);
-    dmaCopy(green_shellPal, &SPRITE_PALETTE[64], green_shellPalLen);
-    dmaCopy(red_shellPal, &SPRITE_PALETTE[80], red_shellPalLen);
-    dmaCopy(missilePal, &SPRITE_PALETTE[96], missilePalLen);
+    dmaCopy(green_shell_rotPal, &SPRITE_PALETTE[64], green_shell_rotPalLen);
+    dmaCopy(red_shell_rotPal, &SPRITE_PALETTE[80], red_shell_rotPalLen);
+    dmaCopy(missile_rotPal, &SPRITE_PALETTE[96], missile_rotPalLen);
     dmaCopy(oil_slickPal, &SPRITE_PALETTE[112], oil_slickPalLen);
-
-    // Update item box spawns with the newly allocated graphics pointer
-    for (int i = 0; i < itemBoxCount; i++) {
-        itemBoxSpawns[i].gfx = itemBoxGfx;
-    }
+    MemBudget_ClaimPalette(MEM_POOL_PAL_MAIN, MEM_OWNER_ITEMS, 1, 7);
 }
 
 void Items_FreeGraphics(void) {
     if (itemBoxGfx) {
-        oamFreeGfx(&oamMain, itemBoxGfx);
+        MemBudget_FreeGfx(&oamMain, itemBoxGfx);
         itemBoxGfx = NULL;
     }
     if (bananaGfx) {
-        oamFreeGfx(&oamMain, bananaGfx);
+        MemBudget_FreeGfx(&oamMain, bananaGfx);
         bananaGfx = NULL;
     }
     if (bombGfx) {
-        oamFreeGfx(&oamMain, bombGfx);
+        MemBudget_FreeGfx(&oamMain, bombGfx);
         bombGfx = NULL;
     }
-    if (greenShellGfx) {
-        oamFreeGfx(&oamMain, greenShellGfx);
-        greenShellGfx = NULL;
-    }
-    if (redShellGfx) {
-        oamFreeGfx(&oamMain, redShellGfx);
-        redShellGfx = NULL;
-    }
-    if (missileGfx) {
-        oamFreeGfx(&oamMain, missileGfx);
-        missileGfx = NULL;
-    }
+    RotSprite_Free(&greenShellFrames);
+    RotSprite_Free(&redShellFrames);
+    RotSprite_Free(&missileFrames);
+    greenShellGfx = NULL;
+    redShellGfx = NULL;
+    missileGfx = NULL;
     if (oilSlickGfx) {
-        oamFreeGfx(&oamMain, oilSlickGfx);
+        MemBudget_FreeGfx(&oamMain, oilSlickGfx);
         oilSlickGfx = NULL;
     }
 }
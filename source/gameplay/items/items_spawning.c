@@ -17,6 +17,7 @@
 #include "../gameplay_logic.h"
 #include "../../core/game_constants.h"
 #include "../../network/multiplayer.h"
+#include "../replay.h"
 
 //=============================================================================
 // Item Spawning
@@ -29,8 +30,8 @@ void fireProjectileInternal(Item type, const Vec2* pos, int angle512, Q16_8 spee
                             int shooterCarIndex) {
     const RaceState* state = Race_GetState();
 
-    // In multiplayer, broadcast item placement to other players
-    if (sendNetwork && state->gameMode == MultiPlayer) {
+    // In multiplayer, broadcast item placement to other players (not replays)
+    if (sendNetwork && state->gameMode == MultiPlayer && !Replay_IsPlaying()) {
         Multiplayer_SendItemPlacement(type, *pos, angle512, speed, state->playerIndex);
     }
 
@@ -39,7 +40,7 @@ void fireProjectileInternal(Item type, const Vec2* pos, int angle512, Q16_8 spee
         return;  // No free slots
     }
 
-    TrackItem* item = &activeItems[slot];
+    TrackItem* item = &simState.items.activeItems[slot];
     item->type = type;
     item->position = *pos;
     item->speed = speed;
@@ -81,15 +82,13 @@ void fireProjectileInternal(Item type, const Vec2* pos, int angle512, Q16_8 spee
         item->hasCompletedLap = false;
     }
 
-    // Set hitbox and graphics based on type
+    // Set hitbox based on type (sprites are picked by type in items_render.c)
     if (type == ITEM_MISSILE) {
         item->hitbox_width = MISSILE_HITBOX_W;
         item->hitbox_height = MISSILE_HITBOX_H;
-        item->gfx = missileGfx;
     } else {
         item->hitbox_width = SHELL_HITBOX;
         item->hitbox_height = SHELL_HITBOX;
-        item->gfx = (type == ITEM_GREEN_SHELL) ? greenShellGfx : redShellGfx;
     }
 }
 
@@ -104,7 +103,7 @@ void placeHazardInternal(Item type, const Vec2* pos, bool sendNetwork) {
     // In multiplayer, broadcast item placement to other players
     if (sendNetwork) {
         const RaceState* state = Race_GetState();
-        if (state->gameMode == MultiPlayer) {
+        if (state->gameMode == MultiPlayer && !Replay_IsPlaying()) {
             Multiplayer_SendItemPlacement(type, *pos, 0, 0,
                                           state->playerIndex);  // Hazards don't move
         }
@@ -114,7 +113,7 @@ void placeHazardInternal(Item type, const Vec2* pos, bool sendNetwork) {
     if (slot < 0)
         return;
 
-    TrackItem* item = &activeItems[slot];
+    TrackItem* item = &simState.items.activeItems[slot];
     item->type = type;
     item->position = *pos;
     item->startPosition = *pos;
@@ -122,22 +121,19 @@ void placeHazardInternal(Item type, const Vec2* pos, bool sendNetwork) {
     item->angle512 = 0;
     item->active = true;
 
-    // Set lifetime and graphics based on item type
+    // Set lifetime and hitbox based on item type
     if (type == ITEM_BOMB) {
         item->lifetime_ticks = BOMB_LIFETIME_SECONDS * RACE_TICK_FREQ;
         item->hitbox_width = BOMB_HITBOX;
         item->hitbox_height = BOMB_HITBOX;
-        item->gfx = bombGfx;
     } else if (type == ITEM_BANANA) {
         item->lifetime_ticks = BANANA_LIFETIME_SECONDS * RACE_TICK_FREQ;
         item->hitbox_width = BANANA_HITBOX;
         item->hitbox_height = BANANA_HITBOX;
-        item->gfx = bananaGfx;
     } else if (type == ITEM_OIL) {
         item->lifetime_ticks = OIL_LIFETIME_TICKS;
         item->hitbox_width = OIL_SLICK_HITBOX;
         item->hitbox_height = OIL_SLICK_HITBOX;
-        item->gfx = oilSlickGfx;
     }
 }
 
@@ -151,7 +147,7 @@ void Items_PlaceHazard(Item type, const Vec2* pos) {
 
 static int findInactiveItemSlot(void) {
     for (int i = 0; i < MAX_TRACK_ITEMS; i++) {
-        if (!activeItems[i].active) {
+        if (!simState.items.activeItems[i].active) {
             return i;
         }
     }
@@ -2,8 +2,9 @@
  * File: items_state.c
  * -------------------
  * Description: Module state management and lifecycle functions for the items
- *              system. Handles initialization, reset, and storage of all
- *              active items, item boxes, player effects, and graphics pointers.
+ *              system. Handles initialization and reset of the active items,
+ *              item boxes and player effects (stored in the race SimState),
+ *              and storage of the graphics pointers.
  *
  * Authors: Bahey Shalash, Hugo Svolgaard
  * Version: 1.0
@@ -12,6 +13,7 @@
 
 #include "items_internal.h"
 #include "items_api.h"
+#include "items_link.h"
 
 #include <string.h>
 
@@ -19,10 +21,7 @@
 // Module State
 //=============================================================================
 
-TrackItem activeItems[MAX_TRACK_ITEMS];
-ItemBoxSpawn itemBoxSpawns[MAX_ITEM_BOX_SPAWNS];
-int itemBoxCount = 0;
-PlayerItemEffects playerEffects;
+SchedTaskId retargetTask = SCHED_NO_TASK;
 
 // Sprite graphics pointers (allocated during Items_LoadGraphics)
 u16* itemBoxGfx = NULL;
@@ -44,11 +43,18 @@ static void clearActiveItems(void);
 //=============================================================================
 
 void Items_Init(Map map) {
+    ItemLink_Init();
     clearActiveItems();
     initItemBoxSpawns(map);
 
     // Initialize player effects
-    memset(&playerEffects, 0, sizeof(PlayerItemEffects));
+    memset(&simState.items.playerEffects, 0, sizeof(PlayerItemEffects));
+
+    // Low priority: under load homing items look for new targets less often
+    // (locked targets are still tracked every tick)
+    if (retargetTask == SCHED_NO_TASK)
+        retargetTask = Scheduler_Register("retarget", NULL, SCHED_PRIO_LOW, 1,
+                                          SCHED_BUDGET_RETARGET);
 
     // Graphics are loaded once in configureSprite()
 }
@@ -57,13 +63,14 @@ void Items_Reset(void) {
     clearActiveItems();
 
     // Reset all item boxes to active
-    for (int i = 0; i < itemBoxCount; i++) {
-        itemBoxSpawns[i].active = true;
-        itemBoxSpawns[i].respawnTimer = 0;
+    for (int i = 0; i < simState.items.itemBoxCount; i++) {
+        ItemBoxSpawn* box = &simState.items.itemBoxSpawns[i];
+        box->active = true;
+        box->respawnTimer = 0;
     }
 
     // Reset player effects
-    memset(&playerEffects, 0, sizeof(PlayerItemEffects));
+    memset(&simState.items.playerEffects, 0, sizeof(PlayerItemEffects));
 }
 
 //=============================================================================
@@ -75,7 +82,7 @@ static void initItemBoxSpawns(Map map) {
     // TODO: Add spawn locations for other maps
 
     if (map != ScorchingSands) {
-        itemBoxCount = 0;
+        simState.items.itemBoxCount = 0;
         return;
     }
 
@@ -83,19 +90,19 @@ static void initItemBoxSpawns(Map map) {
                                    Vec2_FromInt(474, 211), Vec2_FromInt(493, 167),
                                    Vec2_FromInt(47, 483),  Vec2_FromInt(117, 483)};
 
-    itemBoxCount = 6;  // can add more
+    simState.items.itemBoxCount = 6;  // can add more
 
-    for (int i = 0; i < itemBoxCount; i++) {
-        itemBoxSpawns[i].position = spawnLocations[i];
-        itemBoxSpawns[i].active = true;
-        itemBoxSpawns[i].respawnTimer = 0;
-        itemBoxSpawns[i].gfx = itemBoxGfx;
+    for (int i = 0; i < simState.items.itemBoxCount; i++) {
+        ItemBoxSpawn* box = &simState.items.itemBoxSpawns[i];
+        box->position = spawnLocations[i];
+        box->active = true;
+        box->respawnTimer = 0;
     }
 }
 
 static void clearActiveItems(void) {
     for (int i = 0; i < MAX_TRACK_ITEMS; i++) {
-        activeItems[i].active = false;
+        simState.items.activeItems[i].active = false;
     }
 }
 
@@ -80,7 +80,6 @@ typedef struct {
     int lifetime_ticks;
     int targetCarIndex;  // For homing missiles/red shells (-1 = none)
     bool active;
-    u16* gfx;  // Sprite graphics pointer
 
     int currentWaypoint;    // Which waypoint we're heading toward
     int waypointsVisited;   // Counter to prevent infinite loops
@@ -109,7 +108,6 @@ typedef struct {
     Vec2 position;
     bool active;       // Is box available for pickup?
     int respawnTimer;  // Ticks until respawn
-    u16* gfx;          // Sprite graphics pointer
 } ItemBoxSpawn;
 
 //=============================================================================
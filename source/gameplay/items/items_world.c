@@ -0,0 +1,511 @@
+/**
+ * File: items_world.c
+ * -------------------
+ * Description: The item world: projectile movement, homing behavior, lifetimes,
+ *              item box respawns and collision detection with cars and walls.
+ *              Cars are only seen as the poses in the ItemWorldTick; hits and
+ *              box pickups are posted on the item link (items_link.h) and
+ *              applied to the cars by items_events.c. Compiled for both CPUs
+ *              (the ARM7 runs it with ITEMS_ON_ARM7).
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 06.01.2026
+ */
+
+#include "items_world.h"
+#include "items_link.h"
+#include "item_navigation.h"
+
+#include <stdlib.h>
+
+#include "../wall_collision.h"
+#include "../../core/game_constants.h"
+#include "../../core/tcm.h"
+
+//=============================================================================
+// Internal Helper Prototypes
+//=============================================================================
+static void updateProjectile(TrackItem* item);
+static void updateHoming(TrackItem* item, const ItemWorldTick* tick);
+static void updateHomingTargetLock(TrackItem* item, const ItemWorldTick* tick,
+                                   bool isMultiplayer);
+static void updateHomingTargetPoint(TrackItem* item, const ItemWorldTick* tick,
+                                    bool isMultiplayer, Vec2* targetPoint);
+static void applyHomingTurn(TrackItem* item, const Vec2* targetPoint);
+static bool isCarConnected(const ItemWorldTick* tick, int carIndex);
+static bool shouldCheckProjectileCar(const TrackItem* item, int carIndex,
+                                     const ItemWorldTick* tick);
+static void postHit(int carIndex, Item type, Vec2 knockback);
+static void applyProjectileHit(TrackItem* item, int carIndex);
+static bool isHazardHit(const TrackItem* item, const Vec2* carPos);
+static void applyHazardHit(TrackItem* item, int carIndex, const ItemWorldTick* tick);
+static void checkProjectileCollision(TrackItem* item, const ItemWorldTick* tick);
+static void checkHazardCollision(TrackItem* item, const ItemWorldTick* tick);
+static void explodeBomb(const Vec2* position, const ItemWorldTick* tick);
+static bool checkItemCarCollision(const Vec2* itemPos, const Vec2* carPos,
+                                  int itemHitbox);
+static bool checkItemBoxPickup(const Vec2* carPos, ItemBoxSpawn* box);
+static QuadrantID getQuadrantFromPos(const Vec2* pos);
+static void checkItemBoxCollisions(ItemsState* world, const ItemWorldTick* tick);
+static void checkAllProjectileCollisions(ItemsState* world, const ItemWorldTick* tick);
+static void checkAllHazardCollisions(ItemsState* world, const ItemWorldTick* tick);
+static bool isItemNearScreen(const Vec2* itemPos, int scrollX, int scrollY);
+static void updateTrackItems(ItemsState* world, const ItemWorldTick* tick);
+static void updateItemBoxRespawns(ItemsState* world);
+static bool tickItemLifetime(TrackItem* item, const ItemWorldTick* tick);
+static void tickItemImmunity(TrackItem* item, const ItemWorldTick* tick);
+static bool Item_IsProjectile(Item type);
+static bool Item_IsHoming(Item type);
+static bool Item_IsHazard(Item type);
+
+//=============================================================================
+// Public API
+//=============================================================================
+
+TCM_CODE void ItemWorld_Update(ItemsState* world, const ItemWorldTick* tick) {
+    updateTrackItems(world, tick);
+    updateItemBoxRespawns(world);
+}
+
+TCM_CODE void ItemWorld_CheckCollisions(ItemsState* world, const ItemWorldTick* tick) {
+    checkItemBoxCollisions(world, tick);
+    checkAllProjectileCollisions(world, tick);
+    checkAllHazardCollisions(world, tick);
+}
+
+//=============================================================================
+// Private Implementation
+//=============================================================================
+
+static TCM_CODE void updateTrackItems(ItemsState* world, const ItemWorldTick* tick) {
+    for (int i = 0; i < MAX_TRACK_ITEMS; i++) {
+        if (!world->activeItems[i].active) {
+            continue;
+        }
+
+        TrackItem* item = &world->activeItems[i];
+
+        if (!tickItemLifetime(item, tick)) {
+            continue;
+        }
+
+        tickItemImmunity(item, tick);
+
+        if (Item_IsProjectile(item->type)) {
+            updateProjectile(item);
+        }
+
+        if (Item_IsHoming(item->type)) {
+            updateHoming(item, tick);
+        }
+    }
+}
+
+static TCM_CODE void updateItemBoxRespawns(ItemsState* world) {
+    for (int i = 0; i < world->itemBoxCount; i++) {
+        ItemBoxSpawn* box = &world->itemBoxSpawns[i];
+        if (!box->active && box->respawnTimer > 0) {
+            box->respawnTimer--;
+            if (box->respawnTimer <= 0) {
+                box->active = true;
+            }
+        }
+    }
+}
+
+static TCM_CODE bool tickItemLifetime(TrackItem* item, const ItemWorldTick* tick) {
+    if (item->lifetime_ticks > 0) {
+        item->lifetime_ticks--;
+        if (item->lifetime_ticks <= 0) {
+            if (item->type == ITEM_BOMB) {
+                explodeBomb(&item->position, tick);
+            }
+            item->active = false;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static TCM_CODE void tickItemImmunity(TrackItem* item, const ItemWorldTick* tick) {
+    if (item->immunityTimer == 0) {
+        return;
+    }
+
+    if (item->immunityTimer > 0) {
+        item->immunityTimer--;
+
+        if (item->shooterCarIndex >= 0 && item->shooterCarIndex < tick->carCount) {
+            const Vec2* shooter = &tick->carPos[item->shooterCarIndex];
+            Q16_8 distFromShooter = Vec2_Distance(&item->position, shooter);
+
+            if (distFromShooter >= IMMUNITY_MIN_DISTANCE) {
+                item->immunityTimer = 0;
+            }
+        }
+    } else if (item->immunityTimer == -1) {
+        if (!item->hasCompletedLap && item->waypointsVisited > 0) {
+            int waypointDiff = abs(item->currentWaypoint - item->startingWaypoint);
+
+            if (waypointDiff <= WAYPOINT_LAP_THRESHOLD &&
+                item->waypointsVisited > 100) {
+                item->hasCompletedLap = true;
+                item->immunityTimer = 0;
+            }
+        }
+    }
+}
+
+static TCM_CODE void updateProjectile(TrackItem* item) {
+    // Move projectile
+    Vec2 velocity = Vec2_FromAngle(item->angle512);
+    velocity = Vec2_Scale(velocity, item->speed);
+    item->position = Vec2_Add(item->position, velocity);
+
+    // Check wall collision
+    int x = FixedToInt(item->position.x);
+    int y = FixedToInt(item->position.y);
+    QuadrantID quad = getQuadrantFromPos(&item->position);
+
+    if (Wall_CheckCollision(x, y, item->hitbox_width / 2, quad)) {
+        item->active = false;  // Despawn on wall hit
+    }
+}
+
+static void updateHoming(TrackItem* item, const ItemWorldTick* tick) {
+    bool isMultiplayer = (tick->flags & ITEM_TICK_MULTIPLAYER) != 0;
+
+    if (tick->flags & ITEM_TICK_RETARGET)
+        updateHomingTargetLock(item, tick, isMultiplayer);
+
+    Vec2 targetPoint = item->position;
+    updateHomingTargetPoint(item, tick, isMultiplayer, &targetPoint);
+    applyHomingTurn(item, &targetPoint);
+}
+
+static void updateHomingTargetLock(TrackItem* item, const ItemWorldTick* tick,
+                                   bool isMultiplayer) {
+    // Never keep the shooter as a target in multiplayer
+    if (isMultiplayer && item->targetCarIndex == item->shooterCarIndex) {
+        item->targetCarIndex = INVALID_CAR_INDEX;
+    }
+
+    // If no target is locked, scan for nearby cars to attack
+    if (item->targetCarIndex == INVALID_CAR_INDEX) {
+        Q16_8 lockOnRadius = IntToFixed(100);  // 100 pixels detection range
+
+        for (int i = 0; i < tick->carCount; i++) {
+            if (isMultiplayer && i == item->shooterCarIndex) {
+                continue;  // Never lock onto the shooter in multiplayer
+            }
+
+            // Single player keeps the old immunity-based skip
+            if (!isMultiplayer && item->immunityTimer != 0 &&
+                i == item->shooterCarIndex) {
+                continue;
+            }
+
+            Q16_8 dist = Vec2_Distance(&item->position, &tick->carPos[i]);
+            if (dist <= lockOnRadius) {
+                // Lock onto this car!
+                item->targetCarIndex = i;
+                item->usePathFollowing = false;  // Switch to direct attack
+                break;
+            }
+        }
+    }
+}
+
+static void updateHomingTargetPoint(TrackItem* item, const ItemWorldTick* tick,
+                                    bool isMultiplayer, Vec2* targetPoint) {
+    *targetPoint = item->position;
+
+    // If we have a locked target, check if we should stay locked
+    if (item->targetCarIndex >= 0 && item->targetCarIndex < tick->carCount) {
+        if (isMultiplayer && item->targetCarIndex == item->shooterCarIndex) {
+            item->targetCarIndex = INVALID_CAR_INDEX;
+            item->usePathFollowing = true;
+        } else {
+            const Vec2* target = &tick->carPos[item->targetCarIndex];
+            Q16_8 distToTarget = Vec2_Distance(&item->position, target);
+
+            // If target is too far away, unlock and return to path following
+            if (distToTarget > IntToFixed(150)) {  // 150 pixel leash
+                item->targetCarIndex = INVALID_CAR_INDEX;
+                item->usePathFollowing = true;
+            } else {
+                // Stay locked - aim directly at target
+                *targetPoint = *target;
+                item->usePathFollowing = false;
+            }
+        }
+    }
+
+    // If no target or using path following, follow waypoints
+    if (item->usePathFollowing || item->targetCarIndex == INVALID_CAR_INDEX) {
+        // Get current waypoint position
+        Vec2 waypointPos =
+            ItemNav_GetWaypointPosition(item->currentWaypoint, (Map)tick->map);
+
+        // Check if we've reached this waypoint
+        if (ItemNav_IsWaypointReached(&item->position, &waypointPos)) {
+            // Advance to next waypoint
+            item->currentWaypoint =
+                ItemNav_GetNextWaypoint(item->currentWaypoint, (Map)tick->map);
+            item->waypointsVisited++;
+        }
+
+        // Aim toward current waypoint
+        *targetPoint = waypointPos;
+    }
+}
+
+static TCM_CODE void applyHomingTurn(TrackItem* item, const Vec2* targetPoint) {
+    // Smooth turn toward target point
+    Vec2 toTarget = Vec2_Sub(*targetPoint, item->position);
+    int targetAngle = Vec2_ToAngle(&toTarget);
+
+    int angleDiff = (targetAngle - item->angle512) & ANGLE_MASK;
+    if (angleDiff > ANGLE_HALF)
+        angleDiff -= ANGLE_FULL;
+
+    if (angleDiff > HOMING_TURN_RATE)
+        angleDiff = HOMING_TURN_RATE;
+    if (angleDiff < -HOMING_TURN_RATE)
+        angleDiff = -HOMING_TURN_RATE;
+
+    item->angle512 = (item->angle512 + angleDiff) & ANGLE_MASK;
+}
+
+// In multiplayer, only connected players are checked for hits and pickups
+static TCM_CODE bool isCarConnected(const ItemWorldTick* tick, int carIndex) {
+    return !(tick->flags & ITEM_TICK_MULTIPLAYER) ||
+           (tick->connected & (1u << carIndex)) != 0;
+}
+
+static bool shouldCheckProjectileCar(const TrackItem* item, int carIndex,
+                                     const ItemWorldTick* tick) {
+    bool isMultiplayer = (tick->flags & ITEM_TICK_MULTIPLAYER) != 0;
+
+    if (!isCarConnected(tick, carIndex)) {
+        return false;
+    }
+
+    // In multiplayer, never collide with the shooter
+    if (isMultiplayer && carIndex == item->shooterCarIndex) {
+        return false;
+    }
+
+    // immunityTimer > 0: multiplayer time-based immunity
+    // immunityTimer == -1 AND !hasCompletedLap: single player lap-based immunity
+    bool hasImmunity = (item->immunityTimer > 0) ||
+                       (item->immunityTimer == -1 && !item->hasCompletedLap);
+
+    // In single player, keep the old immunity-based shooter skip
+    if (!isMultiplayer && hasImmunity && carIndex == item->shooterCarIndex) {
+        return false;  // Can't hit the shooter yet
+    }
+
+    return true;
+}
+
+static TCM_CODE void postHit(int carIndex, Item type, Vec2 knockback) {
+    ItemMsg msg = {.type = ITEM_MSG_HIT,
+                   .car = (u8)carIndex,
+                   .item = (u8)type,
+                   .dx = (s16)knockback.x,
+                   .dy = (s16)knockback.y};
+    ItemLink_Post(&msg);
+}
+
+static TCM_CODE void applyProjectileHit(TrackItem* item, int carIndex) {
+    // Effect by type is applied by the car side (items_events.c)
+    postHit(carIndex, item->type, Vec2_Zero());
+    item->active = false;  // Despawn projectile
+}
+
+static TCM_CODE bool isHazardHit(const TrackItem* item, const Vec2* carPos) {
+    return checkItemCarCollision(&item->position, carPos, item->hitbox_width);
+}
+
+static void applyHazardHit(TrackItem* item, int carIndex, const ItemWorldTick* tick) {
+    switch (item->type) {
+        case ITEM_BANANA:
+            postHit(carIndex, ITEM_BANANA, Vec2_Zero());
+            item->active = false;
+            break;
+
+        case ITEM_OIL:
+            postHit(carIndex, ITEM_OIL, Vec2_Zero());
+            // Oil persists
+            break;
+
+        case ITEM_BOMB:
+            explodeBomb(&item->position, tick);
+            item->active = false;
+            break;
+
+        default:
+            break;
+    }
+}
+
+static TCM_CODE void checkProjectileCollision(TrackItem* item,
+                                              const ItemWorldTick* tick) {
+    for (int i = 0; i < tick->carCount; i++) {
+        if (!shouldCheckProjectileCar(item, i, tick)) {
+            continue;
+        }
+
+        if (checkItemCarCollision(&item->position, &tick->carPos[i],
+                                  item->hitbox_width)) {
+            applyProjectileHit(item, i);
+            break;
+        }
+    }
+}
+
+static TCM_CODE void checkHazardCollision(TrackItem* item, const ItemWorldTick* tick) {
+    for (int i = 0; i < tick->carCount; i++) {
+        if (isHazardHit(item, &tick->carPos[i])) {
+            applyHazardHit(item, i, tick);
+
+            if (!item->active)
+                break;
+        }
+    }
+
+    // Bomb auto-explodes when timer runs out
+    if (item->type == ITEM_BOMB && item->lifetime_ticks <= 0) {
+        explodeBomb(&item->position, tick);
+        item->active = false;
+    }
+}
+
+static void explodeBomb(const Vec2* position, const ItemWorldTick* tick) {
+    for (int i = 0; i < tick->carCount; i++) {
+        Q16_8 dist = Vec2_Distance(position, &tick->carPos[i]);
+
+        if (dist <= BOMB_EXPLOSION_RADIUS) {
+            // Knockback away from bomb (stop and 180° flip are applied with it)
+            Vec2 knockback = Vec2_Zero();
+            Vec2 knockbackDir = Vec2_Sub(tick->carPos[i], *position);
+            if (!Vec2_IsZero(knockbackDir)) {
+                knockbackDir = Vec2_Normalize(&knockbackDir);
+                knockback =
+                    Vec2_Scale(knockbackDir, IntToFixed(BOMB_KNOCKBACK_DISTANCE));
+            }
+            postHit(i, ITEM_BOMB, knockback);
+        }
+    }
+}
+
+static TCM_CODE bool checkItemBoxPickup(const Vec2* carPos, ItemBoxSpawn* box) {
+    Q16_8 dist = Vec2_Distance(carPos, &box->position);
+    int pickupRadius = (CAR_RADIUS + ITEM_BOX_HITBOX);
+    return (dist <= IntToFixed(pickupRadius));
+}
+
+static bool checkItemCarCollision(const Vec2* itemPos, const Vec2* carPos,
+                                  int itemHitbox) {
+    Q16_8 dist = Vec2_Distance(itemPos, carPos);
+    int hitRadius = (itemHitbox + CAR_COLLISION_SIZE) / 2;
+    return (dist <= IntToFixed(hitRadius));
+}
+
+static TCM_CODE void checkItemBoxCollisions(ItemsState* world,
+                                            const ItemWorldTick* tick) {
+    for (int i = 0; i < world->itemBoxCount; i++) {
+        ItemBoxSpawn* box = &world->itemBoxSpawns[i];
+        if (!box->active)
+            continue;
+
+        for (int c = 0; c < tick->carCount; c++) {
+            if (!isCarConnected(tick, c)) {
+                continue;
+            }
+
+            if (checkItemBoxPickup(&tick->carPos[c], box)) {
+                // Deactivate box and start respawn timer; the car side gives
+                // the item
+                box->active = false;
+                box->respawnTimer = ITEM_BOX_RESPAWN_TICKS;
+                ItemMsg msg = {.type = ITEM_MSG_BOX_PICKUP,
+                               .car = (u8)c,
+                               .index = (u8)i};
+                ItemLink_Post(&msg);
+                break;
+            }
+        }
+    }
+}
+
+static void checkAllProjectileCollisions(ItemsState* world, const ItemWorldTick* tick) {
+    for (int i = 0; i < MAX_TRACK_ITEMS; i++) {
+        if (!world->activeItems[i].active)
+            continue;
+
+        TrackItem* item = &world->activeItems[i];
+
+        if (Item_IsProjectile(item->type)) {
+            // Only check collision if item is near the screen
+            if (isItemNearScreen(&item->position, tick->scrollX, tick->scrollY)) {
+                checkProjectileCollision(item, tick);
+            }
+        }
+    }
+}
+
+static void checkAllHazardCollisions(ItemsState* world, const ItemWorldTick* tick) {
+    for (int i = 0; i < MAX_TRACK_ITEMS; i++) {
+        if (!world->activeItems[i].active)
+            continue;
+
+        TrackItem* item = &world->activeItems[i];
+
+        if (Item_IsHazard(item->type)) {
+            // Only check collision if item is near the screen
+            if (isItemNearScreen(&item->position, tick->scrollX, tick->scrollY)) {
+                checkHazardCollision(item, tick);
+            }
+        }
+    }
+}
+
+static TCM_CODE bool isItemNearScreen(const Vec2* itemPos, int scrollX, int scrollY) {
+    int itemX = FixedToInt(itemPos->x);
+    int itemY = FixedToInt(itemPos->y);
+
+    int screenLeft = scrollX - COLLISION_BUFFER_ZONE;
+    int screenRight = scrollX + SCREEN_WIDTH + COLLISION_BUFFER_ZONE;
+    int screenTop = scrollY - COLLISION_BUFFER_ZONE;
+    int screenBottom = scrollY + SCREEN_HEIGHT + COLLISION_BUFFER_ZONE;
+
+    return (itemX >= screenLeft && itemX <= screenRight && itemY >= screenTop &&
+            itemY <= screenBottom);
+}
+
+static TCM_CODE QuadrantID getQuadrantFromPos(const Vec2* pos) {
+    int x = FixedToInt(pos->x);
+    int y = FixedToInt(pos->y);
+
+    int col = (x < QUAD_BOUNDARY_LOW) ? 0 : (x < QUAD_BOUNDARY_HIGH) ? 1 : 2;
+    int row = (y < QUAD_BOUNDARY_LOW) ? 0 : (y < QUAD_BOUNDARY_HIGH) ? 1 : 2;
+
+    return (QuadrantID)(row * QUADRANT_GRID_SIZE + col);
+}
+
+static TCM_CODE bool Item_IsProjectile(Item type) {
+    return (type == ITEM_GREEN_SHELL || type == ITEM_RED_SHELL ||
+            type == ITEM_MISSILE);
+}
+
+static TCM_CODE bool Item_IsHoming(Item type) {
+    return (type == ITEM_RED_SHELL || type == ITEM_MISSILE);
+}
+
+static TCM_CODE bool Item_IsHazard(Item type) {
+    return (type == ITEM_BANANA || type == ITEM_OIL || type == ITEM_BOMB);
+}
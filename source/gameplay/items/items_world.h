@@ -0,0 +1,76 @@
+/**
+ * File: items_world.h
+ * -------------------
+ * Description: The item world on its own: projectile movement and homing,
+ *              lifetimes, immunity, item box respawns and collision detection,
+ *              stepped on an ItemsState with everything else it needs passed
+ *              in an ItemWorldTick. It reads no globals and calls nothing on
+ *              the ARM9 (race state, replay, network, scheduler), so the same
+ *              file is compiled into the ARM7 program when the game is built
+ *              with ITEMS_ON_ARM7 (see items_link.h).
+ *
+ * The world only writes the item pool and the boxes; hits and pickups are
+ * posted with ItemLink_Post().
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef ITEMS_WORLD_H
+#define ITEMS_WORLD_H
+
+#include <nds.h>
+#include <stdbool.h>
+
+#include "items_api.h"
+
+//=============================================================================
+// PUBLIC CONSTANTS
+//=============================================================================
+#define ITEM_TICK_MULTIPLAYER 0x01  // Multiplayer rules (shooter never hit)
+#define ITEM_TICK_RETARGET 0x02     // Homing items look for a new target
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+/**
+ * Struct: ItemWorldTick
+ * ---------------------
+ * What the world reads from the race for one step: the car poses as they were
+ * when the step was started, and the per-tick decisions the ARM9 makes (the
+ * retarget poll, which cars are connected).
+ */
+typedef struct {
+    Vec2 carPos[MAX_CARS];
+    u8 carCount;
+    u8 map;        // Map (item waypoints)
+    u8 flags;      // ITEM_TICK_*
+    u8 connected;  // Bit per car: checked for hits and pickups (multiplayer)
+    s16 scrollX;   // Collision culling window (the local player's screen)
+    s16 scrollY;
+} ItemWorldTick;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: ItemWorld_Update
+ * --------------------------
+ * Ticks lifetimes and immunity, moves projectiles, steers homing items and
+ * respawns boxes. Bombs that run out explode (posting their hits).
+ */
+void ItemWorld_Update(ItemsState* world, const ItemWorldTick* tick);
+
+/**
+ * Function: ItemWorld_CheckCollisions
+ * -----------------------------------
+ * Checks item boxes, projectiles and hazards near the screen against the
+ * cars. Despawns the items that hit, deactivates picked-up boxes and posts
+ * each hit and pickup.
+ */
+void ItemWorld_CheckCollisions(ItemsState* world, const ItemWorldTick* tick);
+
+#endif  // ITEMS_WORLD_H
@@ -0,0 +1,199 @@
+/**
+ * File: race_snapshot.c
+ * ---------------------
+ * Description: Implementation of the double-buffered race snapshot. The
+ *              writer runs in the tick ISR, which the main loop cannot
+ *              interrupt, so a snapshot is always complete once `published`
+ *              points at it. The reader announces the buffer it pins in
+ *              `reading`; the writer always fills the other one. The poses
+ *              of the last capture are kept per car and per item pool slot to
+ *              fill in the previous-tick fields.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "race_snapshot.h"
+
+#include <string.h>
+
+#include "gameplay.h"
+#include "gameplay_logic.h"
+#include "items/items_api.h"
+#include "replay.h"
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define NO_BUFFER (-1)
+
+#define MAX_STEP IntToFixed(RENDER_INTERP_MAX_STEP)
+
+// Keeps the compiler from moving buffer accesses across index updates
+#define SNAPSHOT_BARRIER() __asm__ volatile("" ::: "memory")
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static RaceSnapshot buffers[2];
+static volatile int published = NO_BUFFER;  // Latest complete snapshot
+static volatile int reading = NO_BUFFER;    // Snapshot pinned by the reader
+static u32 publishCount = 0;
+
+// Poses of the previous capture (indexed by car / item pool slot)
+static Vec2 lastKartPos[MAX_CARS];
+static s16 lastKartAngle[MAX_CARS];
+static Vec2 lastItemPos[MAX_TRACK_ITEMS];
+static s16 lastItemAngle[MAX_TRACK_ITEMS];
+static u8 lastItemType[MAX_TRACK_ITEMS];
+static bool lastItemActive[MAX_TRACK_ITEMS];
+static bool lastValid = false;  // Kart poses above are from this race
+
+//=============================================================================
+// PRIVATE HELPERS
+//=============================================================================
+
+// Previous pose to blend from; the current one if it jumped (respawn, slot reuse)
+static void RaceSnapshot_SetPrevious(Vec2* prevPos, s16* prevAngle, Vec2 lastPos,
+                                     s16 lastAngle, Vec2 pos, s16 angle) {
+    Vec2 step = Vec2_Sub(pos, lastPos);
+    if (step.x > MAX_STEP || step.x < -MAX_STEP || step.y > MAX_STEP ||
+        step.y < -MAX_STEP) {
+        *prevPos = pos;
+        *prevAngle = angle;
+    } else {
+        *prevPos = lastPos;
+        *prevAngle = lastAngle;
+    }
+}
+
+static void RaceSnapshot_CaptureKarts(RaceSnapshot* snap, const RaceState* state) {
+    snap->carCount = (u8)state->carCount;
+    snap->playerIndex = (u8)state->playerIndex;
+    snap->multiplayer = (state->gameMode == MultiPlayer);
+    snap->finished = state->raceFinished;
+
+    for (int i = 0; i < state->carCount; i++) {
+        const Car* car = &state->cars[i];
+        KartPose* pose = &snap->karts[i];
+        pose->position = car->position;
+        pose->angle512 = (s16)car->angle512;
+        pose->visible = !snap->multiplayer || Replay_IsPlayerConnected(i);
+
+        RaceSnapshot_SetPrevious(&pose->prevPosition, &pose->prevAngle512,
+                                 lastValid ? lastKartPos[i] : pose->position,
+                                 lastValid ? lastKartAngle[i] : pose->angle512,
+                                 pose->position, pose->angle512);
+        lastKartPos[i] = pose->position;
+        lastKartAngle[i] = pose->angle512;
+    }
+}
+
+static void RaceSnapshot_CaptureItems(RaceSnapshot* snap) {
+    int unused;
+    const TrackItem* items = Items_GetActiveItems(&unused);
+    int count = 0;
+    for (int i = 0; i < MAX_TRACK_ITEMS; i++) {
+        if (!items[i].active) {
+            lastItemActive[i] = false;
+            continue;
+        }
+        ItemPose* pose = &snap->items[count++];
+        pose->position = items[i].position;
+        pose->angle512 = (s16)items[i].angle512;
+        pose->type = (u8)items[i].type;
+        pose->width = (u8)items[i].hitbox_width;
+        pose->height = (u8)items[i].hitbox_height;
+
+        // A slot that was free or held another item has nothing to blend from
+        bool same = lastItemActive[i] && lastItemType[i] == pose->type;
+        RaceSnapshot_SetPrevious(&pose->prevPosition, &pose->prevAngle512,
+                                 same ? lastItemPos[i] : pose->position,
+                                 same ? lastItemAngle[i] : pose->angle512,
+                                 pose->position, pose->angle512);
+        lastItemPos[i] = pose->position;
+        lastItemAngle[i] = pose->angle512;
+        lastItemType[i] = pose->type;
+        lastItemActive[i] = true;
+    }
+    snap->itemCount = (u8)count;
+
+    int boxCount;
+    const ItemBoxSpawn* boxes = Items_GetBoxSpawns(&boxCount);
+    count = 0;
+    for (int i = 0; i < boxCount && count < MAX_ITEM_BOX_SPAWNS; i++) {
+        if (boxes[i].active)
+            snap->boxes[count++] = boxes[i].position;
+    }
+    snap->boxCount = (u8)count;
+}
+
+static void RaceSnapshot_CaptureHud(RaceSnapshot* snap, const RaceState* state) {
+    snap->heldItem = (u8)state->cars[state->playerIndex].item;
+    snap->currentLap = (u8)Gameplay_GetCurrentLap();
+    snap->totalLaps = (u8)state->totalLaps;
+    int min, sec, msec;
+    Gameplay_GetLapTime(&min, &sec, &msec);
+    snap->lapMin = (s16)min;
+    snap->lapSec = (s16)sec;
+    snap->lapMsec = (s16)msec;
+    snap->lapTicks = state->lapTicks;
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void RaceSnapshot_Reset(void) {
+    published = NO_BUFFER;
+    reading = NO_BUFFER;
+    publishCount = 0;
+    lastValid = false;
+    memset(lastItemActive, 0, sizeof(lastItemActive));
+}
+
+void RaceSnapshot_Publish(void) {
+    // Never the pinned buffer. With no reader, the one that is not published;
+    // if the reader pins an older one, the published buffer is free to reuse
+    // because this runs to completion before the reader can look again.
+    int held = reading;
+    int target;
+    if (held != NO_BUFFER)
+        target = held ^ 1;
+    else
+        target = (published == 0) ? 1 : 0;
+
+    RaceSnapshot* snap = &buffers[target];
+    const RaceState* state = Race_GetState();
+    snap->tick = ++publishCount;
+    RaceSnapshot_CaptureKarts(snap, state);
+    RaceSnapshot_CaptureItems(snap);
+    RaceSnapshot_CaptureHud(snap, state);
+    lastValid = true;
+
+    SNAPSHOT_BARRIER();
+    published = target;
+}
+
+const RaceSnapshot* RaceSnapshot_Acquire(void) {
+    int index;
+    do {
+        // A tick between these reads re-publishes; pin again until stable
+        index = published;
+        reading = index;
+        SNAPSHOT_BARRIER();
+    } while (index != published);
+
+    return (index == NO_BUFFER) ? NULL : &buffers[index];
+}
+
+bool RaceSnapshot_IsLatest(const RaceSnapshot* snap) {
+    int index = published;
+    return index != NO_BUFFER && snap == &buffers[index];
+}
+
+void RaceSnapshot_Release(void) {
+    SNAPSHOT_BARRIER();
+    reading = NO_BUFFER;
+}
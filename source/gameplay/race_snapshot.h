@@ -0,0 +1,138 @@
+/**
+ * File: race_snapshot.h
+ * ---------------------
+ * Description: Published render snapshot of the race. At the end of every
+ *              physics tick the simulation copies what the renderers need
+ *              (kart poses, visible items and boxes, HUD numbers) into one of
+ *              two buffers and publishes it with a single index store. The
+ *              main loop renders from the latest snapshot and never reads
+ *              KartMania or the item pool, so it cannot see a tick half-applied
+ *              and never makes the tick wait.
+ *
+ *              Moving poses also carry the pose of the previous tick, so the
+ *              renderer can blend them with RaceTick_GetAlpha() and draw
+ *              smooth motion between ticks.
+ *
+ * Usage:
+ *   TIMER0 ISR:  Race_Tick(); RaceSnapshot_Publish();
+ *   Main loop:   const RaceSnapshot* snap = RaceSnapshot_Acquire();
+ *                Q16_8 alpha = RaceTick_GetAlpha();
+ *                if (!RaceSnapshot_IsLatest(snap)) alpha = FIXED_ONE;
+ *                ...render from snap, blending prev* -> current by alpha...
+ *                RaceSnapshot_Release();
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef RACE_SNAPSHOT_H
+#define RACE_SNAPSHOT_H
+
+#include <nds.h>
+#include <stdbool.h>
+
+#include "../core/game_constants.h"
+#include "../math/fixedmath.h"
+#include "items/items_constants.h"
+#include "items/items_types.h"
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+typedef struct {
+    Vec2 position;      // World position (Q16.8)
+    Vec2 prevPosition;  // Position one tick earlier (= position after a jump)
+    s16 angle512;
+    s16 prevAngle512;
+    bool visible;       // Multiplayer: player connected
+} KartPose;
+
+typedef struct {
+    Vec2 position;      // World position of the item centre (Q16.8)
+    Vec2 prevPosition;  // Centre one tick earlier (= position when just spawned)
+    s16 angle512;
+    s16 prevAngle512;
+    u8 type;            // Item
+    u8 width;       // Hitbox size in pixels (sprite offset for unrotated items)
+    u8 height;
+} ItemPose;
+
+/**
+ * Everything the gameplay renderers read, as of one simulation tick.
+ */
+typedef struct RaceSnapshot {
+    u32 tick;  // Publish counter (increases by one per snapshot)
+
+    // Karts
+    u8 carCount;
+    u8 playerIndex;
+    bool multiplayer;
+    bool finished;  // Race completed
+    KartPose karts[MAX_CARS];
+
+    // Track items and item boxes (only visible ones, packed)
+    u8 itemCount;
+    u8 boxCount;
+    ItemPose items[MAX_TRACK_ITEMS];
+    Vec2 boxes[MAX_ITEM_BOX_SPAWNS];
+
+    // HUD
+    u8 heldItem;  // Item in the player's inventory
+    u8 currentLap;
+    u8 totalLaps;
+    s16 lapMin;
+    s16 lapSec;
+    s16 lapMsec;
+    u32 lapTicks;  // Ticks into the player's lap (ghost playback)
+} RaceSnapshot;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: RaceSnapshot_Reset
+ * ----------------------------
+ * Forgets published snapshots (race setup). Publish once before rendering.
+ */
+void RaceSnapshot_Reset(void);
+
+/**
+ * Function: RaceSnapshot_Publish
+ * ------------------------------
+ * Captures the current race state into the buffer no reader holds and makes
+ * it the latest snapshot. Call from one context at a time: the physics tick
+ * ISR while racing, the main loop during setup and the countdown (when the
+ * tick timer is not running).
+ */
+void RaceSnapshot_Publish(void);
+
+/**
+ * Function: RaceSnapshot_Acquire
+ * ------------------------------
+ * Pins the latest snapshot for reading. It stays unchanged until
+ * RaceSnapshot_Release(), even if ticks publish newer ones meanwhile.
+ *
+ * Returns: Latest snapshot, or NULL if nothing was published since the reset
+ */
+const RaceSnapshot* RaceSnapshot_Acquire(void);
+
+/**
+ * Function: RaceSnapshot_IsLatest
+ * -------------------------------
+ * Checks that no tick was published since `snap` was acquired. Only then does
+ * the tick timer phase (RaceTick_GetAlpha) describe the time after `snap`;
+ * otherwise render it unblended (alpha FIXED_ONE).
+ */
+bool RaceSnapshot_IsLatest(const RaceSnapshot* snap);
+
+/**
+ * Function: RaceSnapshot_Release
+ * ------------------------------
+ * Unpins the snapshot returned by RaceSnapshot_Acquire().
+ */
+void RaceSnapshot_Release(void);
+
+#endif  // RACE_SNAPSHOT_H
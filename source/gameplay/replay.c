@@ -0,0 +1,780 @@
+/**
+ * File: replay.c
+ * --------------
+ * Description: Implementation of race replay recording and playback. The
+ *              race tick fills one batch of words per tick (TICK word first)
+ *              and the "replay" task moves batches between the SPSC queue and
+ *              the card. While recording it encodes them into one of two
+ *              REPLAY_BUFFER_BYTES buffers and hands a full one to the SD
+ *              write queue while it fills the other; while playing the first
+ *              buffer is the read window. Keyframe copies are staged by the
+ *              tick and packed by the task.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "replay.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../core/game_constants.h"
+#include "../core/kmlog.h"
+#include "../core/spsc_queue.h"
+#include "../core/timer.h"
+#include "../storage/io_queue.h"
+#include "gameplay_logic.h"
+#include "race_snapshot.h"
+#include "sim_state.h"
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define CAR_WORDS 6  // REPLAY_EV_CAR: x, y, speed, angle, lap, item
+
+static const int PlaybackSpeeds[] = {1, 4, 16};
+
+// A keyframe (header + worst packed state) fits the buffer after a flush
+_Static_assert(REPLAY_MAX_KEYFRAME_HEADER + REPLAY_PACK_BOUND(sizeof(SimState)) <=
+                   REPLAY_BUFFER_BYTES,
+               "REPLAY_BUFFER_BYTES cannot hold a keyframe");
+
+//=============================================================================
+// PRIVATE TYPES
+//=============================================================================
+typedef enum {
+    REPLAY_IDLE,       // Live race, not recorded (no card)
+    REPLAY_RECORDING,  // Live race, recorded
+    REPLAY_PLAYING     // Race driven by REPLAY_FILE
+} ReplayMode;
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static volatile ReplayMode mode = REPLAY_IDLE;
+static SchedTaskId replayTask = SCHED_NO_TASK;
+static bool available = false;  // The last race left a finalized replay
+
+static FILE* file = NULL;  // Playback (recordings go through the io queue)
+static ReplayHeader header;
+static ReplayIndexEntry keyframeIndex[REPLAY_MAX_KEYFRAMES];
+static SimState base;    // Keyframe 0 (later keyframes are packed against it)
+static SimState staged;  // Keyframe being written (recording) or restored
+static u16 stagedInput;
+static u8 stagedConnected;
+static volatile bool keyframeStaged = false;
+
+// Race tick <-> replay task, one batch per tick
+static u32 queueSlots[REPLAY_QUEUE_WORDS];
+static SpscQueue queue;
+
+// Current tick (race tick side)
+static u32 tickWords[REPLAY_TICK_MAX_WORDS];  // TICK word, then the events
+static int tickCount = 1;
+static u16 tickInput = 0;
+static u8 connected = 0;  // Connected player mask
+static bool inTick = false;
+static u8 cursors[REPLAY_EV_BOX + 1];  // Playback: next word to search, by type
+
+// Card side (replay task): buffers[current] fills while the other one is
+// written, or buffers[0] is the read window
+static u8 buffers[2][REPLAY_BUFFER_BYTES];
+static u8* buffer = buffers[0];
+static IoRequestId pending[2] = {IO_NO_REQUEST, IO_NO_REQUEST};
+static IoRequestId finalWrite = IO_NO_REQUEST;  // Index and header, then the rename
+static int current = 0;
+static ReplayCoder coder;
+static volatile bool recordFailed = false;
+static int bufferBytes = 0;    // Recording: bytes not queued yet
+static u32 fileBytes = 0;      // Recording: bytes queued before them
+static int windowStart = 0;    // Playback: unread bytes [windowStart, windowEnd)
+static int windowEnd = 0;
+static u32 readOffset = 0;     // Playback: file offset of buffer[windowEnd]
+static bool streamEnded = false;
+static ReplayRecord decoded;   // Playback: last decoded tick
+static bool hasPending = false;  // `decoded` is not queued yet
+static u32 queuedTick = 0;     // Tick the queued ticks lead to
+static volatile int speed = 1;
+
+//=============================================================================
+// PRIVATE HELPERS - Race tick
+//=============================================================================
+
+static u8 Replay_SampleConnected(void) {
+    if (simState.race.gameMode != MultiPlayer)
+        return 0;
+    u8 mask = 0;
+    for (int i = 0; i < MAX_CARS; i++) {
+        if (Multiplayer_IsPlayerConnected(i))
+            mask |= (u8)(1u << i);
+    }
+    return mask;
+}
+
+// Appends event words to the tick being recorded
+static void Replay_Record(const u32* words, int count) {
+    if (mode != REPLAY_RECORDING)
+        return;
+    if (tickCount + count > REPLAY_TICK_MAX_WORDS) {
+        recordFailed = true;  // More events in one tick than a record holds
+        return;
+    }
+    memcpy(&tickWords[tickCount], words, count * sizeof(u32));
+    tickCount += count;
+}
+
+// Playback: index of the next event of `type` in this tick, or -1
+static int Replay_NextEvent(u32 type) {
+    int i = cursors[type];
+    while (i < tickCount) {
+        u32 found = SPSC_EVENT_TYPE(tickWords[i]);
+        int extra = ReplayFormat_EventWords(found);
+        if (extra < 0)
+            break;
+        int at = i;
+        i += 1 + extra;
+        if (found == type) {
+            cursors[type] = (u8)i;
+            return at;
+        }
+    }
+    cursors[type] = (u8)tickCount;
+    return -1;
+}
+
+static void Replay_CarWords(const Car* car, u32* words) {
+    words[0] = (u32)car->position.x;
+    words[1] = (u32)car->position.y;
+    words[2] = (u32)car->speed;
+    words[3] = (u32)car->angle512;
+    words[4] = (u32)car->Lap;
+    words[5] = (u32)car->item;
+}
+
+static inline u32 Replay_TickMs(void) {
+    return (u32)(((u64)simState.tick * MS_PER_SECOND) / RACE_TICK_FREQ);
+}
+
+//=============================================================================
+// PRIVATE HELPERS - Recording (replay task)
+//=============================================================================
+
+static void Replay_WriteDone(bool ok) {
+    if (!ok && !recordFailed) {
+        recordFailed = true;  // No card (or a full one): the replay is lost
+        LOG_WARN("replay write failed");
+    }
+}
+
+static void Replay_SaveDone(bool ok) {
+    available = ok && !recordFailed;
+    if (available)
+        LOG_INFO("replay saved: %u ticks, %u keyframes, %u bytes", header.ticks,
+                 header.keyframes,
+                 (u32)(header.indexOffset + header.keyframes * sizeof(ReplayIndexEntry) +
+                       sizeof(header)));
+    else
+        LOG_WARN("replay not saved: write failed");
+}
+
+// Queues a write; with `wait` (race end) the io queue is stepped until it
+// has room
+static IoRequestId Replay_Queue(const IoWrite* write, bool wait) {
+    IoRequestId id;
+    while ((id = IoQueue_Write(write)) == IO_NO_REQUEST && wait && IoQueue_Step())
+        ;
+    return id;
+}
+
+// Queues the filled buffer to REPLAY_TMP_FILE and switches to the other one.
+// False if the io queue is full: the buffer is kept for the next try.
+static bool Replay_Flush(bool wait) {
+    if (bufferBytes == 0 || recordFailed)
+        return !recordFailed;
+    u8 flags = (fileBytes == 0 ? 0 : IO_APPEND) | IO_KEEP_OPEN;
+    IoWrite write = {REPLAY_TMP_FILE, NULL, flags, {{buffer, (u32)bufferBytes}},
+                     Replay_WriteDone};
+    IoRequestId id = Replay_Queue(&write, wait);
+    if (id == IO_NO_REQUEST)
+        return false;
+    pending[current] = id;
+    current ^= 1;
+    buffer = buffers[current];
+    fileBytes += bufferBytes;
+    bufferBytes = 0;
+    return true;
+}
+
+// Room for `bytes` in a buffer the card is done with, flushing the current
+// one if it is full. Without `wait` false leaves the ticks queued for the
+// next frame; with it (race end) the card is waited for.
+static bool Replay_Reserve(int bytes, bool wait) {
+    if (bufferBytes + bytes > REPLAY_BUFFER_BYTES && !Replay_Flush(wait))
+        return false;
+    if (wait)
+        IoQueue_Wait(pending[current]);
+    return !recordFailed && IoQueue_IsDone(pending[current]);
+}
+
+// Packs the staged state after the ticks coded so far
+static void Replay_WriteKeyframe(void) {
+    bufferBytes += ReplayFormat_EndRun(&coder, buffer + bufferBytes);
+    int room = REPLAY_MAX_KEYFRAME_HEADER + REPLAY_PACK_BOUND(sizeof(SimState));
+
+    // With both buffers still on their way to the card the keyframe is left
+    // out: a seek past it starts from the one before
+    if (header.keyframes < REPLAY_MAX_KEYFRAMES && Replay_Reserve(room, false)) {
+        bool first = (header.keyframes == 0);
+        ReplayKeyframe kf = {staged.tick, stagedInput, stagedConnected,
+                             SimState_Hash(&staged), 0};
+        u8* packed = buffer + bufferBytes + REPLAY_MAX_KEYFRAME_HEADER;
+        kf.bytes = ReplayFormat_PackState((const u8*)&staged,
+                                          first ? NULL : (const u8*)&base,
+                                          sizeof(SimState), packed);
+
+        keyframeIndex[header.keyframes].tick = kf.tick;
+        keyframeIndex[header.keyframes].offset = fileBytes + bufferBytes;
+        header.keyframes++;
+
+        int n = ReplayFormat_PutKeyframe(&coder, &kf, buffer + bufferBytes);
+        memmove(buffer + bufferBytes + n, packed, kf.bytes);
+        bufferBytes += n + kf.bytes;
+        if (first)
+            memcpy(&base, &staged, sizeof(base));
+    }
+    keyframeStaged = false;
+}
+
+static void Replay_RecordStep(bool wait) {
+    u32 words[REPLAY_TICK_MAX_WORDS];
+    while (Replay_Reserve(REPLAY_MAX_TICK_BYTES, wait) &&
+           SpscQueue_PopBatch(&queue, words, 1) == 1) {
+        int following = (int)REPLAY_TICK_FOLLOWING(words[0]);
+        SpscQueue_PopBatch(&queue, words + 1, following);
+
+        int n = ReplayFormat_EncodeTick(&coder, words, 1 + following,
+                                        buffer + bufferBytes);
+        if (n < 0) {
+            recordFailed = true;
+            break;
+        }
+        bufferBytes += n;
+
+        // The tick staged its state right after pushing its words
+        if (keyframeStaged && coder.tick == staged.tick)
+            Replay_WriteKeyframe();
+    }
+    // Early writes keep the buffers small, but only into a free buffer
+    if (bufferBytes >= REPLAY_FLUSH_BYTES && IoQueue_IsDone(pending[current ^ 1]))
+        Replay_Flush(false);
+}
+
+// End tag, then the index and the final header appended by one last queued
+// write, which renames the file over REPLAY_FILE
+static void Replay_Finish(void) {
+    Replay_RecordStep(true);  // Ticks the task had not written (the tick is stopped)
+
+    bool ok = !recordFailed && header.keyframes > 0 &&
+              Replay_Reserve(REPLAY_MAX_TICK_BYTES, true);
+    if (ok) {
+        header.ticks = coder.tick;
+        bufferBytes += ReplayFormat_EndRun(&coder, buffer + bufferBytes);
+        buffer[bufferBytes++] = REPLAY_TAG_END;
+        ok = Replay_Flush(true);
+        header.indexOffset = fileBytes;
+    }
+
+    // A lost recording is only closed; REPLAY_FILE keeps the previous replay
+    IoWrite write = {REPLAY_TMP_FILE, NULL, IO_APPEND, {{NULL, 0}}, NULL};
+    if (ok) {
+        u32 indexBytes = header.keyframes * sizeof(ReplayIndexEntry);
+        write = (IoWrite){REPLAY_FILE, REPLAY_TMP_FILE, IO_APPEND,
+                          {{keyframeIndex, indexBytes}, {&header, sizeof(header)}},
+                          Replay_SaveDone};
+    }
+    finalWrite = Replay_Queue(&write, true);
+    if (!ok || finalWrite == IO_NO_REQUEST) {
+        LOG_WARN("replay not saved (%u ticks, %u dropped)", coder.tick,
+                 SpscQueue_GetDropped(&queue));
+        ok = false;
+    }
+    available = ok;  // Until Replay_SaveDone() says otherwise
+}
+
+//=============================================================================
+// PRIVATE HELPERS - Playback (replay task and seeks)
+//=============================================================================
+
+static inline bool Replay_AtEnd(void) {
+    return readOffset >= header.indexOffset;
+}
+
+static void Replay_SeekStream(u32 offset) {
+    fseek(file, offset, SEEK_SET);
+    readOffset = offset;
+    windowStart = 0;
+    windowEnd = 0;
+    streamEnded = false;
+}
+
+static void Replay_Refill(void) {
+    int unread = windowEnd - windowStart;
+    memmove(buffer, buffer + windowStart, unread);
+    windowStart = 0;
+    windowEnd = unread;
+
+    u32 room = REPLAY_BUFFER_BYTES - unread;
+    u32 left = header.indexOffset - readOffset;
+    u32 want = (left < room) ? left : room;
+    size_t got = fread(buffer + windowEnd, 1, want, file);
+    windowEnd += (int)got;
+    readOffset += (u32)got;
+    if (got < want)
+        readOffset = header.indexOffset;  // Short file: play what there is
+}
+
+static void Replay_Skip(u32 bytes) {
+    u32 unread = (u32)(windowEnd - windowStart);
+    if (bytes <= unread)
+        windowStart += (int)bytes;
+    else
+        Replay_SeekStream(readOffset + (bytes - unread));
+}
+
+// Decodes the next tick into `decoded`, skipping keyframes
+static bool Replay_DecodeNext(void) {
+    while (!streamEnded) {
+        if (windowEnd - windowStart < REPLAY_MAX_TICK_BYTES && !Replay_AtEnd())
+            Replay_Refill();
+        int avail = windowEnd - windowStart;
+        int used = ReplayFormat_Next(&coder, buffer + windowStart, avail, Replay_AtEnd(),
+                                     &decoded);
+        if (used < 0 || decoded.type == REPLAY_REC_END) {
+            if (used < 0)
+                LOG_WARN("replay data error at tick %u", coder.tick);
+            streamEnded = true;
+            break;
+        }
+        windowStart += used;
+        if (decoded.type == REPLAY_REC_KEYFRAME) {
+            Replay_Skip(decoded.keyframe.bytes);
+            continue;
+        }
+        return true;
+    }
+    return false;
+}
+
+// Reads keyframe `k` into `staged` and leaves the stream after it
+static bool Replay_LoadKeyframe(int k) {
+    Replay_SeekStream(keyframeIndex[k].offset);
+    Replay_Refill();
+    int used = ReplayFormat_Next(&coder, buffer, windowEnd, Replay_AtEnd(), &decoded);
+    if (used <= 0 || decoded.type != REPLAY_REC_KEYFRAME)
+        return false;
+    windowStart = used;
+
+    const ReplayKeyframe* kf = &decoded.keyframe;
+    if (kf->bytes > (u32)(windowEnd - windowStart))
+        return false;
+    const u8* against = (k == 0) ? NULL : (const u8*)&base;
+    if (!ReplayFormat_UnpackState(buffer + windowStart, (int)kf->bytes, against,
+                                  sizeof(SimState), (u8*)&staged))
+        return false;
+    windowStart += (int)kf->bytes;
+    hasPending = false;
+    stagedConnected = kf->connected;
+    return staged.tick == kf->tick && SimState_Hash(&staged) == kf->hash;
+}
+
+// Makes the loaded keyframe the live race (tick stopped)
+static void Replay_Restore(void) {
+    SimState_Restore(&staged);
+    connected = stagedConnected;
+    SpscQueue_Init(&queue, queueSlots, REPLAY_QUEUE_WORDS);
+    hasPending = false;
+    queuedTick = staged.tick;
+}
+
+static void Replay_PlayStep(void) {
+    while (queuedTick - simState.tick < REPLAY_LEAD_TICKS) {
+        if (!hasPending) {
+            if (!Replay_DecodeNext())
+                break;
+            hasPending = true;
+        }
+        if (!SpscQueue_PushBatch(&queue, decoded.words, decoded.count))
+            break;  // Queue full of event-heavy ticks: retry next frame
+        hasPending = false;
+        queuedTick++;
+    }
+}
+
+static void Replay_Seek(int deltaTicks) {
+    if (IsPaused() || Race_IsCompleted())
+        return;  // The finish is final: the tick no longer runs to re-simulate
+
+    u32 now = simState.tick;
+    u32 target = (deltaTicks < 0 && now < (u32)-deltaTicks) ? 0 : now + deltaTicks;
+    if (target > header.ticks)
+        target = header.ticks;
+    int k = ReplayFormat_FindKeyframe(keyframeIndex, (int)header.keyframes, target);
+    if (k < 0)
+        return;
+
+    RaceTick_TimerPause();
+    if (Replay_LoadKeyframe(k)) {
+        Replay_Restore();
+        // Re-simulate from the keyframe on the recorded inputs (at most one
+        // keyframe interval)
+        while (simState.tick < target && !Race_IsCompleted() && Replay_DecodeNext()) {
+            SpscQueue_PushBatch(&queue, decoded.words, decoded.count);
+            queuedTick++;
+            Race_Tick();
+        }
+        RaceSnapshot_Reset();
+        RaceSnapshot_Publish();
+        Replay_PlayStep();
+    } else {
+        streamEnded = true;  // The stream position is lost: end the playback here
+        LOG_WARN("replay seek failed at keyframe %d", k);
+    }
+    RaceTick_TimerEnable();
+}
+
+//=============================================================================
+// PRIVATE HELPERS - Session
+//=============================================================================
+
+static void Replay_Step(void) {
+    if (mode == REPLAY_RECORDING)
+        Replay_RecordStep(false);
+    else if (mode == REPLAY_PLAYING)
+        Replay_PlayStep();
+}
+
+static void Replay_RegisterTask(void) {
+    // Normal priority: deferred under load, but the queue covers a few frames
+    if (replayTask == SCHED_NO_TASK)
+        replayTask = Scheduler_Register("replay", Replay_Step, SCHED_PRIO_NORMAL, 1,
+                                        SCHED_BUDGET_REPLAY);
+}
+
+static void Replay_CloseFile(void) {
+    if (file != NULL)
+        fclose(file);
+    file = NULL;
+}
+
+// The previous recording may still be on its way to the card: its buffers,
+// index and header are not reused, nor REPLAY_FILE read, until it is written
+static void Replay_WaitWrites(void) {
+    IoQueue_Wait(pending[0]);
+    IoQueue_Wait(pending[1]);
+    IoQueue_Wait(finalWrite);
+}
+
+// The leading header names the build and the map; the final one, at the end
+// of the file, locates the index that ends right before it
+static bool Replay_ReadHeader(Map map) {
+    ReplayHeader lead;
+    long trailer = -1;
+    bool ok = fread(&lead, sizeof(lead), 1, file) == 1 &&
+              fseek(file, -(long)sizeof(header), SEEK_END) == 0 &&
+              (trailer = ftell(file)) > (long)sizeof(header) &&
+              fread(&header, sizeof(header), 1, file) == 1;
+    return ok && memcmp(&lead, &header, offsetof(ReplayHeader, ticks)) == 0 &&
+           header.magic == REPLAY_MAGIC && header.version == REPLAY_VERSION &&
+           header.headerSize == sizeof(ReplayHeader) &&
+           header.stateSize == sizeof(SimState) && header.map == (u16)map &&
+           header.keyframes > 0 && header.keyframes <= REPLAY_MAX_KEYFRAMES &&
+           header.indexOffset >= sizeof(ReplayHeader) &&
+           header.indexOffset + header.keyframes * sizeof(ReplayIndexEntry) ==
+               (u32)trailer;
+}
+
+//=============================================================================
+// PUBLIC API - Session
+//=============================================================================
+
+void Replay_BeginRecording(Map map, GameMode gameMode) {
+    Replay_RegisterTask();
+    Replay_CloseFile();
+    Replay_WaitWrites();
+    mode = REPLAY_IDLE;
+    available = false;
+
+    memset(&header, 0, sizeof(header));
+    header.magic = REPLAY_MAGIC;
+    header.version = REPLAY_VERSION;
+    header.headerSize = sizeof(ReplayHeader);
+    header.stateSize = sizeof(SimState);
+    header.map = (u16)map;
+    header.mode = (u16)gameMode;
+    header.keyframeTicks = REPLAY_KEYFRAME_TICKS;
+
+    // Leading header (indexOffset 0); Replay_Finish() appends the final one
+    current = 0;
+    buffer = buffers[0];
+    memcpy(buffer, &header, sizeof(header));
+    bufferBytes = sizeof(header);
+    fileBytes = 0;
+    recordFailed = false;
+    keyframeStaged = false;
+    SpscQueue_Init(&queue, queueSlots, REPLAY_QUEUE_WORDS);
+    ReplayFormat_Reset(&coder, 0, 0);
+    mode = REPLAY_RECORDING;
+}
+
+void Replay_MarkStart(void) {
+    if (mode != REPLAY_RECORDING)
+        return;
+    connected = Replay_SampleConnected();
+    SimState_Save(&staged);
+    stagedInput = 0;
+    stagedConnected = connected;
+    Replay_WriteKeyframe();
+}
+
+bool Replay_BeginPlayback(Map map) {
+    Replay_RegisterTask();
+    Replay_CloseFile();
+    Replay_WaitWrites();
+    mode = REPLAY_IDLE;
+    speed = 1;
+
+    file = fopen(REPLAY_FILE, "rb");
+    if (file == NULL)
+        return false;
+
+    current = 0;
+    buffer = buffers[0];
+    bool ok = Replay_ReadHeader(map);
+    ok = ok && fseek(file, header.indexOffset, SEEK_SET) == 0 &&
+         fread(keyframeIndex, sizeof(ReplayIndexEntry), header.keyframes, file) ==
+             header.keyframes;
+    ok = ok && Replay_LoadKeyframe(0);
+    if (!ok) {
+        LOG_WARN("replay of map %d unreadable", map);
+        Replay_CloseFile();
+        return false;
+    }
+
+    memcpy(&base, &staged, sizeof(base));
+    Replay_Restore();
+    mode = REPLAY_PLAYING;
+    Replay_PlayStep();
+    LOG_INFO("replay playback: %u ticks, %u keyframes", header.ticks, header.keyframes);
+    return true;
+}
+
+void Replay_Update(int keysdown) {
+    if (mode != REPLAY_PLAYING)
+        return;
+
+    if (keysdown & KEY_R) {
+        int next = 0;
+        for (int i = 0; i < 2; i++) {
+            if (PlaybackSpeeds[i] == speed)
+                next = i + 1;
+        }
+        speed = PlaybackSpeeds[next];
+    }
+    if (keysdown & KEY_LEFT)
+        Replay_Seek(-REPLAY_SEEK_TICKS);
+    else if (keysdown & KEY_RIGHT)
+        Replay_Seek(REPLAY_SEEK_TICKS);
+}
+
+void Replay_Cleanup(void) {
+    if (mode == REPLAY_RECORDING)
+        Replay_Finish();
+    mode = REPLAY_IDLE;
+    speed = 1;
+    inTick = false;
+    Replay_CloseFile();
+}
+
+bool Replay_IsAvailable(void) {
+    return available;
+}
+
+bool Replay_IsPlaying(void) {
+    return mode == REPLAY_PLAYING;
+}
+
+int Replay_GetSpeed(void) {
+    return (mode == REPLAY_PLAYING) ? speed : 1;
+}
+
+u32 Replay_GetClockMs(void) {
+    return (mode == REPLAY_PLAYING) ? Replay_TickMs() : RaceTick_GetElapsedMs();
+}
+
+//=============================================================================
+// PUBLIC API - Race tick inputs
+//=============================================================================
+
+bool Replay_BeginTick(void) {
+    if (mode == REPLAY_PLAYING) {
+        if (SpscQueue_PopBatch(&queue, tickWords, 1) != 1)
+            return false;  // The task has not decoded this far yet
+        tickCount = 1 + (int)REPLAY_TICK_FOLLOWING(tickWords[0]);
+        SpscQueue_PopBatch(&queue, tickWords + 1, tickCount - 1);
+        tickInput = (u16)REPLAY_TICK_INPUT(tickWords[0]);
+        memset(cursors, 1, sizeof(cursors));
+
+        int at = Replay_NextEvent(REPLAY_EV_CONNECTED);
+        if (at > 0)
+            connected = (u8)SPSC_EVENT_PAYLOAD(tickWords[at]);
+    } else {
+        scanKeys();
+        tickInput = (u16)(keysHeld() & REPLAY_KEY_MASK);
+        tickCount = 1;
+
+        u8 now = Replay_SampleConnected();
+        if (now != connected) {
+            connected = now;
+            u32 event = SPSC_EVENT(REPLAY_EV_CONNECTED, now);
+            Replay_Record(&event, 1);
+        }
+    }
+    inTick = true;
+    return true;
+}
+
+u32 Replay_GetKeys(void) {
+    return tickInput & REPLAY_KEY_MASK;
+}
+
+bool Replay_Poll(ReplayPoll poll, SchedTaskId task) {
+    u16 bit = (u16)REPLAY_INPUT_POLL(poll);
+    if (mode == REPLAY_PLAYING)
+        return (tickInput & bit) != 0;
+
+    bool due = Scheduler_Poll(task);
+    if (due)
+        tickInput |= bit;
+    return due;
+}
+
+u32 Replay_NowMs(void) {
+    if (mode == REPLAY_PLAYING) {
+        int at = Replay_NextEvent(REPLAY_EV_NOW_MS);
+        return (at > 0) ? tickWords[at + 1] : Replay_TickMs();
+    }
+
+    u32 ms = RaceTick_GetElapsedMs();
+    u32 event[2] = {SPSC_EVENT(REPLAY_EV_NOW_MS, 0), ms};
+    Replay_Record(event, 2);
+    return ms;
+}
+
+bool Replay_IsPlayerConnected(int player) {
+    if (mode != REPLAY_PLAYING && !inTick)
+        return Multiplayer_IsPlayerConnected(player);
+    return (connected >> player) & 1;
+}
+
+void Replay_ReceiveCarStates(Car* cars, int carCount) {
+    if (mode == REPLAY_PLAYING) {
+        int at;
+        while ((at = Replay_NextEvent(REPLAY_EV_CAR)) > 0) {
+            int c = (int)SPSC_EVENT_PAYLOAD(tickWords[at]);
+            const u32* w = &tickWords[at + 1];
+            if (c >= carCount)
+                continue;
+            cars[c].position.x = (Q16_8)w[0];
+            cars[c].position.y = (Q16_8)w[1];
+            cars[c].speed = (Q16_8)w[2];
+            cars[c].angle512 = (int)w[3];
+            cars[c].Lap = (int)w[4];
+            cars[c].item = (Item)w[5];
+        }
+        return;
+    }
+    if (mode != REPLAY_RECORDING) {
+        Multiplayer_ReceiveCarStates(cars, carCount);
+        return;
+    }
+
+    // Record the remote cars the packets changed
+    static u32 before[MAX_CARS][CAR_WORDS];  // Static: the ISR stack is small
+    int count = (carCount < MAX_CARS) ? carCount : MAX_CARS;
+    for (int c = 0; c < count; c++)
+        Replay_CarWords(&cars[c], before[c]);
+    Multiplayer_ReceiveCarStates(cars, carCount);
+
+    for (int c = 0; c < count; c++) {
+        u32 event[1 + CAR_WORDS];
+        Replay_CarWords(&cars[c], event + 1);
+        if (memcmp(event + 1, before[c], sizeof(before[c])) != 0) {
+            event[0] = SPSC_EVENT(REPLAY_EV_CAR, c);
+            Replay_Record(event, 1 + CAR_WORDS);
+        }
+    }
+}
+
+ItemPlacementData Replay_ReceiveItemPlacement(void) {
+    ItemPlacementData data;
+    if (mode == REPLAY_PLAYING) {
+        memset(&data, 0, sizeof(data));
+        int at = Replay_NextEvent(REPLAY_EV_ITEM);
+        if (at < 0)
+            return data;  // valid = false: none left this tick
+        u32 payload = SPSC_EVENT_PAYLOAD(tickWords[at]);
+        data.valid = true;
+        data.itemType = (Item)(payload & 0xFF);
+        data.shooterCarIndex = (s8)(payload >> 8);
+        data.playerID = (u8)(payload >> 16);
+        data.position.x = (Q16_8)tickWords[at + 1];
+        data.position.y = (Q16_8)tickWords[at + 2];
+        data.angle512 = (int)tickWords[at + 3];
+        data.speed = (Q16_8)tickWords[at + 4];
+        return data;
+    }
+
+    data = Multiplayer_ReceiveItemPlacements();
+    if (data.valid) {
+        u32 payload = ((u32)data.itemType & 0xFF) | ((u32)(u8)data.shooterCarIndex << 8) |
+                      ((u32)data.playerID << 16);
+        u32 event[5] = {SPSC_EVENT(REPLAY_EV_ITEM, payload), (u32)data.position.x,
+                        (u32)data.position.y, (u32)data.angle512, (u32)data.speed};
+        Replay_Record(event, 5);
+    }
+    return data;
+}
+
+int Replay_ReceiveItemBoxPickup(void) {
+    if (mode == REPLAY_PLAYING) {
+        int at = Replay_NextEvent(REPLAY_EV_BOX);
+        return (at > 0) ? (int)SPSC_EVENT_PAYLOAD(tickWords[at]) : -1;
+    }
+
+    int boxIndex = Multiplayer_ReceiveItemBoxPickup();
+    if (boxIndex >= 0) {
+        u32 event = SPSC_EVENT(REPLAY_EV_BOX, boxIndex);
+        Replay_Record(&event, 1);
+    }
+    return boxIndex;
+}
+
+void Replay_EndTick(void) {
+    inTick = false;
+    if (mode != REPLAY_RECORDING)
+        return;
+
+    tickWords[0] = REPLAY_TICK_WORD(tickInput, tickCount - 1);
+    if (!SpscQueue_PushBatch(&queue, tickWords, tickCount))
+        recordFailed = true;  // The task fell a queue behind: the replay is lost
+
+    if (simState.tick % REPLAY_KEYFRAME_TICKS == 0 && !keyframeStaged) {
+        SimState_Save(&staged);
+        stagedInput = tickInput;
+        stagedConnected = connected;
+        keyframeStaged = true;
+    }
+}
@@ -0,0 +1,208 @@
+/**
+ * File: replay.h
+ * --------------
+ * Description: Full race replays. Every race records what its ticks read
+ *              from outside the simulation (keys, scheduler polls, chrono at
+ *              the line, network receives) plus a keyframe of the whole
+ *              SimState every REPLAY_KEYFRAME_TICKS, into REPLAY_FILE
+ *              (replay_format.h). Playing a replay restores the first
+ *              keyframe and runs the normal race tick on the recorded inputs,
+ *              so all karts, items and item boxes move exactly as they did.
+ *              Playback runs at 1x, 4x or 16x and seeks by restoring the
+ *              nearest keyframe and re-simulating at most one interval.
+ *
+ * The race tick (TIMER0 ISR) gets its inputs through the Replay_* hooks
+ * below instead of keysHeld(), Scheduler_Poll(), RaceTick_GetElapsedMs() and
+ * the Multiplayer_Receive* calls. It exchanges one batch of words per tick
+ * with the "replay" scheduler task through an SPSC queue: recording, the tick
+ * produces and the task encodes and writes; playing, the task reads and
+ * decodes ahead and the tick consumes. Neither side touches the card in the
+ * ISR.
+ *
+ * Usage:
+ *   Gameplay_Initialize:  Race_Init();
+ *                         if (!(replay mode && Replay_BeginPlayback(map)))
+ *                             Replay_BeginRecording(map, mode);
+ *   updateCountdown:      Replay_MarkStart(); RaceTick_TimerInit();
+ *   Race_Tick:            if (!Replay_BeginTick()) return; ... Replay_EndTick();
+ *   Gameplay_Update:      Replay_Update();  // playback speed and seeking
+ *   Gameplay_Cleanup:     Replay_Cleanup(); // finalizes the recording
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <nds.h>
+#include <stdbool.h>
+
+#include "../core/game_types.h"
+#include "../core/scheduler.h"
+#include "../network/multiplayer.h"
+#include "Car.h"
+#include "gameplay_logic.h"
+#include "replay_format.h"
+
+//=============================================================================
+// PUBLIC API - Session (main loop)
+//=============================================================================
+
+/**
+ * Function: Replay_BeginRecording
+ * -------------------------------
+ * Starts a recording to REPLAY_TMP_FILE, written through the SD write queue
+ * (io_queue.h). Nothing is recorded until Replay_MarkStart(). Without a card
+ * the first write fails and the race runs unrecorded.
+ */
+void Replay_BeginRecording(Map map, GameMode mode);
+
+/**
+ * Function: Replay_MarkStart
+ * --------------------------
+ * Writes keyframe 0, the state the first race tick starts from. Call when
+ * the countdown ends, before the tick timer starts.
+ */
+void Replay_MarkStart(void);
+
+/**
+ * Function: Replay_BeginPlayback
+ * ------------------------------
+ * Opens REPLAY_FILE and replaces the live race with its first keyframe. Call
+ * after Race_Init(); then start the tick timer (the countdown is over in the
+ * restored state).
+ *
+ * Returns: false if there is no finalized replay of `map` for this build
+ *          (the race stays as Race_Init() left it)
+ */
+bool Replay_BeginPlayback(Map map);
+
+/**
+ * Function: Replay_Update
+ * -----------------------
+ * Playback controls, once per frame: R cycles 1x/4x/16x, LEFT and RIGHT seek
+ * REPLAY_SEEK_TICKS back and forward. Seeking pauses the tick while the
+ * keyframe is restored and re-simulated.
+ *
+ * Parameters:
+ *   keysdown - keysDown() of this frame
+ */
+void Replay_Update(int keysdown);
+
+/**
+ * Function: Replay_Cleanup
+ * ------------------------
+ * Ends the session. A recording is finished: the end tag, then the keyframe
+ * index and final header as the last queued write, which renames the file to
+ * REPLAY_FILE. Call after the tick timer stopped.
+ */
+void Replay_Cleanup(void);
+
+/**
+ * Function: Replay_IsAvailable
+ * ----------------------------
+ * Whether the race that just ended left a replay in REPLAY_FILE (or its last
+ * write is still queued; Replay_BeginPlayback() waits for it).
+ */
+bool Replay_IsAvailable(void);
+
+/**
+ * Function: Replay_IsPlaying
+ * --------------------------
+ * Whether the race is a replay (inputs come from the file; nothing is sent
+ * to the network or saved as a record).
+ */
+bool Replay_IsPlaying(void);
+
+/**
+ * Function: Replay_GetSpeed
+ * -------------------------
+ * Race ticks per TIMER0 period: 1 live, 1, 4 or 16 during playback.
+ */
+int Replay_GetSpeed(void);
+
+/**
+ * Function: Replay_GetClockMs
+ * ---------------------------
+ * Race chrono for the HUD: RaceTick_GetElapsedMs() live, the replayed race's
+ * time during playback.
+ */
+u32 Replay_GetClockMs(void);
+
+//=============================================================================
+// PUBLIC API - Race tick inputs (TIMER0 ISR, or the main loop while seeking)
+//=============================================================================
+
+/**
+ * Function: Replay_BeginTick
+ * --------------------------
+ * Takes this tick's inputs: samples the keys (live) or pops the next
+ * decoded tick (playback).
+ *
+ * Returns: false if playback has no decoded tick ready (skip the tick)
+ */
+bool Replay_BeginTick(void);
+
+/**
+ * Function: Replay_GetKeys
+ * ------------------------
+ * keysHeld() of this tick (REPLAY_KEY_MASK bits).
+ */
+u32 Replay_GetKeys(void);
+
+/**
+ * Function: Replay_Poll
+ * ---------------------
+ * Scheduler_Poll() of a task the tick polls; the result is part of the
+ * tick's input, so a replay sheds the same work the race did.
+ */
+bool Replay_Poll(ReplayPoll poll, SchedTaskId task);
+
+/**
+ * Function: Replay_NowMs
+ * ----------------------
+ * Race chrono read at the finish line (recorded, so replayed laps get the
+ * recorded times).
+ */
+u32 Replay_NowMs(void);
+
+/**
+ * Function: Replay_IsPlayerConnected
+ * ----------------------------------
+ * Multiplayer_IsPlayerConnected() as sampled at the start of the tick.
+ * Outside a tick (renderers) it asks the network, except during playback.
+ */
+bool Replay_IsPlayerConnected(int player);
+
+/**
+ * Function: Replay_ReceiveCarStates
+ * ---------------------------------
+ * Multiplayer_ReceiveCarStates(); the remote cars it changed are recorded.
+ */
+void Replay_ReceiveCarStates(Car* cars, int carCount);
+
+/**
+ * Function: Replay_ReceiveItemPlacement
+ * -------------------------------------
+ * Multiplayer_ReceiveItemPlacements(), recorded.
+ */
+ItemPlacementData Replay_ReceiveItemPlacement(void);
+
+/**
+ * Function: Replay_ReceiveItemBoxPickup
+ * -------------------------------------
+ * Multiplayer_ReceiveItemBoxPickup(), recorded.
+ */
+int Replay_ReceiveItemBoxPickup(void);
+
+/**
+ * Function: Replay_EndTick
+ * ------------------------
+ * Hands the tick's inputs to the replay task (recording) and stages a
+ * keyframe copy of the state every REPLAY_KEYFRAME_TICKS.
+ */
+void Replay_EndTick(void);
+
+#endif  // REPLAY_H
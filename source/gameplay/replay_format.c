@@ -0,0 +1,424 @@
+/**
+ * File: replay_format.c
+ * ---------------------
+ * Description: Implementation of the replay record coder, the keyframe state
+ *              packer and the index search.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "replay_format.h"
+
+#include <string.h>
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define CAR_WORDS 6    // x, y, speed, angle, lap, item
+#define ITEM_WORDS 4   // x, y, angle, speed
+#define MIN_EQUAL_RUN 3  // Unchanged bytes that end a packed literal
+
+//=============================================================================
+// PRIVATE HELPERS - Varints
+//=============================================================================
+
+static int ReplayFormat_PutVarint(u8* out, u32 v) {
+    int n = 0;
+    while (v >= 0x80) {
+        out[n++] = (u8)(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (u8)v;
+    return n;
+}
+
+static inline int ReplayFormat_PutSigned(u8* out, s32 value) {
+    return ReplayFormat_PutVarint(out, ((u32)value << 1) ^ (u32)(value >> 31));
+}
+
+// Returns bytes read, 0 if the varint runs past `avail`, -1 if too long
+static int ReplayFormat_GetVarint(const u8* in, int avail, u32* value) {
+    u32 v = 0;
+    for (int n = 0; n < 5; n++) {
+        if (n >= avail)
+            return 0;
+        v |= (u32)(in[n] & 0x7F) << (7 * n);
+        if (!(in[n] & 0x80)) {
+            *value = v;
+            return n + 1;
+        }
+    }
+    return -1;
+}
+
+static inline u32 ReplayFormat_UnZigZag(u32 v) {
+    return (v >> 1) ^ (u32)(-(s32)(v & 1));
+}
+
+//=============================================================================
+// PRIVATE HELPERS - Events
+//=============================================================================
+
+// Writes the events words[1..count) as records; -1 if malformed
+static int ReplayFormat_EncodeEvents(const u32* words, int count, u8* out) {
+    int n = 0;
+    for (int i = 1; i < count;) {
+        u32 type = SPSC_EVENT_TYPE(words[i]);
+        u32 payload = SPSC_EVENT_PAYLOAD(words[i]);
+        int extra = ReplayFormat_EventWords(type);
+        if (extra < 0 || i + extra >= count)
+            return -1;
+        const u32* data = &words[i + 1];
+
+        switch (type) {
+            case REPLAY_EV_CONNECTED:
+                out[n++] = REPLAY_TAG_CONNECTED;
+                out[n++] = (u8)payload;
+                break;
+            case REPLAY_EV_BOX:
+                out[n++] = REPLAY_TAG_BOX;
+                out[n++] = (u8)payload;
+                break;
+            case REPLAY_EV_NOW_MS:
+                out[n++] = REPLAY_TAG_NOW_MS;
+                n += ReplayFormat_PutVarint(out + n, data[0]);
+                break;
+            case REPLAY_EV_CAR:
+                out[n++] = REPLAY_TAG_CAR;
+                out[n++] = (u8)payload;
+                for (int w = 0; w < CAR_WORDS; w++)
+                    n += ReplayFormat_PutSigned(out + n, (s32)data[w]);
+                break;
+            case REPLAY_EV_ITEM:
+                out[n++] = REPLAY_TAG_ITEM;
+                out[n++] = (u8)payload;          // Type
+                out[n++] = (u8)(payload >> 8);   // Shooter
+                out[n++] = (u8)(payload >> 16);  // Player
+                for (int w = 0; w < ITEM_WORDS; w++)
+                    n += ReplayFormat_PutSigned(out + n, (s32)data[w]);
+                break;
+        }
+        i += 1 + extra;
+    }
+    return n;
+}
+
+// Reads one event record into words; bytes read, 0 if cut, -1 if bad
+static int ReplayFormat_DecodeEvent(const u8* in, int avail, u32* words, int room,
+                                    int* written) {
+    u8 tag = in[0];
+    int n = 1;
+    u32 v;
+    int used;
+
+    switch (tag) {
+        case REPLAY_TAG_CONNECTED:
+        case REPLAY_TAG_BOX: {
+            if (avail < 2)
+                return 0;
+            if (room < 1)
+                return -1;
+            u32 type = (tag == REPLAY_TAG_BOX) ? REPLAY_EV_BOX : REPLAY_EV_CONNECTED;
+            words[0] = SPSC_EVENT(type, in[1]);
+            *written = 1;
+            return 2;
+        }
+        case REPLAY_TAG_NOW_MS:
+            if (room < 2)
+                return -1;
+            used = ReplayFormat_GetVarint(in + n, avail - n, &v);
+            if (used <= 0)
+                return used;
+            words[0] = SPSC_EVENT(REPLAY_EV_NOW_MS, 0);
+            words[1] = v;
+            *written = 2;
+            return n + used;
+        case REPLAY_TAG_CAR:
+        case REPLAY_TAG_ITEM: {
+            bool car = (tag == REPLAY_TAG_CAR);
+            int fixed = car ? 1 : 3;
+            int extra = car ? CAR_WORDS : ITEM_WORDS;
+            if (avail < 1 + fixed)
+                return 0;
+            if (room < 1 + extra)
+                return -1;
+            u32 payload = in[1];
+            if (!car)
+                payload |= ((u32)in[2] << 8) | ((u32)in[3] << 16);
+            words[0] = SPSC_EVENT(car ? REPLAY_EV_CAR : REPLAY_EV_ITEM, payload);
+            n += fixed;
+            for (int w = 0; w < extra; w++) {
+                used = ReplayFormat_GetVarint(in + n, avail - n, &v);
+                if (used <= 0)
+                    return used;
+                words[1 + w] = ReplayFormat_UnZigZag(v);
+                n += used;
+            }
+            *written = 1 + extra;
+            return n;
+        }
+        default:
+            return -1;
+    }
+}
+
+static inline bool ReplayFormat_StartsTick(u8 tag) {
+    return tag < REPLAY_MAX_RUN || tag == REPLAY_TAG_INPUT;
+}
+
+//=============================================================================
+// PUBLIC API - Records
+//=============================================================================
+
+int ReplayFormat_EventWords(u32 type) {
+    switch (type) {
+        case REPLAY_EV_NOW_MS:
+            return 1;
+        case REPLAY_EV_CAR:
+            return CAR_WORDS;
+        case REPLAY_EV_ITEM:
+            return ITEM_WORDS;
+        case REPLAY_EV_CONNECTED:
+        case REPLAY_EV_BOX:
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+void ReplayFormat_Reset(ReplayCoder* coder, u32 tick, u16 input) {
+    coder->tick = tick;
+    coder->input = input;
+    coder->run = 0;
+}
+
+int ReplayFormat_EndRun(ReplayCoder* coder, u8* out) {
+    if (coder->run == 0)
+        return 0;
+    out[0] = (u8)(coder->run - 1);
+    coder->run = 0;
+    return 1;
+}
+
+int ReplayFormat_EncodeTick(ReplayCoder* coder, const u32* words, int count, u8* out) {
+    if (count < 1 || SPSC_EVENT_TYPE(words[0]) != REPLAY_EV_TICK)
+        return -1;
+    u16 input = (u16)REPLAY_TICK_INPUT(words[0]);
+    int n = 0;
+
+    if (input == coder->input) {
+        // Joins the run; a tick with events ends it (they follow its tag)
+        coder->run++;
+        if (count > 1 || coder->run == REPLAY_MAX_RUN)
+            n += ReplayFormat_EndRun(coder, out);
+    } else {
+        n += ReplayFormat_EndRun(coder, out);
+        out[n++] = REPLAY_TAG_INPUT;
+        out[n++] = (u8)input;
+        out[n++] = (u8)(input >> 8);
+        coder->input = input;
+    }
+
+    int events = ReplayFormat_EncodeEvents(words, count, out + n);
+    if (events < 0)
+        return -1;
+    coder->tick++;
+    return n + events;
+}
+
+int ReplayFormat_PutKeyframe(ReplayCoder* coder, const ReplayKeyframe* keyframe,
+                             u8* out) {
+    int n = 0;
+    out[n++] = REPLAY_TAG_KEYFRAME;
+    n += ReplayFormat_PutVarint(out + n, keyframe->tick);
+    out[n++] = (u8)keyframe->input;
+    out[n++] = (u8)(keyframe->input >> 8);
+    out[n++] = keyframe->connected;
+    memcpy(out + n, &keyframe->hash, sizeof(keyframe->hash));
+    n += sizeof(keyframe->hash);
+    n += ReplayFormat_PutVarint(out + n, keyframe->bytes);
+    ReplayFormat_Reset(coder, keyframe->tick, keyframe->input);
+    return n;
+}
+
+static int ReplayFormat_GetKeyframe(ReplayCoder* coder, const u8* in, int avail,
+                                    bool final, ReplayRecord* rec) {
+    ReplayKeyframe* kf = &rec->keyframe;
+    int n = 1;
+    int used = ReplayFormat_GetVarint(in + n, avail - n, &kf->tick);
+    if (used <= 0)
+        goto cut;
+    n += used;
+    if (avail - n < 7)
+        goto cut;
+    kf->input = (u16)(in[n] | (in[n + 1] << 8));
+    kf->connected = in[n + 2];
+    memcpy(&kf->hash, in + n + 3, sizeof(kf->hash));
+    n += 7;
+    used = ReplayFormat_GetVarint(in + n, avail - n, &kf->bytes);
+    if (used <= 0)
+        goto cut;
+    n += used;
+
+    rec->type = REPLAY_REC_KEYFRAME;
+    ReplayFormat_Reset(coder, kf->tick, kf->input);
+    return n;
+
+cut:
+    return (used < 0 || final) ? REPLAY_BAD_DATA : REPLAY_NEED_MORE;
+}
+
+int ReplayFormat_Next(ReplayCoder* coder, const u8* in, int avail, bool final,
+                      ReplayRecord* rec) {
+    ReplayCoder c = *coder;
+    int n = 0;
+
+    if (c.run > 1) {
+        // Inside a run: a tick with the previous input and no events
+        c.run--;
+    } else if (c.run == 1) {
+        c.run = 0;  // Last tick of the run: its events follow
+    } else {
+        if (avail < 1)
+            return final ? REPLAY_BAD_DATA : REPLAY_NEED_MORE;
+        u8 tag = in[0];
+        if (tag == REPLAY_TAG_END) {
+            rec->type = REPLAY_REC_END;
+            return 1;
+        }
+        if (tag == REPLAY_TAG_KEYFRAME)
+            return ReplayFormat_GetKeyframe(coder, in, avail, final, rec);
+
+        if (tag < REPLAY_MAX_RUN) {
+            c.run = tag;  // Ticks of the run after this one
+            n = 1;
+        } else if (tag == REPLAY_TAG_INPUT) {
+            if (avail < 3)
+                return final ? REPLAY_BAD_DATA : REPLAY_NEED_MORE;
+            c.input = (u16)(in[1] | (in[2] << 8));
+            n = 3;
+        } else {
+            return REPLAY_BAD_DATA;  // Event outside a tick
+        }
+    }
+
+    // Events of this tick, up to the next record that starts something else
+    int count = 1;
+    if (c.run == 0) {
+        while (true) {
+            if (n >= avail) {
+                if (final)
+                    break;
+                return REPLAY_NEED_MORE;
+            }
+            u8 tag = in[n];
+            if (ReplayFormat_StartsTick(tag) || tag == REPLAY_TAG_KEYFRAME ||
+                tag == REPLAY_TAG_END)
+                break;
+
+            int written = 0;
+            int used = ReplayFormat_DecodeEvent(in + n, avail - n, rec->words + count,
+                                                REPLAY_TICK_MAX_WORDS - count, &written);
+            if (used < 0)
+                return REPLAY_BAD_DATA;
+            if (used == 0)
+                return final ? REPLAY_BAD_DATA : REPLAY_NEED_MORE;
+            n += used;
+            count += written;
+        }
+    }
+
+    rec->type = REPLAY_REC_TICK;
+    rec->count = count;
+    rec->words[0] = REPLAY_TICK_WORD(c.input, count - 1);
+    c.tick++;
+    *coder = c;
+    return n;
+}
+
+//=============================================================================
+// PUBLIC API - Keyframes
+//=============================================================================
+
+static inline u8 ReplayFormat_Base(const u8* base, int i) {
+    return base ? base[i] : 0;
+}
+
+int ReplayFormat_PackState(const u8* state, const u8* base, int size, u8* out) {
+    int n = 0;
+    int i = 0;
+    while (i < size) {
+        int same = i;
+        while (same < size && state[same] == ReplayFormat_Base(base, same))
+            same++;
+
+        // Literal until MIN_EQUAL_RUN unchanged bytes (or the end)
+        int end = same;
+        while (end < size) {
+            if (state[end] != ReplayFormat_Base(base, end)) {
+                end++;
+                continue;
+            }
+            int run = 0;
+            while (end + run < size && run < MIN_EQUAL_RUN &&
+                   state[end + run] == ReplayFormat_Base(base, end + run))
+                run++;
+            if (run >= MIN_EQUAL_RUN || end + run == size)
+                break;
+            end += run;
+        }
+
+        n += ReplayFormat_PutVarint(out + n, (u32)(same - i));
+        n += ReplayFormat_PutVarint(out + n, (u32)(end - same));
+        for (int k = same; k < end; k++)
+            out[n++] = state[k] ^ ReplayFormat_Base(base, k);
+        i = end;
+    }
+    return n;
+}
+
+bool ReplayFormat_UnpackState(const u8* in, int bytes, const u8* base, int size,
+                              u8* state) {
+    int n = 0;
+    int i = 0;
+    while (i < size) {
+        u32 same, changed;
+        int used = ReplayFormat_GetVarint(in + n, bytes - n, &same);
+        if (used <= 0)
+            return false;
+        n += used;
+        used = ReplayFormat_GetVarint(in + n, bytes - n, &changed);
+        if (used <= 0)
+            return false;
+        n += used;
+        if (same > (u32)(size - i) || changed > (u32)(size - i) - same ||
+            changed > (u32)(bytes - n))
+            return false;
+
+        for (u32 k = 0; k < same; k++, i++)
+            state[i] = ReplayFormat_Base(base, i);
+        for (u32 k = 0; k < changed; k++, i++)
+            state[i] = in[n++] ^ ReplayFormat_Base(base, i);
+        if (same == 0 && changed == 0)
+            return false;  // No progress
+    }
+    return n == bytes;
+}
+
+int ReplayFormat_FindKeyframe(const ReplayIndexEntry* index, int count, u32 tick) {
+    int lo = 0;
+    int hi = count - 1;
+    int found = -1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (index[mid].tick <= tick) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return found;
+}
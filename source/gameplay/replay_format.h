@@ -0,0 +1,286 @@
+/**
+ * File: replay_format.h
+ * ---------------------
+ * Description: Race replay file format: the inputs of every race tick, a
+ *              compact copy of the whole SimState every few seconds
+ *              (keyframe) and an index of the keyframes. Replaying a race is
+ *              restoring a keyframe and running the race tick on the recorded
+ *              inputs, so seeking to any tick costs at most one keyframe
+ *              interval of re-simulation.
+ *
+ * Inputs are what the race tick reads from outside SimState: the keys and
+ * the scheduler polls (together the tick's 16-bit input), the chrono at the
+ * finish line, and in multiplayer the car states, item placements, box
+ * pickups and connected players received from the network. The tick and the
+ * replay task exchange them as SPSC event words (spsc_queue.h); the file
+ * stores them as byte records.
+ *
+ * File layout (little-endian):
+ *   ReplayHeader  leading copy: ticks, keyframes and indexOffset are 0
+ *   records   tick runs, input changes, events, keyframes, then REPLAY_TAG_END
+ *   index     ReplayIndexEntry per keyframe (header.indexOffset)
+ *   ReplayHeader  final copy, the last bytes of the file
+ *
+ * The file is only ever appended to (the SD write queue cannot seek), so the
+ * final header follows the index instead of replacing the leading one.
+ * Readers take it from the end and check that the index ends where it starts.
+ *
+ * Records (first byte):
+ *   0x00-0x7F  run of (byte + 1) ticks with the previous input; events that
+ *              follow belong to the last tick of the run
+ *   INPUT      one tick with a new input (u16)
+ *   NOW_MS     varint ms
+ *   CAR        u8 car, zigzag varints x, y, speed, angle, lap, item
+ *   ITEM       u8 type, s8 shooter, u8 player, zigzag varints x, y, angle, speed
+ *   BOX        u8 box index
+ *   CONNECTED  u8 player mask
+ *   KEYFRAME   varint tick, u16 input, u8 mask, u32 hash, varint size, packed
+ *              SimState (after that tick, XOR keyframe 0; keyframe 0 XOR zero)
+ *   END        end of the records
+ *
+ * The due polls change the input only under load (the retarget poll is due
+ * every tick, the network poll only exists in multiplayer), so a race is
+ * mostly runs: about one byte per two seconds of unchanged keys.
+ *
+ * Packed state: (varint unchanged bytes, varint changed bytes, changed bytes
+ * XOR base) until the state is covered.
+ *
+ * Builds on the host (no libnds) for tools and benchmarks.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef REPLAY_FORMAT_H
+#define REPLAY_FORMAT_H
+
+#include <stdbool.h>
+
+#ifdef ARM9
+#include <nds.h>
+#else
+#include <stdint.h>
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef int32_t s32;
+typedef uint32_t u32;
+#endif
+
+#include "../core/spsc_queue.h"
+
+//=============================================================================
+// PUBLIC CONSTANTS
+//=============================================================================
+
+#define REPLAY_MAGIC 0x50524D4B  // "KMRP"
+#define REPLAY_VERSION 2  // 2: final header at the end of the file
+
+#define REPLAY_KEY_MASK 0x3FFF        // keysHeld() bits recorded (A .. LID)
+#define REPLAY_INPUT_POLL(poll) (1u << (14 + (poll)))  // Due poll bits of the input
+#define REPLAY_TICK_MAX_WORDS 128     // Event words of one tick, TICK word included
+#define REPLAY_MAX_TICK_BYTES 800     // Encoded tick: run/keys + events
+#define REPLAY_MAX_KEYFRAME_HEADER 20  // Keyframe record before the packed state
+#define REPLAY_PACK_BOUND(size) ((size) + (size) / 2 + 16)  // Worst packed state
+
+// Record tags (run lengths are below REPLAY_TAG_INPUT)
+#define REPLAY_TAG_INPUT 0x80
+#define REPLAY_TAG_NOW_MS 0x81
+#define REPLAY_TAG_CAR 0x82
+#define REPLAY_TAG_ITEM 0x83
+#define REPLAY_TAG_BOX 0x84
+#define REPLAY_TAG_CONNECTED 0x85
+#define REPLAY_TAG_KEYFRAME 0x86
+#define REPLAY_TAG_END 0x87
+#define REPLAY_MAX_RUN 128
+
+// ReplayFormat_Next() results other than a byte count
+#define REPLAY_NEED_MORE (-1)
+#define REPLAY_BAD_DATA (-2)
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+/**
+ * Event words, SPSC_EVENT(type, payload) followed by the listed words.
+ * Recording, the tick posts its events as they happen and its REPLAY_EV_TICK
+ * word last; on playback the TICK word comes first and also holds the number
+ * of words of the tick that follow it.
+ */
+typedef enum {
+    REPLAY_EV_TICK = 1,       // input | following words << 16
+    REPLAY_EV_CONNECTED = 2,  // player mask
+    REPLAY_EV_NOW_MS = 3,     // +1: chrono (ms)
+    REPLAY_EV_CAR = 4,        // car; +6: x, y, speed, angle, lap, item
+    REPLAY_EV_ITEM = 5,       // type | (u8)shooter << 8 | player << 16;
+                              // +4: x, y, angle, speed
+    REPLAY_EV_BOX = 6         // box index
+} ReplayEvent;
+
+#define REPLAY_TICK_WORD(input, following) \
+    SPSC_EVENT(REPLAY_EV_TICK, ((input) & 0xFFFF) | ((u32)(following) << 16))
+#define REPLAY_TICK_INPUT(word) (SPSC_EVENT_PAYLOAD(word) & 0xFFFF)
+#define REPLAY_TICK_FOLLOWING(word) (SPSC_EVENT_PAYLOAD(word) >> 16)
+
+// Scheduler polls the tick makes (their results are part of the input)
+typedef enum {
+    REPLAY_POLL_NET_SYNC = 0,
+    REPLAY_POLL_RETARGET = 1
+} ReplayPoll;
+
+typedef struct {
+    u32 magic;          // REPLAY_MAGIC
+    u16 version;        // REPLAY_VERSION
+    u16 headerSize;     // sizeof(ReplayHeader)
+    u32 stateSize;      // sizeof(SimState) of the build that recorded
+    u16 map;
+    u16 mode;           // GameMode
+    u16 keyframeTicks;  // Keyframe interval
+    u16 reserved;
+    u32 ticks;          // Ticks recorded
+    u32 keyframes;
+    u32 indexOffset;    // File offset of the index (0: leading copy)
+} ReplayHeader;
+
+typedef struct {
+    u32 tick;
+    u32 offset;  // File offset of the KEYFRAME record
+} ReplayIndexEntry;
+
+typedef struct {
+    u32 tick;       // State after this tick
+    u16 input;      // Input of that tick (later runs repeat it)
+    u8 connected;   // Connected player mask
+    u32 hash;       // SimState_Hash of the state
+    u32 bytes;      // Packed state size
+} ReplayKeyframe;
+
+typedef enum {
+    REPLAY_REC_TICK,
+    REPLAY_REC_KEYFRAME,
+    REPLAY_REC_END
+} ReplayRecordType;
+
+typedef struct {
+    ReplayRecordType type;
+    int count;                          // Words (REPLAY_REC_TICK)
+    u32 words[REPLAY_TICK_MAX_WORDS];   // TICK word, then the events
+    ReplayKeyframe keyframe;            // REPLAY_REC_KEYFRAME (state not read)
+} ReplayRecord;
+
+// Coder state: input of the last tick and the run being built or read
+typedef struct {
+    u32 tick;  // Ticks coded since the reset
+    u16 input;
+    u16 run;   // Encoder: ticks waiting to be written; decoder: ticks left
+} ReplayCoder;
+
+//=============================================================================
+// PUBLIC API - Records
+//=============================================================================
+
+/**
+ * Function: ReplayFormat_Reset
+ * ----------------------------
+ * Starts coding after a keyframe (tick and input of the keyframe).
+ */
+void ReplayFormat_Reset(ReplayCoder* coder, u32 tick, u16 input);
+
+/**
+ * Function: ReplayFormat_EncodeTick
+ * ---------------------------------
+ * Appends one tick. `words` starts with its REPLAY_EV_TICK word. A tick with
+ * the previous input and no events only extends the pending run, so nothing
+ * may be written.
+ *
+ * Parameters:
+ *   out - Room for REPLAY_MAX_TICK_BYTES bytes
+ *
+ * Returns: Bytes written, or -1 if the words are malformed
+ */
+int ReplayFormat_EncodeTick(ReplayCoder* coder, const u32* words, int count, u8* out);
+
+/**
+ * Function: ReplayFormat_EndRun
+ * -----------------------------
+ * Writes the pending run (before a keyframe or the end).
+ *
+ * Returns: Bytes written (0 or 1)
+ */
+int ReplayFormat_EndRun(ReplayCoder* coder, u8* out);
+
+/**
+ * Function: ReplayFormat_PutKeyframe
+ * ----------------------------------
+ * Writes a keyframe record header; `keyframe->bytes` of packed state must
+ * follow. Call after ReplayFormat_EndRun(); the coder restarts from it.
+ *
+ * Parameters:
+ *   out - Room for REPLAY_MAX_KEYFRAME_HEADER bytes
+ *
+ * Returns: Bytes written
+ */
+int ReplayFormat_PutKeyframe(ReplayCoder* coder, const ReplayKeyframe* keyframe, u8* out);
+
+/**
+ * Function: ReplayFormat_Next
+ * ---------------------------
+ * Reads the next record from `avail` bytes at `in`. A tick is only complete
+ * once the next record's tag is visible, so unless `final` (end of input) a
+ * tick at the end of the bytes asks for more. A keyframe's packed state is
+ * not consumed: `rec->keyframe.bytes` follow the returned length. The coder
+ * only changes when a record is returned.
+ *
+ * Returns: Bytes consumed (0 for a tick inside a run), REPLAY_NEED_MORE or
+ *          REPLAY_BAD_DATA
+ */
+int ReplayFormat_Next(ReplayCoder* coder, const u8* in, int avail, bool final,
+                      ReplayRecord* rec);
+
+/**
+ * Function: ReplayFormat_EventWords
+ * ---------------------------------
+ * Words that follow an event word of `type` (REPLAY_EV_TICK excepted).
+ *
+ * Returns: 0 to 6, or -1 for an unknown type
+ */
+int ReplayFormat_EventWords(u32 type);
+
+//=============================================================================
+// PUBLIC API - Keyframes
+//=============================================================================
+
+/**
+ * Function: ReplayFormat_PackState
+ * --------------------------------
+ * Packs `size` bytes of state as changes against `base` (NULL: zeros).
+ *
+ * Parameters:
+ *   out - Room for REPLAY_PACK_BOUND(size) bytes
+ *
+ * Returns: Packed size
+ */
+int ReplayFormat_PackState(const u8* state, const u8* base, int size, u8* out);
+
+/**
+ * Function: ReplayFormat_UnpackState
+ * ----------------------------------
+ * Rebuilds a state packed by ReplayFormat_PackState() with the same base.
+ *
+ * Returns: false if the packed bytes do not cover exactly `size` bytes
+ */
+bool ReplayFormat_UnpackState(const u8* in, int bytes, const u8* base, int size,
+                              u8* state);
+
+/**
+ * Function: ReplayFormat_FindKeyframe
+ * -----------------------------------
+ * Binary search of the index (sorted by tick) for the last keyframe at or
+ * before `tick`.
+ *
+ * Returns: Entry index, or -1 if `tick` is before the first keyframe
+ */
+int ReplayFormat_FindKeyframe(const ReplayIndexEntry* index, int count, u32 tick);
+
+#endif  // REPLAY_FORMAT_H
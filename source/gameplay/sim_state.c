@@ -0,0 +1,84 @@
+/**
+ * File: sim_state.c
+ * -----------------
+ * Description: Storage, save/restore, hashing and random numbers for the race
+ *              simulation state. The race tick runs in the TIMER0 ISR, so
+ *              copies in and out of the live block are done with interrupts
+ *              disabled: a save never sees half a tick.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "sim_state.h"
+
+#include <string.h>
+
+#include "../core/game_constants.h"
+#include "../core/tcm.h"
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+//=============================================================================
+// PUBLIC STATE
+//=============================================================================
+// In DTCM: the race tick reads and writes it all tick long. With ITEMS_ON_ARM7
+// it stays in main RAM, where the ARM7 can step the items in it
+#ifdef ITEMS_ON_ARM7
+SimState simState = {.rngState = SIM_RNG_SEED};
+#else
+SimState simState TCM_DATA = {.rngState = SIM_RNG_SEED};
+#endif
+
+#if defined(TCM_ENABLED) && !defined(ITEMS_ON_ARM7)
+_Static_assert(sizeof(SimState) <= SIM_STATE_DTCM_BUDGET,
+               "SimState outgrew its DTCM budget (see tcm.h)");
+#endif
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void SimState_Clear(void) {
+    int oldIme = enterCriticalSection();
+    u32 rng = simState.rngState;
+    memset(&simState, 0, sizeof(simState));
+    simState.rngState = (rng != 0) ? rng : SIM_RNG_SEED;
+    leaveCriticalSection(oldIme);
+}
+
+void SimState_Save(SimState* out) {
+    int oldIme = enterCriticalSection();
+    memcpy(out, &simState, sizeof(simState));
+    leaveCriticalSection(oldIme);
+}
+
+void SimState_Restore(const SimState* in) {
+    int oldIme = enterCriticalSection();
+    memcpy(&simState, in, sizeof(simState));
+    leaveCriticalSection(oldIme);
+}
+
+u32 SimState_Hash(const SimState* state) {
+    const u8* bytes = (const u8*)state;
+    u32 hash = FNV_OFFSET_BASIS;
+    for (size_t i = 0; i < sizeof(*state); i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+u32 SimState_Random(void) {
+    u32 x = simState.rngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    simState.rngState = x;
+    return x;
+}
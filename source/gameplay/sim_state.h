@@ -0,0 +1,104 @@
+/**
+ * File: sim_state.h
+ * -----------------
+ * Description: The complete per-race simulation state in one contiguous,
+ *              pointer-free block: cars, lap and checkpoint progress,
+ *              countdown, track items, item boxes, player effects and the
+ *              random generator. Everything a race tick reads and writes
+ *              lives here and nowhere else, so the whole race can be saved
+ *              and restored with one memcpy (race restart, rollback, replay
+ *              seeking) and compared with one hash (desync checks).
+ *
+ * Not part of the simulation (and not in the block): sprite memory, render
+ * interpolation, HUD caches, the pause flag and scheduler task ids.
+ *
+ * Rules for anything added to SimState:
+ *   - No pointers (a restored block must not point into another race)
+ *   - Only simulation modules (gameplay_logic.c, items/) write it, from the
+ *     race tick or while the tick is stopped
+ *   - Fields are written one by one, never by assigning a struct with
+ *     uninitialized padding, so the bytes (and SimState_Hash) only depend
+ *     on the values
+ *
+ * Usage:
+ *   SimState saved;
+ *   SimState_Save(&saved);
+ *   ...
+ *   SimState_Restore(&saved);  // exactly the race as it was
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef SIM_STATE_H
+#define SIM_STATE_H
+
+#include <nds.h>
+
+#include "gameplay_logic.h"
+#include "items/items_api.h"
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+typedef struct {
+    u32 tick;      // Race ticks simulated since the race started
+    u32 rngState;  // SimState_Random() generator (never 0)
+    RaceState race;
+    ItemsState items;
+} SimState;
+
+//=============================================================================
+// PUBLIC STATE
+//=============================================================================
+
+// The live race, written by the simulation modules only (others use the
+// Race_* and Items_* getters)
+extern SimState simState;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: SimState_Clear
+ * ------------------------
+ * Zeroes the live state for a new race. The random generator carries on from
+ * where the previous race left it.
+ */
+void SimState_Clear(void);
+
+/**
+ * Function: SimState_Save
+ * -----------------------
+ * Copies the live state (one memcpy, atomic with respect to the race tick).
+ */
+void SimState_Save(SimState* out);
+
+/**
+ * Function: SimState_Restore
+ * --------------------------
+ * Replaces the live state with a saved one (one memcpy, atomic with respect
+ * to the race tick).
+ */
+void SimState_Restore(const SimState* in);
+
+/**
+ * Function: SimState_Hash
+ * -----------------------
+ * FNV-1a hash of a state's bytes. Two machines that simulated the same race
+ * have the same hash.
+ */
+u32 SimState_Hash(const SimState* state);
+
+/**
+ * Function: SimState_Random
+ * -------------------------
+ * Next value of the simulation's xorshift32 generator. Use instead of rand()
+ * in the simulation so a restored state replays the same rolls.
+ */
+u32 SimState_Random(void);
+
+#endif  // SIM_STATE_H
@@ -0,0 +1,330 @@
+/**
+ * File: telemetry.c
+ * -----------------
+ * Description: Implementation of the race telemetry capture. The race tick
+ *              pushes each TICK record (or a GAP before it) as one batch of
+ *              TICK_WORDS words into an SPSC queue; the "telemetry" task
+ *              copies them into one of two TELEMETRY_BUFFER_BYTES buffers,
+ *              adds the FRAME record and hands a full buffer to the SD write
+ *              queue while it fills the other. When both are busy the task
+ *              leaves the ticks queued (they become a GAP if the queue fills)
+ *              and skips the FRAME record, so the capture never waits on the
+ *              card.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "telemetry.h"
+
+#ifdef TELEMETRY_ENABLED
+
+#include <string.h>
+
+#include "../core/game_constants.h"
+#include "../core/kmlog.h"
+#include "../core/profiler.h"
+#include "../core/scheduler.h"
+#include "../core/spsc_queue.h"
+#include "../network/multiplayer.h"
+#include "../storage/io_queue.h"
+#include "items/items_api.h"
+#include "items/items_link.h"
+#include "sim_state.h"
+#include "telemetry_format.h"
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define TICK_WORDS (sizeof(TelemetryTick) / sizeof(u32))  // A GAP is padded to it
+
+#ifdef PROFILER_ENABLED
+#define ZONE_COUNT PROF_ZONE_COUNT
+#else
+#define ZONE_COUNT 0
+#endif
+
+#define FRAME_BYTES (sizeof(TelemetryFrame) + ZONE_COUNT * sizeof(u16))
+
+_Static_assert(sizeof(TelemetryGap) <= sizeof(TelemetryTick),
+               "A GAP record must fit a queue batch");
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static volatile bool active = false;
+static SchedTaskId telemetryTask = SCHED_NO_TASK;
+
+// Race tick -> telemetry task, one TICK_WORDS batch per record
+static u32 queueSlots[TELEMETRY_QUEUE_WORDS];
+static SpscQueue queue;
+
+// Race tick side
+static u32 lastTick = 0;
+static u32 gapDropped = 0;  // Ticks refused since the last GAP
+static u8 hits = 0;
+static u8 pickups = 0;
+
+// Task side: buffers[current] fills while the other one is written
+static u8 buffers[2][TELEMETRY_BUFFER_BYTES];
+static IoRequestId pending[2] = {IO_NO_REQUEST, IO_NO_REQUEST};
+static int current = 0;
+static int fill = 0;
+static bool firstWrite = true;  // Replaces the previous race's file
+static u32 ticksWritten = 0;
+static u32 droppedFrames = 0;
+static u32 lastFrames = 0;
+static int lastSent = 0;
+static int lastReceived = 0;
+
+//=============================================================================
+// PRIVATE HELPERS - Writes
+//=============================================================================
+
+static void Telemetry_WriteDone(bool ok) {
+    if (!ok && active) {
+        active = false;  // No card (or a full one): stop, like the log
+        LOG_WARN("telemetry write failed");
+    }
+}
+
+// Queues the filled buffer and switches to the other one
+static void Telemetry_Flush(bool last) {
+    u8 flags = (firstWrite ? 0 : IO_APPEND) | (last ? 0 : IO_KEEP_OPEN);
+    IoWrite write = {TELEMETRY_FILE, NULL, flags,
+                     {{buffers[current], (u32)fill}}, Telemetry_WriteDone};
+    IoRequestId id = IoQueue_Write(&write);
+    if (id == IO_NO_REQUEST) {
+        LOG_WARN("telemetry dropped %d bytes", fill);
+        fill = 0;  // Still the first write if it was: the next one truncates
+        return;
+    }
+    pending[current] = id;
+    firstWrite = false;
+    current ^= 1;
+    fill = 0;
+}
+
+// Room for `bytes` in the current buffer, flushing it if it is full. With
+// `wait` (race end) a buffer still being written is waited for.
+static bool Telemetry_Reserve(int bytes, bool wait) {
+    if (fill + bytes > TELEMETRY_BUFFER_BYTES)
+        Telemetry_Flush(false);
+    if (wait)
+        IoQueue_Wait(pending[current]);
+    return IoQueue_IsDone(pending[current]);
+}
+
+static void Telemetry_Emit(const void* data, int bytes) {
+    memcpy(&buffers[current][fill], data, bytes);
+    fill += bytes;
+}
+
+//=============================================================================
+// PRIVATE HELPERS - Records
+//=============================================================================
+
+static void Telemetry_Drain(bool wait) {
+    u32 words[TICK_WORDS];
+    while (Telemetry_Reserve(sizeof(TelemetryTick), wait) &&
+           SpscQueue_PopBatch(&queue, words, TICK_WORDS) == (int)TICK_WORDS) {
+        if (((const u8*)words)[0] == TELEM_REC_GAP) {
+            Telemetry_Emit(words, sizeof(TelemetryGap));
+        } else {
+            Telemetry_Emit(words, sizeof(TelemetryTick));
+            ticksWritten++;
+        }
+    }
+}
+
+static void Telemetry_RecordFrame(void) {
+    const SchedStats* stats = Scheduler_GetStats();
+    if (stats->frames == lastFrames)
+        return;  // No frame measured since the last record
+    lastFrames = stats->frames;
+
+    int sent, received;
+    Multiplayer_GetDebugStats(&sent, &received);
+    u8 record[FRAME_BYTES];
+    TelemetryFrame frame = {
+        .tag = TELEM_REC_FRAME,
+        .loadLevel = stats->loadLevel,
+        .frameLines = stats->lastFrameLines,
+        .tick = simState.tick,
+        .netSent = (u16)(sent - lastSent),
+        .netReceived = (u16)(received - lastReceived),
+        .zoneCount = ZONE_COUNT,
+    };
+    lastSent = sent;
+    lastReceived = received;
+    memcpy(record, &frame, sizeof(frame));
+
+#ifdef PROFILER_ENABLED
+    u32 micros[PROF_ZONE_COUNT];
+    Profiler_TakeFrameTimes(micros);
+    for (int i = 0; i < PROF_ZONE_COUNT; i++) {
+        u16 us = (micros[i] > 0xFFFF) ? 0xFFFF : (u16)micros[i];
+        memcpy(&record[sizeof(frame) + i * sizeof(u16)], &us, sizeof(us));
+    }
+#endif
+
+    if (!Telemetry_Reserve(FRAME_BYTES, false)) {
+        droppedFrames++;
+        return;
+    }
+    Telemetry_Emit(record, FRAME_BYTES);
+}
+
+static void Telemetry_WriteHeader(bool replaying) {
+    const RaceState* race = &simState.race;
+    TelemetryHeader header = {
+        .magic = TELEMETRY_MAGIC,
+        .version = TELEMETRY_VERSION,
+        .headerBytes = sizeof(TelemetryHeader) + ZONE_COUNT * TELEMETRY_ZONE_NAME_BYTES,
+        .tickHz = RACE_TICK_FREQ,
+        .linesPerFrame = SCHED_LINES_PER_FRAME,
+        .budgetLines = SCHED_FRAME_BUDGET_LINES,
+        .map = (u8)race->currentMap,
+        .gameMode = (u8)race->gameMode,
+        .carCount = (u8)race->carCount,
+        .playerIndex = (u8)race->playerIndex,
+        .totalLaps = (u8)race->totalLaps,
+        .flags = replaying ? TELEM_HEADER_REPLAY : 0,
+        .zoneCount = ZONE_COUNT,
+    };
+    Telemetry_Emit(&header, sizeof(header));
+
+#ifdef PROFILER_ENABLED
+    for (int i = 0; i < PROF_ZONE_COUNT; i++) {
+        char name[TELEMETRY_ZONE_NAME_BYTES] = {0};
+        strncpy(name, Profiler_GetZoneName((ProfZone)i), sizeof(name) - 1);
+        Telemetry_Emit(name, sizeof(name));
+    }
+#endif
+}
+
+static void Telemetry_Step(void) {
+    if (!active)
+        return;
+    Telemetry_Drain(false);
+    Telemetry_RecordFrame();
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void Telemetry_Begin(bool replaying) {
+    // Normal priority: the queue covers a few deferred frames
+    if (telemetryTask == SCHED_NO_TASK)
+        telemetryTask = Scheduler_Register("telemetry", Telemetry_Step, SCHED_PRIO_NORMAL,
+                                           1, SCHED_BUDGET_TELEMETRY);
+
+    // The previous race's buffers may still be on their way to the card
+    IoQueue_Wait(pending[0]);
+    IoQueue_Wait(pending[1]);
+
+    SpscQueue_Init(&queue, queueSlots, TELEMETRY_QUEUE_WORDS);
+    lastTick = simState.tick;
+    gapDropped = 0;
+    hits = 0;
+    pickups = 0;
+    current = 0;
+    fill = 0;
+    firstWrite = true;
+    ticksWritten = 0;
+    droppedFrames = 0;
+    lastFrames = Scheduler_GetStats()->frames;
+    Multiplayer_GetDebugStats(&lastSent, &lastReceived);
+#ifdef PROFILER_ENABLED
+    u32 discard[PROF_ZONE_COUNT];
+    Profiler_TakeFrameTimes(discard);  // The first frame starts now
+#endif
+
+    Telemetry_WriteHeader(replaying);
+    active = true;
+    LOG_INFO("telemetry started, map %d", simState.race.currentMap);
+}
+
+void Telemetry_Tick(const Car* player, bool onSand, bool hitWall) {
+    if (!active)
+        return;
+
+    u32 words[TICK_WORDS];
+    u32 tick = simState.tick;
+    bool gap = gapDropped > 0 || tick != lastTick + 1;  // Drops, or a replay seek
+    lastTick = tick;
+    if (gap) {
+        TelemetryGap record = {
+            .tag = TELEM_REC_GAP,
+            .dropped = (gapDropped > 0xFFFF) ? 0xFFFF : (u16)gapDropped,
+            .nextTick = tick,
+        };
+        memset(words, 0, sizeof(words));
+        memcpy(words, &record, sizeof(record));
+        if (!SpscQueue_PushBatch(&queue, words, TICK_WORDS)) {
+            gapDropped++;  // This tick cannot follow without its GAP
+            hits = 0;
+            pickups = 0;
+            return;
+        }
+        gapDropped = 0;
+    }
+
+    int activeItems;
+    Items_GetActiveItems(&activeItems);
+    const Q16_8 center = IntToFixed(CAR_SPRITE_CENTER_OFFSET);
+    Q16_8 x = (player->position.x + center) / (FIXED_ONE / TELEM_POS_SCALE);
+    Q16_8 y = (player->position.y + center) / (FIXED_ONE / TELEM_POS_SCALE);
+    u8 flags = (onSand ? TELEM_TICK_SAND : 0) | (hitWall ? TELEM_TICK_WALL : 0) |
+               (simState.race.raceFinished ? TELEM_TICK_FINISHED : 0);
+
+    TelemetryTick record = {
+        .tag = TELEM_REC_TICK,
+        .flags = flags,
+        .lap = (u8)simState.race.currentLap,
+        .item = (u8)player->item,
+        .x = (u16)((x < 0) ? 0 : (x > 0xFFFF) ? 0xFFFF : x),
+        .y = (u16)((y < 0) ? 0 : (y > 0xFFFF) ? 0xFFFF : y),
+        .angle512 = (u16)player->angle512,
+        .speed = (s16)player->speed,
+        .activeItems = (u8)activeItems,
+        .hits = hits,
+        .pickups = pickups,
+        .sequence = (u8)tick,
+    };
+    memcpy(words, &record, sizeof(record));
+    if (!SpscQueue_PushBatch(&queue, words, TICK_WORDS))
+        gapDropped++;  // Reported by the GAP before the next tick that fits
+    hits = 0;
+    pickups = 0;
+}
+
+void Telemetry_ItemEvent(int type) {
+    if (type == ITEM_MSG_HIT && hits < 0xFF)
+        hits++;
+    else if (type == ITEM_MSG_BOX_PICKUP && pickups < 0xFF)
+        pickups++;
+}
+
+void Telemetry_End(void) {
+    if (!active)
+        return;
+    active = false;  // The tick timer is stopped; nothing is pushed any more
+
+    Telemetry_Drain(true);
+    Telemetry_RecordFrame();
+    TelemetryEnd end = {
+        .tag = TELEM_REC_END,
+        .ticks = ticksWritten,
+        .droppedTicks = SpscQueue_GetDropped(&queue),
+        .droppedFrames = droppedFrames,
+    };
+    if (Telemetry_Reserve(sizeof(end), true))
+        Telemetry_Emit(&end, sizeof(end));
+    Telemetry_Flush(true);  // Closes the file
+    LOG_INFO("telemetry: %u ticks, %u frames skipped", ticksWritten, droppedFrames);
+}
+
+#endif  // TELEMETRY_ENABLED
@@ -0,0 +1,91 @@
+/**
+ * File: telemetry.h
+ * -----------------
+ * Description: Per-race telemetry capture for performance work. The race
+ *              tick logs the local player (pose, speed, terrain class, wall
+ *              contact, item held, item events) and the "telemetry" task
+ *              adds one record per frame (scanlines used, load level,
+ *              network packets, profiler zone times). The stream goes to
+ *              TELEMETRY_FILE through the SD write queue, in the binary
+ *              layout of telemetry_format.h; tools/perf/telemetry_report.py
+ *              turns it into lap splits, speed traces, a frame time
+ *              histogram and the track sections where frames ran over.
+ *
+ *              Everything compiles out unless TELEMETRY_ENABLED is defined
+ *              (make TELEMETRY=1). Zone times need the profiler as well
+ *              (make TELEMETRY=1 PROFILE=1). A replay played back is
+ *              captured like a live race, so the same race can be measured
+ *              again after a change.
+ *
+ * Usage:
+ *   Gameplay_Initialize:  Race_Init(); ...; Telemetry_Begin(replaying);
+ *   Race tick:            TELEMETRY_TICK(player, onSand, hitWall);
+ *                         TELEMETRY_ITEM_EVENT(msg->type);
+ *   Gameplay_Cleanup:     Telemetry_End();
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdbool.h>
+
+#include "Car.h"
+
+//=============================================================================
+// MACROS
+//=============================================================================
+
+#ifdef TELEMETRY_ENABLED
+#define TELEMETRY_TICK(car, onSand, hitWall) Telemetry_Tick(car, onSand, hitWall)
+#define TELEMETRY_ITEM_EVENT(type) Telemetry_ItemEvent(type)
+#else
+#define TELEMETRY_TICK(car, onSand, hitWall) \
+    ((void)(car), (void)(onSand), (void)(hitWall))
+#define TELEMETRY_ITEM_EVENT(type) ((void)(type))
+#endif
+
+#ifdef TELEMETRY_ENABLED
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: Telemetry_Begin
+ * -------------------------
+ * Starts a capture of the race Race_Init() just set up, replacing the
+ * previous race's file. Waits for that file's last write first. Call before
+ * the tick timer runs.
+ */
+void Telemetry_Begin(bool replaying);
+
+/**
+ * Function: Telemetry_Tick
+ * ------------------------
+ * Logs the local player after a race tick (race tick). Drops the record if
+ * the task has fallen TELEMETRY_QUEUE_WORDS behind; the file gets a gap.
+ */
+void Telemetry_Tick(const Car* player, bool onSand, bool hitWall);
+
+/**
+ * Function: Telemetry_ItemEvent
+ * -----------------------------
+ * Counts an item hit or box pickup (ItemMsgType) toward the current tick.
+ */
+void Telemetry_ItemEvent(int type);
+
+/**
+ * Function: Telemetry_End
+ * -----------------------
+ * Writes what is buffered and the END record, and closes the file. The
+ * write finishes in the io task's idle time.
+ */
+void Telemetry_End(void);
+
+#endif  // TELEMETRY_ENABLED
+
+#endif  // TELEMETRY_H
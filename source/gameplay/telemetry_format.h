@@ -0,0 +1,133 @@
+/**
+ * File: telemetry_format.h
+ * ------------------------
+ * Description: Layout of the race telemetry file (.kmt) written by
+ *              telemetry.c and read by tools/perf/telemetry_report.py. All
+ *              values are little-endian and records are byte-packed; there
+ *              is no padding between them. Builds on the host.
+ *
+ * File:
+ *   TelemetryHeader, TELEMETRY_ZONE_NAME_BYTES per profiler zone name,
+ *   then records until TELEM_REC_END:
+ *
+ *   TELEM_REC_TICK   one per race tick (the local player after the tick)
+ *   TELEM_REC_FRAME  one per main loop frame (its cost, network, zone times)
+ *   TELEM_REC_GAP    break in the tick sequence (dropped ticks, replay seek)
+ *   TELEM_REC_END    totals, written when the race is cleaned up
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef TELEMETRY_FORMAT_H
+#define TELEMETRY_FORMAT_H
+
+#ifdef ARM9
+#include <nds.h>
+#else
+#include <stdint.h>
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef int16_t s16;
+typedef uint32_t u32;
+#endif
+
+//=============================================================================
+// PUBLIC CONSTANTS
+//=============================================================================
+
+#define TELEMETRY_MAGIC 0x4C544D4B  // "KMTL"
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_ZONE_NAME_BYTES 16  // Zero-padded profiler zone name
+
+// Record tags (first byte of every record)
+#define TELEM_REC_TICK 0x01
+#define TELEM_REC_FRAME 0x02
+#define TELEM_REC_GAP 0x03
+#define TELEM_REC_END 0xFF
+
+// TelemetryHeader flags
+#define TELEM_HEADER_REPLAY 0x01  // Captured while a replay was playing
+
+// TelemetryTick flags
+#define TELEM_TICK_SAND 0x01      // Terrain class (road when clear)
+#define TELEM_TICK_WALL 0x02      // Pushed back by a wall this tick
+#define TELEM_TICK_FINISHED 0x04  // The player finished the race on this tick
+
+#define TELEM_POS_SCALE 16  // Positions in 1/16 pixel
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+typedef struct __attribute__((packed)) {
+    u32 magic;
+    u16 version;
+    u16 headerBytes;     // This struct plus the zone names
+    u16 tickHz;          // RACE_TICK_FREQ
+    u16 linesPerFrame;   // SCHED_LINES_PER_FRAME
+    u16 budgetLines;     // SCHED_FRAME_BUDGET_LINES
+    u8 map;              // Map value
+    u8 gameMode;         // SinglePlayer / MultiPlayer
+    u8 carCount;
+    u8 playerIndex;
+    u8 totalLaps;
+    u8 flags;            // TELEM_HEADER_*
+    u8 zoneCount;        // Zone names that follow (0: profiler not built in)
+    u8 reserved[3];
+} TelemetryHeader;
+
+// Local player after one race tick; ticks are consecutive unless a GAP says
+// otherwise
+typedef struct __attribute__((packed)) {
+    u8 tag;            // TELEM_REC_TICK
+    u8 flags;          // TELEM_TICK_*
+    u8 lap;            // 1-based lap the player is on
+    u8 item;           // Item held (Item value)
+    u16 x;             // Sprite center, TELEM_POS_SCALE units
+    u16 y;
+    u16 angle512;
+    s16 speed;         // Q16.8
+    u8 activeItems;    // Items on the track
+    u8 hits;           // Item hits applied this tick (all cars)
+    u8 pickups;        // Item box pickups this tick (all cars)
+    u8 sequence;       // Low byte of the race tick (continuity check)
+} TelemetryTick;
+
+// One main loop frame; followed by zoneCount u16 microsecond totals (the
+// inclusive time of each profiler zone during the frame, saturated)
+typedef struct __attribute__((packed)) {
+    u8 tag;            // TELEM_REC_FRAME
+    u8 loadLevel;      // Scheduler degradation level
+    u16 frameLines;    // Scanlines the main loop took
+    u32 tick;          // Race ticks so far
+    u16 netSent;       // Packets sent during the frame
+    u16 netReceived;
+    u8 zoneCount;
+} TelemetryFrame;
+
+// The next TICK record is not the tick after the previous one: ticks were
+// dropped (the race tick queue was full) or a replay seek moved the race
+typedef struct __attribute__((packed)) {
+    u8 tag;            // TELEM_REC_GAP
+    u8 reserved;
+    u16 dropped;       // TICK records lost here (saturates)
+    u32 nextTick;      // Race tick of the next TICK record
+} TelemetryGap;
+
+typedef struct __attribute__((packed)) {
+    u8 tag;            // TELEM_REC_END
+    u8 reserved[3];
+    u32 ticks;         // TICK records written
+    u32 droppedTicks;  // Race tick pushes refused (queue full)
+    u32 droppedFrames;  // FRAME records skipped (both write buffers busy)
+} TelemetryEnd;
+
+_Static_assert(sizeof(TelemetryHeader) == 24, "TelemetryHeader layout");
+_Static_assert(sizeof(TelemetryTick) == 16, "TelemetryTick layout");
+_Static_assert(sizeof(TelemetryFrame) == 13, "TelemetryFrame layout");
+_Static_assert(sizeof(TelemetryGap) == 8, "TelemetryGap layout");
+_Static_assert(sizeof(TelemetryEnd) == 16, "TelemetryEnd layout");
+
+#endif  // TELEMETRY_FORMAT_H
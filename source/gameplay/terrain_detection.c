@@ -2,8 +2,8 @@
  * File: terrain_detection.c
  * -------------------------
  * Description: Implementation of terrain type detection for gameplay physics.
- *              Samples background tilemap pixels to determine surface type
- *              (track vs sand) at specific world coordinates. Uses color-based
+ *              Samples track pixels in world space (via track_map) to determine
+ *              surface type (track vs sand) at specific world coordinates. Uses color-based
  *              classification with 5-bit RGB values and tolerance matching.
  *
  * Authors: Bahey Shalash, Hugo Svolgaard
@@ -17,12 +17,14 @@
 #include <stdlib.h>
 
 #include "../core/game_constants.h"
+#include "../core/tcm.h"
+#include "track_map.h"
 
 //=============================================================================
 // PRIVATE CONSTANTS
 //=============================================================================
 
-// Note: QUAD_OFFSET, terrain color constants (GRAY_*, SAND_*), and
+// Note: Terrain color constants (GRAY_*, SAND_*), and
 //       COLOR_TOLERANCE_5BIT moved to game_constants.h
 
 //=============================================================================
@@ -76,53 +78,16 @@ static inline bool Terrain_IsGrayTrack5bit(int r5, int g5, int b5) {
 // PUBLIC API
 //=============================================================================
 
-bool Terrain_IsOnSand(int x, int y, QuadrantID quad) {
-    // Convert quadrant ID to grid coordinates
-    int col = quad % QUADRANT_GRID_SIZE;
-    int row = quad / QUADRANT_GRID_SIZE;
-
-    // Calculate quadrant's world offset
-    int quadStartX = col * QUAD_OFFSET;
-    int quadStartY = row * QUAD_OFFSET;
-
-    // Convert to quadrant-local coordinates
-    int localX = x - quadStartX;
-    int localY = y - quadStartY;
-
-    // Bounds check: ensure position is within quadrant
-    if (localX < 0 || localX >= QUAD_SIZE_DOUBLE || localY < 0 ||
-        localY >= QUAD_SIZE_DOUBLE)
+TCM_CODE bool Terrain_IsOnSand(int x, int y) {
+    // Bounds check: ensure position is within the track
+    if (x < 0 || x >= MAP_SIZE || y < 0 || y >= MAP_SIZE)
         return false;
 
-    // Convert local pixel coordinates to tile coordinates
-    int tileX = localX / TILE_SIZE;
-    int tileY = localY / TILE_SIZE;
-
-    // Determine which screen base the tile is in (2×2 screen layout)
-    int screenX = tileX / SCREEN_SIZE_TILES;
-    int screenY = tileY / SCREEN_SIZE_TILES;
-    int localTileX = tileX % SCREEN_SIZE_TILES;
-    int localTileY = tileY % SCREEN_SIZE_TILES;
-
-    // Calculate screen base index (0-3 for 2×2 layout)
-    int screenBase = screenY * 2 + screenX;
-
-    // Read tile index from map
-    u16* mapBase = (u16*)BG_MAP_RAM(screenBase);
-    u16 tileEntry = mapBase[localTileY * SCREEN_SIZE_TILES + localTileX];
-    u16 tileIndex = tileEntry & TILE_INDEX_MASK;
-
-    // Calculate pixel position within tile
-    int pixelX = localX % TILE_WIDTH_PIXELS;
-    int pixelY = localY % TILE_WIDTH_PIXELS;
-
-    // Read palette index from tile data
-    u8* tileData = (u8*)BG_TILE_RAM(1);
-    u8 paletteIndex =
-        tileData[tileIndex * TILE_DATA_SIZE + pixelY * TILE_WIDTH_PIXELS + pixelX];
+    // Sample the track asset directly so the result does not depend on which
+    // part of the world is currently streamed into the BG map
+    u16 paletteColor = TrackMap_GetPixelColor(x, y);
 
-    // Extract 5-bit RGB from palette
-    u16 paletteColor = BG_PALETTE[paletteIndex];
+    // Extract 5-bit RGB from color
     int r5 = (paletteColor >> COLOR_RED_SHIFT) & COLOR_5BIT_MASK;
     int g5 = (paletteColor >> COLOR_GREEN_SHIFT) & COLOR_5BIT_MASK;
     int b5 = (paletteColor >> COLOR_BLUE_SHIFT) & COLOR_5BIT_MASK;
@@ -3,7 +3,7 @@
  * -------------------------
  * Description: Terrain type detection for gameplay physics. Determines surface
  *              type (track vs sand) at specific world coordinates by sampling
- *              the background tilemap and analyzing pixel colors. Used to apply
+ *              the track graphics and analyzing pixel colors. Used to apply
  *              terrain-specific physics effects (speed reduction on sand).
  *
  * Authors: Bahey Shalash, Hugo Svolgaard
@@ -16,8 +16,6 @@
 
 #include <stdbool.h>
 
-#include "../core/game_types.h"
-
 //=============================================================================
 // PUBLIC API
 //=============================================================================
@@ -28,16 +26,12 @@
  * Determines if a world position is on sand terrain (off-track).
  *
  * Algorithm:
- *   1. Converts world coordinates to quadrant-local coordinates
- *   2. Maps local coordinates to tilemap position
- *   3. Reads tile index from appropriate screen map base
- *   4. Samples pixel color from tile data
- *   5. Compares pixel color against known track/sand colors
+ *   1. Samples the track color at the world pixel (TrackMap_GetPixelColor)
+ *   2. Compares pixel color against known track/sand colors
  *
  * Parameters:
- *   x    - World X coordinate in pixels
- *   y    - World Y coordinate in pixels
- *   quad - Quadrant ID (identifies which 256×256 section of map)
+ *   x - World X coordinate in pixels
+ *   y - World Y coordinate in pixels
  *
  * Returns:
  *   true  - Position is on sand (off-track, applies speed penalty)
@@ -50,6 +44,6 @@
  *
  * Performance: Single palette lookup per call (~O(1))
  */
-bool Terrain_IsOnSand(int x, int y, QuadrantID quad);
+bool Terrain_IsOnSand(int x, int y);
 
 #endif  // TERRAIN_DETECTION_H
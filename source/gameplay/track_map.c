@@ -0,0 +1,226 @@
+/**
+ * File: track_map.c
+ * -----------------
+ * Description: World-space track access. Each track is a single grit asset
+ *              built by tools/img/build_track_tileset.py: one deduplicated
+ *              tileset (flip-reduced), one shared palette and one world-sized
+ *              map, shipped in the NitroFS asset pack as "<track>.img/.map/.pal"
+ *              and read on demand through assets.h. Tiles and map are LZ77
+ *              streams: tiles are decompressed by the BIOS straight into main
+ *              BG VRAM and stay resident for the whole race, the map is
+ *              decompressed once into a heap buffer because bg_stream and
+ *              terrain queries need random access. A map without pack entries
+ *              simply fails to load, so new tracks are data-only additions.
+ *              The world map stays loaded between races on the same track,
+ *              and menus can preload the next track in idle frames.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "track_map.h"
+
+#include <nds.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../core/game_constants.h"
+#include "../core/mem_budget.h"
+#include "../core/scheduler.h"
+#include "../core/tcm.h"
+#include "../storage/assets.h"
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define WORLD_TILES (MAP_SIZE / TILE_SIZE)  // 128
+
+#define MAP_ENTRY_HFLIP BIT(10)
+#define MAP_ENTRY_VFLIP BIT(11)
+
+//=============================================================================
+// PRIVATE TYPES
+//=============================================================================
+typedef struct {
+    const char* name;  // Pack entry prefix (grit PNG basename)
+    int widthTiles;
+    int heightTiles;
+} TrackAsset;
+
+typedef enum {
+    PRELOAD_WORLD_MAP,
+    PRELOAD_TILESET,
+    PRELOAD_PALETTE,
+    PRELOAD_DONE
+} PreloadStep;
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static const TrackAsset trackAssets[] = {
+    [NONEMAP] = {NULL, 0, 0},
+    [ScorchingSands] = {"scorching_sands", WORLD_TILES, WORLD_TILES},
+    [AlpinRush] = {"alpin_rush", WORLD_TILES, WORLD_TILES},
+    [NeonCircuit] = {"neon_circuit", WORLD_TILES, WORLD_TILES},
+};
+
+static const TrackAsset* track = NULL;
+static u16* worldMap = NULL;  // Decompressed "<track>.map"
+
+static Map preloadMap = NONEMAP;
+static PreloadStep preloadStep = PRELOAD_DONE;
+static SchedTaskId preloadTask = SCHED_NO_TASK;
+
+//=============================================================================
+// PRIVATE HELPERS
+//=============================================================================
+static void TrackMap_AssetName(char* out, const TrackAsset* asset, const char* suffix) {
+    snprintf(out, ASSETS_NAME_LEN, "%s.%s", asset->name, suffix);
+}
+
+static void TrackMap_EntryName(char* out, const char* suffix) {
+    TrackMap_AssetName(out, track, suffix);
+}
+
+static inline bool TrackMap_HasAssets(Map map) {
+    return map > NONEMAP && map <= NeonCircuit && trackAssets[map].name != NULL;
+}
+
+static bool TrackMap_LoadWorld(Map map) {
+    if (TrackMap_HasAssets(map) && track == &trackAssets[map] && worldMap != NULL)
+        return true;  // Still loaded from the last race or a preload
+    TrackMap_Unload();
+
+    if (!TrackMap_HasAssets(map))
+        return false;
+    track = &trackAssets[map];
+
+    char name[ASSETS_NAME_LEN];
+    TrackMap_EntryName(name, "map");
+    const void* packed = Assets_Acquire(name, NULL);
+    if (packed != NULL) {
+        worldMap = (u16*)MemBudget_Malloc(Assets_Lz77Size(packed), MEM_OWNER_TRACK);
+        if (worldMap != NULL)
+            decompress(packed, worldMap, LZ77);
+        Assets_Release(name);
+    }
+
+    if (worldMap == NULL) {
+        track = NULL;
+        return false;
+    }
+    return true;
+}
+
+// One preload step per idle frame (each is a pack read and/or a decompress)
+static void TrackMap_PreloadStep(void) {
+    if (preloadStep == PRELOAD_DONE || !TrackMap_HasAssets(preloadMap)) {
+        preloadStep = PRELOAD_DONE;
+        return;
+    }
+
+    char name[ASSETS_NAME_LEN];
+    switch (preloadStep) {
+        case PRELOAD_WORLD_MAP:
+            TrackMap_LoadWorld(preloadMap);
+            break;
+        case PRELOAD_TILESET:
+            TrackMap_AssetName(name, &trackAssets[preloadMap], "img");
+            Assets_Preload(name);
+            break;
+        case PRELOAD_PALETTE:
+            TrackMap_AssetName(name, &trackAssets[preloadMap], "pal");
+            Assets_Preload(name);
+            break;
+        default:
+            break;
+    }
+    preloadStep++;
+}
+
+static inline bool TrackMap_InBounds(int tileX, int tileY) {
+    return track != NULL && tileX >= 0 && tileY >= 0 && tileX < track->widthTiles &&
+           tileY < track->heightTiles;
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+bool TrackMap_Load(Map map) {
+    // The race needs this map now: a pending preload must not replace it
+    preloadStep = PRELOAD_DONE;
+    return TrackMap_LoadWorld(map);
+}
+
+void TrackMap_Unload(void) {
+    MemBudget_Free(worldMap);
+    worldMap = NULL;
+    track = NULL;
+}
+
+void TrackMap_RequestPreload(Map map) {
+    if (map == preloadMap && preloadStep != PRELOAD_DONE)
+        return;  // Already on its way
+    preloadMap = map;
+    preloadStep = PRELOAD_WORLD_MAP;
+
+    if (preloadTask == SCHED_NO_TASK)
+        preloadTask = Scheduler_Register("preload", TrackMap_PreloadStep,
+                                         SCHED_PRIO_LOW, 1, SCHED_BUDGET_PRELOAD);
+}
+
+void TrackMap_UploadGraphics(void) {
+    if (track == NULL)
+        return;
+
+    char name[ASSETS_NAME_LEN];
+    TrackMap_EntryName(name, "img");
+    Assets_DecompressTo(name, BG_TILE_RAM(1));
+
+    memset(BG_PALETTE, 0, PALETTE_SIZE);
+    TrackMap_EntryName(name, "pal");
+    Assets_CopyTo(name, BG_PALETTE);
+}
+
+u16 TrackMap_GetMapEntry(int tileX, int tileY) {
+    if (!TrackMap_InBounds(tileX, tileY))
+        return 0;
+    return worldMap[tileY * track->widthTiles + tileX];
+}
+
+TCM_CODE u16 TrackMap_GetPixelColor(int x, int y) {
+    if (x < 0 || y < 0)
+        return 0;
+
+    int tileX = x / TILE_SIZE;
+    int tileY = y / TILE_SIZE;
+    if (!TrackMap_InBounds(tileX, tileY))
+        return 0;
+
+    u16 entry = worldMap[tileY * track->widthTiles + tileX];
+
+    int px = x % TILE_WIDTH_PIXELS;
+    int py = y % TILE_WIDTH_PIXELS;
+    if (entry & MAP_ENTRY_HFLIP)
+        px = TILE_WIDTH_PIXELS - 1 - px;
+    if (entry & MAP_ENTRY_VFLIP)
+        py = TILE_WIDTH_PIXELS - 1 - py;
+
+    // Tiles and palette only exist in VRAM / palette RAM; both stay resident
+    // all race
+    const u8* tileData = (const u8*)BG_TILE_RAM(1);
+    u8 paletteIndex = tileData[(entry & TILE_INDEX_MASK) * TILE_DATA_SIZE +
+                               py * TILE_WIDTH_PIXELS + px];
+    return BG_PALETTE[paletteIndex];
+}
+
+int TrackMap_GetWidthTiles(void) {
+    return (track != NULL) ? track->widthTiles : 0;
+}
+
+int TrackMap_GetHeightTiles(void) {
+    return (track != NULL) ? track->heightTiles : 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * File: track_map.h
+ * -----------------
+ * Description: World-space access to race track graphics. Owns the per-map
+ *              track assets, uploads their tiles and palettes to main BG VRAM
+ *              once per race, and answers world tile / world pixel queries used
+ *              by the background streamer and terrain detection. Gameplay code
+ *              never needs to know how the track is split into asset files.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef TRACK_MAP_H
+#define TRACK_MAP_H
+
+#include <nds.h>
+#include <stdbool.h>
+
+#include "../core/game_types.h"
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: TrackMap_Load
+ * -----------------------
+ * Selects the track assets for a map and decompresses its world map from the
+ * asset pack into a heap buffer (released by TrackMap_Unload or the next Load
+ * of another map). Loading the map that is already loaded (e.g. preloaded, or
+ * the previous race on the same track) does nothing.
+ *
+ * Parameters:
+ *   map - Map to select
+ *
+ * Returns:
+ *   true  - Map has track graphics
+ *   false - No track data in the pack for this map or out of memory
+ *           (queries return empty tiles)
+ */
+bool TrackMap_Load(Map map);
+
+/**
+ * Function: TrackMap_Unload
+ * -------------------------
+ * Frees the decompressed world map. Queries return empty tiles afterwards.
+ */
+void TrackMap_Unload(void);
+
+/**
+ * Function: TrackMap_RequestPreload
+ * ---------------------------------
+ * Prepares the track of the state that probably comes next, during idle
+ * time: a low-priority scheduler task loads the world map and reads the
+ * tileset and palette into the asset resident set, one step per frame, so
+ * the race setup does no pack reads. A newer request replaces an older one.
+ *
+ * Parameters:
+ *   map - Map to prepare (NONEMAP cancels)
+ */
+void TrackMap_RequestPreload(Map map);
+
+/**
+ * Function: TrackMap_UploadGraphics
+ * ---------------------------------
+ * Decompresses the shared tileset of the selected track into BG_TILE_RAM(1)
+ * (BIOS LZ77, VRAM-safe) and copies its palette to the main BG palette. Map
+ * entries returned by TrackMap_GetMapEntry() index into this resident data, so
+ * this must run before the first entry reaches VRAM. Skipped by the race when
+ * Residency_Claim() finds the tileset still resident.
+ */
+void TrackMap_UploadGraphics(void);
+
+/**
+ * Function: TrackMap_GetMapEntry
+ * ------------------------------
+ * Gets the resident BG map entry for a world tile (BgStreamFetchFn).
+ *
+ * Parameters:
+ *   tileX, tileY - World tile coordinates (0..TrackMap_GetWidthTiles()-1)
+ *
+ * Returns: Map entry with tile index, flip bits and palette bits applied
+ */
+u16 TrackMap_GetMapEntry(int tileX, int tileY);
+
+/**
+ * Function: TrackMap_GetPixelColor
+ * --------------------------------
+ * Samples the track color at a world pixel from the world map and the
+ * resident tileset (independent of what is currently streamed into the BG
+ * map). Requires TrackMap_UploadGraphics() to have run.
+ *
+ * Parameters:
+ *   x, y - World coordinates in pixels
+ *
+ * Returns: RGB15 color, or 0 when outside the track or no map is loaded
+ */
+u16 TrackMap_GetPixelColor(int x, int y);
+
+/**
+ * Gets the world width in tiles.
+ */
+int TrackMap_GetWidthTiles(void);
+
+/**
+ * Gets the world height in tiles.
+ */
+int TrackMap_GetHeightTiles(void);
+
+#endif  // TRACK_MAP_H
@@ -13,12 +13,15 @@
 
 #include "wall_collision.h"
 
+#include "../core/tcm.h"
+
 //=============================================================================
 // PRIVATE WALL GEOMETRY DATA
 //=============================================================================
+// All tables live in DTCM: every car and projectile scans them every tick
 
 // TL Quadrant (offset: 0, 0) - walls already in correct global coords
-static const WallSegment walls_TL[] = {
+static const WallSegment walls_TL[] TCM_DATA = {
     {WALL_VERTICAL, 8, 0, 512},        // good
     {WALL_HORIZONTAL, 8, 0, 512},      // good
     {WALL_VERTICAL, 167, 160, 512},    // good
@@ -28,7 +31,7 @@ static const WallSegment walls_TL[] = {
 };
 
 // TC Quadrant (offset: 256, 0) - add 256 to all X coords
-static const WallSegment walls_TC[] = {
+static const WallSegment walls_TC[] TCM_DATA = {
     {WALL_HORIZONTAL, 8, 256, 734},    // Y=10, X: 0-478 → 256-734 good
     {WALL_VERTICAL, 734, 8, 160},      // X=478 → 734, Y: 8-160 good
     {WALL_HORIZONTAL, 160, 734, 768},  // Y=162, X: 480-512 → 736-768 good
@@ -40,7 +43,7 @@ static const WallSegment walls_TC[] = {
 };
 
 // TR Quadrant (offset: 512, 0) - add 512 to all X coords
-static const WallSegment walls_TR[] = {
+static const WallSegment walls_TR[] TCM_DATA = {
     {WALL_HORIZONTAL, 8, 512, 735},     // Y=8, X: 0-223 → 512-735 good
     {WALL_VERTICAL, 735, 8, 160},       // X=223 → 734, Y: 8-160 good
     {WALL_HORIZONTAL, 160, 735, 1016},  // Y=160, X: 223-504 → 734-1016 good
@@ -52,7 +55,7 @@ static const WallSegment walls_TR[] = {
 };
 
 // ML Quadrant (offset: 0, 256) - add 256 to all Y coords
-static const WallSegment walls_ML[] = {
+static const WallSegment walls_ML[] TCM_DATA = {
     {WALL_VERTICAL, 8, 256, 768},      // X=8, Y: 0-512 → 256-768 good
     {WALL_VERTICAL, 168, 256, 552},    // X=168, Y: 0-296 → 256-552 good
     {WALL_HORIZONTAL, 552, 136, 168},  // Y=296 → 552, X: 136-168 good
@@ -65,7 +68,7 @@ static const WallSegment walls_ML[] = {
 };
 
 // MC Quadrant (offset: 256, 256) - add 256 to both X and Y
-static const WallSegment walls_MC[] = {
+static const WallSegment walls_MC[] TCM_DATA = {
     {WALL_VERTICAL, 735, 496, 768},    // X=479 → 735, Y: 240-512 → 496-768 good
     {WALL_HORIZONTAL, 496, 272, 735},  // Y=240 → 496, X: 16-479 → 272-735 good
     {WALL_VERTICAL, 272, 496, 594},    // X=16 → 272, Y: 240-336 → 496-592 good
@@ -77,7 +80,7 @@ static const WallSegment walls_MC[] = {
 };
 
 // MR Quadrant (offset: 512, 256) - add 512 to X, 256 to Y
-static const WallSegment walls_MR[] = {
+static const WallSegment walls_MR[] TCM_DATA = {
     {WALL_VERTICAL, 815, 416, 768},    // X=303 → 815, Y: 160-512 → 416-768 good
     {WALL_VERTICAL, 1016, 256, 768},   // X=504 → 1016, Y: 0-512 → 256-768 good
     {WALL_HORIZONTAL, 416, 688, 815},  // Y=160 → 416, X: 176-303 → 688-815 good
@@ -88,7 +91,7 @@ static const WallSegment walls_MR[] = {
 };
 
 // BL Quadrant (offset: 0, 512) - add 512 to all Y coords
-static const WallSegment walls_BL[] = {
+static const WallSegment walls_BL[] TCM_DATA = {
     {WALL_HORIZONTAL, 1016, 480, 512},  // Y=504 → 1016, X: 480-512 good
     {WALL_HORIZONTAL, 872, 0, 479},     // Y=360 → 872, X: 0-479 good
     {WALL_VERTICAL, 479, 872, 1016},    // X=479, Y: 360-504 → 872-1016 good
@@ -103,7 +106,7 @@ static const WallSegment walls_BL[] = {
 };
 
 // BC Quadrant (offset: 256, 512) - add 256 to X, 512 to Y
-static const WallSegment walls_BC[] = {
+static const WallSegment walls_BC[] TCM_DATA = {
     {WALL_VERTICAL, 736, 512, 815},     // X=480 → 736, Y: 0-303 → 512-815 good
     {WALL_HORIZONTAL, 815, 736, 768},   // Y=303 → 815, X: 480-512 → 736-768 good
     {WALL_HORIZONTAL, 1016, 479, 768},  // Y=504 → 1016, X: 223-512 → 479-768 good
@@ -114,7 +117,7 @@ static const WallSegment walls_BC[] = {
 };
 
 // BR Quadrant (offset: 512, 512) - add 512 to both X and Y
-static const WallSegment walls_BR[] = {
+static const WallSegment walls_BR[] TCM_DATA = {
     {WALL_HORIZONTAL, 1008, 512, 1008},  // Y=504 → 1016, X: 0-504 → 512-1016 good
     {WALL_VERTICAL, 1008, 512, 1008},    // X=504 → 1016, Y: 0-512 → 512-1016 good
     {WALL_HORIZONTAL, 815, 736, 815},    // Y=303 → 815, X: 224-303 → 736-815 good
@@ -123,7 +126,7 @@ static const WallSegment walls_BR[] = {
 };
 
 // Quadrant wall lookup table
-static const QuadrantWalls quadrantWalls[9] = {
+static const QuadrantWalls quadrantWalls[9] TCM_DATA = {
     {walls_TL, sizeof(walls_TL) / sizeof(WallSegment)},
     {walls_TC, sizeof(walls_TC) / sizeof(WallSegment)},
     {walls_TR, sizeof(walls_TR) / sizeof(WallSegment)},
@@ -175,7 +178,7 @@ static inline bool Wall_SegmentCollision(const WallSegment* wall, int carX, int
 // PUBLIC API
 //=============================================================================
 
-bool Wall_CheckCollision(int carX, int carY, int carRadius, QuadrantID quad) {
+TCM_CODE bool Wall_CheckCollision(int carX, int carY, int carRadius, QuadrantID quad) {
     if (quad < QUAD_TL || quad > QUAD_BR)
         return false;
 
@@ -190,7 +193,8 @@ bool Wall_CheckCollision(int carX, int carY, int carRadius, QuadrantID quad) {
     return false;
 }
 
-void Wall_GetCollisionNormal(int carX, int carY, QuadrantID quad, int* nx, int* ny) {
+TCM_CODE void Wall_GetCollisionNormal(int carX, int carY, QuadrantID quad, int* nx,
+                                      int* ny) {
     if (quad < QUAD_TL || quad > QUAD_BR) {
         *nx = 0;
         *ny = 0;
@@ -0,0 +1,286 @@
+/**
+ * File: bg_stream.c
+ * -----------------
+ * Description: Implementation of the edge-streaming tilemap engine. The window
+ *              is addressed with world tile coordinates masked to 0..63, so a
+ *              world tile always lands in the same VRAM cell and the hardware
+ *              scroll register simply wraps. Commits are recorded in the
+ *              render command list: rows as two 32-entry runs (one per screen
+ *              block), columns as strided writes, refills as four blocks.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "bg_stream.h"
+
+#include <nds.h>
+#include <string.h>
+
+#include "../core/game_constants.h"
+#include "render_cmd.h"
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define LINE_BYTES (BG_STREAM_SIZE_TILES * sizeof(u16))  // 128 bytes per line
+#define SCREEN_BLOCK_ENTRIES (SCREEN_SIZE_TILES * SCREEN_SIZE_TILES)
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static u16* streamMap = NULL;
+static BgStreamFetchFn streamFetch = NULL;
+static int worldWidth = 0;
+static int worldHeight = 0;
+
+// World tile coordinates of the window's top-left corner
+static int originX = 0;
+static int originY = 0;
+static bool windowValid = false;
+static bool refillPending = false;
+
+// Staged lines, indexed by window cell (world coordinate & BG_STREAM_MASK)
+static u16 stagedRows[BG_STREAM_MAX_STAGED][BG_STREAM_SIZE_TILES] ALIGN(4);
+static u16 stagedCols[BG_STREAM_MAX_STAGED][BG_STREAM_SIZE_TILES] ALIGN(4);
+static int stagedRowY[BG_STREAM_MAX_STAGED];
+static int stagedColX[BG_STREAM_MAX_STAGED];
+static int stagedRowCount = 0;
+static int stagedColCount = 0;
+
+static BgStreamStats stats;
+
+//=============================================================================
+// PRIVATE HELPERS
+//=============================================================================
+
+// Address of a window cell inside the 2x2 screen block layout of BG_64x64
+static inline u16* BgStream_CellAddr(int cellX, int cellY) {
+    int block = ((cellY >> 5) << 1) | (cellX >> 5);
+    return streamMap + block * SCREEN_BLOCK_ENTRIES +
+           ((cellY & (SCREEN_SIZE_TILES - 1)) * SCREEN_SIZE_TILES) +
+           (cellX & (SCREEN_SIZE_TILES - 1));
+}
+
+static inline u16 BgStream_Fetch(int tileX, int tileY) {
+    if (tileX < 0 || tileY < 0 || tileX >= worldWidth || tileY >= worldHeight)
+        return 0;
+    return streamFetch(tileX, tileY);
+}
+
+static int BgStream_OriginFromScroll(int scroll, int margin) {
+    // Arithmetic shift floors negative scroll values as well
+    return (scroll >> 3) - margin;
+}
+
+static void BgStream_ScheduleRefill(void) {
+    refillPending = true;
+    stagedRowCount = 0;
+    stagedColCount = 0;
+}
+
+static void BgStream_StageRow(int tileY, int firstX) {
+    if (stagedRowCount >= BG_STREAM_MAX_STAGED) {
+        BgStream_ScheduleRefill();
+        return;
+    }
+    u16* line = stagedRows[stagedRowCount];
+    for (int x = firstX; x < firstX + BG_STREAM_SIZE_TILES; x++)
+        line[x & BG_STREAM_MASK] = BgStream_Fetch(x, tileY);
+    stagedRowY[stagedRowCount++] = tileY;
+}
+
+static void BgStream_StageCol(int tileX, int firstY) {
+    if (stagedColCount >= BG_STREAM_MAX_STAGED) {
+        BgStream_ScheduleRefill();
+        return;
+    }
+    u16* line = stagedCols[stagedColCount];
+    for (int y = firstY; y < firstY + BG_STREAM_SIZE_TILES; y++)
+        line[y & BG_STREAM_MASK] = BgStream_Fetch(tileX, y);
+    stagedColX[stagedColCount++] = tileX;
+
+    // Rows are committed after columns; keep earlier-staged rows from
+    // overwriting this column's cells with stale entries
+    int cellX = tileX & BG_STREAM_MASK;
+    for (int i = 0; i < stagedRowCount; i++)
+        stagedRows[i][cellX] = line[stagedRowY[i] & BG_STREAM_MASK];
+}
+
+static void BgStream_WriteWindow(void) {
+    for (int y = originY; y < originY + BG_STREAM_SIZE_TILES; y++) {
+        for (int x = originX; x < originX + BG_STREAM_SIZE_TILES; x++) {
+            *BgStream_CellAddr(x & BG_STREAM_MASK, y & BG_STREAM_MASK) =
+                BgStream_Fetch(x, y);
+        }
+    }
+}
+
+// Records a whole-window rewrite, one 2 KB command per screen block
+static bool BgStream_RecordWindow(void) {
+    for (int block = 0; block < 4; block++) {
+        int baseX = (block & 1) * SCREEN_SIZE_TILES;
+        int baseY = (block >> 1) * SCREEN_SIZE_TILES;
+        u16* out = RenderCmd_Alloc(BgStream_CellAddr(baseX, baseY),
+                                   SCREEN_BLOCK_ENTRIES * sizeof(u16));
+        if (out == NULL)
+            return false;
+
+        for (int cy = baseY; cy < baseY + SCREEN_SIZE_TILES; cy++) {
+            int y = originY + ((cy - originY) & BG_STREAM_MASK);
+            for (int cx = baseX; cx < baseX + SCREEN_SIZE_TILES; cx++) {
+                int x = originX + ((cx - originX) & BG_STREAM_MASK);
+                *out++ = BgStream_Fetch(x, y);
+            }
+        }
+    }
+    return true;
+}
+
+static void BgStream_AccountFrame(int bytes) {
+    stats.bytesCopied += bytes;
+    stats.lastFrameBytes = bytes;
+    if (bytes > stats.maxFrameBytes)
+        stats.maxFrameBytes = bytes;
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void BgStream_Init(u16* mapBase, int worldW, int worldH, BgStreamFetchFn fetch) {
+    streamMap = mapBase;
+    streamFetch = fetch;
+    worldWidth = worldW;
+    worldHeight = worldH;
+    windowValid = false;
+    refillPending = false;
+    stagedRowCount = 0;
+    stagedColCount = 0;
+    BgStream_ResetStats();
+}
+
+void BgStream_Stop(void) {
+    streamMap = NULL;
+    streamFetch = NULL;
+    windowValid = false;
+    refillPending = false;
+    stagedRowCount = 0;
+    stagedColCount = 0;
+}
+
+void BgStream_Reset(int scrollX, int scrollY) {
+    if (streamMap == NULL)
+        return;
+
+    originX = BgStream_OriginFromScroll(scrollX, BG_STREAM_MARGIN_X_TILES);
+    originY = BgStream_OriginFromScroll(scrollY, BG_STREAM_MARGIN_Y_TILES);
+    windowValid = true;
+    refillPending = false;
+    stagedRowCount = 0;
+    stagedColCount = 0;
+
+    // Display is off during setup: write VRAM directly
+    BgStream_WriteWindow();
+    stats.fullRefills++;
+    BgStream_AccountFrame(BG_STREAM_SIZE_TILES * LINE_BYTES);
+}
+
+void BgStream_Prepare(int scrollX, int scrollY) {
+    if (streamMap == NULL || !windowValid)
+        return;
+
+    int newX = BgStream_OriginFromScroll(scrollX, BG_STREAM_MARGIN_X_TILES);
+    int newY = BgStream_OriginFromScroll(scrollY, BG_STREAM_MARGIN_Y_TILES);
+    int dx = newX - originX;
+    int dy = newY - originY;
+
+    if (dx == 0 && dy == 0)
+        return;
+
+    if (refillPending || dx > BG_STREAM_MAX_STAGED || -dx > BG_STREAM_MAX_STAGED ||
+        dy > BG_STREAM_MAX_STAGED || -dy > BG_STREAM_MAX_STAGED) {
+        originX = newX;
+        originY = newY;
+        BgStream_ScheduleRefill();
+        return;
+    }
+
+    // Columns entering horizontally, sampled over the new vertical span
+    int firstCol = (dx > 0) ? originX + BG_STREAM_SIZE_TILES : newX;
+    int endCol = (dx > 0) ? newX + BG_STREAM_SIZE_TILES : originX;
+    for (int x = firstCol; x < endCol && !refillPending; x++)
+        BgStream_StageCol(x, newY);
+
+    // Rows entering vertically, sampled over the new horizontal span
+    int firstRow = (dy > 0) ? originY + BG_STREAM_SIZE_TILES : newY;
+    int endRow = (dy > 0) ? newY + BG_STREAM_SIZE_TILES : originY;
+    for (int y = firstRow; y < endRow && !refillPending; y++)
+        BgStream_StageRow(y, newX);
+
+    originX = newX;
+    originY = newY;
+}
+
+void BgStream_Commit(void) {
+    if (streamMap == NULL)
+        return;
+
+    if (refillPending) {
+        if (!BgStream_RecordWindow())
+            return;  // Command list full: retry the refill next frame
+        refillPending = false;
+        stats.fullRefills++;
+        BgStream_AccountFrame(BG_STREAM_SIZE_TILES * LINE_BYTES);
+        return;
+    }
+
+    if (stagedRowCount == 0 && stagedColCount == 0) {
+        stats.lastFrameBytes = 0;
+        return;
+    }
+
+    // Columns first: rows staged in the same frame are newer at intersections.
+    // A column crosses two screen blocks (top half, bottom half).
+    bool recorded = true;
+    for (int i = 0; i < stagedColCount; i++) {
+        int cellX = stagedColX[i] & BG_STREAM_MASK;
+        const u16* line = stagedCols[i];
+        recorded &= RenderCmd_CopyStrided(BgStream_CellAddr(cellX, 0),
+                                          SCREEN_SIZE_TILES, line, SCREEN_SIZE_TILES);
+        recorded &= RenderCmd_CopyStrided(BgStream_CellAddr(cellX, SCREEN_SIZE_TILES),
+                                          SCREEN_SIZE_TILES, line + SCREEN_SIZE_TILES,
+                                          SCREEN_SIZE_TILES);
+    }
+
+    for (int i = 0; i < stagedRowCount; i++) {
+        int cellY = stagedRowY[i] & BG_STREAM_MASK;
+        // One contiguous run per screen block (left half, right half)
+        recorded &= RenderCmd_Copy(BgStream_CellAddr(0, cellY), &stagedRows[i][0],
+                                   SCREEN_SIZE_TILES * sizeof(u16));
+        recorded &= RenderCmd_Copy(BgStream_CellAddr(SCREEN_SIZE_TILES, cellY),
+                                   &stagedRows[i][SCREEN_SIZE_TILES],
+                                   SCREEN_SIZE_TILES * sizeof(u16));
+    }
+
+    if (!recorded) {
+        // Some lines were dropped: rebuild the whole window next frame
+        BgStream_ScheduleRefill();
+        return;
+    }
+
+    stats.rowsCopied += stagedRowCount;
+    stats.colsCopied += stagedColCount;
+    BgStream_AccountFrame((stagedRowCount + stagedColCount) * LINE_BYTES);
+    stagedRowCount = 0;
+    stagedColCount = 0;
+}
+
+const BgStreamStats* BgStream_GetStats(void) {
+    return &stats;
+}
+
+void BgStream_ResetStats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
@@ -0,0 +1,119 @@
+/**
+ * File: bg_stream.h
+ * -----------------
+ * Description: Edge-streaming tilemap engine for worlds larger than a hardware
+ *              background. Keeps a 64x64 tile (512x512 px) wrapping text BG in
+ *              sync with a world map of arbitrary size by copying only the tile
+ *              rows and columns the camera newly exposes. Per-frame VRAM traffic
+ *              is bounded by camera speed instead of world or quadrant size.
+ *
+ * Usage:
+ *   BgStream_Init(BG_MAP_RAM(0), worldW, worldH, fetchFn);
+ *   BgStream_Reset(scrollX, scrollY);          // full fill (display setup)
+ *   ...each frame...
+ *   BgStream_Prepare(scrollX, scrollY);        // stage exposed rows/columns
+ *   BgStream_Commit();                         // record staged lines
+ *   RenderCmd_Write16(&BG_OFFSET[0].x, scrollX & (BG_STREAM_SIZE_PX - 1));
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef BG_STREAM_H
+#define BG_STREAM_H
+
+#include <nds.h>
+#include <stdbool.h>
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+/**
+ * Returns the map entry (tile index, flip bits, palette bits) for a world
+ * tile. Called for every tile that enters the window, so it must be cheap.
+ */
+typedef u16 (*BgStreamFetchFn)(int tileX, int tileY);
+
+/**
+ * Cumulative transfer counters since the last BgStream_ResetStats().
+ */
+typedef struct {
+    int rowsCopied;      // Window rows written (64 entries each)
+    int colsCopied;      // Window columns written (64 entries each)
+    int fullRefills;     // Whole-window rewrites (init or large camera jumps)
+    int bytesCopied;     // Total map bytes written to VRAM
+    int maxFrameBytes;   // Largest single-commit transfer
+    int lastFrameBytes;  // Bytes written by the most recent commit
+} BgStreamStats;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: BgStream_Init
+ * -----------------------
+ * Binds the streamer to a 64x64 BG map and a world map source.
+ *
+ * Parameters:
+ *   mapBase    - First of four consecutive 2 KB screen blocks (BG_64x64)
+ *   worldW     - World width in tiles
+ *   worldH     - World height in tiles
+ *   fetch      - World tile lookup (see BgStreamFetchFn)
+ *
+ * The window is invalid until BgStream_Reset() is called.
+ */
+void BgStream_Init(u16* mapBase, int worldW, int worldH, BgStreamFetchFn fetch);
+
+/**
+ * Function: BgStream_Stop
+ * -----------------------
+ * Unbinds the streamer. Prepare/Commit become no-ops until the next Init.
+ */
+void BgStream_Stop(void);
+
+/**
+ * Function: BgStream_Reset
+ * ------------------------
+ * Centers the window on a camera position and rewrites VRAM immediately (not
+ * through the command list). For screen setup, while the BG is not shown.
+ *
+ * Parameters:
+ *   scrollX, scrollY - Camera top-left in world pixels
+ */
+void BgStream_Reset(int scrollX, int scrollY);
+
+/**
+ * Function: BgStream_Prepare
+ * --------------------------
+ * Advances the window to follow the camera and stages the rows/columns that
+ * became visible. Staging accumulates until the next BgStream_Commit(); if
+ * more than BG_STREAM_MAX_STAGED lines pile up a full refill is scheduled.
+ *
+ * Parameters:
+ *   scrollX, scrollY - Camera top-left in world pixels
+ */
+void BgStream_Prepare(int scrollX, int scrollY);
+
+/**
+ * Function: BgStream_Commit
+ * -------------------------
+ * Records the staged rows/columns (or a pending full refill) in the render
+ * command list (render_cmd.h), ahead of the BG scroll register writes. If the
+ * list is full a full refill is scheduled for the next frame instead.
+ */
+void BgStream_Commit(void);
+
+/**
+ * Gets cumulative transfer counters.
+ */
+const BgStreamStats* BgStream_GetStats(void);
+
+/**
+ * Clears transfer counters.
+ */
+void BgStream_ResetStats(void);
+
+#endif  // BG_STREAM_H
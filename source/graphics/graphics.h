@@ -3,8 +3,9 @@
  * ----------------
  * Description: Graphics utilities for safe screen transitions. Provides
  *              video_nuke(), which resets displays, OAM allocators, palettes,
- *              VRAM banks, and BG registers to a known clean state before
- *              initializing the next screen.
+ *              VRAM banks, and BG registers to a known clean state, and
+ *              video_reset_registers(), which resets everything but VRAM and
+ *              palettes so resident assets survive a transition.
  *
  * Authors: Bahey Shalash, Hugo Svolgaard
  * Version: 1.0
@@ -23,4 +24,13 @@
  */
 void video_nuke(void);
 
+/**
+ * Function: video_reset_registers
+ * -------------------------------
+ * Turns off both screens, clears OAM and resets the OAM allocators, maps
+ * VRAM banks A-D to their usual engines and resets BG control/offset/affine
+ * registers. VRAM and palette contents are left as they are.
+ */
+void video_reset_registers(void);
+
 #endif  // GRAPHICS_H
@@ -0,0 +1,223 @@
+/**
+ * File: render_cmd.c
+ * ------------------
+ * Description: Implementation of the render command buffer. A list is a byte
+ *              arena of fixed-size headers, each followed by its payload padded
+ *              to 4 bytes. The arena is flushed from the data cache when it is
+ *              published so the VBlank replay can DMA straight out of it.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "render_cmd.h"
+
+#include <string.h>
+
+#include "../core/game_constants.h"
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define DMA_MIN_BYTES 32  // Smaller copies are cheaper as CPU halfword writes
+#define NO_LIST (-1)
+
+//=============================================================================
+// PRIVATE TYPES
+//=============================================================================
+typedef enum {
+    RCMD_WRITE16,   // arg = value
+    RCMD_COPY,      // payload = data
+    RCMD_COPY_REF,  // payload = source address
+    RCMD_STRIDED    // arg = stride in halfwords, payload = data
+} RenderOp;
+
+typedef struct {
+    u8 op;
+    u8 reserved;
+    u16 arg;
+    u32 dst;
+    u32 bytes;
+} RenderCmd;
+
+typedef struct {
+    u8 arena[RENDER_CMD_ARENA_BYTES] ALIGN(32);
+    u32 used;
+    int commands;
+} RenderList;
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static RenderList lists[2];
+static int recording = 0;                   // List the main loop writes
+static volatile int pending = NO_LIST;      // List waiting for VBlank
+static RenderCmdStats stats;
+
+//=============================================================================
+// PRIVATE HELPERS
+//=============================================================================
+
+static inline u32 RenderCmd_Pad(u32 bytes) {
+    return (bytes + 3) & ~3u;
+}
+
+// Appends a header with room for `payload` bytes; NULL if it does not fit
+static RenderCmd* RenderCmd_Push(RenderOp op, void* dst, u32 bytes, u32 payload) {
+    RenderList* list = &lists[recording];
+    u32 size = sizeof(RenderCmd) + RenderCmd_Pad(payload);
+    if (list->used + size > RENDER_CMD_ARENA_BYTES) {
+        stats.overflows++;
+        return NULL;
+    }
+
+    RenderCmd* cmd = (RenderCmd*)&list->arena[list->used];
+    cmd->op = (u8)op;
+    cmd->reserved = 0;
+    cmd->arg = 0;
+    cmd->dst = (u32)dst;
+    cmd->bytes = bytes;
+    list->used += size;
+    list->commands++;
+    return cmd;
+}
+
+static inline void RenderCmd_CopyHalfwords(volatile u16* dst, const u16* src,
+                                           u32 bytes) {
+    if (bytes >= DMA_MIN_BYTES) {
+        dmaCopy(src, (void*)dst, bytes);
+        return;
+    }
+    for (u32 i = 0; i < bytes / 2; i++)
+        dst[i] = src[i];
+}
+
+static void RenderCmd_Apply(const RenderList* list) {
+    u32 offset = 0;
+    while (offset < list->used) {
+        const RenderCmd* cmd = (const RenderCmd*)&list->arena[offset];
+        const u8* payload = (const u8*)(cmd + 1);
+        volatile u16* dst = (volatile u16*)cmd->dst;
+
+        switch ((RenderOp)cmd->op) {
+            case RCMD_WRITE16:
+                *dst = cmd->arg;
+                offset += sizeof(RenderCmd);
+                continue;
+            case RCMD_COPY:
+                RenderCmd_CopyHalfwords(dst, (const u16*)payload, cmd->bytes);
+                offset += sizeof(RenderCmd) + RenderCmd_Pad(cmd->bytes);
+                continue;
+            case RCMD_COPY_REF:
+                RenderCmd_CopyHalfwords(dst, *(const u16* const*)payload, cmd->bytes);
+                offset += sizeof(RenderCmd) + sizeof(const void*);
+                continue;
+            case RCMD_STRIDED: {
+                const u16* src = (const u16*)payload;
+                for (u32 i = 0; i < cmd->bytes / 2; i++)
+                    dst[i * cmd->arg] = src[i];
+                offset += sizeof(RenderCmd) + RenderCmd_Pad(cmd->bytes);
+                continue;
+            }
+        }
+        break;  // Corrupt list: stop rather than write garbage
+    }
+}
+
+static void RenderCmd_Clear(RenderList* list) {
+    list->used = 0;
+    list->commands = 0;
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void RenderCmd_Reset(void) {
+    int oldIme = enterCriticalSection();
+    pending = NO_LIST;
+    leaveCriticalSection(oldIme);
+
+    recording = 0;
+    RenderCmd_Clear(&lists[0]);
+    RenderCmd_Clear(&lists[1]);
+    memset(&stats, 0, sizeof(stats));
+}
+
+bool RenderCmd_Write16(volatile u16* dst, u16 value) {
+    RenderCmd* cmd = RenderCmd_Push(RCMD_WRITE16, (void*)dst, sizeof(u16), 0);
+    if (cmd == NULL)
+        return false;
+    cmd->arg = value;
+    return true;
+}
+
+bool RenderCmd_Copy(void* dst, const void* src, u32 bytes) {
+    u16* payload = RenderCmd_Alloc(dst, bytes);
+    if (payload == NULL)
+        return false;
+    memcpy(payload, src, bytes);
+    return true;
+}
+
+bool RenderCmd_CopyConst(void* dst, const void* src, u32 bytes) {
+    RenderCmd* cmd = RenderCmd_Push(RCMD_COPY_REF, dst, bytes, sizeof(const void*));
+    if (cmd == NULL)
+        return false;
+    *(const void**)(cmd + 1) = src;
+    return true;
+}
+
+u16* RenderCmd_Alloc(void* dst, u32 bytes) {
+    RenderCmd* cmd = RenderCmd_Push(RCMD_COPY, dst, bytes, bytes);
+    return (cmd != NULL) ? (u16*)(cmd + 1) : NULL;
+}
+
+bool RenderCmd_CopyStrided(u16* dst, int stride, const u16* src, int count) {
+    u32 bytes = (u32)count * sizeof(u16);
+    RenderCmd* cmd = RenderCmd_Push(RCMD_STRIDED, dst, bytes, bytes);
+    if (cmd == NULL)
+        return false;
+    cmd->arg = (u16)stride;
+    memcpy(cmd + 1, src, bytes);
+    return true;
+}
+
+void RenderCmd_Publish(void) {
+    RenderList* list = &lists[recording];
+    if (list->used > 0)
+        DC_FlushRange(list->arena, list->used);
+
+    stats.lastCommands = list->commands;
+    stats.lastBytes = (int)list->used;
+    if (stats.lastBytes > stats.maxBytes)
+        stats.maxBytes = stats.lastBytes;
+
+    int oldIme = enterCriticalSection();
+    if (pending != NO_LIST) {
+        // VBlank never picked the previous list up: apply it now, in order
+        RenderCmd_Apply(&lists[pending]);
+        stats.lateReplays++;
+    }
+    pending = recording;
+    leaveCriticalSection(oldIme);
+
+    recording ^= 1;
+    RenderCmd_Clear(&lists[recording]);
+}
+
+void RenderCmd_Replay(void) {
+    if (pending == NO_LIST) {
+        stats.idleVBlanks++;
+        return;
+    }
+
+    RenderCmd_Apply(&lists[pending]);
+    pending = NO_LIST;
+    stats.replayed++;
+}
+
+const RenderCmdStats* RenderCmd_GetStats(void) {
+    return &stats;
+}
@@ -0,0 +1,145 @@
+/**
+ * File: render_cmd.h
+ * ------------------
+ * Description: Render command buffer. The main loop records every VRAM and
+ *              display register change of a frame (OAM spans, BG scroll, map
+ *              patches, palette entries) into a compact list instead of
+ *              writing hardware directly. RenderCmd_Publish() hands the list to
+ *              the VBlank interrupt, which only replays it with DMA, so the ISR
+ *              stays short and the screen never shows a half-updated frame.
+ *
+ * Usage:
+ *   RenderCmd_Reset();                        // screen setup
+ *   ...each frame, main loop...
+ *   RenderCmd_Write16(&BG_OFFSET[0].x, x);    // record changes
+ *   RenderCmd_Copy(OAM, shadow, bytes);
+ *   RenderCmd_Publish();                      // before swiWaitForVBlank()
+ *   ...VBlank ISR...
+ *   RenderCmd_Replay();
+ *
+ * Two lists alternate: one is being recorded while the other waits for (or
+ * is replayed by) VBlank. Payloads are copied into the list when recorded, so
+ * the source buffers can change right after the call.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef RENDER_CMD_H
+#define RENDER_CMD_H
+
+#include <nds.h>
+#include <stdbool.h>
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+/**
+ * Counters since the last RenderCmd_Reset() (lastCommands/lastBytes describe
+ * the most recently published list).
+ */
+typedef struct {
+    int lastCommands;   // Commands in the last published list
+    int lastBytes;      // Arena bytes used by the last published list
+    int maxBytes;       // Largest published list
+    int overflows;      // Commands rejected because the arena was full
+    int replayed;       // Lists replayed in VBlank
+    int idleVBlanks;    // VBlanks with no new list (frame took too long)
+    int lateReplays;    // Lists replayed outside VBlank (previous one pending)
+} RenderCmdStats;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: RenderCmd_Reset
+ * -------------------------
+ * Drops both lists (recorded and pending) and clears the counters. Call when a
+ * screen is set up, before anything is recorded for it.
+ */
+void RenderCmd_Reset(void);
+
+/**
+ * Function: RenderCmd_Write16
+ * ---------------------------
+ * Records a 16-bit write (display register, single palette or map entry).
+ *
+ * Returns: false if the list is full (nothing recorded)
+ */
+bool RenderCmd_Write16(volatile u16* dst, u16 value);
+
+/**
+ * Function: RenderCmd_Copy
+ * ------------------------
+ * Records a copy to VRAM, OAM or palette memory. The source is copied into
+ * the list now.
+ *
+ * Parameters:
+ *   dst   - Destination (halfword aligned)
+ *   src   - Source data
+ *   bytes - Size in bytes (multiple of 2)
+ *
+ * Returns: false if the list is full (nothing recorded)
+ */
+bool RenderCmd_Copy(void* dst, const void* src, u32 bytes);
+
+/**
+ * Function: RenderCmd_CopyConst
+ * -----------------------------
+ * Like RenderCmd_Copy() but only records the source address. For data that
+ * never changes while the game runs (grit tiles and palettes).
+ */
+bool RenderCmd_CopyConst(void* dst, const void* src, u32 bytes);
+
+/**
+ * Function: RenderCmd_Alloc
+ * -------------------------
+ * Records a copy whose payload the caller fills in place (avoids staging the
+ * data twice, e.g. for a whole BG window).
+ *
+ * Parameters:
+ *   dst   - Destination (halfword aligned)
+ *   bytes - Size in bytes (multiple of 2)
+ *
+ * Returns: Payload to fill before RenderCmd_Publish(), or NULL if the list is
+ *          full
+ */
+u16* RenderCmd_Alloc(void* dst, u32 bytes);
+
+/**
+ * Function: RenderCmd_CopyStrided
+ * -------------------------------
+ * Records `count` halfwords written `stride` halfwords apart (a tilemap
+ * column). The source is copied into the list now.
+ *
+ * Returns: false if the list is full (nothing recorded)
+ */
+bool RenderCmd_CopyStrided(u16* dst, int stride, const u16* src, int count);
+
+/**
+ * Function: RenderCmd_Publish
+ * ---------------------------
+ * Hands the recorded list to the next VBlank and starts a new one. If the
+ * previously published list was never replayed (VBlank replay not running)
+ * it is applied immediately so no change is lost.
+ */
+void RenderCmd_Publish(void);
+
+/**
+ * Function: RenderCmd_Replay
+ * --------------------------
+ * Applies the published list, if any. Call from the VBlank ISR only.
+ */
+void RenderCmd_Replay(void);
+
+/**
+ * Function: RenderCmd_GetStats
+ * ----------------------------
+ * Gets the counters.
+ */
+const RenderCmdStats* RenderCmd_GetStats(void);
+
+#endif  // RENDER_CMD_H
@@ -0,0 +1,162 @@
+/**
+ * File: residency.c
+ * -----------------
+ * Description: Implementation of VRAM/palette residency. A table lists, per
+ *              state, the regions it draws into and the ones it claims with a
+ *              tag. Unclaimed regions are cleared when the state is entered
+ *              (as video_nuke did for every bank); claimed regions are cleared
+ *              only when their tag changes.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "residency.h"
+
+#include <string.h>
+
+#include "../core/game_constants.h"
+#include "../core/mem_budget.h"
+#include "graphics.h"
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define REGION_BIT(region) (1u << (region))
+#define ALL_REGIONS (REGION_BIT(RES_REGION_COUNT) - 1)
+#define REGION_BYTES (VRAM_BANK_SIZE + PALETTE_SIZE)
+
+//=============================================================================
+// PRIVATE TYPES
+//=============================================================================
+typedef struct {
+    u8 uses;    // Regions the state draws into
+    u8 claims;  // Subset it claims with Residency_Claim()
+} StateRegions;
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static const StateRegions stateRegions[] = {
+    [HOME_PAGE] = {REGION_BIT(RES_MAIN_BG) | REGION_BIT(RES_MAIN_SPRITE) |
+                       REGION_BIT(RES_SUB_BG),
+                   0},
+    [REINIT_HOME] = {REGION_BIT(RES_MAIN_BG) | REGION_BIT(RES_MAIN_SPRITE) |
+                         REGION_BIT(RES_SUB_BG),
+                     0},
+    [MAPSELECTION] = {REGION_BIT(RES_MAIN_BG) | REGION_BIT(RES_SUB_BG), 0},
+    [MULTIPLAYER_LOBBY] = {REGION_BIT(RES_SUB_BG), 0},  // Console only
+    [GAMEPLAY] = {ALL_REGIONS, REGION_BIT(RES_MAIN_BG) | REGION_BIT(RES_MAIN_SPRITE) |
+                                   REGION_BIT(RES_SUB_SPRITE)},
+    [PLAYAGAIN] = {REGION_BIT(RES_SUB_BG), 0},
+    [SETTINGS] = {REGION_BIT(RES_MAIN_BG) | REGION_BIT(RES_SUB_BG), 0},
+};
+
+static void* const regionVram[RES_REGION_COUNT] = {
+    [RES_MAIN_BG] = (void*)VRAM_A,
+    [RES_MAIN_SPRITE] = (void*)VRAM_B,
+    [RES_SUB_BG] = (void*)VRAM_C,
+    [RES_SUB_SPRITE] = (void*)VRAM_D,
+};
+
+static u16* const regionPalette[RES_REGION_COUNT] = {
+    [RES_MAIN_BG] = BG_PALETTE,
+    [RES_MAIN_SPRITE] = SPRITE_PALETTE,
+    [RES_SUB_BG] = BG_PALETTE_SUB,
+    [RES_SUB_SPRITE] = SPRITE_PALETTE_SUB,
+};
+
+// Accounting of what a region holds besides OAM blocks (see mem_budget.h)
+static const MemPool regionPool[RES_REGION_COUNT] = {
+    [RES_MAIN_BG] = MEM_POOL_BG_MAIN,
+    [RES_MAIN_SPRITE] = MEM_POOL_PAL_MAIN,
+    [RES_SUB_BG] = MEM_POOL_BG_SUB,
+    [RES_SUB_SPRITE] = MEM_POOL_PAL_SUB,
+};
+
+static ResTag tags[RES_REGION_COUNT];
+static u8 pendingClaims = 0;  // Claimable regions not yet claimed this transition
+static ResidencyStats stats;
+
+//=============================================================================
+// PRIVATE HELPERS
+//=============================================================================
+
+static void Residency_Clear(ResRegion region) {
+    memset(regionVram[region], 0, VRAM_BANK_SIZE);
+    memset(regionPalette[region], 0, PALETTE_SIZE);
+    MemBudget_ReleasePool(regionPool[region]);
+    tags[region] = RES_TAG_NONE;
+    stats.lastClearedBytes += REGION_BYTES;
+    stats.totalClearedBytes += REGION_BYTES;
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void Residency_Init(void) {
+    video_nuke();
+    for (int r = 0; r < RES_REGION_COUNT; r++)
+        MemBudget_ReleasePool(regionPool[r]);
+    memset(tags, 0, sizeof(tags));
+    memset(&stats, 0, sizeof(stats));
+    pendingClaims = 0;
+}
+
+void Residency_BeginTransition(GameState next) {
+    video_reset_registers();
+    stats.transitions++;
+    stats.lastClearedBytes = 0;
+    stats.lastKeptBytes = 0;
+
+#ifdef RESIDENCY_DISABLED
+    // Measurement baseline: every region is cleared, as video_nuke() did
+    (void)next;
+    for (int r = 0; r < RES_REGION_COUNT; r++)
+        Residency_Clear((ResRegion)r);
+    pendingClaims = 0;
+#else
+    const StateRegions* regions = &stateRegions[next];
+    for (int r = 0; r < RES_REGION_COUNT; r++) {
+        u8 bit = REGION_BIT(r);
+        if ((regions->uses & bit) && !(regions->claims & bit))
+            Residency_Clear((ResRegion)r);
+    }
+    pendingClaims = regions->claims;
+#endif
+}
+
+bool Residency_Claim(ResRegion region, ResTag tag) {
+#ifdef RESIDENCY_DISABLED
+    tags[region] = tag;  // Already cleared by Residency_BeginTransition()
+    return false;
+#else
+    pendingClaims &= ~REGION_BIT(region);
+    if (tag != RES_TAG_NONE && tags[region] == tag) {
+        stats.lastKeptBytes += REGION_BYTES;
+        stats.totalKeptBytes += REGION_BYTES;
+        return true;
+    }
+    Residency_Clear(region);
+    tags[region] = tag;
+    return false;
+#endif
+}
+
+void Residency_EndTransition(void) {
+    for (int r = 0; r < RES_REGION_COUNT; r++) {
+        if (pendingClaims & REGION_BIT(r))
+            Residency_Clear((ResRegion)r);
+    }
+    pendingClaims = 0;
+}
+
+void Residency_Invalidate(ResRegion region) {
+    tags[region] = RES_TAG_NONE;
+}
+
+const ResidencyStats* Residency_GetStats(void) {
+    return &stats;
+}
@@ -0,0 +1,128 @@
+/**
+ * File: residency.h
+ * -----------------
+ * Description: VRAM and palette residency across state transitions. Each of
+ *              the four VRAM banks, with the palette of the same engine and
+ *              layer kind, is a region that remembers which asset set it
+ *              holds. A transition only clears the regions the next state
+ *              uses; regions it does not use keep their contents (the screens
+ *              are off), and a state that claims a region with the tag of
+ *              what is already there skips the upload. PLAYAGAIN -> GAMEPLAY
+ *              thus keeps the track tileset, its palette and the race sprite
+ *              banks resident instead of wiping 512 KB of VRAM and decoding
+ *              the track again.
+ *
+ * Usage (main loop):
+ *   StateMachine_Cleanup(old, next);
+ *   Residency_BeginTransition(next);   // instead of video_nuke()
+ *   StateMachine_Init(next);           // states call Residency_Claim()
+ *   Residency_EndTransition();
+ *
+ * Usage (state init):
+ *   if (!Residency_Claim(RES_MAIN_BG, RES_TAG_TRACK(map)))
+ *       TrackMap_UploadGraphics();     // region was cleared, upload
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef RESIDENCY_H
+#define RESIDENCY_H
+
+#include <nds.h>
+#include <stdbool.h>
+
+#include "../core/game_types.h"
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+typedef enum {
+    RES_MAIN_BG,      // VRAM A + BG_PALETTE
+    RES_MAIN_SPRITE,  // VRAM B + SPRITE_PALETTE
+    RES_SUB_BG,       // VRAM C + BG_PALETTE_SUB
+    RES_SUB_SPRITE,   // VRAM D + SPRITE_PALETTE_SUB
+    RES_REGION_COUNT
+} ResRegion;
+
+// What a region holds; RES_TAG_NONE means cleared or written by a state that
+// does not claim it (contents unknown)
+typedef u32 ResTag;
+
+#define RES_TAG_NONE 0u
+#define RES_TAG_TRACK(map) (0x100u | (u32)(map))  // Track tileset + palette
+#define RES_TAG_RACE_SPRITES 0x200u              // Kart and item sheets
+#define RES_TAG_RACE_ITEM_SUB 0x201u             // Held item display
+
+/**
+ * Counters since Residency_Init().
+ */
+typedef struct {
+    u32 transitions;
+    u32 lastClearedBytes;  // VRAM + palette bytes cleared by the last transition
+    u32 lastKeptBytes;     // Bytes a claim found resident in the last transition
+    u32 totalClearedBytes;
+    u32 totalKeptBytes;
+} ResidencyStats;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: Residency_Init
+ * ------------------------
+ * Clears all VRAM and palettes (video_nuke) and forgets every tag. Call once
+ * at boot.
+ */
+void Residency_Init(void);
+
+/**
+ * Function: Residency_BeginTransition
+ * -----------------------------------
+ * Resets the display registers and clears the regions `next` uses without
+ * claiming them. Regions `next` claims are cleared lazily by
+ * Residency_Claim(); regions it does not use are left untouched.
+ */
+void Residency_BeginTransition(GameState next);
+
+/**
+ * Function: Residency_Claim
+ * -------------------------
+ * Takes a region for the state being initialized.
+ *
+ * Parameters:
+ *   region - Region to use
+ *   tag    - Asset set the state keeps in it
+ *
+ * Returns:
+ *   true  - The region already holds `tag`: skip the upload
+ *   false - The region was cleared and now carries `tag`: upload it
+ */
+bool Residency_Claim(ResRegion region, ResTag tag);
+
+/**
+ * Function: Residency_EndTransition
+ * ---------------------------------
+ * Clears the regions the new state was expected to claim but did not (e.g.
+ * its assets failed to load), so it never shows a previous screen's data.
+ */
+void Residency_EndTransition(void);
+
+/**
+ * Function: Residency_Invalidate
+ * ------------------------------
+ * Forgets what a region holds (it was overwritten outside a claim).
+ */
+void Residency_Invalidate(ResRegion region);
+
+/**
+ * Function: Residency_GetStats
+ * ----------------------------
+ * Gets the transition counters.
+ */
+const ResidencyStats* Residency_GetStats(void);
+
+#endif  // RESIDENCY_H
@@ -0,0 +1,134 @@
+/**
+ * File: rot_sprite.c
+ * ------------------
+ * Description: Frame selection for pre-rotated sprites. A direction index d
+ *              (0..directions-1) is mapped to a stored frame and flips using
+ *              R(180 + a) = HV R(a), and for mirror-symmetric sprites
+ *              R(-a) = V R(a) (x-axis) or H R(a) (y-axis).
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "rot_sprite.h"
+
+#include <string.h>
+
+#include "../core/game_constants.h"
+
+//=============================================================================
+// PRIVATE HELPERS
+//=============================================================================
+
+// 4bpp bytes of one frame: SpriteSize keeps the pixel count / 32 in bits 0-11
+static inline u32 RotSprite_FrameBytes(SpriteSize size) {
+    return (u32)(size & 0xFFF) << 4;
+}
+
+static int RotSprite_StoredFrames(int directions, RotSymmetry symmetry) {
+    return (symmetry == ROT_SYMMETRY_HALF) ? directions / 2 : directions / 4 + 1;
+}
+
+static void RotSprite_Dimensions(SpriteSize size, int* w, int* h) {
+    // Frames are square or tall/wide with the same table as the hardware
+    static const u8 dims[3][4][2] = {
+        {{8, 8}, {16, 16}, {32, 32}, {64, 64}},
+        {{16, 8}, {32, 8}, {32, 16}, {64, 32}},
+        {{8, 16}, {8, 32}, {16, 32}, {32, 64}},
+    };
+    int shape = SPRITE_SIZE_SHAPE(size);
+    if (shape > 2)
+        shape = 0;
+    *w = dims[shape][SPRITE_SIZE_SIZE(size)][0];
+    *h = dims[shape][SPRITE_SIZE_SIZE(size)][1];
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+bool RotSprite_Load(RotSprite* sprite, int directions, RotSymmetry symmetry,
+                    SpriteSize size, const void* tiles, u32 tilesLen, MemOwner owner) {
+    memset(sprite, 0, sizeof(*sprite));
+
+    int count = RotSprite_StoredFrames(directions, symmetry);
+    u32 frameBytes = RotSprite_FrameBytes(size);
+    if (count > ROT_SPRITE_MAX_FRAMES || tilesLen != count * frameBytes)
+        return false;
+
+    sprite->directions = directions;
+    sprite->symmetry = symmetry;
+    sprite->size = size;
+
+    const u8* src = (const u8*)tiles;
+    for (int i = 0; i < count; i++) {
+        u16* gfx =
+            MemBudget_AllocGfx(&oamMain, size, SpriteColorFormat_16Color, owner);
+        if (gfx == NULL) {
+            RotSprite_Free(sprite);
+            return false;
+        }
+        dmaCopy(src + i * frameBytes, gfx, frameBytes);
+        sprite->frames[sprite->frameCount++] = gfx;
+    }
+    return true;
+}
+
+void RotSprite_Free(RotSprite* sprite) {
+    for (int i = 0; i < sprite->frameCount; i++) {
+        MemBudget_FreeGfx(&oamMain, sprite->frames[i]);
+        sprite->frames[i] = NULL;
+    }
+    sprite->frameCount = 0;
+}
+
+void RotSprite_Place(const RotSprite* sprite, int angle512, int centerX, int centerY,
+                     SpriteDesc* out) {
+    int w, h;
+    RotSprite_Dimensions(sprite->size, &w, &h);
+    out->x = centerX - w / 2;
+    out->y = centerY - h / 2;
+    out->size = sprite->size;
+    out->rotate = false;
+    out->hflip = false;
+    out->vflip = false;
+
+    if (sprite->frameCount == 0) {
+        out->gfx = NULL;
+        return;
+    }
+
+    // Nearest direction, then fold it into the stored range
+    int step = ANGLE_FULL / sprite->directions;
+    int d = ((angle512 + step / 2) & ANGLE_MASK) / step;
+    int half = sprite->directions / 2;
+    int quarter = sprite->directions / 4;
+    int frame = d;
+
+    if (sprite->symmetry == ROT_SYMMETRY_HALF) {
+        if (d >= half) {
+            frame = d - half;
+            out->hflip = out->vflip = true;
+        }
+    } else {
+        // Flip that turns frame a into -a for this mirror axis
+        bool mirrorX = (sprite->symmetry == ROT_SYMMETRY_QUARTER_X);
+        if (d > quarter && d <= half) {  // 180 - a
+            frame = half - d;
+            out->hflip = mirrorX;
+            out->vflip = !mirrorX;
+        } else if (d > half && d < half + quarter) {  // 180 + a
+            frame = d - half;
+            out->hflip = out->vflip = true;
+        } else if (d >= half + quarter) {  // -a
+            frame = sprite->directions - d;
+            out->hflip = !mirrorX;
+            out->vflip = mirrorX;
+        }
+    }
+
+    if (frame >= sprite->frameCount)
+        frame = sprite->frameCount - 1;
+    out->gfx = sprite->frames[frame];
+}
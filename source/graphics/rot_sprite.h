@@ -0,0 +1,101 @@
+/**
+ * File: rot_sprite.h
+ * ------------------
+ * Description: Pre-rotated sprite frames. tools/img/prerotate_sprite.py
+ *              renders 16 or 32 directions of a sprite at build time and keeps
+ *              only the frames that hflip/vflip cannot rebuild. At runtime a
+ *              frame and flip pair is picked from angle512, so karts and
+ *              projectiles rotate without consuming any of the 32 affine
+ *              matrices (those stay free for effects through the sprite
+ *              batcher's `rotate` flag).
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef ROT_SPRITE_H
+#define ROT_SPRITE_H
+
+#include <nds.h>
+#include <stdbool.h>
+
+#include "../core/mem_budget.h"
+#include "sprite_batch.h"
+
+//=============================================================================
+// PUBLIC CONSTANTS
+//=============================================================================
+#define ROT_SPRITE_MAX_FRAMES 16  // 32 directions with half-turn symmetry
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+/**
+ * Which flips rebuild the directions that are not stored (must match the
+ * --symmetry option the sheet was generated with).
+ */
+typedef enum {
+    ROT_SYMMETRY_HALF,       // directions/2 frames, +180 deg = hflip + vflip
+    ROT_SYMMETRY_QUARTER_X,  // directions/4+1 frames, sprite mirrors about x-axis
+    ROT_SYMMETRY_QUARTER_Y   // directions/4+1 frames, sprite mirrors about y-axis
+} RotSymmetry;
+
+typedef struct {
+    int directions;  // Directions per full turn (16 or 32)
+    RotSymmetry symmetry;
+    SpriteSize size;  // Size of one frame
+    int frameCount;
+    u16* frames[ROT_SPRITE_MAX_FRAMES];  // One OAM graphics block per frame
+} RotSprite;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: RotSprite_Load
+ * ------------------------
+ * Allocates one 16-color OAM graphics block per stored frame on the main
+ * engine and copies the frame sheet into them.
+ *
+ * Parameters:
+ *   sprite     - Sprite to fill
+ *   directions - Directions per full turn the sheet was generated for
+ *   symmetry   - Symmetry the sheet was generated with
+ *   size       - Frame size
+ *   tiles      - Grit tile data of the frame sheet
+ *   tilesLen   - Size of tiles in bytes
+ *   owner      - Subsystem the blocks are charged to (see mem_budget.h)
+ *
+ * Returns: false if the sheet does not match the expected frame count or
+ *          sprite VRAM ran out (sprite is left empty)
+ */
+bool RotSprite_Load(RotSprite* sprite, int directions, RotSymmetry symmetry,
+                    SpriteSize size, const void* tiles, u32 tilesLen, MemOwner owner);
+
+/**
+ * Function: RotSprite_Free
+ * ------------------------
+ * Releases the frame graphics blocks.
+ */
+void RotSprite_Free(RotSprite* sprite);
+
+/**
+ * Function: RotSprite_Place
+ * -------------------------
+ * Fills the position, size, graphics and flip fields of a sprite description
+ * with the frame nearest to an angle, centred on a screen point.
+ *
+ * Parameters:
+ *   sprite   - Loaded frames
+ *   angle512 - Heading (0-511, clockwise on screen, 0 = as drawn)
+ *   centerX  - Screen X of the sprite centre
+ *   centerY  - Screen Y of the sprite centre
+ *   out      - Description to fill (format, palette, priority left untouched)
+ */
+void RotSprite_Place(const RotSprite* sprite, int angle512, int centerX, int centerY,
+                     SpriteDesc* out);
+
+#endif  // ROT_SPRITE_H
@@ -0,0 +1,245 @@
+/**
+ * File: sprite_batch.c
+ * --------------------
+ * Description: Implementation of the main-screen sprite batcher. OAM entries
+ *              are composed as raw attribute words and compared against the
+ *              libnds shadow OAM, so a sprite that did not move costs one
+ *              compare instead of an oamSet() and a 1 KB oamUpdate(). Affine
+ *              matrices are handed out per frame from the 32 hardware slots;
+ *              a matrix is only rewritten when its angle changes.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "sprite_batch.h"
+
+#include <string.h>
+
+#include "../core/game_constants.h"
+#include "render_cmd.h"
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define PRIORITY_LEVELS 4
+#define ENTRIES_PER_MATRIX 4  // Matrix k lives in attribute3 of entries 4k..4k+3
+#define UNIT_SCALE (1 << 8)
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static OamState* oam = NULL;
+
+static SpriteDesc queue[SPRITE_COUNT];
+static int queueCount = 0;
+static int lastDrawn = 0;  // Entries used by the previous frame
+
+static s16 matrixAngle[MATRIX_COUNT];  // Angle currently in each matrix
+static bool matrixValid[MATRIX_COUNT];
+
+static int dirtyMin = SPRITE_COUNT;
+static int dirtyMax = -1;
+
+static SpriteBatchStats stats;
+
+//=============================================================================
+// PRIVATE HELPERS
+//=============================================================================
+
+static inline void SpriteBatch_MarkDirty(int first, int last) {
+    if (first < dirtyMin)
+        dirtyMin = first;
+    if (last > dirtyMax)
+        dirtyMax = last;
+}
+
+// Pixel dimensions of a libnds SpriteSize (shape x size table)
+static void SpriteBatch_GetDimensions(SpriteSize size, int* w, int* h) {
+    static const u8 dims[3][4][2] = {
+        {{8, 8}, {16, 16}, {32, 32}, {64, 64}},  // Square
+        {{16, 8}, {32, 8}, {32, 16}, {64, 32}},  // Wide
+        {{8, 16}, {8, 32}, {16, 32}, {32, 64}},  // Tall
+    };
+    int shape = SPRITE_SIZE_SHAPE(size);
+    int index = SPRITE_SIZE_SIZE(size);
+    if (shape > 2)
+        shape = 0;
+    *w = dims[shape][index][0];
+    *h = dims[shape][index][1];
+}
+
+// Returns the matrix holding `angle` this frame, claiming a new one if needed
+static int SpriteBatch_AcquireMatrix(s16 angle) {
+    for (int k = 0; k < stats.affineUsed; k++) {
+        if (matrixAngle[k] == angle)
+            return k;
+    }
+    if (stats.affineUsed >= MATRIX_COUNT)
+        return -1;
+
+    int k = stats.affineUsed++;
+    if (!matrixValid[k] || matrixAngle[k] != angle) {
+        oamRotateScale(oam, k, angle, UNIT_SCALE, UNIT_SCALE);
+        matrixAngle[k] = angle;
+        matrixValid[k] = true;
+        SpriteBatch_MarkDirty(k * ENTRIES_PER_MATRIX,
+                              k * ENTRIES_PER_MATRIX + ENTRIES_PER_MATRIX - 1);
+    }
+    return k;
+}
+
+static void SpriteBatch_WriteEntry(int index, u16 attr0, u16 attr1, u16 attr2) {
+    SpriteEntry* e = &oam->oamMemory[index];
+    if (e->attribute[0] == attr0 && e->attribute[1] == attr1 &&
+        e->attribute[2] == attr2)
+        return;
+
+    e->attribute[0] = attr0;
+    e->attribute[1] = attr1;
+    e->attribute[2] = attr2;
+    stats.entriesWritten++;
+    SpriteBatch_MarkDirty(index, index);
+}
+
+static void SpriteBatch_Emit(int index, const SpriteDesc* s) {
+    int x = s->x;
+    int y = s->y;
+    int matrix = s->rotate ? SpriteBatch_AcquireMatrix(s->angle) : -1;
+    if (s->doubleSize && matrix < 0) {
+        // Drawn at normal size: keep the art centred where the doubled box had it
+        int w, h;
+        SpriteBatch_GetDimensions(s->size, &w, &h);
+        x += w / 2;
+        y += h / 2;
+    }
+
+    u16 attr0 = OBJ_Y(y) | (SPRITE_SIZE_SHAPE(s->size) << 14);
+    u16 attr1 = OBJ_X(x) | (SPRITE_SIZE_SIZE(s->size) << 14);
+    u16 attr2 = (oamGfxPtrToOffset(oam, s->gfx) & 0x3FF) |
+                ATTR2_PRIORITY(s->priority) | ATTR2_PALETTE(s->palette);
+
+    if (s->format == SpriteColorFormat_256Color)
+        attr0 |= ATTR0_COLOR_256;
+    if (s->blended)
+        attr0 |= ATTR0_TYPE_BLENDED;
+
+    if (matrix >= 0) {
+        attr0 |= s->doubleSize ? ATTR0_ROTSCALE_DOUBLE : ATTR0_ROTSCALE;
+        attr1 |= ATTR1_ROTDATA(matrix);
+    } else {
+        if (s->rotate)
+            stats.affineOverflow++;  // Still drawn, just unrotated
+        if (s->hflip)
+            attr1 |= ATTR1_FLIP_X;
+        if (s->vflip)
+            attr1 |= ATTR1_FLIP_Y;
+    }
+
+    SpriteBatch_WriteEntry(index, attr0, attr1, attr2);
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void SpriteBatch_Init(OamState* target) {
+    oam = target;
+    queueCount = 0;
+    lastDrawn = SPRITE_COUNT;  // First End() hides whatever it does not use
+    memset(matrixValid, 0, sizeof(matrixValid));
+    memset(&stats, 0, sizeof(stats));
+
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        oam->oamMemory[i].attribute[0] = ATTR0_DISABLED;
+        oam->oamMemory[i].attribute[1] = 0;
+        oam->oamMemory[i].attribute[2] = 0;
+    }
+    SpriteBatch_MarkDirty(0, SPRITE_COUNT - 1);
+}
+
+void SpriteBatch_Begin(void) {
+    queueCount = 0;
+    stats.submitted = 0;
+    stats.culled = 0;
+    stats.dropped = 0;
+}
+
+bool SpriteBatch_Submit(const SpriteDesc* sprite) {
+    stats.submitted++;
+
+    int w, h;
+    SpriteBatch_GetDimensions(sprite->size, &w, &h);
+    if (sprite->doubleSize) {
+        w *= 2;
+        h *= 2;
+    }
+    if (sprite->x + w <= 0 || sprite->x >= SCREEN_WIDTH || sprite->y + h <= 0 ||
+        sprite->y >= SCREEN_HEIGHT) {
+        stats.culled++;
+        return false;
+    }
+
+    if (queueCount >= SPRITE_COUNT) {
+        stats.dropped++;
+        return false;
+    }
+
+    queue[queueCount++] = *sprite;
+    return true;
+}
+
+void SpriteBatch_End(void) {
+    if (oam == NULL)
+        return;
+
+    stats.drawn = 0;
+    stats.affineUsed = 0;
+    stats.affineOverflow = 0;
+    stats.entriesWritten = 0;
+
+    // Stable counting sort by priority: lower OAM index wins ties on screen,
+    // so submission order is kept within a priority level
+    int index = 0;
+    for (int p = 0; p < PRIORITY_LEVELS; p++) {
+        for (int i = 0; i < queueCount; i++) {
+            if ((queue[i].priority & 3) == p)
+                SpriteBatch_Emit(index++, &queue[i]);
+        }
+    }
+    stats.drawn = index;
+
+    // Hide entries the previous frame used and this one did not
+    for (int i = index; i < lastDrawn; i++)
+        SpriteBatch_WriteEntry(i, ATTR0_DISABLED, 0, 0);
+    lastDrawn = index;
+
+    // Matrices no longer in use keep their last angle (still valid to reuse)
+}
+
+void SpriteBatch_Flush(void) {
+    if (oam == NULL || dirtyMax < dirtyMin) {
+        stats.bytesFlushed = 0;
+        return;
+    }
+
+    SpriteEntry* src = &oam->oamMemory[dirtyMin];
+    int bytes = (dirtyMax - dirtyMin + 1) * (int)sizeof(SpriteEntry);
+    u16* hw = (oam == &oamSub) ? OAM_SUB : OAM;
+
+    // Span stays dirty (retried next frame) if the command list is full
+    if (!RenderCmd_Copy(hw + dirtyMin * (sizeof(SpriteEntry) / sizeof(u16)), src,
+                        bytes)) {
+        stats.bytesFlushed = 0;
+        return;
+    }
+
+    stats.bytesFlushed = bytes;
+    dirtyMin = SPRITE_COUNT;
+    dirtyMax = -1;
+}
+
+const SpriteBatchStats* SpriteBatch_GetStats(void) {
+    return &stats;
+}
@@ -0,0 +1,124 @@
+/**
+ * File: sprite_batch.h
+ * --------------------
+ * Description: Per-frame sprite batcher for the main screen. Gameplay code
+ *              submits sprites (position, size, graphics, palette, priority,
+ *              optional rotation) instead of writing fixed OAM slots. At the
+ *              end of the frame the batcher culls off-screen sprites, orders
+ *              the rest by priority, assigns OAM entries and affine matrices
+ *              dynamically (sprites with the same angle share a matrix), and
+ *              writes only the entries that changed into the libnds shadow OAM.
+ *              SpriteBatch_Flush() records just the dirty span as a render
+ *              command (render_cmd.h), replayed to hardware OAM in VBlank.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <nds.h>
+#include <stdbool.h>
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+/**
+ * One sprite for the current frame. Fields not set by a designated
+ * initializer default to 0: no rotation, palette 0, OBJPRIORITY_0, no flips.
+ */
+typedef struct {
+    int x, y;                  // Screen position of the top-left corner (of the
+                               // doubled box if doubleSize)
+    SpriteSize size;
+    SpriteColorFormat format;
+    const void* gfx;           // Tile data from oamAllocateGfx()
+    u8 palette;                // 16-color palette slot (0-15)
+    u8 priority;               // OBJPRIORITY_0 (front) .. OBJPRIORITY_3
+    bool rotate;               // Use an affine matrix for `angle`
+    s16 angle;                 // libnds angle (32768 = full turn), if rotate
+    bool doubleSize;           // Rotated in a box twice the size, so corners
+                               // are not clipped; art centred at x + w, y + h
+    bool hflip, vflip;         // Ignored when rotate is set
+    bool blended;              // Semi-transparent (weights in REG_BLDALPHA)
+} SpriteDesc;
+
+/**
+ * Batcher counters for the last frame (SpriteBatch_End) and last flush.
+ */
+typedef struct {
+    int submitted;        // Sprites passed to SpriteBatch_Submit()
+    int drawn;            // Sprites that got an OAM entry
+    int culled;           // Sprites fully off-screen
+    int dropped;          // Sprites past the 128-entry OAM limit
+    int affineUsed;       // Distinct affine matrices in use
+    int affineOverflow;   // Rotated sprites drawn unrotated (no matrix left)
+    int entriesWritten;   // OAM entries whose attributes changed
+    int bytesFlushed;     // Bytes recorded for hardware OAM by the last flush
+} SpriteBatchStats;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: SpriteBatch_Init
+ * --------------------------
+ * Binds the batcher to an OAM (call after oamInit()). Hides every entry and
+ * marks the whole table dirty so the first flush writes a clean OAM.
+ *
+ * Parameters:
+ *   oam - &oamMain (the batcher owns every entry of this OAM while in use)
+ */
+void SpriteBatch_Init(OamState* oam);
+
+/**
+ * Function: SpriteBatch_Begin
+ * ---------------------------
+ * Starts a new frame; sprites submitted afterwards replace the last frame's.
+ */
+void SpriteBatch_Begin(void);
+
+/**
+ * Function: SpriteBatch_Submit
+ * ----------------------------
+ * Queues a sprite for this frame. Off-screen sprites are counted and
+ * discarded here.
+ *
+ * Parameters:
+ *   sprite - Sprite description (copied)
+ *
+ * Returns: true if the sprite is queued (visible and within the OAM limit)
+ */
+bool SpriteBatch_Submit(const SpriteDesc* sprite);
+
+/**
+ * Function: SpriteBatch_End
+ * -------------------------
+ * Orders queued sprites by priority (submission order within a priority),
+ * assigns OAM entries and affine matrices, and writes changed entries into
+ * the shadow OAM. Entries left over from a larger previous frame are hidden.
+ */
+void SpriteBatch_End(void);
+
+/**
+ * Function: SpriteBatch_Flush
+ * ---------------------------
+ * Records a copy of the dirty span of the shadow OAM to hardware OAM in the
+ * render command list. Call once per frame after SpriteBatch_End() (replaces
+ * oamUpdate()). Does nothing when nothing changed; if the list is full the
+ * span stays dirty and is retried next frame.
+ */
+void SpriteBatch_Flush(void);
+
+/**
+ * Function: SpriteBatch_GetStats
+ * ------------------------------
+ * Gets the counters of the last frame.
+ */
+const SpriteBatchStats* SpriteBatch_GetStats(void);
+
+#endif  // SPRITE_BATCH_H
@@ -19,6 +19,8 @@
 
 #include "fixedmath.h"
 
+#include "../core/tcm.h"
+
 /*=============================================================================
  * SIN/COS LOOKUP TABLE
  *
@@ -36,7 +38,7 @@
  *       val = int(round(sin(rad) * 256))
  *===========================================================================*/
 
-static const int16_t sin_lut[129] = {
+static const int16_t sin_lut[129] TCM_DATA = {
     0,   3,   6,   9,   13,  16,  19,  22,  25,  28,  31,  34,  38,  41,  44,
     47,  50,  53,  56,  59,  62,  65,  68,  71,  74,  77,  80,  83,  86,  89,
     92,  95,  98,  101, 104, 107, 109, 112, 115, 118, 121, 123, 126, 129, 132,
@@ -70,7 +72,7 @@ static const int16_t sin_lut[129] = {
  *   - Quadrants 1,3: mirror lookup (count down from 128)
  *   - Quadrants 2,3: negate result
  */
-Q16_8 Fixed_Sin(int angle) {
+TCM_CODE Q16_8 Fixed_Sin(int angle) {
     /* Wrap to 0-511 */
     int a = angle & ANGLE_MASK;
 
@@ -107,7 +109,7 @@ Q16_8 Fixed_Sin(int angle) {
  *
  * Returns: Cosine value in Q16.8 format (-256 to 256, representing -1.0 to 1.0)
  */
-Q16_8 Fixed_Cos(int angle) {
+TCM_CODE Q16_8 Fixed_Cos(int angle) {
     /* cos(x) = sin(x + 90°) */
     return Fixed_Sin(angle + ANGLE_QUARTER);
 }
@@ -132,7 +134,7 @@ Q16_8 Fixed_Cos(int angle) {
  *   - Computes square root bit by bit
  *   - Each iteration tests if adding current bit makes result too large
  */
-static uint32_t isqrt(uint64_t n) {
+static TCM_CODE uint32_t isqrt(uint64_t n) {
     uint64_t res = 0;
     uint64_t bit = 1ull << 62; /* Highest power of 4 <= 2^64 */
 
@@ -175,7 +177,7 @@ static uint32_t isqrt(uint64_t n) {
  *   - Uses integer sqrt to get Q16.8 result
  *   - Avoids floating point entirely
  */
-Q16_8 Vec2_Len(const Vec2* a) {
+TCM_CODE Q16_8 Vec2_Len(const Vec2* a) {
     Q16_8 len2 = Vec2_LenSquared(*a);
     if (len2 <= 0) {
         return 0;
@@ -204,7 +206,7 @@ Q16_8 Vec2_Len(const Vec2* a) {
  *
  * Note: Expensive operation due to length calculation and division
  */
-Vec2 Vec2_Normalize(const Vec2* a) {
+TCM_CODE Vec2 Vec2_Normalize(const Vec2* a) {
     if (Vec2_IsZero(*a)) {
         return Vec2_Zero();
     }
@@ -230,7 +232,7 @@ Vec2 Vec2_Normalize(const Vec2* a) {
  *
  * Optimization: Compares len² to avoid sqrt if length is already within bounds
  */
-Vec2 Vec2_ClampLen(const Vec2* v, Q16_8 maxLen) {
+TCM_CODE Vec2 Vec2_ClampLen(const Vec2* v, Q16_8 maxLen) {
     if (maxLen <= 0) {
         return Vec2_Zero();
     }
@@ -261,7 +263,7 @@ Vec2 Vec2_ClampLen(const Vec2* v, Q16_8 maxLen) {
  *
  * Returns: Unit vector with x = cos(angle), y = sin(angle)
  */
-Vec2 Vec2_FromAngle(int angle) {
+TCM_CODE Vec2 Vec2_FromAngle(int angle) {
     return Vec2_Create(Fixed_Cos(angle), Fixed_Sin(angle));
 }
 
@@ -285,7 +287,7 @@ Vec2 Vec2_FromAngle(int angle) {
  *     * Quadrant 3 (x<0, y<0): 256-384
  *     * Quadrant 4 (x≥0, y<0): 384-512
  */
-int Vec2_ToAngle(const Vec2* v) {
+TCM_CODE int Vec2_ToAngle(const Vec2* v) {
     if (Vec2_IsZero(*v)) {
         return 0;
     }
@@ -347,7 +349,7 @@ int Vec2_ToAngle(const Vec2* v) {
  *   Uses rotation matrix: | cos -sin | * | x |
  *                         | sin  cos |   | y |
  */
-Vec2 Vec2_Rotate(const Vec2* v, int angle) {
+TCM_CODE Vec2 Vec2_Rotate(const Vec2* v, int angle) {
     Q16_8 c = Fixed_Cos(angle);
     Q16_8 s = Fixed_Sin(angle);
 
@@ -415,7 +417,7 @@ Mat2 Mat2_Rotate(int angle) {
  *
  * Note: Expensive (uses sqrt). Use Vec2_DistanceSquared for comparisons.
  */
-Q16_8 Vec2_Distance(const Vec2* a, const Vec2* b) {
+TCM_CODE Q16_8 Vec2_Distance(const Vec2* a, const Vec2* b) {
     Vec2 diff = Vec2_Sub(*a, *b);
     return Vec2_Len(&diff);
 }
@@ -287,6 +287,27 @@ static inline Vec2 Vec2_Reflect(Vec2 v, Vec2 normal) {
     return Vec2_Sub(v, Vec2_Scale(normal, dot2));
 }
 
+/**
+ * Function: Vec2_Lerp
+ * -------------------
+ * Linear interpolation from a (t = 0) to b (t = FIXED_ONE).
+ */
+static inline Vec2 Vec2_Lerp(Vec2 a, Vec2 b, Q16_8 t) {
+    return Vec2_Add(a, Vec2_Scale(Vec2_Sub(b, a), t));
+}
+
+/**
+ * Function: Angle_Lerp
+ * --------------------
+ * Interpolates binary angles along the shorter arc (wraps through 0).
+ *
+ * Returns: Angle in [0, ANGLE_FULL)
+ */
+static inline int Angle_Lerp(int a, int b, Q16_8 t) {
+    int delta = ((b - a + ANGLE_HALF) & ANGLE_MASK) - ANGLE_HALF;
+    return (a + FixedMul(delta, t)) & ANGLE_MASK;
+}
+
 /*=============================================================================
  * FUNCTION PROTOTYPES (implemented in fixedmath.c)
  *===========================================================================*/
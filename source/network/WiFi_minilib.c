@@ -41,7 +41,8 @@
  * 5. DEBUG INSTRUMENTATION
  *    Problem: Original had no way to diagnose multiplayer connectivity issues.
  *    Solution: Added debug statistics (total_recvfrom_calls, total_filtered_own)
- *              and iprintf() debug messages for socket/WiFi lifecycle events.
+ *              and debug log records (LOG_DEBUG, see kmlog.h) for socket/WiFi
+ *              lifecycle events.
  *
  * 6. MINOR FIXES
  *    - Changed ~MSG_PEEK to 0 (standard non-blocking receive)
@@ -58,8 +59,8 @@
  */
 
 #include "WiFi_minilib.h"
-#include <stdio.h>
 #include "../core/game_constants.h"
+#include "../core/kmlog.h"
 
 // Note: LOCAL_PORT, OUT_PORT, WIFI_SCAN_TIMEOUT_FRAMES, WIFI_CONNECT_TIMEOUT_FRAMES
 // moved to game_constants.h
@@ -208,7 +209,7 @@ int initWiFi() {
 int openSocket() {
     // Safety: force close if somehow still open
     if (socket_opened) {
-        iprintf("WARNING: socket still open, forcing close...\n");
+        LOG_WARN("socket still open, forcing close");
         closeSocket();
     }
 
@@ -219,13 +220,11 @@ int openSocket() {
     socket_id = socket(AF_INET, SOCK_DGRAM, 0);  // UDP socket
 
     if (socket_id < 0) {
-        // DEBUG: Socket creation failed
-        iprintf("ERROR: socket() failed: %d\n", socket_id);
+        LOG_WARN("socket() failed: %d", socket_id);
         return 0;  // Failed to create socket
     }
 
-    // DEBUG: Print socket ID (can help diagnose issues)
-    iprintf("Socket created: ID=%d\n", socket_id);
+    LOG_DEBUG("socket created: id=%d", socket_id);
 
     //-----------Configure receiving side---------------------//
 
@@ -240,12 +239,12 @@ int openSocket() {
     // Bind the socket
     if (bind(socket_id, (struct sockaddr*)&sa_in, sizeof(sa_in)) < 0) {
         // Cleanup the socket we just created before returning error
-        iprintf("ERROR: bind() failed!\n");
+        LOG_WARN("bind() failed on port %d", LOCAL_PORT);
         closesocket(socket_id);
         return 0;  // Error binding the socket
     }
 
-    iprintf("Socket bound to port %d\n", LOCAL_PORT);
+    LOG_DEBUG("socket bound to port %d", LOCAL_PORT);
 
     //-----------Configure sending side-----------------------//
 
@@ -255,11 +254,10 @@ int openSocket() {
     // Use 255.255.255.255 instead of calculated subnet broadcast
     sa_out.sin_addr.s_addr = htonl(0xFFFFFFFF);
 
-    // DEBUG: Print network info
-    unsigned long ip_host = Wifi_GetIP();
-    iprintf("IP: %lu.%lu.%lu.%lu\n", (ip_host & 0xFF), ((ip_host >> 8) & 0xFF),
-            ((ip_host >> 16) & 0xFF), ((ip_host >> 24) & 0xFF));
-    iprintf("Broadcast: 255.255.255.255\n");
+    u32 ip_host = (u32)Wifi_GetIP();
+    (void)ip_host;  // Only logged: unused when LOG_DEBUG is compiled out
+    LOG_DEBUG("IP %u.%u.%u.%u, broadcast 255.255.255.255", ip_host & 0xFF,
+              (ip_host >> 8) & 0xFF, (ip_host >> 16) & 0xFF, (ip_host >> 24) & 0xFF);
 
     // Enable broadcast permission on the socket
     int broadcast_permission = 1;
@@ -278,28 +276,26 @@ int openSocket() {
 void closeSocket() {
     // If socket not opened, nothing to do
     if (socket_opened == false) {
-        iprintf("closeSocket: already closed\n");
+        LOG_DEBUG("closeSocket: already closed");
         return;
     }
 
-    iprintf("Closing socket ID=%d\n", socket_id);
+    LOG_DEBUG("closing socket id=%d", socket_id);
 
     // Close the socket (skip shutdown() - can be problematic on DS)
     closesocket(socket_id);
     socket_id = -1;
     socket_opened = false;
-
-    iprintf("Socket closed\n");
 }
 
 void disconnectFromWiFi() {
     // If Wi-Fi not connected, nothing to do
     if (WiFi_initialized == false) {
-        iprintf("WiFi: already disconnected\n");
+        LOG_DEBUG("WiFi already disconnected");
         return;
     }
 
-    iprintf("Disconnecting WiFi...\n");
+    LOG_DEBUG("disconnecting WiFi");
 
     // Disconnect from the access point
     Wifi_DisconnectAP();
@@ -313,8 +309,7 @@ void disconnectFromWiFi() {
     }
 
     WiFi_initialized = false;
-
-    iprintf("WiFi disconnected (stack still alive)\n");
+    LOG_DEBUG("WiFi disconnected (stack still alive)");
 }
 
 int sendData(char* data_buff, int bytes) {
@@ -74,6 +74,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "../core/kmlog.h"
 #include "WiFi_minilib.h"
 
 // Access WiFi/socket status flags from WiFi_minilib
@@ -558,8 +559,9 @@ int Multiplayer_Init(void) {
 
     // Initialize WiFi (with timeout)
     int wifiResult = initWiFi();
-    printf("WiFi init result: %d\n", wifiResult);
+    LOG_DEBUG("WiFi init result: %d", wifiResult);
     if (!wifiResult) {
+        LOG_WARN("multiplayer init: WiFi connection failed");
         consoleClear();
         printf("WiFi Connection Failed!\n\n");
         printf("Possible issues:\n");
@@ -575,18 +577,12 @@ int Multiplayer_Init(void) {
             scanKeys();
 
             if (keysDown() & KEY_B) {
-                printf("DEBUG: B pressed! Breaking...\n");
-                for (int i = 0; i < 120; i++)
-                    swiWaitForVBlank();
                 break;
             }
             Wifi_Update();
             swiWaitForVBlank();
         }
 
-        printf("DEBUG: Returning -1\n");
-        for (int i = 0; i < 120; i++)
-            swiWaitForVBlank();
         return -1;
     }
 
@@ -595,7 +591,7 @@ int Multiplayer_Init(void) {
 
     // Open socket
     int socketResult = openSocket();
-    printf("Socket open result: %d\n", socketResult);
+    LOG_DEBUG("socket open result: %d", socketResult);
     if (!socketResult) {
         consoleClear();
         printf("Socket Error!\n\n");
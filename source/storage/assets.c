@@ -0,0 +1,351 @@
+/**
+ * File: assets.c
+ * --------------
+ * Description: Asset pack reader and resident set. The pack index is read
+ *              once; entry data is read on first Acquire into a heap buffer
+ *              that stays resident until the least-recently-used eviction
+ *              needs its bytes for another load. Pinned entries (between
+ *              Acquire and Release) are never evicted.
+ *
+ *              Pack layout (little endian, written by tools/img/pack_assets.py):
+ *                header  "KMPK", u16 version, u16 count, u32 dataOffset, u32 0
+ *                index   count x { char name[24], u32 offset, u32 size },
+ *                        sorted by name
+ *                data    entries, each 4-byte aligned
+ *
+ *              Backends: NitroFS + stdio on the DS, mmap on Linux hosts.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "assets.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../core/mem_budget.h"
+
+#ifdef ARM9
+#include <filesystem.h>
+#include <nds.h>
+#include <stdio.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define PACK_MAGIC "KMPK"
+#define PACK_VERSION 1
+#define PACK_HEADER_SIZE 16
+#define PACK_ENTRY_SIZE (ASSETS_NAME_LEN + 8)
+
+//=============================================================================
+// PRIVATE TYPES
+//=============================================================================
+typedef struct {
+    char name[ASSETS_NAME_LEN];
+    uint32_t offset;
+    uint32_t size;
+} PackEntry;
+
+typedef struct {
+    void* data;        // NULL when not resident
+    uint16_t pins;     // Outstanding Acquire calls
+    uint32_t lastUse;  // Acquire tick, smallest = least recently used
+} Resident;
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static PackEntry* entries = NULL;
+static Resident* residents = NULL;
+static int entryCount = 0;
+
+static uint32_t budget = ASSETS_DEFAULT_BUDGET;
+static uint32_t useTick = 0;
+static AssetStats stats;
+
+#ifdef ARM9
+static FILE* packFile = NULL;
+static bool nitroMounted = false;
+#else
+static const uint8_t* packMap = NULL;
+static size_t packMapSize = 0;
+#endif
+
+//=============================================================================
+// PRIVATE HELPERS - BACKEND
+//=============================================================================
+
+static inline uint32_t Assets_ReadU32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+#ifdef ARM9
+static bool Assets_OpenPack(const char* path) {
+    if (!nitroMounted)
+        nitroMounted = nitroFSInit(NULL);
+    if (!nitroMounted)
+        return false;
+    packFile = fopen(path, "rb");
+    return packFile != NULL;
+}
+
+static void Assets_ClosePack(void) {
+    if (packFile != NULL)
+        fclose(packFile);
+    packFile = NULL;
+}
+
+static bool Assets_ReadPack(uint32_t offset, void* dst, uint32_t size) {
+    if (fseek(packFile, offset, SEEK_SET) != 0)
+        return false;
+    return fread(dst, 1, size, packFile) == size;
+}
+#else
+static bool Assets_OpenPack(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < PACK_HEADER_SIZE) {
+        close(fd);
+        return false;
+    }
+
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps the file referenced
+    if (map == MAP_FAILED)
+        return false;
+
+    packMap = (const uint8_t*)map;
+    packMapSize = (size_t)st.st_size;
+    return true;
+}
+
+static void Assets_ClosePack(void) {
+    if (packMap != NULL)
+        munmap((void*)packMap, packMapSize);
+    packMap = NULL;
+    packMapSize = 0;
+}
+
+static bool Assets_ReadPack(uint32_t offset, void* dst, uint32_t size) {
+    if ((size_t)offset + size > packMapSize)
+        return false;
+    memcpy(dst, packMap + offset, size);
+    return true;
+}
+#endif
+
+//=============================================================================
+// PRIVATE HELPERS - INDEX & RESIDENT SET
+//=============================================================================
+
+static int Assets_CompareName(const void* key, const void* entry) {
+    return strncmp((const char*)key, ((const PackEntry*)entry)->name, ASSETS_NAME_LEN);
+}
+
+static int Assets_Find(const char* name) {
+    if (entries == NULL || name == NULL)
+        return -1;
+    const PackEntry* e =
+        bsearch(name, entries, entryCount, sizeof(PackEntry), Assets_CompareName);
+    return (e != NULL) ? (int)(e - entries) : -1;
+}
+
+static bool Assets_ReadIndex(void) {
+    uint8_t header[PACK_HEADER_SIZE];
+    if (!Assets_ReadPack(0, header, sizeof(header)) ||
+        memcmp(header, PACK_MAGIC, 4) != 0 ||
+        (header[4] | (header[5] << 8)) != PACK_VERSION)
+        return false;
+
+    int count = header[6] | (header[7] << 8);
+    uint32_t indexBytes = (uint32_t)count * PACK_ENTRY_SIZE;
+    uint8_t* raw = MemBudget_Malloc(indexBytes, MEM_OWNER_ASSETS);
+    entries = MemBudget_Calloc(count, sizeof(PackEntry), MEM_OWNER_ASSETS);
+    residents = MemBudget_Calloc(count, sizeof(Resident), MEM_OWNER_ASSETS);
+    if (raw == NULL || entries == NULL || residents == NULL ||
+        !Assets_ReadPack(PACK_HEADER_SIZE, raw, indexBytes)) {
+        MemBudget_Free(raw);
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const uint8_t* r = raw + i * PACK_ENTRY_SIZE;
+        memcpy(entries[i].name, r, ASSETS_NAME_LEN);
+        entries[i].name[ASSETS_NAME_LEN - 1] = '\0';
+        entries[i].offset = Assets_ReadU32(r + ASSETS_NAME_LEN);
+        entries[i].size = Assets_ReadU32(r + ASSETS_NAME_LEN + 4);
+        // Assets_Find uses bsearch: names must be strictly ascending
+        if (i > 0 && strcmp(entries[i - 1].name, entries[i].name) >= 0) {
+            MemBudget_Free(raw);
+            return false;
+        }
+    }
+    MemBudget_Free(raw);
+    entryCount = count;
+    return true;
+}
+
+static void Assets_Evict(int i) {
+    MemBudget_Free(residents[i].data);
+    residents[i].data = NULL;
+    stats.residentBytes -= entries[i].size;
+    stats.evictions++;
+}
+
+// Evicts LRU unpinned entries until `incoming` more bytes fit the budget
+static bool Assets_MakeRoom(uint32_t incoming) {
+    while (stats.residentBytes + incoming > budget) {
+        int victim = -1;
+        for (int i = 0; i < entryCount; i++) {
+            if (residents[i].data == NULL || residents[i].pins > 0)
+                continue;
+            if (victim < 0 || residents[i].lastUse < residents[victim].lastUse)
+                victim = i;
+        }
+        if (victim < 0)
+            return false;  // Everything resident is pinned
+        Assets_Evict(victim);
+    }
+    return true;
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+bool Assets_Init(const char* packPath) {
+    Assets_Shutdown();
+    if (!Assets_OpenPack(packPath))
+        return false;
+    if (!Assets_ReadIndex()) {
+        Assets_Shutdown();
+        return false;
+    }
+    return true;
+}
+
+void Assets_Shutdown(void) {
+    for (int i = 0; i < entryCount; i++)
+        MemBudget_Free(residents[i].data);
+    MemBudget_Free(entries);
+    MemBudget_Free(residents);
+    entries = NULL;
+    residents = NULL;
+    entryCount = 0;
+    useTick = 0;
+    memset(&stats, 0, sizeof(stats));
+    Assets_ClosePack();
+}
+
+void Assets_SetBudget(uint32_t bytes) {
+    budget = bytes;
+    if (entries != NULL)
+        Assets_MakeRoom(0);
+}
+
+const void* Assets_Acquire(const char* name, uint32_t* outSize) {
+    int i = Assets_Find(name);
+    if (i < 0)
+        return NULL;
+
+    Resident* r = &residents[i];
+    if (r->data != NULL) {
+        stats.hits++;
+    } else {
+        uint32_t size = entries[i].size;
+        if (!Assets_MakeRoom(size))
+            stats.overBudget++;  // Load anyway: a screen without graphics is worse
+
+        // Word-aligned for the BIOS decompressors and DMA
+        r->data = MemBudget_Malloc((size + 3) & ~3u, MEM_OWNER_ASSETS);
+        if (r->data == NULL)
+            return NULL;
+        if (!Assets_ReadPack(entries[i].offset, r->data, size)) {
+            MemBudget_Free(r->data);
+            r->data = NULL;
+            return NULL;
+        }
+
+        stats.misses++;
+        stats.bytesRead += size;
+        stats.residentBytes += size;
+        if (stats.residentBytes > stats.peakResident)
+            stats.peakResident = stats.residentBytes;
+    }
+
+    r->pins++;
+    r->lastUse = ++useTick;
+    if (outSize != NULL)
+        *outSize = entries[i].size;
+    return r->data;
+}
+
+void Assets_Release(const char* name) {
+    int i = Assets_Find(name);
+    if (i >= 0 && residents[i].pins > 0)
+        residents[i].pins--;
+}
+
+bool Assets_Exists(const char* name) {
+    return Assets_Find(name) >= 0;
+}
+
+bool Assets_Preload(const char* name) {
+    if (Assets_Acquire(name, NULL) == NULL)
+        return false;
+    Assets_Release(name);
+    return true;
+}
+
+void Assets_Trim(void) {
+    for (int i = 0; i < entryCount; i++) {
+        if (residents[i].data != NULL && residents[i].pins == 0)
+            Assets_Evict(i);
+    }
+}
+
+const AssetStats* Assets_GetStats(void) {
+    return &stats;
+}
+
+uint32_t Assets_Lz77Size(const void* stream) {
+    const uint8_t* header = (const uint8_t*)stream;  // Byte 0 is the type (0x10)
+    return header[1] | ((uint32_t)header[2] << 8) | ((uint32_t)header[3] << 16);
+}
+
+#ifdef ARM9
+bool Assets_DecompressTo(const char* name, void* dst) {
+    const void* data = Assets_Acquire(name, NULL);
+    if (data == NULL)
+        return false;
+    decompress(data, dst, LZ77Vram);
+    MemBudget_MarkVram(dst, Assets_Lz77Size(data));
+    Assets_Release(name);
+    return true;
+}
+
+bool Assets_CopyTo(const char* name, void* dst) {
+    uint32_t size;
+    const void* data = Assets_Acquire(name, &size);
+    if (data == NULL)
+        return false;
+    DC_FlushRange(data, size);  // Freshly read through the data cache
+    dmaCopy(data, dst, size);
+    MemBudget_MarkVram(dst, size);
+    Assets_Release(name);
+    return true;
+}
+#endif
@@ -0,0 +1,180 @@
+/**
+ * File: assets.h
+ * --------------
+ * Description: On-demand access to the graphics asset pack. Large assets
+ *              (UI screens, track tilesets and maps) are no longer linked into
+ *              the ARM9 binary; tools/img/pack_assets.py bundles grit's binary
+ *              output into one "KMPK" pack file that ships in NitroFS. Assets
+ *              are read into a budgeted, LRU-evicted resident set in main RAM
+ *              when a screen first needs them, so adding screens or tracks does
+ *              not grow boot-time RAM.
+ *
+ *              The module builds for the DS (NitroFS + stdio) and for Linux
+ *              hosts, where the pack is mapped with mmap so tools and
+ *              benchmarks exercise the same index and eviction code.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//=============================================================================
+// PUBLIC CONSTANTS
+//=============================================================================
+
+// Pack location inside the ROM's NitroFS
+#define ASSETS_PACK_PATH "nitro:/assets.pak"
+
+// Entry names are "<png basename>.<img|map|pal>", NUL-padded in the index
+#define ASSETS_NAME_LEN 24
+
+// Default resident set budget (compressed bytes kept in main RAM)
+#define ASSETS_DEFAULT_BUDGET (128 * 1024)
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+/**
+ * Resident set counters (cumulative since Assets_Init).
+ */
+typedef struct {
+    uint32_t hits;           // Acquire served from the resident set
+    uint32_t misses;         // Acquire that had to read the pack
+    uint32_t evictions;      // Entries dropped to stay within budget
+    uint32_t bytesRead;      // Bytes read from the pack
+    uint32_t residentBytes;  // Bytes currently resident
+    uint32_t peakResident;   // High-water mark of residentBytes
+    uint32_t overBudget;     // Loads that could not be fit under the budget
+} AssetStats;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: Assets_Init
+ * ---------------------
+ * Opens the asset pack and reads its index. No asset data is loaded.
+ *
+ * Parameters:
+ *   packPath - Pack file path (ASSETS_PACK_PATH on the DS)
+ *
+ * Returns:
+ *   true  - Pack opened and index valid
+ *   false - Pack missing or corrupt (every Acquire returns NULL)
+ */
+bool Assets_Init(const char* packPath);
+
+/**
+ * Function: Assets_Shutdown
+ * -------------------------
+ * Frees every resident asset and closes the pack.
+ */
+void Assets_Shutdown(void);
+
+/**
+ * Function: Assets_SetBudget
+ * --------------------------
+ * Sets the resident set budget. Unpinned assets are evicted least recently
+ * used first whenever a load would exceed it.
+ *
+ * Parameters:
+ *   bytes - Budget in bytes (ASSETS_DEFAULT_BUDGET by default)
+ */
+void Assets_SetBudget(uint32_t bytes);
+
+/**
+ * Function: Assets_Acquire
+ * ------------------------
+ * Returns an asset's bytes, reading it from the pack if it is not resident,
+ * and pins it so it cannot be evicted until the matching Assets_Release().
+ *
+ * Parameters:
+ *   name    - Entry name, e.g. "home_top.img"
+ *   outSize - Optional, receives the size in bytes
+ *
+ * Returns: 4-byte aligned data, or NULL if the entry is missing or the read
+ *          failed
+ */
+const void* Assets_Acquire(const char* name, uint32_t* outSize);
+
+/**
+ * Function: Assets_Release
+ * ------------------------
+ * Unpins an asset. It stays resident (cached) until evicted.
+ *
+ * Parameters:
+ *   name - Entry name passed to Assets_Acquire()
+ */
+void Assets_Release(const char* name);
+
+/**
+ * Function: Assets_Exists
+ * -----------------------
+ * Checks whether the pack contains an entry, without loading it.
+ */
+bool Assets_Exists(const char* name);
+
+/**
+ * Function: Assets_Preload
+ * ------------------------
+ * Reads an asset into the resident set without pinning it, so a later
+ * Acquire is a hit (unless it was evicted meanwhile).
+ *
+ * Returns: false if the entry is missing or the read failed
+ */
+bool Assets_Preload(const char* name);
+
+/**
+ * Function: Assets_Trim
+ * ---------------------
+ * Evicts every unpinned asset (e.g. to hand heap back before a race).
+ */
+void Assets_Trim(void);
+
+/**
+ * Function: Assets_GetStats
+ * -------------------------
+ * Gets the resident set counters.
+ */
+const AssetStats* Assets_GetStats(void);
+
+/**
+ * Function: Assets_Lz77Size
+ * -------------------------
+ * Gets the decompressed size from the header of a BIOS LZ77 stream (bits
+ * 8-31 of the first word), e.g. to allocate or account for the destination.
+ */
+uint32_t Assets_Lz77Size(const void* stream);
+
+#ifdef ARM9
+/**
+ * Function: Assets_DecompressTo
+ * -----------------------------
+ * Acquires an LZ77 asset, decompresses it with the BIOS (VRAM-safe) into dst
+ * and releases it again.
+ *
+ * Returns: false if the asset is missing (dst untouched)
+ */
+bool Assets_DecompressTo(const char* name, void* dst);
+
+/**
+ * Function: Assets_CopyTo
+ * -----------------------
+ * Acquires a raw asset, DMA-copies it to dst (VRAM or palette RAM) and
+ * releases it again.
+ *
+ * Returns: false if the asset is missing (dst untouched)
+ */
+bool Assets_CopyTo(const char* name, void* dst);
+#endif
+
+#endif  // ASSETS_H
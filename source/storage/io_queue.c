@@ -0,0 +1,308 @@
+/**
+ * File: io_queue.c
+ * ----------------
+ * Description: Implementation of the asynchronous write queue. Requests sit
+ *              in a ring served in order; the oldest one advances one phase
+ *              (or one chunk of its data) per step. A file left open with
+ *              IO_KEEP_OPEN is reused by the next write to the same path and
+ *              closed, as a step of its own, before any other file is opened.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "io_queue.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../core/kmlog.h"
+
+#ifdef ARM9
+#include "../core/game_constants.h"
+#include "../core/scheduler.h"
+#endif
+
+//=============================================================================
+// PRIVATE TYPES
+//=============================================================================
+typedef enum {
+    IO_PHASE_OPEN,
+    IO_PHASE_WRITE,
+    IO_PHASE_SYNC,
+    IO_PHASE_CLOSE,
+    IO_PHASE_REPLACE,
+    IO_PHASE_DONE
+} IoPhase;
+
+typedef struct {
+    IoRequestId id;
+    char path[IO_PATH_BYTES];
+    char tmpPath[IO_PATH_BYTES];  // Empty: written in place
+    u8 flags;
+    IoSegment segments[IO_MAX_SEGMENTS];
+    IoDoneFn done;
+} IoRequest;
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static const IoBackend* backend = &IoStdioBackend;
+
+static IoRequest requests[IO_MAX_REQUESTS];
+static int head = 0;  // Oldest request
+static int queued = 0;
+static IoRequestId nextId = 1;
+static IoRequestId lastCompleted = IO_NO_REQUEST;
+
+// Progress of the oldest request
+static IoPhase phase = IO_PHASE_OPEN;
+static int segment = 0;
+static u32 segmentOffset = 0;
+static bool failed = false;
+
+// File left open by IO_KEEP_OPEN (or by the request in progress)
+static void* openFile = NULL;
+static char openPath[IO_PATH_BYTES];
+
+static IoQueueStats stats;
+
+//=============================================================================
+// PRIVATE HELPERS - stdio backend
+//=============================================================================
+
+static void* IoStdio_Open(const char* path, bool append) {
+    return fopen(path, append ? "ab" : "wb");
+}
+
+static int IoStdio_Write(void* file, const void* data, u32 bytes) {
+    return (int)fwrite(data, 1, bytes, (FILE*)file);
+}
+
+static bool IoStdio_Sync(void* file) {
+    return fflush((FILE*)file) == 0;
+}
+
+static bool IoStdio_Close(void* file) {
+    return fclose((FILE*)file) == 0;
+}
+
+static bool IoStdio_Replace(const char* from, const char* to) {
+    // FAT rename does not replace an existing file
+    remove(to);
+    return rename(from, to) == 0;
+}
+
+const IoBackend IoStdioBackend = {
+    IoStdio_Open, IoStdio_Write, IoStdio_Sync, IoStdio_Close, IoStdio_Replace,
+};
+
+//=============================================================================
+// PRIVATE HELPERS - Requests
+//=============================================================================
+
+static inline const char* IoQueue_Target(const IoRequest* req) {
+    return (req->tmpPath[0] != '\0') ? req->tmpPath : req->path;
+}
+
+static bool IoQueue_CloseOpenFile(void) {
+    bool ok = backend->close(openFile);
+    openFile = NULL;
+    openPath[0] = '\0';
+    return ok;
+}
+
+// Skips empty segments; false once all the data is written
+static bool IoQueue_HasData(const IoRequest* req) {
+    while (segment < IO_MAX_SEGMENTS &&
+           segmentOffset >= req->segments[segment].bytes) {
+        segment++;
+        segmentOffset = 0;
+    }
+    return segment < IO_MAX_SEGMENTS;
+}
+
+static bool IoQueue_PhaseNeeded(const IoRequest* req, IoPhase p) {
+    switch (p) {
+        case IO_PHASE_WRITE:
+            return IoQueue_HasData(req);
+        case IO_PHASE_SYNC:
+            return (req->flags & IO_SYNC) != 0;
+        case IO_PHASE_CLOSE:
+            return !(req->flags & IO_KEEP_OPEN) || req->tmpPath[0] != '\0';
+        case IO_PHASE_REPLACE:
+            return req->tmpPath[0] != '\0';
+        default:
+            return true;
+    }
+}
+
+// Moves past the phases the request does not need (a write stays in
+// IO_PHASE_WRITE until its data is out)
+static void IoQueue_NextPhase(const IoRequest* req) {
+    if (phase == IO_PHASE_WRITE && IoQueue_HasData(req))
+        return;
+    do {
+        phase++;
+    } while (!IoQueue_PhaseNeeded(req, phase));
+}
+
+static void IoQueue_Complete(void) {
+    IoRequest* req = &requests[head];
+    IoRequestId id = req->id;
+    IoDoneFn done = req->done;
+    bool ok = !failed;
+
+    // Pop first: the callback may queue the next write
+    head = (head + 1) % IO_MAX_REQUESTS;
+    queued--;
+    lastCompleted = id;
+    phase = IO_PHASE_OPEN;
+    segment = 0;
+    segmentOffset = 0;
+    failed = false;
+
+    stats.completed++;
+    if (!ok) {
+        stats.failed++;
+        LOG_WARN("io write %u failed", id);
+    }
+    if (done != NULL)
+        done(ok);
+}
+
+// One file operation of the current phase; false if it failed
+static bool IoQueue_DoPhase(IoRequest* req) {
+    const char* target = IoQueue_Target(req);
+    switch (phase) {
+        case IO_PHASE_OPEN:
+            if (openFile != NULL)
+                return true;  // Kept open by the previous write
+            openFile = backend->open(target, (req->flags & IO_APPEND) != 0);
+            if (openFile == NULL)
+                return false;
+            strcpy(openPath, target);
+            return true;
+
+        case IO_PHASE_WRITE: {
+            const IoSegment* seg = &req->segments[segment];
+            u32 bytes = seg->bytes - segmentOffset;
+            if (bytes > IO_CHUNK_BYTES)
+                bytes = IO_CHUNK_BYTES;
+            int written =
+                backend->write(openFile, (const u8*)seg->data + segmentOffset, bytes);
+            if (written != (int)bytes)
+                return false;
+            segmentOffset += bytes;
+            stats.bytes += bytes;
+            return true;
+        }
+
+        case IO_PHASE_SYNC:
+            return backend->sync(openFile);
+
+        case IO_PHASE_CLOSE:
+            return IoQueue_CloseOpenFile();
+
+        case IO_PHASE_REPLACE:
+            return backend->replace(req->tmpPath, req->path);
+
+        default:
+            return true;
+    }
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+void IoQueue_Init(const IoBackend* ioBackend) {
+    backend = (ioBackend != NULL) ? ioBackend : &IoStdioBackend;
+    head = 0;
+    queued = 0;
+    nextId = 1;
+    lastCompleted = IO_NO_REQUEST;
+    phase = IO_PHASE_OPEN;
+    segment = 0;
+    segmentOffset = 0;
+    failed = false;
+    openFile = NULL;
+    openPath[0] = '\0';
+    memset(&stats, 0, sizeof(stats));
+}
+
+IoRequestId IoQueue_Write(const IoWrite* write) {
+    const char* tmpPath = (write->tmpPath != NULL) ? write->tmpPath : "";
+    if (queued == IO_MAX_REQUESTS || strlen(write->path) >= IO_PATH_BYTES ||
+        strlen(tmpPath) >= IO_PATH_BYTES) {
+        stats.rejected++;
+        return IO_NO_REQUEST;
+    }
+
+    IoRequest* req = &requests[(head + queued) % IO_MAX_REQUESTS];
+    req->id = nextId++;
+    if (nextId == IO_NO_REQUEST)
+        nextId++;
+    strcpy(req->path, write->path);
+    strcpy(req->tmpPath, tmpPath);
+    req->flags = write->flags;
+    memcpy(req->segments, write->segments, sizeof(req->segments));
+    req->done = write->done;
+
+    queued++;
+    stats.requests++;
+    if ((u32)queued > stats.maxQueued)
+        stats.maxQueued = (u32)queued;
+    return req->id;
+}
+
+bool IoQueue_Step(void) {
+    if (queued == 0)
+        return false;
+
+    IoRequest* req = &requests[head];
+    stats.steps++;
+
+    // A file kept open for another path (or not for appending) is closed in a
+    // step of its own; a failed close belongs to the write that kept it
+    if (phase == IO_PHASE_OPEN && openFile != NULL &&
+        !(strcmp(openPath, IoQueue_Target(req)) == 0 && (req->flags & IO_APPEND))) {
+        IoQueue_CloseOpenFile();
+        return true;
+    }
+
+    if (!IoQueue_DoPhase(req)) {
+        failed = true;
+        if (openFile != NULL)
+            IoQueue_CloseOpenFile();  // Do not append to a file in an unknown state
+        phase = IO_PHASE_DONE;
+    } else {
+        IoQueue_NextPhase(req);
+    }
+
+    if (phase == IO_PHASE_DONE)
+        IoQueue_Complete();
+    return queued > 0;
+}
+
+#ifdef ARM9
+void IoQueue_Service(void) {
+    // The scheduler started the run with SCHED_BUDGET_IO lines to spare
+    while (IoQueue_Step() && Scheduler_GetSpareLines() >= SCHED_BUDGET_IO)
+        ;
+}
+#endif
+
+bool IoQueue_IsDone(IoRequestId id) {
+    return id == IO_NO_REQUEST || (int)(lastCompleted - id) >= 0;
+}
+
+void IoQueue_Wait(IoRequestId id) {
+    while (!IoQueue_IsDone(id) && IoQueue_Step())
+        ;
+}
+
+const IoQueueStats* IoQueue_GetStats(void) {
+    return &stats;
+}
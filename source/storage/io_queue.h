@@ -0,0 +1,174 @@
+/**
+ * File: io_queue.h
+ * ----------------
+ * Description: Asynchronous SD card writes. Callers queue a whole file write
+ *              (the record file, a ghost, log words) and return at once; the
+ *              "io" idle scheduler task carries it out one small step at a
+ *              time (open, a IO_CHUNK_BYTES write, sync, close, rename) while
+ *              the frame has spare lines, and reports the result through a
+ *              completion callback. A FAT write can take tens of milliseconds;
+ *              split like this it never holds up a frame's work.
+ *
+ * Requests are served in order, one file at a time. A write with a temporary
+ * path goes there first and is renamed over the destination when complete,
+ * so a power-off leaves either the old file or the new one. The data is not
+ * copied: it must stay unchanged until the callback (or IoQueue_Wait()).
+ *
+ * The file operations go through an IoBackend: stdio (libfat on the DS) by
+ * default, POSIX files in tools/perf/io_queue_tool.c. Builds on the host.
+ *
+ * Main loop only: neither the queue nor the callbacks are ISR-safe.
+ *
+ * Usage:
+ *   IoWrite write = {RECORDS_FILE, RECORDS_TMP_FILE, 0,
+ *                    {{&staged, sizeof(staged)}}, RecordStore_WriteDone};
+ *   if (IoQueue_Write(&write) == IO_NO_REQUEST)
+ *       ...queue full, retry later...
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef IO_QUEUE_H
+#define IO_QUEUE_H
+
+#include <stdbool.h>
+
+#ifdef ARM9
+#include <nds.h>
+#else
+#include <stdint.h>
+typedef uint8_t u8;
+typedef uint32_t u32;
+#endif
+
+//=============================================================================
+// PUBLIC CONSTANTS
+//=============================================================================
+
+#define IO_MAX_REQUESTS 8    // Queued writes: log 1, replay 3, telemetry 2, records, ghost
+#define IO_MAX_SEGMENTS 2    // Data pieces per write (header + body, ring halves)
+#define IO_PATH_BYTES 40     // Longest path, terminator included
+#define IO_CHUNK_BYTES 512   // Bytes per write step (one sector)
+
+#define IO_NO_REQUEST 0u
+
+// IoWrite flags
+#define IO_APPEND 0x01     // Add to the end of the file instead of replacing it
+#define IO_KEEP_OPEN 0x02  // Leave the file open for the next write to it
+#define IO_SYNC 0x04       // Flush to the card before completing
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+typedef u32 IoRequestId;
+
+// Completion: `ok` is false if any step failed (the rest were skipped)
+typedef void (*IoDoneFn)(bool ok);
+
+typedef struct {
+    const void* data;
+    u32 bytes;
+} IoSegment;
+
+typedef struct {
+    const char* path;     // Destination (copied)
+    const char* tmpPath;  // Written first, renamed over `path` (NULL: in place)
+    u8 flags;             // IO_APPEND | IO_KEEP_OPEN | IO_SYNC
+    IoSegment segments[IO_MAX_SEGMENTS];  // Written in order (bytes 0: unused)
+    IoDoneFn done;        // May be NULL
+} IoWrite;
+
+/**
+ * File operations. The stdio backend is the default; a host test can supply
+ * its own (slow or failing writes).
+ */
+typedef struct {
+    void* (*open)(const char* path, bool append);   // NULL on failure
+    int (*write)(void* file, const void* data, u32 bytes);  // Bytes written
+    bool (*sync)(void* file);
+    bool (*close)(void* file);
+    bool (*replace)(const char* from, const char* to);  // Rename over `to`
+} IoBackend;
+
+/**
+ * Counters since IoQueue_Init().
+ */
+typedef struct {
+    u32 requests;    // Writes queued
+    u32 rejected;    // IoQueue_Write() calls refused on a full queue
+    u32 completed;
+    u32 failed;      // Completed with ok = false
+    u32 steps;
+    u32 bytes;       // Data bytes written
+    u32 maxQueued;   // Most requests waiting at once
+} IoQueueStats;
+
+extern const IoBackend IoStdioBackend;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: IoQueue_Init
+ * ----------------------
+ * Empties the queue and selects the backend (NULL: IoStdioBackend). Call
+ * once at boot, before anything writes.
+ */
+void IoQueue_Init(const IoBackend* backend);
+
+/**
+ * Function: IoQueue_Write
+ * -----------------------
+ * Queues a write. The segments must stay valid and unchanged until the
+ * request completes.
+ *
+ * Returns: Request id, or IO_NO_REQUEST if the queue is full or a path is
+ *          too long
+ */
+IoRequestId IoQueue_Write(const IoWrite* write);
+
+/**
+ * Function: IoQueue_Step
+ * ----------------------
+ * Does one file operation of the oldest request; the last one calls its
+ * completion callback.
+ *
+ * Returns: true if work remains
+ */
+bool IoQueue_Step(void);
+
+/**
+ * Function: IoQueue_Service
+ * -------------------------
+ * "io" idle scheduler task (DS only): steps while the frame has
+ * SCHED_BUDGET_IO lines to spare.
+ */
+void IoQueue_Service(void);
+
+/**
+ * Function: IoQueue_IsDone
+ * ------------------------
+ * Whether a request has completed (true for IO_NO_REQUEST).
+ */
+bool IoQueue_IsDone(IoRequestId id);
+
+/**
+ * Function: IoQueue_Wait
+ * ----------------------
+ * Steps until a request has completed, for an owner about to reuse its data
+ * or read the file back. Returns at once if it already has.
+ */
+void IoQueue_Wait(IoRequestId id);
+
+/**
+ * Function: IoQueue_GetStats
+ * --------------------------
+ * Read-only counters.
+ */
+const IoQueueStats* IoQueue_GetStats(void);
+
+#endif  // IO_QUEUE_H
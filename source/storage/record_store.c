@@ -0,0 +1,179 @@
+/**
+ * File: record_store.c
+ * --------------------
+ * Description: Implementation of the cached record file. One fread at boot,
+ *              one queued write per write-behind, no parsing: the cache has
+ *              the layout of the file. The write is a snapshot of the cache,
+ *              so changes made while it is in flight wait for the next one.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include "record_store.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../core/kmlog.h"
+#include "../core/scheduler.h"
+#include "io_queue.h"
+#include "storage.h"
+
+//=============================================================================
+// PRIVATE CONSTANTS
+//=============================================================================
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+_Static_assert(sizeof(RecordFile) == 16 + 4 * RECORDS_MAP_SLOTS,
+               "RecordFile must have no padding");
+_Static_assert(NeonCircuit < RECORDS_MAP_SLOTS, "RECORDS_MAP_SLOTS too small");
+
+//=============================================================================
+// PRIVATE STATE
+//=============================================================================
+static RecordFile cache = {RECORDS_MAGIC, RECORDS_VERSION, sizeof(RecordFile), 1, 1, 1};
+static bool writable = false;  // Record file loaded (SD card present)
+static bool dirty = false;
+static u32 dirtyFrame = 0;     // Frame of the change (or failed write) to wait from
+static RecordFile written;     // Snapshot being written by the io task
+static IoRequestId writeRequest = IO_NO_REQUEST;
+
+//=============================================================================
+// PRIVATE HELPERS
+//=============================================================================
+
+static u32 RecordStore_Checksum(const RecordFile* file) {
+    const u8* bytes = (const u8*)file;
+    u32 hash = FNV_OFFSET_BASIS;
+    for (size_t i = 0; i < offsetof(RecordFile, checksum); i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static void RecordStore_SetDefaults(void) {
+    memset(&cache, 0, sizeof(cache));
+    cache.magic = RECORDS_MAGIC;
+    cache.version = RECORDS_VERSION;
+    cache.size = sizeof(RecordFile);
+    cache.wifiEnabled = 1;
+    cache.musicEnabled = 1;
+    cache.soundFxEnabled = 1;
+}
+
+static void RecordStore_MarkDirty(void) {
+    dirty = true;
+    dirtyFrame = Scheduler_GetStats()->frames;
+}
+
+static bool RecordStore_Read(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+        return false;
+
+    RecordFile loaded;
+    bool ok = fread(&loaded, sizeof(loaded), 1, file) == 1 &&
+              loaded.magic == RECORDS_MAGIC && loaded.version == RECORDS_VERSION &&
+              loaded.size == sizeof(RecordFile) &&
+              loaded.checksum == RecordStore_Checksum(&loaded);
+    fclose(file);
+
+    if (ok)
+        cache = loaded;
+    return ok;
+}
+
+static void RecordStore_WriteDone(bool ok) {
+    writeRequest = IO_NO_REQUEST;
+    if (!ok) {
+        LOG_WARN("record store write failed");
+        RecordStore_MarkDirty();  // Retry after another delay
+    }
+}
+
+// Queues a snapshot of the cache; false if the queue is full
+static bool RecordStore_Write(void) {
+    cache.checksum = RecordStore_Checksum(&cache);
+    written = cache;
+
+    IoWrite write = {RECORDS_FILE, RECORDS_TMP_FILE, 0,
+                     {{&written, sizeof(written)}}, RecordStore_WriteDone};
+    writeRequest = IoQueue_Write(&write);
+    if (writeRequest == IO_NO_REQUEST)
+        return false;
+    dirty = false;
+    return true;
+}
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+bool RecordStore_Load(void) {
+    RecordStore_SetDefaults();
+    writable = true;
+    dirty = false;
+    if (RecordStore_Read(RECORDS_FILE))
+        return true;
+    if (RecordStore_Read(RECORDS_TMP_FILE)) {
+        RecordStore_MarkDirty();  // Finish the interrupted rename
+        return true;
+    }
+    RecordStore_SetDefaults();  // A failed read may have left a partial copy
+    RecordStore_MarkDirty();    // Create the file
+    return false;
+}
+
+const RecordFile* RecordStore_Get(void) {
+    return &cache;
+}
+
+void RecordStore_SetSettings(bool wifiEnabled, bool musicEnabled, bool soundFxEnabled) {
+    if (cache.wifiEnabled == wifiEnabled && cache.musicEnabled == musicEnabled &&
+        cache.soundFxEnabled == soundFxEnabled)
+        return;
+    cache.wifiEnabled = wifiEnabled;
+    cache.musicEnabled = musicEnabled;
+    cache.soundFxEnabled = soundFxEnabled;
+    RecordStore_MarkDirty();
+}
+
+void RecordStore_SetBestTime(Map map, u32 timeMs) {
+    if ((unsigned)map >= RECORDS_MAP_SLOTS || cache.bestTimeMs[map] == timeMs)
+        return;
+    cache.bestTimeMs[map] = timeMs;
+    RecordStore_MarkDirty();
+}
+
+void RecordStore_ResetSettings(void) {
+    RecordStore_SetSettings(true, true, true);
+}
+
+void RecordStore_Flush(void) {
+    if (!dirty || !writable || writeRequest != IO_NO_REQUEST)
+        return;  // Nothing new, or the snapshot is still being written
+    u32 now = Scheduler_GetStats()->frames;
+    if (now - dirtyFrame < RECORDS_WRITE_DELAY)
+        return;
+    if (!RecordStore_Write())
+        dirtyFrame = now;  // Queue full: retry after another delay
+}
+
+bool RecordStore_Sync(void) {
+    IoQueue_Wait(writeRequest);
+    if (!dirty)
+        return true;
+    if (!writable || !RecordStore_Write())
+        return false;
+    IoQueue_Wait(writeRequest);
+    return !dirty;
+}
+
+bool RecordStore_IsDirty(void) {
+    return dirty;
+}
@@ -0,0 +1,119 @@
+/**
+ * File: record_store.h
+ * --------------------
+ * Description: In-memory cache of the persistent record file: user settings
+ *              and the best race time of every map in one fixed-layout binary
+ *              file with a checksum. The file is read once at boot; updates
+ *              only change the cache and mark it dirty, and the "store"
+ *              scheduler task queues a copy for the io task (io_queue.h),
+ *              which writes it in idle time (write-behind), so saving a
+ *              record or the settings never waits on FAT I/O.
+ *
+ * The file is written to RECORDS_TMP_FILE and renamed over RECORDS_FILE; a
+ * power-off between the two leaves the temporary copy, which the next boot
+ * reads instead.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef RECORD_STORE_H
+#define RECORD_STORE_H
+
+#include <nds.h>
+#include <stdbool.h>
+
+#include "../core/game_constants.h"
+#include "../core/game_types.h"
+
+//=============================================================================
+// PUBLIC TYPES
+//=============================================================================
+
+/**
+ * On-card layout (little-endian, naturally aligned, no padding). A file
+ * whose magic, version, size or checksum does not match is ignored.
+ */
+typedef struct {
+    u32 magic;    // RECORDS_MAGIC
+    u16 version;  // RECORDS_VERSION
+    u16 size;     // sizeof(RecordFile)
+    u8 wifiEnabled;
+    u8 musicEnabled;
+    u8 soundFxEnabled;
+    u8 reserved;
+    u32 bestTimeMs[RECORDS_MAP_SLOTS];  // Indexed by Map, 0 = no record
+    u32 checksum;                       // FNV-1a of every field above
+} RecordFile;
+
+//=============================================================================
+// PUBLIC API
+//=============================================================================
+
+/**
+ * Function: RecordStore_Load
+ * --------------------------
+ * Reads the record file into the cache (the temporary copy if the file is
+ * missing or damaged) and enables write-behind. When neither copy is valid
+ * the cache holds the defaults (everything enabled, no records) and is
+ * dirty, so the next write creates the file.
+ *
+ * Returns:
+ *   true  - A valid record file was read
+ *   false - Cache holds the defaults
+ */
+bool RecordStore_Load(void);
+
+/**
+ * Function: RecordStore_Get
+ * -------------------------
+ * Gets the cached records (read-only; use the setters to change them).
+ */
+const RecordFile* RecordStore_Get(void);
+
+/**
+ * Function: RecordStore_SetSettings / RecordStore_SetBestTime
+ * -----------------------------------------------------------
+ * Update the cache and schedule a write. Setting the values already cached
+ * schedules nothing. RecordStore_SetBestTime stores the time as given; the
+ * caller decides whether it is a record.
+ */
+void RecordStore_SetSettings(bool wifiEnabled, bool musicEnabled, bool soundFxEnabled);
+void RecordStore_SetBestTime(Map map, u32 timeMs);
+
+/**
+ * Function: RecordStore_ResetSettings
+ * -----------------------------------
+ * Restores the default settings in the cache (best times are kept).
+ */
+void RecordStore_ResetSettings(void);
+
+/**
+ * Function: RecordStore_Flush
+ * ---------------------------
+ * "store" scheduler task (SCHED_PRIO_LOW). Queues a write of the cache once
+ * it has been dirty for RECORDS_WRITE_DELAY frames, so a burst of changes
+ * (settings toggles, a record then the settings) costs one write. One write
+ * is in flight at a time; a failed one is retried after another delay.
+ */
+void RecordStore_Flush(void);
+
+/**
+ * Function: RecordStore_Sync
+ * --------------------------
+ * Writes the cache now if it is dirty, waiting for the io queue (boot-time
+ * migration).
+ *
+ * Returns: true if the file is up to date
+ */
+bool RecordStore_Sync(void);
+
+/**
+ * Function: RecordStore_IsDirty
+ * -----------------------------
+ * Returns: true while changes are waiting for the write-behind
+ */
+bool RecordStore_IsDirty(void);
+
+#endif  // RECORD_STORE_H
@@ -2,8 +2,9 @@
  * File: storage.c
  * ---------------
  * Description: Implementation of persistent storage for game settings on SD card.
- *              Uses FAT filesystem to read/write user preferences. Implements
- *              directory creation, file I/O, and default settings management.
+ *              Uses FAT filesystem for the storage directory; user preferences
+ *              are read from and written to the record cache. Imports the
+ *              text settings file of earlier versions once.
  *
  * Authors: Bahey Shalash, Hugo Svolgaard
  * Version: 1.0
@@ -20,6 +21,7 @@
 #include <sys/stat.h>
 
 #include "../core/context.h"
+#include "record_store.h"
 #include "storage_pb.h"
 
 //=============================================================================
@@ -44,44 +46,31 @@ static bool Storage_DirectoryExists(const char* path) {
 }
 
 /**
- * Checks if a file exists on the filesystem.
+ * Imports the settings of a settings.txt written by an earlier version into
+ * the record cache. Missing keys keep their default.
  *
- * Parameters:
- *   path - File path to check
- *
- * Returns: true if file exists and is accessible, false otherwise
+ * Returns: true if the file existed
  */
-static bool Storage_FileExists(const char* path) {
-    FILE* file = fopen(path, "r");
-    if (file) {
-        fclose(file);
-        return true;
-    }
-    return false;
-}
-
-/**
- * Writes factory default settings to a file.
- *
- * Default settings:
- *   - wifi=1 (WiFi enabled)
- *   - music=1 (Music enabled)
- *   - soundfx=1 (Sound effects enabled)
- *
- * Parameters:
- *   path - File path to write defaults to
- *
- * Returns: true on success, false if file cannot be created/written
- */
-static bool Storage_WriteDefaultsToFile(const char* path) {
-    FILE* file = fopen(path, "w+");
+static bool Storage_ImportTextSettings(void) {
+    FILE* file = fopen(SETTINGS_FILE, "r");
     if (file == NULL)
         return false;
 
-    fprintf(file, "wifi=1\n");
-    fprintf(file, "music=1\n");
-    fprintf(file, "soundfx=1\n");
+    int wifi = 1, music = 1, soundfx = 1;
+    char line[32];
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (strncmp(line, "wifi=", 5) == 0) {
+            wifi = (line[5] == '1') ? 1 : 0;
+        } else if (strncmp(line, "music=", 6) == 0) {
+            music = (line[6] == '1') ? 1 : 0;
+        } else if (strncmp(line, "soundfx=", 8) == 0) {
+            soundfx = (line[8] == '1') ? 1 : 0;
+        }
+    }
+
     fclose(file);
+    RecordStore_SetSettings(wifi, music, soundfx);
     return true;
 }
 
@@ -99,73 +88,40 @@ bool Storage_Init(void) {
         mkdir(STORAGE_DIR, 0777);
     }
 
-    // Create default_settings.txt if it doesn't exist
-    if (!Storage_FileExists(DEFAULT_SETTINGS_FILE)) {
-        if (!Storage_WriteDefaultsToFile(DEFAULT_SETTINGS_FILE))
-            return false;
-    }
-
-    // Create settings.txt if it doesn't exist (copy defaults)
-    if (!Storage_FileExists(SETTINGS_FILE)) {
-        if (!Storage_WriteDefaultsToFile(SETTINGS_FILE))
+    // Read settings and best times once; later saves only touch the cache
+    if (!RecordStore_Load()) {
+        // First boot of this version: bring over the text files, if any
+        Storage_ImportTextSettings();
+        StoragePB_ImportTextTimes();
+        if (!RecordStore_Sync())
             return false;
     }
-    // Initialize personal best times
-    if (!StoragePB_Init()) {
-        return false;
-    }
     return true;
 }
 
 bool Storage_LoadSettings(void) {
-    FILE* file = fopen(SETTINGS_FILE, "r");
-    if (file == NULL)
-        return false;
-
     GameContext* ctx = GameContext_Get();
-
-    int wifi = 1, music = 1, soundfx = 1;
-    char line[32];
-
-    while (fgets(line, sizeof(line), file) != NULL) {
-        if (strncmp(line, "wifi=", 5) == 0) {
-            wifi = (line[5] == '1') ? 1 : 0;
-        } else if (strncmp(line, "music=", 6) == 0) {
-            music = (line[6] == '1') ? 1 : 0;
-        } else if (strncmp(line, "soundfx=", 8) == 0) {
-            soundfx = (line[8] == '1') ? 1 : 0;
-        }
-    }
-
-    fclose(file);
+    const RecordFile* records = RecordStore_Get();
 
     // Apply to context (don't trigger side effects yet - main.c will do that)
-    ctx->userSettings.wifiEnabled = wifi;
-    ctx->userSettings.musicEnabled = music;
-    ctx->userSettings.soundFxEnabled = soundfx;
+    ctx->userSettings.wifiEnabled = records->wifiEnabled;
+    ctx->userSettings.musicEnabled = records->musicEnabled;
+    ctx->userSettings.soundFxEnabled = records->soundFxEnabled;
 
     return true;
 }
 
 bool Storage_SaveSettings(void) {
-    GameContext* ctx = GameContext_Get();
-
-    FILE* file = fopen(SETTINGS_FILE, "w+");
-    if (file == NULL)
-        return false;
+    const GameContext* ctx = GameContext_Get();
 
-    fprintf(file, "wifi=%d\n", ctx->userSettings.wifiEnabled ? 1 : 0);
-    fprintf(file, "music=%d\n", ctx->userSettings.musicEnabled ? 1 : 0);
-    fprintf(file, "soundfx=%d\n", ctx->userSettings.soundFxEnabled ? 1 : 0);
-
-    fclose(file);
+    RecordStore_SetSettings(ctx->userSettings.wifiEnabled,
+                            ctx->userSettings.musicEnabled,
+                            ctx->userSettings.soundFxEnabled);
     return true;
 }
 
 bool Storage_ResetToDefaults(void) {
-    // Write factory defaults to settings.txt
-    if (!Storage_WriteDefaultsToFile(SETTINGS_FILE))
-        return false;
+    RecordStore_ResetSettings();
 
     // Reload defaults into context
     return Storage_LoadSettings();
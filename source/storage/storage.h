@@ -5,7 +5,9 @@
  *              Manages user preferences (WiFi, music, sound effects) using
  *              FAT filesystem. Provides initialization, load, save, and
  *              factory reset operations. Does not trigger side effects -
- *              only mutates GameContext data.
+ *              only mutates GameContext data. Settings live in the cached
+ *              record file (see record_store.h): loading and saving only
+ *              touch the cache, the card is written in the background.
  *
  * Authors: Bahey Shalash, Hugo Svolgaard
  * Version: 1.0
@@ -24,11 +26,12 @@
 // Storage directory path on SD card
 #define STORAGE_DIR "/kart-mania"
 
-// User settings file path (modified by user)
-#define SETTINGS_FILE "/kart-mania/settings.txt"
+// Binary record file (settings and best times) and its write-behind copy
+#define RECORDS_FILE "/kart-mania/records.bin"
+#define RECORDS_TMP_FILE "/kart-mania/records.tmp"
 
-// Default settings file path (reference copy)
-#define DEFAULT_SETTINGS_FILE "/kart-mania/default_settings.txt"
+// Text settings file of earlier versions (imported once, then unused)
+#define SETTINGS_FILE "/kart-mania/settings.txt"
 
 //=============================================================================
 // PUBLIC API
@@ -37,13 +40,11 @@
 /**
  * Function: Storage_Init
  * ----------------------
- * Initializes FAT filesystem and creates storage directory structure.
- *
- * Creates the following if they don't exist:
- *   - /kart-mania directory
- *   - /kart-mania/default_settings.txt (reference defaults)
- *   - /kart-mania/settings.txt (user settings, initialized from defaults)
- *   - /kart-mania/best_times.txt (personal best lap times)
+ * Initializes FAT filesystem, creates the /kart-mania directory and reads
+ * the record file into memory (the only read of the card for settings and
+ * best times). Without a valid record file, the settings and best times
+ * of the text files of earlier versions are imported and the record file
+ * is written once.
  *
  * Returns:
  *   true  - Storage initialized successfully, SD card accessible
@@ -54,9 +55,9 @@ bool Storage_Init(void);
 /**
  * Function: Storage_LoadSettings
  * ------------------------------
- * Loads user settings from settings.txt into GameContext.
+ * Loads user settings from the record cache into GameContext (no I/O).
  *
- * Reads settings file and updates GameContext fields:
+ * Updates GameContext fields:
  *   - userSettings.wifiEnabled
  *   - userSettings.musicEnabled
  *   - userSettings.soundFxEnabled
@@ -65,31 +66,25 @@ bool Storage_Init(void);
  * Caller is responsible for applying loaded settings.
  *
  * Returns:
- *   true  - Settings loaded successfully
- *   false - File not found or read error (caller should use defaults)
+ *   true  - Settings loaded (defaults if the card held no records)
  */
 bool Storage_LoadSettings(void);
 
 /**
  * Function: Storage_SaveSettings
  * ------------------------------
- * Saves current GameContext settings to settings.txt.
- *
- * Writes current values to persistent storage:
- *   - wifi=0/1
- *   - music=0/1
- *   - soundfx=0/1
+ * Saves current GameContext settings (WiFi, music, sound FX) to the record
+ * cache. The record file is written by the "store" task a few frames later.
  *
  * Returns:
- *   true  - Settings saved successfully
- *   false - Write error (SD card removed or full)
+ *   true - Settings saved to the cache
  */
 bool Storage_SaveSettings(void);
 
 /**
  * Function: Storage_ResetToDefaults
  * ----------------------------------
- * Resets settings.txt to factory defaults and reloads into GameContext.
+ * Resets the saved settings to factory defaults and reloads into GameContext.
  *
  * Default values:
  *   - WiFi: Enabled (1)
@@ -99,8 +94,7 @@ bool Storage_SaveSettings(void);
  * Triggered by: START+SELECT+A on Settings screen Save button
  *
  * Returns:
- *   true  - Reset successful, defaults loaded into context
- *   false - Write or reload error
+ *   true - Reset successful, defaults loaded into context
  */
 bool Storage_ResetToDefaults(void);
 
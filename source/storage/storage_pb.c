@@ -1,10 +1,11 @@
 /**
  * File: storage_pb.c
  * ------------------
- * Description: Implementation of personal best lap time storage. Reads and
- *              writes per-map racing records to SD card. Uses text file
- *              format (MapName=MM:SS.mmm). Implements time comparison and
- *              automatic record detection.
+ * Description: Implementation of personal best lap time storage. Records
+ *              live in the record cache as milliseconds (see record_store.h).
+ *              Implements time comparison, automatic record detection and
+ *              the one-time import of the text format of earlier versions
+ *              (MapName=MM:SS.mmm).
  *
  * Authors: Bahey Shalash, Hugo Svolgaard
  * Version: 1.0
@@ -16,6 +17,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "record_store.h"
+
 //=============================================================================
 // PRIVATE HELPER FUNCTIONS
 //=============================================================================
@@ -66,65 +69,50 @@ static bool StoragePB_IsTimeFaster(int min1, int sec1, int msec1, int min2, int
 }
 
 /**
- * Checks if a file exists on the filesystem.
- *
- * Parameters:
- *   path - File path to check
- *
- * Returns: true if file exists and is accessible, false otherwise
+ * Converts a time to the milliseconds stored in the record file.
  */
-static bool StoragePB_FileExists(const char* path) {
-    FILE* file = fopen(path, "r");
-    if (file) {
-        fclose(file);
-        return true;
-    }
-    return false;
+static u32 StoragePB_ToMs(int min, int sec, int msec) {
+    return (u32)((min * 60 + sec) * 1000 + msec);
 }
 
 //=============================================================================
 // PUBLIC API
 //=============================================================================
 
-bool StoragePB_Init(void) {
-    // Create best_times.txt if it doesn't exist (empty file is fine)
-    if (!StoragePB_FileExists(BEST_TIMES_FILE)) {
-        FILE* file = fopen(BEST_TIMES_FILE, "w+");
-        if (file == NULL) {
-            return false;
-        }
-        fclose(file);
-    }
-    return true;
-}
-
-bool StoragePB_LoadBestTime(Map map, int* min, int* sec, int* msec) {
+void StoragePB_ImportTextTimes(void) {
     FILE* file = fopen(BEST_TIMES_FILE, "r");
     if (file == NULL) {
-        return false;  // No best times file exists yet
+        return;  // No best times file (first boot)
     }
 
-    const char* mapName = StoragePB_MapToString(map);
     char line[64];
-    bool found = false;
-
     while (fgets(line, sizeof(line), file) != NULL) {
         char mapStr[32];
         int m, s, ms;
         // Format: MapName=MM:SS.mmm
-        if (sscanf(line, "%[^=]=%d:%d.%d", mapStr, &m, &s, &ms) == 4) {
-            if (strcmp(mapStr, mapName) == 0) {
-                *min = m;
-                *sec = s;
-                *msec = ms;
-                found = true;
-                break;
-            }
+        if (sscanf(line, "%31[^=]=%d:%d.%d", mapStr, &m, &s, &ms) != 4)
+            continue;
+        for (Map map = ScorchingSands; map <= NeonCircuit; map++) {
+            if (strcmp(mapStr, StoragePB_MapToString(map)) == 0)
+                RecordStore_SetBestTime(map, StoragePB_ToMs(m, s, ms));
         }
     }
 
     fclose(file);
-    return found;
+}
+
+bool StoragePB_LoadBestTime(Map map, int* min, int* sec, int* msec) {
+    if ((unsigned)map >= RECORDS_MAP_SLOTS)
+        return false;
+    u32 ms = RecordStore_Get()->bestTimeMs[map];
+    if (ms == 0) {
+        return false;  // No record for this map yet
+    }
+
+    *min = ms / 60000;
+    *sec = (ms / 1000) % 60;
+    *msec = ms % 1000;
+    return true;
 }
 
 bool StoragePB_SaveBestTime(Map map, int min, int sec, int msec) {
@@ -139,50 +127,7 @@ bool StoragePB_SaveBestTime(Map map, int min, int sec, int msec) {
         }
     }
 
-    // Read all existing times into memory
-    char lines[10][64];  // Support up to 10 map records
-    int lineCount = 0;
-    bool updatedExisting = false;
-
-    FILE* file = fopen(BEST_TIMES_FILE, "r");
-    if (file != NULL) {
-        char line[64];
-        while (fgets(line, sizeof(line), file) != NULL && lineCount < 10) {
-            char mapStr[32];
-            if (sscanf(line, "%[^=]=", mapStr) == 1) {
-                if (strcmp(mapStr, StoragePB_MapToString(map)) == 0) {
-                    // Update this line with new time
-                    snprintf(lines[lineCount], sizeof(lines[lineCount]),
-                             "%s=%02d:%02d.%03d\n", StoragePB_MapToString(map), min,
-                             sec, msec);
-                    updatedExisting = true;
-                } else {
-                    // Keep existing line
-                    snprintf(lines[lineCount], sizeof(lines[lineCount]), "%s", line);
-                }
-                lineCount++;
-            }
-        }
-        fclose(file);
-    }
-
-    // If we didn't update an existing entry, add a new one
-    if (!updatedExisting && lineCount < 10) {
-        snprintf(lines[lineCount], sizeof(lines[lineCount]), "%s=%02d:%02d.%03d\n",
-                 StoragePB_MapToString(map), min, sec, msec);
-        lineCount++;
-    }
-
-    // Write all lines back to file
-    file = fopen(BEST_TIMES_FILE, "w+");
-    if (file == NULL) {
-        return false;
-    }
-
-    for (int i = 0; i < lineCount; i++) {
-        fputs(lines[i], file);
-    }
-
-    fclose(file);
+    // Cache only: the "store" task writes the record file in the background
+    RecordStore_SetBestTime(map, StoragePB_ToMs(min, sec, msec));
     return true;  // New record!
 }
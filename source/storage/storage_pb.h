@@ -4,7 +4,9 @@
  * Description: Persistent storage for personal best lap times. Manages
  *              per-map racing records saved to SD card. Provides loading,
  *              saving, and automatic record detection (only saves if time
- *              is better than existing record).
+ *              is better than existing record). Records are kept in the
+ *              cached record file (see record_store.h), so neither call
+ *              touches the card.
  *
  * Authors: Bahey Shalash, Hugo Svolgaard
  * Version: 1.0
@@ -22,7 +24,7 @@
 // PUBLIC CONSTANTS
 //=============================================================================
 
-// Best times file path on SD card
+// Text best times file of earlier versions (imported once, then unused)
 #define BEST_TIMES_FILE "/kart-mania/best_times.txt"
 
 //=============================================================================
@@ -30,27 +32,23 @@
 //=============================================================================
 
 /**
- * Function: StoragePB_Init
- * ------------------------
- * Initializes best times file if it doesn't exist.
- *
- * Creates an empty /kart-mania/best_times.txt file. File format:
+ * Function: StoragePB_ImportTextTimes
+ * -----------------------------------
+ * Copies the records of a best_times.txt written by an earlier version into
+ * the record cache. Called by Storage_Init() when there is no record file.
+ * File format:
  *   MapName=MM:SS.mmm
  *
  * Example:
  *   ScorchingSands=01:23.456
  *   AlpinRush=02:15.789
- *
- * Returns:
- *   true  - File initialized or already exists
- *   false - File creation failed (SD card error)
  */
-bool StoragePB_Init(void);
+void StoragePB_ImportTextTimes(void);
 
 /**
  * Function: StoragePB_LoadBestTime
  * ---------------------------------
- * Loads best lap time for a specific map from file.
+ * Loads best lap time for a specific map from the record cache.
  *
  * Parameters:
  *   map  - Map enum to load time for (ScorchingSands, AlpinRush, NeonCircuit)
@@ -69,7 +67,8 @@ bool StoragePB_LoadBestTime(Map map, int* min, int* sec, int* msec);
  * ---------------------------------
  * Saves best lap time for a specific map (only if it's a new record).
  *
- * Compares new time against existing record. Only writes to file if:
+ * Compares new time against existing record. Only updates the cache (and
+ * schedules the write-behind) if:
  *   1. No previous record exists, OR
  *   2. New time is faster than existing record
  *
@@ -18,11 +18,12 @@
 
 #include "../audio/sound.h"
 #include "../core/context.h"
+#include "../core/game_constants.h"
+#include "../core/mem_budget.h"
 #include "../core/timer.h"
 #include "../graphics/color.h"
 #include "../network/multiplayer.h"
-#include "data/ui/ds_menu.h"
-#include "data/ui/home_top.h"
+#include "../storage/assets.h"
 #include "data/sprites/kart_home.h"
 
 //=============================================================================
@@ -191,7 +192,7 @@ void HomePage_OnVBlank(void) {
 
 void HomePage_Cleanup(void) {
     if (homeKart.gfx) {
-        oamFreeGfx(&oamMain, homeKart.gfx);
+        MemBudget_FreeGfx(&oamMain, homeKart.gfx);
         homeKart.gfx = NULL;
     }
 }
@@ -207,8 +208,8 @@ static void HomePage_ConfigureGraphicsMain(void) {
 
 static void HomePage_ConfigureBackgroundMain(void) {
     BGCTRL[2] = BG_BMP_BASE(0) | BgSize_B8_256x256;
-    dmaCopy(home_topBitmap, BG_BMP_RAM(0), home_topBitmapLen);
-    dmaCopy(home_topPal, BG_PALETTE, home_topPalLen);
+    Assets_DecompressTo("home_top.img", BG_BMP_RAM(0));
+    Assets_CopyTo("home_top.pal", BG_PALETTE);
     REG_BG2PA = 256;
     REG_BG2PC = 0;
     REG_BG2PB = 0;
@@ -221,14 +222,15 @@ static void HomePage_ConfigureBackgroundMain(void) {
 
 static void HomePage_ConfigureKartSprite(void) {
     VRAM_B_CR = VRAM_ENABLE | VRAM_B_MAIN_SPRITE;
-    oamInit(&oamMain, SpriteMapping_1D_32, false);
+    MemBudget_OamInit(&oamMain, SpriteMapping_1D_32, false);
     homeKart.id = 0;
     homeKart.x = -64;
     homeKart.y = 120;
-    homeKart.gfx =
-        oamAllocateGfx(&oamMain, SpriteSize_64x64, SpriteColorFormat_256Color);
+    homeKart.gfx = MemBudget_AllocGfx(&oamMain, SpriteSize_64x64,
+                                      SpriteColorFormat_256Color, MEM_OWNER_SCREEN);
     swiCopy(kart_homePal, SPRITE_PALETTE, kart_homePalLen / 2);
-    swiCopy(kart_homeTiles, homeKart.gfx, kart_homeTilesLen / 2);
+    MemBudget_ClaimPalette(MEM_POOL_PAL_MAIN, MEM_OWNER_SCREEN, 0, MEM_PALETTE_BANKS);
+    decompress(kart_homeTiles, homeKart.gfx, LZ77Vram);
 }
 
 static void HomePage_MoveKartSprite(void) {
@@ -254,9 +256,9 @@ static void HomePage_ConfigureBackgroundSub(void) {
     // BG0: Menu layer (front) - Static menu graphics
     BGCTRL_SUB[0] =
         BG_32x32 | BG_MAP_BASE(0) | BG_TILE_BASE(1) | BG_COLOR_256 | BG_PRIORITY(0);
-    dmaCopy(ds_menuPal, BG_PALETTE_SUB, ds_menuPalLen);
-    dmaCopy(ds_menuTiles, BG_TILE_RAM_SUB(1), ds_menuTilesLen);
-    dmaCopy(ds_menuMap, BG_MAP_RAM_SUB(0), ds_menuMapLen);
+    Assets_CopyTo("ds_menu.pal", BG_PALETTE_SUB);
+    Assets_DecompressTo("ds_menu.img", BG_TILE_RAM_SUB(1));
+    Assets_DecompressTo("ds_menu.map", BG_MAP_RAM_SUB(0));
 
     // BG1: Selection highlight layer (back) - Dynamic highlights
     BGCTRL_SUB[1] =
@@ -66,12 +66,10 @@
 #include <string.h>
 
 #include "../graphics/color.h"
-#include "data/ui/combined.h"
 #include "../core/context.h"
 #include "../core/game_types.h"
-#include "data/ui/map_bottom.h"
-#include "data/ui/map_top.h"
-#include "data/ui/map_top_clouds.h"
+#include "../gameplay/track_map.h"
+#include "../storage/assets.h"
 #include "../audio/sound.h"
 
 //=============================================================================
@@ -198,6 +196,14 @@ GameState MapSelection_Update(void) {
         if (selected != BTN_NONE)
             setSelectionHighlight(selected, true);
         lastSelected = selected;
+
+        // Decode the highlighted track while the player decides
+        if (selected == BTN_MAP1)
+            TrackMap_RequestPreload(ScorchingSands);
+        else if (selected == BTN_MAP2)
+            TrackMap_RequestPreload(AlpinRush);
+        else if (selected == BTN_MAP3)
+            TrackMap_RequestPreload(NeonCircuit);
     }
 
     // Handle button activation on release
@@ -279,10 +285,11 @@ static void configureGraphicsMain(void) {
  * - Map base 1, tile base 1 (shares tiles with BG0)
  * - Contains scrolling cloud graphics
  *
- * Loads combined graphics (all three map thumbnails merged):
- * - Tile data to BG_TILE_RAM(1)
+ * Loads combined graphics (all three map thumbnails merged) from the asset pack:
+ * - Tile data to BG_TILE_RAM(1) (LZ77, decompressed by the BIOS)
  * - Palette data to BG_PALETTE
- * - Map data split between BG0 and BG1 (64x24 bytes each)
+ * - Map data split between BG0 and BG1 (64x24 bytes each, kept raw because
+ *   the two halves land in non-contiguous screen blocks)
  */
 static void configureBackgroundsMain(void) {
     BGCTRL[0] =
@@ -290,10 +297,16 @@ static void configureBackgroundsMain(void) {
 
     BGCTRL[1] =
         BG_32x32 | BG_COLOR_256 | BG_MAP_BASE(1) | BG_TILE_BASE(1) | BG_PRIORITY(0);
-    dmaCopy(combinedTiles, BG_TILE_RAM(1), combinedTilesLen);
-    dmaCopy(combinedPal, BG_PALETTE, combinedPalLen);
-    dmaCopy(&combinedMap[0], BG_MAP_RAM(0), 64 * 24);
-    dmaCopy(&combinedMap[32 * 24], BG_MAP_RAM(1), 64 * 24);
+    Assets_DecompressTo("combined.img", BG_TILE_RAM(1));
+    Assets_CopyTo("combined.pal", BG_PALETTE);
+
+    const u16* combinedMap = Assets_Acquire("combined.map", NULL);
+    if (combinedMap != NULL) {
+        DC_FlushRange(combinedMap, 64 * 24 * 2);
+        dmaCopy(&combinedMap[0], BG_MAP_RAM(0), 64 * 24);
+        dmaCopy(&combinedMap[32 * 24], BG_MAP_RAM(1), 64 * 24);
+        Assets_Release("combined.map");
+    }
 }
 
 /**
@@ -335,9 +348,9 @@ static void configureBackgroundsSub(void) {
     // BG0: Menu layer (front)
     BGCTRL_SUB[0] =
         BG_32x32 | BG_MAP_BASE(0) | BG_TILE_BASE(1) | BG_COLOR_256 | BG_PRIORITY(0);
-    dmaCopy(map_bottomPal, BG_PALETTE_SUB, map_bottomPalLen);
-    dmaCopy(map_bottomTiles, BG_TILE_RAM_SUB(1), map_bottomTilesLen);
-    dmaCopy(map_bottomMap, BG_MAP_RAM_SUB(0), map_bottomMapLen);
+    Assets_CopyTo("map_bottom.pal", BG_PALETTE_SUB);
+    Assets_DecompressTo("map_bottom.img", BG_TILE_RAM_SUB(1));
+    Assets_DecompressTo("map_bottom.map", BG_MAP_RAM_SUB(0));
 
     // BG1: Selection highlight layer (behind)
     BGCTRL_SUB[1] =
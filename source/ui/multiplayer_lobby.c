@@ -49,6 +49,7 @@
 
 #include "../core/context.h"
 #include "../core/game_types.h"
+#include "../gameplay/track_map.h"
 #include "../network/multiplayer.h"
 #include "../network/WiFi_minilib.h"
 
@@ -88,6 +89,7 @@ void MultiplayerLobby_Init(void) {
     // Set default map for multiplayer (ScorchingSands for now)
     // TODO: Add map selection screen for multiplayer mode
     GameContext_SetMap(ScorchingSands);
+    TrackMap_RequestPreload(ScorchingSands);  // Decoded while players join
 
     // Reset countdown state
     countdownTimer = 0;
@@ -20,9 +20,10 @@
 #include "../core/context.h"
 #include "../gameplay/gameplay.h"
 #include "../gameplay/gameplay_logic.h"
+#include "../gameplay/replay.h"
 #include "../graphics/color.h"
 #include "../network/multiplayer.h"
-#include "data/ui/playagain.h"
+#include "../storage/assets.h"
 
 //=============================================================================
 // PRIVATE TYPES
@@ -109,6 +110,13 @@ GameState PlayAgain_Update(void) {
         }
     }
 
+    // R: watch the race that just ended (replay.h)
+    if ((keysDown() & KEY_R) && Replay_IsAvailable()) {
+        PlayCLICKSFX();
+        GameContext_SetReplayMode(true);
+        return GAMEPLAY;
+    }
+
     // SELECT button quick exit to home
     if (keysDown() & KEY_SELECT) {
         PlayAgain_CleanupAndExit();
@@ -135,9 +143,9 @@ static void PlayAgain_ConfigureBackground(void) {
     // BG0: Play Again screen (front layer)
     BGCTRL_SUB[0] =
         BG_32x32 | BG_MAP_BASE(0) | BG_TILE_BASE(1) | BG_COLOR_256 | BG_PRIORITY(0);
-    dmaCopy(playagainPal, BG_PALETTE_SUB, playagainPalLen);
-    dmaCopy(playagainTiles, BG_TILE_RAM_SUB(1), playagainTilesLen);
-    dmaCopy(playagainMap, BG_MAP_RAM_SUB(0), playagainMapLen);
+    Assets_CopyTo("playagain.pal", BG_PALETTE_SUB);
+    Assets_DecompressTo("playagain.img", BG_TILE_RAM_SUB(1));
+    Assets_DecompressTo("playagain.map", BG_MAP_RAM_SUB(0));
 
     // BG1: Selection highlight layer (back layer)
     BGCTRL_SUB[1] =
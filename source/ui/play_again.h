@@ -36,7 +36,8 @@ void PlayAgain_Initialize(void);
  * Updates the Play Again screen state. Handles input and selection logic.
  *
  * Returns:
- *   GAMEPLAY  - User selected YES (restart race)
+ *   GAMEPLAY  - User selected YES (restart race) or pressed R (watch the
+ *               replay of the race)
  *   HOME_PAGE - User selected NO or pressed SELECT (return home)
  *   PLAYAGAIN - Stay on screen (no selection made)
  *
@@ -20,9 +20,8 @@
 #include "../audio/sound.h"
 #include "../core/context.h"
 #include "../graphics/color.h"
+#include "../storage/assets.h"
 #include "../storage/storage.h"
-#include "data/ui/nds_settings.h"
-#include "data/ui/settings_top.h"
 
 //=============================================================================
 // PRIVATE TYPES
@@ -215,8 +214,8 @@ static void Settings_ConfigureGraphicsMain(void) {
 
 static void Settings_ConfigureBackgroundMain(void) {
     BGCTRL[2] = BG_BMP_BASE(0) | BgSize_B8_256x256;
-    dmaCopy(settings_topBitmap, BG_BMP_RAM(0), settings_topBitmapLen);
-    dmaCopy(settings_topPal, BG_PALETTE, settings_topPalLen);
+    Assets_DecompressTo("settings_top.img", BG_BMP_RAM(0));
+    Assets_CopyTo("settings_top.pal", BG_PALETTE);
     REG_BG2PA = 256;
     REG_BG2PC = 0;
     REG_BG2PB = 0;
@@ -327,9 +326,9 @@ static void Settings_ConfigureBackgroundSub(void) {
     // BG0: Menu layer (front) - Static graphics with setting labels
     BGCTRL_SUB[0] =
         BG_32x32 | BG_MAP_BASE(0) | BG_TILE_BASE(1) | BG_COLOR_256 | BG_PRIORITY(0);
-    dmaCopy(nds_settingsPal, BG_PALETTE_SUB, nds_settingsPalLen);
-    dmaCopy(nds_settingsTiles, BG_TILE_RAM_SUB(1), nds_settingsTilesLen);
-    dmaCopy(nds_settingsMap, BG_MAP_RAM_SUB(0), nds_settingsMapLen);
+    Assets_CopyTo("nds_settings.pal", BG_PALETTE_SUB);
+    Assets_DecompressTo("nds_settings.img", BG_TILE_RAM_SUB(1));
+    Assets_DecompressTo("nds_settings.map", BG_MAP_RAM_SUB(0));
 
     // BG1: Toggle and selection layer (back) - Dynamic highlights
     BGCTRL_SUB[1] =
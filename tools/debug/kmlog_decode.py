@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+"""
+Decoder for the binary log stream written by source/core/kmlog.c.
+
+Log records only carry the offset of their format string in the `kmlog_fmt`
+section and raw 32-bit argument words; this tool reads the format strings
+from the ELF that produced the stream and prints one line per record.
+
+Stream (little-endian 32-bit words):
+  header  "KMLG", version, clock, kmlog_fmt section size
+  record  offset << 8 | level << 4 | argc, timestamp, argc argument words
+
+Usage:
+  python kmlog_decode.py Kart_Mania.elf log.kml        # log copied from the SD card
+  python kmlog_decode.py Kart_Mania.elf log.kml --level warn
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+MAGIC = 0x474C4D4B  # "KMLG"
+VERSION = 1
+DROP_OFFSET = 0xFFFFFF
+LEVELS = ["DEBUG", "INFO", "WARN", "ERROR"]
+CLOCK_DS = 0    # frame << 9 | scanline
+CLOCK_HOST = 1  # microseconds
+
+# printf conversions the decoder understands (integer arguments only)
+SPEC = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(?:hh|h|ll|l|z|j|t)?([diuxXc%])")
+
+
+# -----------------------------------------------------------------------------
+# ELF
+# -----------------------------------------------------------------------------
+def read_section(elf_path, name):
+    """Returns the contents of section `name` of a little-endian ELF file."""
+    with open(elf_path, "rb") as f:
+        data = f.read()
+    if data[:4] != b"\x7fELF":
+        sys.exit(f"{elf_path}: not an ELF file")
+    is64 = data[4] == 2
+    if data[5] != 1:
+        sys.exit(f"{elf_path}: big-endian ELF not supported")
+
+    if is64:
+        shoff, = struct.unpack_from("<Q", data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x3A)
+    else:
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x2E)
+
+    def header(index):
+        base = shoff + index * shentsize
+        if is64:
+            sh_name, _, _, _, sh_offset, sh_size = struct.unpack_from("<IIQQQQ", data, base)
+        else:
+            sh_name, _, _, _, sh_offset, sh_size = struct.unpack_from("<IIIIII", data, base)
+        return sh_name, sh_offset, sh_size
+
+    _, str_offset, str_size = header(shstrndx)
+    names = data[str_offset:str_offset + str_size]
+    for i in range(shnum):
+        sh_name, sh_offset, sh_size = header(i)
+        end = names.index(b"\0", sh_name)
+        if names[sh_name:end].decode() == name:
+            return data[sh_offset:sh_offset + sh_size]
+    sys.exit(f"{elf_path}: no {name} section (built without kmlog?)")
+
+
+# -----------------------------------------------------------------------------
+# Formatting
+# -----------------------------------------------------------------------------
+def format_message(fmt, args):
+    words = iter(args)
+
+    def convert(match):
+        flags, width, precision, conv = match.groups()
+        if conv == "%":
+            return "%"
+        value = next(words, 0)
+        if conv in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            conv = "d"
+        elif conv == "u":
+            conv = "d"
+        elif conv == "c":
+            value = chr(value & 0xFF)
+        spec = "%" + flags + width + ("." + precision if precision else "") + conv
+        return spec % value
+
+    return SPEC.sub(convert, fmt)
+
+
+def format_time(clock, timestamp):
+    if clock == CLOCK_DS:
+        return f"{timestamp >> 9:7d}:{timestamp & 0x1FF:03d}"
+    return f"{timestamp / 1e6:12.6f}"
+
+
+def format_string(section, offset):
+    if offset >= len(section):
+        return f"<bad format offset {offset:#x}>"
+    end = section.find(b"\0", offset)
+    return section[offset:end].decode("utf-8", errors="replace")
+
+
+# -----------------------------------------------------------------------------
+# Stream
+# -----------------------------------------------------------------------------
+def decode(stream, section, min_level, out):
+    data = stream.read()
+    count = len(data) // 4
+    words = struct.unpack_from(f"<{count}I", data)
+    if count < 4 or words[0] != MAGIC:
+        sys.exit("not a kmlog stream (bad magic)")
+    if words[1] != VERSION:
+        sys.exit(f"unsupported stream version {words[1]}")
+    clock, fmt_size = words[2], words[3]
+    if fmt_size != len(section):
+        sys.exit(f"ELF does not match the stream (kmlog_fmt is {len(section)} bytes, "
+                 f"stream expects {fmt_size})")
+
+    records = 0
+    i = 4
+    while i + 2 <= count:
+        head, timestamp = words[i], words[i + 1]
+        offset, level, argc = head >> 8, (head >> 4) & 0x3, head & 0xF
+        args = words[i + 2:i + 2 + argc]
+        if len(args) < argc:
+            break  # Stream cut mid-record (power off before the last sync)
+        i += 2 + argc
+        records += 1
+
+        if offset == DROP_OFFSET:
+            message = f"--- {args[0]} records dropped (ring full) ---"
+        else:
+            message = format_message(format_string(section, offset), args)
+        if level >= min_level:
+            out.write(f"{format_time(clock, timestamp)} {LEVELS[level]:5s} {message}\n")
+    return records
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a Kart Mania binary log")
+    parser.add_argument("elf", help="ELF the log was written by (Kart_Mania.elf)")
+    parser.add_argument("log", nargs="?", help="log file (default: stdin)")
+    parser.add_argument("--level", choices=[l.lower() for l in LEVELS], default="debug",
+                        help="lowest level to print")
+    args = parser.parse_args()
+
+    section = read_section(args.elf, "kmlog_fmt")
+    min_level = LEVELS.index(args.level.upper())
+    if args.log:
+        with open(args.log, "rb") as stream:
+            decode(stream, section, min_level, sys.stdout)
+    else:
+        decode(sys.stdin.buffer, section, min_level, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""
+Builds a single shared-tileset track image from the 3x3 quadrant PNGs.
+
+The track art is authored as nine overlapping 512x512 quadrants placed every
+256 px (TL, TC, TR / ML, MC, MR / BL, BC, BR). This tool:
+  1. stitches them into one 1024x1024 world image (overlaps must agree),
+  2. quantizes every quadrant to one shared palette (index 0 = black backdrop),
+  3. writes an 8bpp indexed PNG that grit turns into ONE tileset, ONE palette
+     and one 128x128 map (see data/tracks/<track>.grit),
+  4. reports tile counts and bytes before/after, deduplicating 8x8 tiles
+     including horizontally/vertically flipped variants (as grit -mRtf does).
+
+Usage:
+  cd tools/img
+  python build_track_tileset.py                      # scorching_sands
+  python build_track_tileset.py --track scorching_sands --report report.md
+"""
+
+import argparse
+import os
+import sys
+
+from PIL import Image
+
+REPO_ROOT = os.path.normpath(os.path.join(os.path.dirname(__file__), "..", ".."))
+TRACK_DIR = os.path.join(REPO_ROOT, "data", "tracks")
+QUADRANT_NAMES = ["TL", "TC", "TR", "ML", "MC", "MR", "BL", "BC", "BR"]
+
+GRID = 3
+QUAD_PX = 512
+QUAD_OFFSET = 256
+WORLD_PX = QUAD_OFFSET * (GRID - 1) + QUAD_PX  # 1024
+TILE = 8
+TILE_BYTES = TILE * TILE  # 8bpp
+PALETTE_BYTES = 512
+MAX_TILES = 1024  # 10-bit tile index in text BG map entries
+
+
+# -----------------------------------------------------------------------------
+# Tile helpers
+# -----------------------------------------------------------------------------
+def tile_at(pixels, tx, ty):
+    return tuple(tuple(pixels[tx + x, ty + y] for x in range(TILE)) for y in range(TILE))
+
+
+def canonical(tile, flips):
+    """Smallest of the tile and its flipped variants, so flips share a key."""
+    if not flips:
+        return tile
+    h = tuple(row[::-1] for row in tile)
+    return min(tile, h, tile[::-1], h[::-1])
+
+
+def count_tiles(img, flips=True):
+    px = img.load()
+    w, h = img.size
+    seen = set()
+    for ty in range(0, h, TILE):
+        for tx in range(0, w, TILE):
+            seen.add(canonical(tile_at(px, tx, ty), flips))
+    return len(seen)
+
+
+# -----------------------------------------------------------------------------
+# Pipeline
+# -----------------------------------------------------------------------------
+def load_quadrants(track):
+    quads = []
+    for name in QUADRANT_NAMES:
+        path = os.path.join(TRACK_DIR, f"{track}_{name}.png")
+        img = Image.open(path).convert("RGB")
+        if img.size != (QUAD_PX, QUAD_PX):
+            sys.exit(f"error: {path} is {img.size}, expected {QUAD_PX}x{QUAD_PX}")
+        quads.append(img)
+    return quads
+
+
+def stitch(quads):
+    world = Image.new("RGB", (WORLD_PX, WORLD_PX))
+    owner = {}
+    conflicts = 0
+    for i, img in enumerate(quads):
+        ox, oy = (i % GRID) * QUAD_OFFSET, (i // GRID) * QUAD_OFFSET
+        src = img.load()
+        dst = world.load()
+        for y in range(QUAD_PX):
+            for x in range(QUAD_PX):
+                key = (ox + x, oy + y)
+                if key in owner and dst[key] != src[x, y]:
+                    conflicts += 1
+                    continue  # first quadrant wins
+                owner[key] = i
+                dst[key] = src[x, y]
+    return world, conflicts
+
+
+def shared_palette(world):
+    """Index 0 stays black (BG backdrop); other colors by descending use."""
+    counts = world.getcolors(maxcolors=WORLD_PX * WORLD_PX)
+    counts.sort(key=lambda c: -c[0])
+    colors = [rgb for _, rgb in counts if rgb != (0, 0, 0)]
+    if len(colors) > 255:
+        # More than one palette's worth: let Pillow pick 255 representatives
+        quant = world.quantize(colors=255, method=Image.Quantize.MEDIANCUT)
+        pal = quant.getpalette()[: 255 * 3]
+        colors = [tuple(pal[i: i + 3]) for i in range(0, len(pal), 3)]
+    return [(0, 0, 0)] + colors
+
+
+def to_indexed(world, palette):
+    flat = [c for rgb in palette for c in rgb]
+    flat += [0] * (768 - len(flat))
+    pal_img = Image.new("P", (1, 1))
+    pal_img.putpalette(flat)
+    exact = {rgb: i for i, rgb in enumerate(palette)}
+    src = world.load()
+    if all(src[x, y] in exact for y in range(WORLD_PX) for x in range(WORLD_PX)):
+        out = Image.new("P", world.size)
+        out.putpalette(flat)
+        out.putdata([exact[src[x, y]] for y in range(WORLD_PX) for x in range(WORLD_PX)])
+        return out
+    return world.quantize(palette=pal_img, dither=Image.Dither.NONE)
+
+
+def report_lines(track, quads, world_indexed, conflicts, palette):
+    before_tiles = [count_tiles(q) for q in quads]
+    after_tiles = count_tiles(world_indexed)
+    after_noflip = count_tiles(world_indexed, flips=False)
+
+    quad_map_bytes = (QUAD_PX // TILE) ** 2 * 2
+    world_map_bytes = (WORLD_PX // TILE) ** 2 * 2
+    before_tile_bytes = sum(before_tiles) * TILE_BYTES
+    before_total = before_tile_bytes + len(quads) * (PALETTE_BYTES + quad_map_bytes)
+    after_tile_bytes = after_tiles * TILE_BYTES
+    after_total = after_tile_bytes + PALETTE_BYTES + world_map_bytes
+
+    lines = [
+        f"# {track}: shared tileset report",
+        "",
+        f"- overlap conflicts: {conflicts}",
+        f"- shared palette colors: {len(palette)} (index 0 = backdrop)",
+        "",
+        "| quadrant | unique tiles (with flips) |",
+        "|----------|---------------------------|",
+    ]
+    lines += [f"| {n} | {t} |" for n, t in zip(QUADRANT_NAMES, before_tiles)]
+    lines += [
+        "",
+        "| | before (9 quadrants) | after (shared) |",
+        "|--|--|--|",
+        f"| tiles | {sum(before_tiles)} | {after_tiles} ({after_noflip} without flip reduction) |",
+        f"| tile bytes | {before_tile_bytes} | {after_tile_bytes} |",
+        f"| palettes | {len(quads)} x {PALETTE_BYTES} B | 1 x {PALETTE_BYTES} B |",
+        f"| map bytes | {len(quads)} x {quad_map_bytes} | {world_map_bytes} |",
+        f"| total bytes | {before_total} | {after_total} |",
+        f"| resident VRAM (tiles + palette) | {max(before_tiles) * TILE_BYTES + PALETTE_BYTES} per quadrant, reloaded on every swap | {after_tile_bytes + PALETTE_BYTES}, loaded once |",
+    ]
+    if after_tiles > MAX_TILES:
+        lines.append(f"\nWARNING: {after_tiles} tiles exceed the {MAX_TILES}-tile map limit")
+    return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--track", default="scorching_sands", help="Quadrant file prefix")
+    parser.add_argument("--out", help="Output PNG (default data/tracks/<track>.png)")
+    parser.add_argument("--report", help="Also write the report to this markdown file")
+    args = parser.parse_args()
+
+    quads = load_quadrants(args.track)
+    world, conflicts = stitch(quads)
+    palette = shared_palette(world)
+    indexed = to_indexed(world, palette)
+
+    out = args.out or os.path.join(TRACK_DIR, f"{args.track}.png")
+    indexed.save(out, optimize=True)
+
+    lines = report_lines(args.track, quads, indexed, conflicts, palette)
+    print("\n".join(lines))
+    print(f"\nwrote {os.path.relpath(out, REPO_ROOT)}")
+    if args.report:
+        with open(args.report, "w") as f:
+            f.write("\n".join(lines) + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""
+Builds the NitroFS asset pack read by source/storage/assets.c.
+
+Input is a directory of grit binary outputs (grit -ftb -fh!), i.e. files named
+<png>.img.bin / <png>.map.bin / <png>.pal.bin. Each becomes one pack entry
+named "<png>.img", "<png>.map" or "<png>.pal". Compression is whatever the
+asset's .grit file asked for (-gzl / -mzl); the pack stores bytes as-is.
+
+Pack layout (little endian):
+  header  "KMPK", u16 version, u16 count, u32 dataOffset, u32 0
+  index   count x { char name[24], u32 offset, u32 size }, sorted by name
+  data    entries, each 4-byte aligned
+
+Usage:
+  python pack_assets.py build/pack -o nitrofiles/assets.pak   # (Makefile)
+  python pack_assets.py --list nitrofiles/assets.pak
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"KMPK"
+VERSION = 1
+HEADER = struct.Struct("<4sHHII")
+ENTRY = struct.Struct("<24sII")
+NAME_LEN = 24
+SUFFIX = ".bin"
+
+
+def align4(n):
+    return (n + 3) & ~3
+
+
+def collect(src_dir):
+    items = []
+    for fname in sorted(os.listdir(src_dir)):
+        if not fname.endswith(SUFFIX):
+            continue
+        name = fname[: -len(SUFFIX)]
+        if len(name.encode()) >= NAME_LEN:
+            sys.exit(f"error: entry name '{name}' longer than {NAME_LEN - 1} bytes")
+        with open(os.path.join(src_dir, fname), "rb") as f:
+            items.append((name, f.read()))
+    # The runtime bsearch()es the index with strncmp: sort by raw bytes
+    items.sort(key=lambda item: item[0].encode())
+    return items
+
+
+def build(items):
+    data_offset = align4(HEADER.size + ENTRY.size * len(items))
+    index, blobs = [], []
+    offset = data_offset
+    for name, blob in items:
+        index.append(ENTRY.pack(name.encode(), offset, len(blob)))
+        padded = blob + b"\0" * (align4(len(blob)) - len(blob))
+        blobs.append(padded)
+        offset += len(padded)
+
+    header = HEADER.pack(MAGIC, VERSION, len(items), data_offset, 0)
+    head = header + b"".join(index)
+    head += b"\0" * (data_offset - len(head))
+    return head + b"".join(blobs)
+
+
+def read_index(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    magic, version, count, data_offset, _ = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION:
+        sys.exit(f"error: {path} is not a version {VERSION} KMPK pack")
+    for i in range(count):
+        raw, offset, size = ENTRY.unpack_from(data, HEADER.size + i * ENTRY.size)
+        yield raw.rstrip(b"\0").decode(), offset, size, data[offset: offset + 4]
+
+
+def describe(head):
+    """BIOS stream type from the first header byte (grit -gzl/-mzl output)."""
+    kind = head[0] & 0xF0 if head else 0
+    return {0x10: "lz77", 0x30: "rle", 0x20: "huff"}.get(kind, "raw")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("src", nargs="?", help="Directory of grit .bin outputs")
+    parser.add_argument("-o", "--out", help="Output pack file")
+    parser.add_argument("--list", metavar="PACK", help="Print the index of a pack")
+    args = parser.parse_args()
+
+    if args.list:
+        total = 0
+        for name, offset, size, head in read_index(args.list):
+            print(f"{name:<24} {offset:>8} {size:>8}  {describe(head)}")
+            total += size
+        print(f"{'total':<24} {'':>8} {total:>8}")
+        return
+
+    if not args.src or not args.out:
+        parser.error("src and --out are required to build a pack")
+
+    items = collect(args.src)
+    if not items:
+        sys.exit(f"error: no {SUFFIX} files in {args.src}")
+    pack = build(items)
+    os.makedirs(os.path.dirname(os.path.abspath(args.out)), exist_ok=True)
+    with open(args.out, "wb") as f:
+        f.write(pack)
+    print(f"{os.path.basename(args.out)}: {len(items)} entries, {len(pack)} bytes")
+
+
+if __name__ == "__main__":
+    main()
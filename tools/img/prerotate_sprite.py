@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""
+Generates pre-rotated sprite frames so karts and projectiles do not need the
+32 affine matrices of the main engine (see source/graphics/rot_sprite.c).
+
+The source sprite is rotated with nearest-neighbour sampling exactly like the
+affine hardware would show it for angle512 = k * 512 / directions (angle 0 is
+the sprite as drawn, angles grow clockwise on screen). Only the frames that
+cannot be derived with hflip/vflip are stored:
+
+  half       directions / 2 frames (0..180 deg), the other half turn is the
+             same frame with hflip + vflip. Exact for any sprite.
+  quarter-x  directions / 4 + 1 frames (0..90 deg). Needs the sprite to be
+             mirror-symmetric about its horizontal axis (e.g. a kart facing
+             right).
+  quarter-y  same, for sprites symmetric about their vertical axis (e.g. the
+             missile, drawn pointing up).
+
+Frames are stacked vertically into one sheet (frame width x N*frame height) so
+grit's tile order matches 1D sprite mapping frame by frame. Colours are
+copied, never blended, so the sheet keeps the source palette and magenta
+transparency; the source .grit options are reused for the sheet.
+
+Usage:
+  cd tools/img
+  python prerotate_sprite.py ../../data/sprites/kart_sprite.png --symmetry half
+  python prerotate_sprite.py ../../data/items/missile.png --symmetry quarter-y --frame 32x32
+  python prerotate_sprite.py ../../data/items/red_shell.png --check    # symmetry report only
+"""
+
+import argparse
+import math
+import os
+import shutil
+import sys
+
+from PIL import Image
+
+TRANSPARENT = (255, 0, 255)
+ANGLE_STEPS = 512
+SYMMETRY_ENUM = {
+    "half": "ROT_SYMMETRY_HALF",
+    "quarter-x": "ROT_SYMMETRY_QUARTER_X",
+    "quarter-y": "ROT_SYMMETRY_QUARTER_Y",
+}
+
+
+def rotate_frame(src, angle512, frame_w, frame_h):
+    """Screen pixel d (from the frame centre) samples the source at R(-a) d."""
+    sw, sh = src.size
+    px = src.load()
+    theta = angle512 * 2.0 * math.pi / ANGLE_STEPS
+    c, s = math.cos(theta), math.sin(theta)
+    out = Image.new("RGB", (frame_w, frame_h), TRANSPARENT)
+    dst = out.load()
+    for y in range(frame_h):
+        for x in range(frame_w):
+            dx = x + 0.5 - frame_w / 2.0
+            dy = y + 0.5 - frame_h / 2.0
+            sx = c * dx + s * dy + sw / 2.0
+            sy = -s * dx + c * dy + sh / 2.0
+            ix, iy = int(math.floor(sx)), int(math.floor(sy))
+            if 0 <= ix < sw and 0 <= iy < sh:
+                dst[x, y] = px[ix, iy]
+    return out
+
+
+def stored_frames(directions, symmetry):
+    if symmetry == "half":
+        return directions // 2
+    return directions // 4 + 1
+
+
+def mirror_mismatch(src, axis):
+    """Opaque pixels that differ from their mirror across the given axis."""
+    w, h = src.size
+    px = src.load()
+    bad = 0
+    for y in range(h):
+        for x in range(w):
+            mx, my = (x, h - 1 - y) if axis == "x" else (w - 1 - x, y)
+            a, b = px[x, y], px[mx, my]
+            if a != b and (a != TRANSPARENT or b != TRANSPARENT):
+                bad += 1
+    return bad
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("src", help="Source sprite PNG (magenta = transparent)")
+    parser.add_argument("--directions", type=int, default=32, choices=[16, 32],
+                        help="Directions per full turn (default 32)")
+    parser.add_argument("--symmetry", default="half", choices=sorted(SYMMETRY_ENUM),
+                        help="Which flips rebuild the missing frames (default half)")
+    parser.add_argument("--frame", help="Frame size WxH (default: source size)")
+    parser.add_argument("--out", help="Output sheet (default <src>_rot.png)")
+    parser.add_argument("--check", action="store_true",
+                        help="Only report mirror symmetry of the source")
+    args = parser.parse_args()
+
+    src = Image.open(args.src).convert("RGB")
+    total = src.size[0] * src.size[1]
+    for axis in ("x", "y"):
+        bad = mirror_mismatch(src, axis)
+        print(f"mirror about {axis}-axis: {bad} / {total} pixels differ")
+    if args.check:
+        return
+
+    if args.frame:
+        frame_w, frame_h = (int(v) for v in args.frame.lower().split("x"))
+    else:
+        frame_w, frame_h = src.size
+    if frame_w % 8 or frame_h % 8:
+        sys.exit("error: frame size must be a multiple of 8")
+
+    count = stored_frames(args.directions, args.symmetry)
+    step = ANGLE_STEPS // args.directions
+    sheet = Image.new("RGB", (frame_w, frame_h * count), TRANSPARENT)
+    for k in range(count):
+        sheet.paste(rotate_frame(src, k * step, frame_w, frame_h), (0, k * frame_h))
+
+    base, _ = os.path.splitext(args.src)
+    out = args.out or f"{base}_rot.png"
+    sheet.save(out)
+
+    grit_src, grit_out = f"{base}.grit", f"{os.path.splitext(out)[0]}.grit"
+    if os.path.exists(grit_src) and not os.path.exists(grit_out):
+        shutil.copyfile(grit_src, grit_out)
+
+    print(f"wrote {out}: {count} frames of {frame_w}x{frame_h} "
+          f"({args.directions} directions, {args.symmetry})")
+    print(f"descriptor: {{{args.directions}, {SYMMETRY_ENUM[args.symmetry]}, "
+          f"SpriteSize_{frame_w}x{frame_h}}}")
+
+
+if __name__ == "__main__":
+    main()
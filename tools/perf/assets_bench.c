@@ -0,0 +1,608 @@
+/**
+ * File: assets_bench.c
+ * --------------------
+ * Description: Host test bench for the asset manager
+ *              (source/storage/assets.h). Loads a pack built by
+ *              tools/img/pack_assets.py through the mmap backend of assets.c
+ *              and checks:
+ *
+ *              lookup    every index entry is found, has its size and is
+ *                        4-byte aligned; its bytes match the pack (or the
+ *                        grit .bin file with --src); near-miss names are not
+ *                        found
+ *              lru       a random Acquire / Release / Preload / Trim sequence
+ *                        under a small budget, against a model of the
+ *                        resident set: hits, misses, evictions and resident
+ *                        bytes after every call; pinned data never moves or
+ *                        changes; pinning past the budget still loads, and
+ *                        counts each load over
+ *              damaged   copies of the pack with a bad magic, version or
+ *                        index order, a truncated index or data, and an
+ *                        entry past the end: Assets_Init refuses the index,
+ *                        or only the damaged entries fail to load
+ *
+ *              and reports index load time, cold load throughput and the
+ *              cost of a resident hit.
+ *
+ * No grit on the machine: "synth" writes random grit-like .bin files
+ * (LZ77-headed .img and .map, raw .pal) to pack.
+ *
+ * Build (from the repository root):
+ *   gcc -O2 -DKMLOG_LEVEL=4 -Isource -o assets_bench tools/perf/assets_bench.c \
+ *       source/storage/assets.c source/core/mem_budget.c
+ *
+ * Usage:
+ *   assets_bench synth <dir> [--count n] [--seed n]
+ *   assets_bench <pack> [--src dir] [--budget bytes] [--ops n] [--rounds n]
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "core/mem_budget.h"
+#include "storage/assets.h"
+
+//=============================================================================
+// CONSTANTS
+//=============================================================================
+#define HEADER_BYTES 16              // "KMPK", u16 version, u16 count, ...
+#define ENTRY_BYTES (ASSETS_NAME_LEN + 8)
+#define MAX_PINS 4                   // Pins the lru sequence holds at once
+#define DAMAGED_PATH_SUFFIX ".damaged"
+
+//=============================================================================
+// TYPES
+//=============================================================================
+typedef struct {
+    char name[ASSETS_NAME_LEN];
+    uint32_t offset;
+    uint32_t size;
+} IndexEntry;
+
+// What assets.c should hold for one entry
+typedef struct {
+    bool resident;
+    int pins;
+    uint32_t lastUse;
+    const void* data;  // Pointer while pinned (must not change)
+} ModelEntry;
+
+//=============================================================================
+// STATE
+//=============================================================================
+static uint8_t* pack;  // Whole pack, read with stdio (independent of assets.c)
+static size_t packBytes;
+static IndexEntry* entries;
+static int entryCount;
+
+static int failures = 0;
+
+//=============================================================================
+// HELPERS
+//=============================================================================
+
+static uint64_t NowNs(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t NextRandom(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static uint32_t ReadU32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+static void WriteU32(uint8_t* p, uint32_t value) {
+    for (int i = 0; i < 4; i++)
+        p[i] = (uint8_t)(value >> (8 * i));
+}
+
+static void Fail(const char* check, const char* fmt, const char* detail) {
+    if (failures++ < 20) {
+        printf("  FAIL %s: ", check);
+        printf(fmt, detail);
+        printf("\n");
+    }
+}
+
+static uint8_t* ReadFile(const char* path, size_t* outBytes) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+        return NULL;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t* data = malloc(size > 0 ? (size_t)size : 1);
+    if (data != NULL && fread(data, 1, (size_t)size, file) != (size_t)size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *outBytes = (size_t)size;
+    return data;
+}
+
+static bool WriteFile(const char* path, const uint8_t* data, size_t bytes) {
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+        return false;
+    bool ok = fwrite(data, 1, bytes, file) == bytes;
+    return fclose(file) == 0 && ok;
+}
+
+// Parses the index the way pack_assets.py writes it
+static bool LoadIndex(const char* path) {
+    pack = ReadFile(path, &packBytes);
+    if (pack == NULL || packBytes < HEADER_BYTES || memcmp(pack, "KMPK", 4) != 0)
+        return false;
+    entryCount = pack[6] | (pack[7] << 8);
+    if (HEADER_BYTES + (size_t)entryCount * ENTRY_BYTES > packBytes)
+        return false;
+
+    entries = calloc((size_t)entryCount + 1, sizeof(IndexEntry));
+    for (int i = 0; i < entryCount; i++) {
+        const uint8_t* raw = pack + HEADER_BYTES + i * ENTRY_BYTES;
+        memcpy(entries[i].name, raw, ASSETS_NAME_LEN);
+        entries[i].name[ASSETS_NAME_LEN - 1] = '\0';
+        entries[i].offset = ReadU32(raw + ASSETS_NAME_LEN);
+        entries[i].size = ReadU32(raw + ASSETS_NAME_LEN + 4);
+        if ((size_t)entries[i].offset + entries[i].size > packBytes)
+            return false;
+    }
+    return entryCount > 0;
+}
+
+//=============================================================================
+// SYNTH
+//=============================================================================
+
+static int Synth(const char* dir, int count, uint32_t seed) {
+    static const char* const kinds[] = {"img", "map", "pal"};
+    mkdir(dir, 0755);
+
+    uint32_t rng = seed ? seed : 1;
+    uint32_t total = 0;
+    for (int i = 0; i < count; i++) {
+        const char* kind = kinds[i % 3];
+        char path[512];
+        // The last name uses all 23 characters the index allows
+        if (i == count - 1)
+            snprintf(path, sizeof(path), "%s/longest_asset_name1.%s.bin", dir, kind);
+        else
+            snprintf(path, sizeof(path), "%s/asset%03d.%s.bin", dir, i / 3, kind);
+
+        // Palettes are 32-512 bytes; tiles and maps up to 24 KB, often not a
+        // multiple of 4, so the pack pads between them
+        uint32_t size = (i % 3 == 2) ? 32u << (NextRandom(&rng) % 5)
+                                     : 64 + NextRandom(&rng) % (24 * 1024);
+        uint8_t* data = malloc(size);
+        for (uint32_t b = 0; b < size; b++)
+            data[b] = (uint8_t)NextRandom(&rng);
+        if (i % 3 != 2)
+            WriteU32(data, 0x10u | ((size * 3) << 8));  // LZ77 header, ~3x ratio
+        bool ok = WriteFile(path, data, size);
+        free(data);
+        if (!ok) {
+            fprintf(stderr, "cannot write %s\n", path);
+            return 2;
+        }
+        total += size;
+    }
+    printf("%d files, %u bytes in %s\n", count, total, dir);
+    printf("pack them with: python tools/img/pack_assets.py %s -o <pack>\n", dir);
+    return 0;
+}
+
+//=============================================================================
+// CHECKS
+//=============================================================================
+
+static void CheckLookup(const char* srcDir) {
+    Assets_Trim();
+    for (int i = 0; i < entryCount; i++) {
+        const IndexEntry* e = &entries[i];
+        uint32_t size = 0;
+        if (!Assets_Exists(e->name))
+            Fail("lookup", "%s not found", e->name);
+        const uint8_t* data = Assets_Acquire(e->name, &size);
+        if (data == NULL) {
+            Fail("lookup", "%s did not load", e->name);
+            continue;
+        }
+        if (size != e->size)
+            Fail("lookup", "%s has the wrong size", e->name);
+        if ((uintptr_t)data & 3)
+            Fail("lookup", "%s is not 4-byte aligned", e->name);
+        if (memcmp(data, pack + e->offset, e->size) != 0)
+            Fail("lookup", "%s bytes differ from the pack", e->name);
+
+        if (srcDir != NULL) {
+            char path[512];
+            size_t bytes = 0;
+            snprintf(path, sizeof(path), "%s/%s.bin", srcDir, e->name);
+            uint8_t* source = ReadFile(path, &bytes);
+            if (source == NULL || bytes != size || memcmp(source, data, size) != 0)
+                Fail("lookup", "%s differs from its .bin file", e->name);
+            free(source);
+        }
+        Assets_Release(e->name);
+    }
+
+    // Names next to real ones must miss: a prefix, an extra character, empty
+    char name[ASSETS_NAME_LEN + 8];
+    const char* first = entries[0].name;
+    snprintf(name, sizeof(name), "%.*s", (int)strlen(first) - 1, first);
+    if (Assets_Exists(name) || Assets_Acquire(name, NULL) != NULL)
+        Fail("lookup", "prefix '%s' was found", name);
+    snprintf(name, sizeof(name), "%sx", entries[entryCount - 1].name);
+    if (Assets_Exists(name) || Assets_Acquire(name, NULL) != NULL)
+        Fail("lookup", "'%s' was found", name);
+    if (Assets_Exists("") || Assets_Acquire("", NULL) != NULL)
+        Fail("lookup", "%s", "the empty name was found");
+    Assets_Release("not in the pack");  // Must be harmless
+}
+
+// Evicts from the model the way Assets_MakeRoom does
+static void Model_MakeRoom(ModelEntry* model, uint32_t* resident, uint32_t incoming,
+                           uint32_t budget, uint32_t* evictions, uint32_t* overBudget) {
+    while (*resident + incoming > budget) {
+        int victim = -1;
+        for (int i = 0; i < entryCount; i++) {
+            if (!model[i].resident || model[i].pins > 0)
+                continue;
+            if (victim < 0 || model[i].lastUse < model[victim].lastUse)
+                victim = i;
+        }
+        if (victim < 0) {
+            (*overBudget)++;
+            return;
+        }
+        model[victim].resident = false;
+        *resident -= entries[victim].size;
+        (*evictions)++;
+    }
+}
+
+static void CheckLru(uint32_t budget, int ops, uint32_t seed) {
+    ModelEntry* model = calloc((size_t)entryCount, sizeof(ModelEntry));
+    int pinned[MAX_PINS];
+    int pinCount = 0;
+    uint32_t rng = seed;
+    uint32_t useTick = 0, resident = 0;
+    uint32_t hits = 0, misses = 0, evictions = 0, overBudget = 0;
+
+    Assets_Trim();
+    Assets_SetBudget(budget);
+    const AssetStats* stats = Assets_GetStats();
+    uint32_t baseHits = stats->hits, baseMisses = stats->misses;
+    uint32_t baseEvictions = stats->evictions, baseOver = stats->overBudget;
+
+    // Recently used entries come back often, so the resident set gets hits
+    int hot = entryCount < 8 ? entryCount : 8;
+    for (int op = 0; op < ops; op++) {
+        uint32_t roll = NextRandom(&rng) % 100;
+        int i = (roll < 70) ? (int)(NextRandom(&rng) % (uint32_t)hot)
+                            : (int)(NextRandom(&rng) % (uint32_t)entryCount);
+        const IndexEntry* e = &entries[i];
+
+        if (roll >= 97) {
+            // Trim: every unpinned entry goes
+            Assets_Trim();
+            for (int k = 0; k < entryCount; k++) {
+                if (model[k].resident && model[k].pins == 0) {
+                    model[k].resident = false;
+                    resident -= entries[k].size;
+                    evictions++;
+                }
+            }
+        } else if (roll >= 90 && pinCount > 0) {
+            // Release the oldest pin
+            int k = pinned[0];
+            memmove(pinned, pinned + 1, (size_t)(--pinCount) * sizeof(int));
+            Assets_Release(entries[k].name);
+            model[k].pins--;
+        } else {
+            bool pin = roll < 20 && pinCount < MAX_PINS;
+            if (model[i].resident) {
+                hits++;
+            } else {
+                Model_MakeRoom(model, &resident, e->size, budget, &evictions,
+                               &overBudget);
+                model[i].resident = true;
+                resident += e->size;
+                misses++;
+            }
+            model[i].lastUse = ++useTick;
+
+            const void* data = Assets_Acquire(e->name, NULL);
+            if (data == NULL || memcmp(data, pack + e->offset, e->size) != 0)
+                Fail("lru", "%s did not load correctly", e->name);
+            if (pin) {
+                if (model[i].pins > 0 && model[i].data != data)
+                    Fail("lru", "pinned %s moved", e->name);
+                model[i].pins++;
+                model[i].data = data;
+                pinned[pinCount++] = i;
+            } else {
+                Assets_Release(e->name);  // Preload: resident, not pinned
+            }
+        }
+
+        // Pinned data stays where it was, unchanged
+        for (int p = 0; p < pinCount; p++) {
+            const ModelEntry* m = &model[pinned[p]];
+            const IndexEntry* pe = &entries[pinned[p]];
+            if (memcmp(m->data, pack + pe->offset, pe->size) != 0)
+                Fail("lru", "pinned %s was overwritten", pe->name);
+        }
+
+        if (stats->hits - baseHits != hits || stats->misses - baseMisses != misses ||
+            stats->evictions - baseEvictions != evictions ||
+            stats->overBudget - baseOver != overBudget ||
+            stats->residentBytes != resident) {
+            char detail[160];
+            snprintf(detail, sizeof(detail),
+                     "op %d: hits %u/%u misses %u/%u evictions %u/%u resident %u/%u", op,
+                     stats->hits - baseHits, hits, stats->misses - baseMisses, misses,
+                     stats->evictions - baseEvictions, evictions, stats->residentBytes,
+                     resident);
+            Fail("lru", "%s (assets.c/model)", detail);
+            break;
+        }
+        if (overBudget == 0 && resident > budget)
+            Fail("lru", "%s", "resident bytes over budget with nothing pinned over");
+    }
+
+    for (int p = 0; p < pinCount; p++)
+        Assets_Release(entries[pinned[p]].name);
+    printf("  lru: %d calls, budget %u: %u hits, %u misses, %u evictions, "
+           "%u loads over budget (pinned)\n",
+           ops, budget, hits, misses, evictions, overBudget);
+    free(model);
+}
+
+// Pins more than the budget: the loads still succeed, each one counted
+static void CheckPinnedOverBudget(void) {
+    int pins = entryCount < MAX_PINS ? entryCount : MAX_PINS;
+    Assets_Trim();
+    Assets_SetBudget(entries[0].size);
+    uint32_t overBefore = Assets_GetStats()->overBudget;
+
+    const void* data[MAX_PINS];
+    for (int i = 0; i < pins; i++)
+        data[i] = Assets_Acquire(entries[i].name, NULL);
+    uint32_t over = Assets_GetStats()->overBudget - overBefore;
+    for (int i = 0; i < pins; i++) {
+        if (data[i] == NULL ||
+            memcmp(data[i], pack + entries[i].offset, entries[i].size) != 0)
+            Fail("pins", "%s was not loaded while over budget", entries[i].name);
+    }
+    if (over != (uint32_t)pins - 1)
+        Fail("pins", "%s", "loads over budget not counted");
+
+    // Unpinned, they go back under the budget
+    for (int i = 0; i < pins; i++)
+        Assets_Release(entries[i].name);
+    Assets_SetBudget(entries[0].size);
+    if (Assets_GetStats()->residentBytes > entries[0].size)
+        Fail("pins", "%s", "released entries stayed over budget");
+    printf("  pins: %d pinned over a %u byte budget: %u loads counted over\n", pins,
+           entries[0].size, over);
+}
+
+// Opens a damaged copy; `expectInit` false: Assets_Init must refuse it,
+// otherwise entries at or past `firstBad` must fail to load and the rest load
+static void CheckDamaged(const char* path, const char* what, const uint8_t* data,
+                         size_t bytes, bool expectInit, int firstBad) {
+    char damaged[512];
+    snprintf(damaged, sizeof(damaged), "%s%s", path, DAMAGED_PATH_SUFFIX);
+    if (!WriteFile(damaged, data, bytes)) {
+        Fail("damaged", "cannot write %s", damaged);
+        return;
+    }
+
+    bool init = Assets_Init(damaged);
+    if (init != expectInit) {
+        Fail("damaged", expectInit ? "%s: index refused" : "%s: index accepted",
+             what);
+    } else if (init) {
+        for (int i = 0; i < entryCount; i++) {
+            const uint8_t* got = Assets_Acquire(entries[i].name, NULL);
+            bool good = i < firstBad;
+            if (good && (got == NULL || memcmp(got, pack + entries[i].offset,
+                                               entries[i].size) != 0))
+                Fail("damaged", "%s: an intact entry failed", what);
+            if (!good && got != NULL)
+                Fail("damaged", "%s: a damaged entry loaded", what);
+            if (got != NULL)
+                Assets_Release(entries[i].name);
+        }
+    }
+    Assets_Shutdown();
+    remove(damaged);
+    printf("  damaged: %-34s %s\n", what,
+           init ? "index read, damaged entries refused" : "index refused");
+}
+
+static void CheckDamagedPacks(const char* path) {
+    uint8_t* copy = malloc(packBytes);
+
+    memcpy(copy, pack, packBytes);
+    copy[0] = 'X';
+    CheckDamaged(path, "bad magic", copy, packBytes, false, 0);
+
+    memcpy(copy, pack, packBytes);
+    copy[4] = 2;
+    CheckDamaged(path, "unknown version", copy, packBytes, false, 0);
+
+    size_t indexEnd = HEADER_BYTES + (size_t)entryCount * ENTRY_BYTES;
+    CheckDamaged(path, "index cut short", pack, indexEnd - ENTRY_BYTES / 2, false, 0);
+
+    memcpy(copy, pack, packBytes);
+    copy[6] = 0xFF;  // Count far past the file
+    copy[7] = 0xFF;
+    CheckDamaged(path, "entry count too large", copy, packBytes, false, 0);
+
+    if (entryCount >= 2) {
+        // Swap the first two entries: bsearch could no longer find names
+        memcpy(copy, pack, packBytes);
+        memcpy(copy + HEADER_BYTES, pack + HEADER_BYTES + ENTRY_BYTES, ENTRY_BYTES);
+        memcpy(copy + HEADER_BYTES + ENTRY_BYTES, pack + HEADER_BYTES, ENTRY_BYTES);
+        CheckDamaged(path, "index out of order", copy, packBytes, false, 0);
+    }
+
+    // Data cut in the middle of the last entry
+    const IndexEntry* last = &entries[entryCount - 1];
+    CheckDamaged(path, "data cut short", pack, last->offset + last->size / 2, true,
+                 entryCount - 1);
+
+    // The last entry's offset points past the end of the file
+    memcpy(copy, pack, packBytes);
+    WriteU32(copy + HEADER_BYTES + (entryCount - 1) * ENTRY_BYTES + ASSETS_NAME_LEN,
+             (uint32_t)packBytes + 64);
+    CheckDamaged(path, "entry offset past the end", copy, packBytes, true,
+                 entryCount - 1);
+
+    free(copy);
+}
+
+//=============================================================================
+// BENCHMARK
+//=============================================================================
+
+static void Benchmark(const char* path, int rounds) {
+    uint64_t initNs = 0, coldNs = 0, hitNs = 0, lookupNs = 0;
+    uint64_t bytes = 0, hitsTimed = 0, lookups = 0;
+
+    for (int r = 0; r < rounds; r++) {
+        uint64_t t0 = NowNs();
+        Assets_Init(path);
+        initNs += NowNs() - t0;
+        Assets_SetBudget(UINT32_MAX);
+
+        // Cold: every entry read from the pack
+        t0 = NowNs();
+        for (int i = 0; i < entryCount; i++) {
+            Assets_Acquire(entries[i].name, NULL);
+            Assets_Release(entries[i].name);
+        }
+        coldNs += NowNs() - t0;
+        bytes += Assets_GetStats()->bytesRead;
+
+        // Warm: resident hits (lookup, pin, unpin)
+        t0 = NowNs();
+        for (int k = 0; k < 64; k++) {
+            for (int i = 0; i < entryCount; i++) {
+                Assets_Acquire(entries[i].name, NULL);
+                Assets_Release(entries[i].name);
+            }
+        }
+        hitNs += NowNs() - t0;
+        hitsTimed += 64u * (uint64_t)entryCount;
+
+        t0 = NowNs();
+        for (int k = 0; k < 64; k++) {
+            for (int i = 0; i < entryCount; i++)
+                lookups += Assets_Exists(entries[i].name);
+        }
+        lookupNs += NowNs() - t0;
+        Assets_Shutdown();
+    }
+
+    printf("  index: %d entries read in %.1f us\n", entryCount, initNs / 1e3 / rounds);
+    printf("  cold loads: %.1f MB/s (%llu bytes per round, mmap + copy)\n",
+           bytes / (coldNs / 1e9) / 1e6, (unsigned long long)(bytes / rounds));
+    printf("  resident hit: %.0f ns per Acquire + Release, lookup %.0f ns\n",
+           (double)hitNs / hitsTimed, (double)lookupNs / lookups);
+}
+
+//=============================================================================
+// MAIN
+//=============================================================================
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && strcmp(argv[1], "synth") == 0) {
+        int count = 48;
+        uint32_t seed = 1;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (strcmp(argv[i], "--count") == 0)
+                count = atoi(argv[i + 1]);
+            else if (strcmp(argv[i], "--seed") == 0)
+                seed = (uint32_t)atoi(argv[i + 1]);
+        }
+        return Synth(argv[2], count > 0 ? count : 1, seed);
+    }
+    if (argc < 2) {
+        fprintf(stderr, "usage: assets_bench synth <dir> [--count n] [--seed n]\n"
+                        "       assets_bench <pack> [--src dir] [--budget bytes] "
+                        "[--ops n] [--rounds n]\n");
+        return 2;
+    }
+
+    const char* path = argv[1];
+    const char* srcDir = NULL;
+    uint32_t budget = 0;
+    int ops = 20000, rounds = 20;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--src") == 0)
+            srcDir = argv[i + 1];
+        else if (strcmp(argv[i], "--budget") == 0)
+            budget = (uint32_t)atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--ops") == 0)
+            ops = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--rounds") == 0)
+            rounds = atoi(argv[i + 1]);
+    }
+
+    if (!LoadIndex(path)) {
+        fprintf(stderr, "%s: not a readable KMPK pack\n", path);
+        return 2;
+    }
+    uint32_t total = 0, largest = 0;
+    for (int i = 0; i < entryCount; i++) {
+        total += entries[i].size;
+        if (entries[i].size > largest)
+            largest = entries[i].size;
+    }
+    if (budget == 0)
+        budget = total / 4 > largest ? total / 4 : largest;  // A quarter resident
+
+    MemBudget_Init();
+    printf("%s: %d entries, %u bytes of data\n", path, entryCount, total);
+    if (!Assets_Init(path)) {
+        printf("  FAIL Assets_Init refused the pack\n");
+        return 1;
+    }
+    CheckLookup(srcDir);
+    printf("  lookup: %d entries found and byte-identical%s\n", entryCount,
+           srcDir ? " to the pack and the .bin files" : " to the pack");
+    CheckLru(budget, ops, 0x9E3779B9u);
+    CheckPinnedOverBudget();
+    Assets_Shutdown();
+
+    CheckDamagedPacks(path);
+
+    if (MemBudget_GetOwnerUsage(MEM_POOL_HEAP, MEM_OWNER_ASSETS) != 0)
+        Fail("memory", "%s", "asset heap still charged after Assets_Shutdown");
+
+    Benchmark(path, rounds > 0 ? rounds : 1);
+
+    printf("%s\n", failures ? "FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
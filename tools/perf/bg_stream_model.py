@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+"""
+Host model of track background VRAM traffic.
+
+Replays a camera path and counts the bytes each frame would copy to main BG
+VRAM with:
+  - quadrant swaps (old Gameplay_LoadQuadrant: palette clear + tiles + palette
+    + 8 KB map whenever the camera crosses a 256 px quadrant boundary)
+  - edge streaming (source/graphics/bg_stream.c: 128-byte rows/columns as the
+    64x64 wrapping window follows the camera, full 8 KB refill on big jumps)
+
+The camera path is either a recorded CSV (frame,scrollX,scrollY) or is
+generated by driving the Scorching Sands racing line parsed from
+source/gameplay/items/item_navigation.c at a constant speed.
+
+Usage:
+  python bg_stream_model.py                     # 3 laps at 3 px/frame
+  python bg_stream_model.py --speed 6 --laps 1
+  python bg_stream_model.py --path camera.csv --csv per_frame.csv
+  python bg_stream_model.py --world-tiles 256   # same path scaled to 2048 px
+"""
+
+import argparse
+import csv
+import math
+import os
+import re
+import sys
+
+REPO_ROOT = os.path.normpath(os.path.join(os.path.dirname(__file__), "..", ".."))
+NAV_SOURCE = os.path.join(REPO_ROOT, "source", "gameplay", "items", "item_navigation.c")
+TRACK_DIR = os.path.join(REPO_ROOT, "data", "tracks")
+QUADRANT_NAMES = ["TL", "TC", "TR", "ML", "MC", "MR", "BL", "BC", "BR"]
+
+# Mirrors game_constants.h
+SCREEN_WIDTH = 256
+SCREEN_HEIGHT = 192
+TILE_SIZE = 8
+QUAD_OFFSET = 256
+PALETTE_SIZE = 512
+TILE_DATA_SIZE = 64
+QUAD_MAP_BYTES = 64 * 64 * 2
+BG_STREAM_SIZE_TILES = 64
+BG_STREAM_MARGIN_X = (BG_STREAM_SIZE_TILES - (SCREEN_WIDTH // TILE_SIZE + 1)) // 2
+BG_STREAM_MARGIN_Y = (BG_STREAM_SIZE_TILES - (SCREEN_HEIGHT // TILE_SIZE + 1)) // 2
+BG_STREAM_MAX_STAGED = 8
+LINE_BYTES = BG_STREAM_SIZE_TILES * 2
+DEFAULT_TILE_COUNT = 60  # Used when the track PNGs cannot be read
+
+
+# -----------------------------------------------------------------------------
+# Camera path
+# -----------------------------------------------------------------------------
+def load_waypoints():
+    pattern = re.compile(r"IntToFixed\((\d+)\),\s*IntToFixed\((\d+)\)")
+    with open(NAV_SOURCE) as f:
+        text = f.read()
+    # Only the first table (Scorching Sands) is a closed racing line we know
+    start = text.index("scorchingSands_racingLine")
+    end = text.index("};", start)
+    return [(int(x), int(y)) for x, y in pattern.findall(text[start:end])]
+
+
+def drive_path(waypoints, speed, laps, scale):
+    """Yields car centers moving `speed` px/frame along the closed polyline."""
+    pts = [(x * scale, y * scale) for x, y in waypoints]
+    pos = pts[0]
+    for _ in range(laps):
+        for i in range(len(pts)):
+            target = pts[(i + 1) % len(pts)]
+            while True:
+                dx, dy = target[0] - pos[0], target[1] - pos[1]
+                dist = math.hypot(dx, dy)
+                if dist <= speed:
+                    pos = target
+                    break
+                pos = (pos[0] + dx / dist * speed, pos[1] + dy / dist * speed)
+                yield pos
+
+
+def camera_from_car(path, world_px):
+    max_x = world_px - SCREEN_WIDTH
+    max_y = world_px - SCREEN_HEIGHT
+    for cx, cy in path:
+        sx = min(max(int(cx) - SCREEN_WIDTH // 2, 0), max_x)
+        sy = min(max(int(cy) - SCREEN_HEIGHT // 2, 0), max_y)
+        yield sx, sy
+
+
+def load_csv_path(path):
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            yield int(row["scrollX"]), int(row["scrollY"])
+
+
+# -----------------------------------------------------------------------------
+# Transfer models
+# -----------------------------------------------------------------------------
+def quadrant_tile_bytes():
+    """Tile bytes per quadrant, deduplicated like grit (-m with flips)."""
+    try:
+        from PIL import Image
+    except ImportError:
+        return None
+
+    sizes = []
+    for name in QUADRANT_NAMES:
+        png = os.path.join(TRACK_DIR, f"scorching_sands_{name}.png")
+        if not os.path.exists(png):
+            return None
+        img = Image.open(png).convert("P")
+        w, h = img.size
+        px = img.load()
+        seen = set()
+        for ty in range(0, h, TILE_SIZE):
+            for tx in range(0, w, TILE_SIZE):
+                rows = [tuple(px[tx + x, ty + y] for x in range(TILE_SIZE))
+                        for y in range(TILE_SIZE)]
+                variants = (
+                    tuple(rows),
+                    tuple(r[::-1] for r in rows),
+                    tuple(rows[::-1]),
+                    tuple(r[::-1] for r in rows[::-1]),
+                )
+                if not any(v in seen for v in variants):
+                    seen.add(variants[0])
+        sizes.append(len(seen) * TILE_DATA_SIZE)
+    return sizes
+
+
+class QuadrantModel:
+    def __init__(self, world_px, tile_bytes):
+        self.grid = max(1, world_px // QUAD_OFFSET - 1)
+        self.tile_bytes = tile_bytes
+        self.current = None
+
+    def _quadrant(self, sx, sy):
+        col = min(sx // QUAD_OFFSET, self.grid - 1)
+        row = min(sy // QUAD_OFFSET, self.grid - 1)
+        return row * self.grid + col
+
+    def frame(self, sx, sy):
+        quad = self._quadrant(sx, sy)
+        if quad == self.current:
+            return 0
+        self.current = quad
+        tiles = self.tile_bytes[quad % len(self.tile_bytes)]
+        return PALETTE_SIZE + tiles + PALETTE_SIZE + QUAD_MAP_BYTES
+
+
+class StreamModel:
+    """Line-for-line port of BgStream_Prepare/Commit byte accounting."""
+
+    def __init__(self):
+        self.origin = None
+        self.refills = 0
+
+    def frame(self, sx, sy):
+        nx = (sx >> 3) - BG_STREAM_MARGIN_X
+        ny = (sy >> 3) - BG_STREAM_MARGIN_Y
+        if self.origin is None:
+            self.origin = (nx, ny)
+            self.refills += 1
+            return BG_STREAM_SIZE_TILES * LINE_BYTES
+        dx, dy = nx - self.origin[0], ny - self.origin[1]
+        self.origin = (nx, ny)
+        if abs(dx) > BG_STREAM_MAX_STAGED or abs(dy) > BG_STREAM_MAX_STAGED:
+            self.refills += 1
+            return BG_STREAM_SIZE_TILES * LINE_BYTES
+        return (abs(dx) + abs(dy)) * LINE_BYTES
+
+
+# -----------------------------------------------------------------------------
+# Report
+# -----------------------------------------------------------------------------
+def summarize(name, per_frame):
+    frames = len(per_frame)
+    active = [b for b in per_frame if b]
+    total = sum(per_frame)
+    ordered = sorted(per_frame)
+    p99 = ordered[min(frames - 1, int(frames * 0.99))] if frames else 0
+    print(f"{name}")
+    print(f"  total bytes      : {total}")
+    print(f"  mean bytes/frame : {total / frames:.1f}" if frames else "  no frames")
+    print(f"  p99 bytes/frame  : {p99}")
+    print(f"  max bytes/frame  : {max(per_frame) if per_frame else 0}")
+    print(f"  max after setup  : {max(per_frame[1:]) if frames > 1 else 0}")
+    print(f"  frames copying   : {len(active)} / {frames}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--path", help="CSV camera path with scrollX,scrollY columns")
+    parser.add_argument("--speed", type=float, default=3.0,
+                        help="Car speed in px/frame for the generated path (default 3)")
+    parser.add_argument("--laps", type=int, default=3, help="Laps to drive (default 3)")
+    parser.add_argument("--world-tiles", type=int, default=128,
+                        help="World size in tiles; scales the racing line (default 128)")
+    parser.add_argument("--csv", help="Write per-frame bytes to this CSV file")
+    args = parser.parse_args()
+
+    world_px = args.world_tiles * TILE_SIZE
+    if args.path:
+        camera = list(load_csv_path(args.path))
+    else:
+        scale = world_px / 1024.0
+        camera = list(camera_from_car(
+            drive_path(load_waypoints(), args.speed, args.laps, scale), world_px))
+
+    tile_bytes = quadrant_tile_bytes()
+    if tile_bytes is None:
+        print("note: Pillow or track PNGs unavailable, assuming "
+              f"{DEFAULT_TILE_COUNT} tiles per quadrant", file=sys.stderr)
+        tile_bytes = [DEFAULT_TILE_COUNT * TILE_DATA_SIZE]
+
+    quad = QuadrantModel(world_px, tile_bytes)
+    stream = StreamModel()
+    quad_bytes = [quad.frame(x, y) for x, y in camera]
+    stream_bytes = [stream.frame(x, y) for x, y in camera]
+
+    print(f"camera path: {len(camera)} frames, world {world_px}x{world_px} px")
+    summarize("quadrant swap", quad_bytes)
+    summarize("edge streaming", stream_bytes)
+    print(f"  full refills     : {stream.refills}")
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            out = csv.writer(f)
+            out.writerow(["frame", "scrollX", "scrollY", "quadrantBytes", "streamBytes"])
+            for i, ((x, y), qb, sb) in enumerate(zip(camera, quad_bytes, stream_bytes)):
+                out.writerow([i, x, y, qb, sb])
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,45 @@
+/**
+ * File: nds.h
+ * -----------
+ * Description: Host stand-in for the parts of libnds that the race simulation
+ *              sources include <nds.h> for: the fixed-size integer types and
+ *              the interrupt critical section. Lets tools/perf link game
+ *              modules unchanged (gcc -Itools/perf/host). Not a libnds
+ *              replacement: hardware registers, video and sprites are absent,
+ *              so only simulation code builds against it.
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#ifndef HOST_NDS_H
+#define HOST_NDS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef int64_t s64;
+typedef volatile u16 vu16;
+typedef volatile u32 vu32;
+
+#define BIT(n) (1u << (n))
+
+// No interrupts on the host: each thread owns the state it touches
+static inline int enterCriticalSection(void) {
+    return 0;
+}
+
+static inline void leaveCriticalSection(int oldIme) {
+    (void)oldIme;
+}
+
+#endif  // HOST_NDS_H
@@ -0,0 +1,343 @@
+/**
+ * File: io_queue_tool.c
+ * ---------------------
+ * Description: Host test bench for the SD card write queue
+ *              (source/storage/io_queue.h). Runs the queue on POSIX files
+ *              with the write traffic of a play session - the log appended
+ *              every frame, the record file rewritten after settings
+ *              changes, a ghost saved after each race - and services it the
+ *              way the "io" idle task does: steps while the simulated frame
+ *              has spare lines. Reports how long requests wait, the longest
+ *              step, and checks every file against what was queued.
+ *
+ * The POSIX backend can slow writes down (--write-us, an SD card's latency)
+ * and fail them (--fail-every), to exercise the completion callbacks.
+ *
+ * Build (from the repository root):
+ *   gcc -O2 -DKMLOG_LEVEL=4 -Isource -o io_queue_tool tools/perf/io_queue_tool.c \
+ *       source/storage/io_queue.c
+ *
+ * Usage:
+ *   io_queue_tool <dir> [--frames n] [--spare-lines n] [--write-us n]
+ *                       [--fail-every n]
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "storage/io_queue.h"
+
+//=============================================================================
+// CONSTANTS
+//=============================================================================
+#define LINE_NS 63556           // One scanline
+#define LOG_BYTES_PER_FRAME 96  // Typical log traffic (a few records)
+#define SETTINGS_EVERY 45       // Frames between settings changes
+#define RACE_FRAMES 5400        // A 90 s race: a ghost save at its end
+#define RECORD_BYTES 48         // sizeof(RecordFile)
+#define GHOST_BYTES 11000       // A 90 s lap at 2 bytes per tick
+
+//=============================================================================
+// TYPES
+//=============================================================================
+typedef struct {
+    const char* name;
+    u32 queued;
+    u32 done;
+    u32 failed;
+    uint64_t waitFrames;  // Sum of enqueue-to-callback frames
+    u32 worstFrames;
+    u32 enqueuedAt;       // Frame of the write in flight
+} Stream;
+
+//=============================================================================
+// STATE
+//=============================================================================
+static int writeUs = 0;
+static int failEvery = 0;
+static u32 writes = 0;
+static u32 frame = 0;
+
+static Stream logStream = {.name = "log"};
+static Stream recordStream = {.name = "records"};
+static Stream ghostStream = {.name = "ghost"};
+
+static u8 logBatch[4096];
+static u32 logStaged = 0;
+static uint64_t logExpected = 0;
+static bool logWriting = false;
+static bool logStarted = false;
+
+static u8 record[RECORD_BYTES];
+static u8 recordWritten[RECORD_BYTES];  // Snapshot in flight, as RecordStore does
+static u8 recordExpected[RECORD_BYTES];
+static bool recordWriting = false;
+static bool recordDirty = false;
+
+static u8 ghost[GHOST_BYTES];
+static u8 ghostExpected[GHOST_BYTES];
+static bool ghostWriting = false;
+
+static char logPath[IO_PATH_BYTES], recordPath[IO_PATH_BYTES], recordTmp[IO_PATH_BYTES];
+static char ghostPath[IO_PATH_BYTES], ghostTmp[IO_PATH_BYTES];
+
+//=============================================================================
+// POSIX BACKEND
+//=============================================================================
+
+static uint64_t NowNs(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+static void* Posix_Open(const char* path, bool append) {
+    int fd = open(path, O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC), 0644);
+    return (fd < 0) ? NULL : (void*)(intptr_t)(fd + 1);  // fd 0 is not NULL
+}
+
+static int Posix_Write(void* file, const void* data, u32 bytes) {
+    if (failEvery > 0 && ++writes % (u32)failEvery == 0)
+        return -1;
+    if (writeUs > 0) {
+        struct timespec delay = {0, (long)writeUs * 1000};
+        nanosleep(&delay, NULL);  // SD card latency
+    }
+    return (int)write((int)(intptr_t)file - 1, data, bytes);
+}
+
+static bool Posix_Sync(void* file) {
+    return fsync((int)(intptr_t)file - 1) == 0;
+}
+
+static bool Posix_Close(void* file) {
+    return close((int)(intptr_t)file - 1) == 0;
+}
+
+static bool Posix_Replace(const char* from, const char* to) {
+    unlink(to);  // Same steps as FAT, whose rename does not replace
+    return rename(from, to) == 0;
+}
+
+static const IoBackend PosixBackend = {
+    Posix_Open, Posix_Write, Posix_Sync, Posix_Close, Posix_Replace,
+};
+
+//=============================================================================
+// WORKLOAD
+//=============================================================================
+
+static void Stream_Done(Stream* stream, bool ok) {
+    u32 wait = frame - stream->enqueuedAt;
+    stream->done++;
+    stream->waitFrames += wait;
+    if (wait > stream->worstFrames)
+        stream->worstFrames = wait;
+    if (!ok)
+        stream->failed++;
+}
+
+static bool Stream_Queue(Stream* stream, const IoWrite* write) {
+    if (IoQueue_Write(write) == IO_NO_REQUEST)
+        return false;
+    stream->queued++;
+    stream->enqueuedAt = frame;
+    return true;
+}
+
+static void Log_Done(bool ok) {
+    Stream_Done(&logStream, ok);
+    if (ok)
+        logExpected += logStaged;
+    logStaged = 0;
+    logWriting = false;
+}
+
+static void Record_Done(bool ok) {
+    Stream_Done(&recordStream, ok);
+    if (ok)
+        memcpy(recordExpected, recordWritten, sizeof(recordWritten));
+    else
+        recordDirty = true;
+    recordWriting = false;
+}
+
+static void Ghost_Done(bool ok) {
+    Stream_Done(&ghostStream, ok);
+    if (ok)
+        memcpy(ghostExpected, ghost, sizeof(ghost));
+    ghostWriting = false;
+}
+
+// What the game's owners queue in one frame
+static void Workload_Frame(void) {
+    // Log: the "log" task stages what the frame logged, one write in flight
+    if (!logWriting) {
+        u32 bytes = LOG_BYTES_PER_FRAME + (frame * 7919u) % 64u;
+        if (logStaged + bytes <= sizeof(logBatch)) {
+            for (u32 i = 0; i < bytes; i++)
+                logBatch[logStaged + i] = (u8)(frame + i);
+            logStaged += bytes;
+        }
+        IoWrite write = {logPath, NULL,
+                         (u8)(IO_KEEP_OPEN | (logStarted ? IO_APPEND : 0) |
+                              ((frame % 30 == 0) ? IO_SYNC : 0)),
+                         {{logBatch, logStaged}}, Log_Done};
+        if (Stream_Queue(&logStream, &write)) {
+            logWriting = true;
+            logStarted = true;
+        }
+    }
+
+    // Settings change now and then; the record file follows
+    if (frame % SETTINGS_EVERY == 0) {
+        record[frame % RECORD_BYTES]++;
+        recordDirty = true;
+    }
+    if (recordDirty && !recordWriting) {
+        memcpy(recordWritten, record, sizeof(record));
+        IoWrite write = {recordPath, recordTmp, 0, {{recordWritten, RECORD_BYTES}},
+                         Record_Done};
+        if (Stream_Queue(&recordStream, &write)) {
+            recordWriting = true;
+            recordDirty = false;
+        }
+    }
+
+    // A ghost lap at the end of each race
+    if (frame % RACE_FRAMES == RACE_FRAMES - 1 && !ghostWriting) {
+        for (u32 i = 0; i < GHOST_BYTES; i++)
+            ghost[i] = (u8)(i * 31u + frame);
+        IoWrite write = {ghostPath, ghostTmp, 0,
+                         {{ghost, 16}, {ghost + 16, GHOST_BYTES - 16}}, Ghost_Done};
+        if (Stream_Queue(&ghostStream, &write))
+            ghostWriting = true;
+    }
+}
+
+//=============================================================================
+// CHECKS
+//=============================================================================
+
+static long FileSize(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+        return -1;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+static bool FileEquals(const char* path, const u8* data, long bytes) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+        return false;
+    u8* read = malloc((size_t)bytes + 1);
+    bool ok = fread(read, 1, (size_t)bytes + 1, file) == (size_t)bytes &&
+              memcmp(read, data, (size_t)bytes) == 0;
+    free(read);
+    fclose(file);
+    return ok;
+}
+
+static void PrintStream(const Stream* stream) {
+    printf("  %-8s %6u queued %6u done %4u failed  wait avg %.2f max %u frames\n",
+           stream->name, stream->queued, stream->done, stream->failed,
+           stream->done ? (double)stream->waitFrames / stream->done : 0.0,
+           stream->worstFrames);
+}
+
+//=============================================================================
+// MAIN
+//=============================================================================
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr,
+                "usage: io_queue_tool <dir> [--frames n] [--spare-lines n] "
+                "[--write-us n] [--fail-every n]\n");
+        return 2;
+    }
+    const char* dir = argv[1];
+    u32 frames = 3 * RACE_FRAMES;
+    int spareLines = 40;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--frames") == 0)
+            frames = (u32)atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--spare-lines") == 0)
+            spareLines = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--write-us") == 0)
+            writeUs = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--fail-every") == 0)
+            failEvery = atoi(argv[i + 1]);
+    }
+
+    snprintf(logPath, sizeof(logPath), "%s/log.kml", dir);
+    snprintf(recordPath, sizeof(recordPath), "%s/records.bin", dir);
+    snprintf(recordTmp, sizeof(recordTmp), "%s/records.tmp", dir);
+    snprintf(ghostPath, sizeof(ghostPath), "%s/ghost_0.kmg", dir);
+    snprintf(ghostTmp, sizeof(ghostTmp), "%s/ghost.tmp", dir);
+    if (strlen(ghostTmp) + 2 >= IO_PATH_BYTES) {
+        fprintf(stderr, "directory path too long (paths are %d bytes)\n", IO_PATH_BYTES);
+        return 2;
+    }
+
+    IoQueue_Init(&PosixBackend);
+    uint64_t budgetNs = (uint64_t)spareLines * LINE_NS;
+    uint64_t worstStepNs = 0, worstFrameNs = 0;
+    u32 busyFrames = 0;
+
+    for (frame = 0; frame < frames; frame++) {
+        Workload_Frame();
+
+        // "io" idle task: a step whenever the spare lines allow one
+        uint64_t start = NowNs(), now = start;
+        bool more = true;
+        while (more && now - start < budgetNs) {
+            uint64_t stepStart = now;
+            more = IoQueue_Step();
+            now = NowNs();
+            if (now - stepStart > worstStepNs)
+                worstStepNs = now - stepStart;
+        }
+        if (now - start > worstFrameNs)
+            worstFrameNs = now - start;
+        if (more)
+            busyFrames++;
+    }
+    // Drain what the last frames queued
+    while (IoQueue_Step())
+        ;
+
+    const IoQueueStats* stats = IoQueue_GetStats();
+    printf("%u frames, %d spare lines (%.2f ms) per frame, write latency %d us\n",
+           frames, spareLines, budgetNs / 1e6, writeUs);
+    printf("queue: %u requests, %u rejected, %u failed, %u steps, %u bytes, "
+           "max %u queued\n",
+           stats->requests, stats->rejected, stats->failed, stats->steps, stats->bytes,
+           stats->maxQueued);
+    printf("io time: worst step %.3f ms, worst frame %.3f ms, %u frames ended with "
+           "work left\n",
+           worstStepNs / 1e6, worstFrameNs / 1e6, busyFrames);
+    PrintStream(&logStream);
+    PrintStream(&recordStream);
+    PrintStream(&ghostStream);
+
+    bool ok = FileSize(logPath) == (long)logExpected;
+    if (recordStream.done > recordStream.failed)
+        ok = FileEquals(recordPath, recordExpected, RECORD_BYTES) && ok;
+    if (ghostStream.done > ghostStream.failed)
+        ok = FileEquals(ghostPath, ghostExpected, GHOST_BYTES) && ok;
+    printf("files: %s\n", ok ? "match the completed writes" : "MISMATCH");
+    return ok ? 0 : 1;
+}
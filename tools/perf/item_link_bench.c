@@ -0,0 +1,531 @@
+/**
+ * File: item_link_bench.c
+ * -----------------------
+ * Description: Host test bench for the item world / car split
+ *              (source/gameplay/items/items_link.h). Links the game's item
+ *              sources unchanged and runs the same scripted race twice:
+ *
+ *              loopback  one thread, per tick: cars move, Items_Update and
+ *                        Items_CheckCollisions post, Items_ApplyEvents applies
+ *                        (the order Race_Tick uses on the DS)
+ *              threaded  the item world on one thread and the car side on
+ *                        another, connected only by the ItemLink queue. The
+ *                        world reads a copy of the car poses, as a
+ *                        coprocessor would; the car side applies messages
+ *                        while the world is still posting them.
+ *
+ * Eight cars follow the item waypoints of Scorching Sands, and every few
+ * ticks one of them uses an item (shells ahead, hazards behind). The bench
+ * checks that both runs apply the same hits and box pickups in the same
+ * order on the same ticks, leave the race random generator in the same state
+ * after every tick, and end on the same SimState hash. It reports the time
+ * each side takes per tick in both runs.
+ *
+ * The messages the car side receives are logged by wrapping ItemLink_Receive
+ * at link time (GNU ld --wrap), so items_events.c is not changed.
+ *
+ * Build (from the repository root):
+ *   gcc -O2 -pthread -DKMLOG_LEVEL=4 -Itools/perf/host -Isource \
+ *       -Wl,--wrap=ItemLink_Receive -o item_link_bench tools/perf/item_link_bench.c \
+ *       source/gameplay/items/items_{update,events,link,state,spawning,inventory}.c \
+ *       source/gameplay/items/items_effects.c source/gameplay/items/items_world.c \
+ *       source/gameplay/items/item_navigation.c \
+ *       source/gameplay/sim_state.c source/gameplay/wall_collision.c \
+ *       source/math/fixedmath.c source/core/spsc_queue.c
+ *
+ * Usage:
+ *   item_link_bench [--ticks n] [--use-every n]
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "audio/sound.h"
+#include "core/game_constants.h"
+#include "core/scheduler.h"
+#include "gameplay/items/item_navigation.h"
+#include "gameplay/items/items_api.h"
+#include "gameplay/items/items_internal.h"
+#include "gameplay/items/items_link.h"
+#include "gameplay/replay.h"
+#include "gameplay/sim_state.h"
+#include "network/multiplayer.h"
+
+//=============================================================================
+// CONSTANTS
+//=============================================================================
+#define BENCH_MAP ScorchingSands
+#define CAR_COUNT MAX_CARS
+#define START_SPACING 3       // Waypoints between cars on the grid
+#define CAR_TURN_STEP 8       // Steering per tick (binary angle)
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+
+//=============================================================================
+// TYPES
+//=============================================================================
+typedef struct {
+    u32 tick;
+    ItemMsg msg;
+} LoggedMsg;
+
+typedef struct {
+    const char* name;
+    LoggedMsg* msgs;       // Every message the car side received, in order
+    u32 msgCount;
+    u32 msgCapacity;
+    u32* rngAfterTick;     // simState.rngState after the car side of each tick
+    u32* carsAfterTick;    // Hash of the cars after each tick
+    u32 finalHash;         // SimState_Hash at the end
+    u32 dropped;           // ItemLink_GetDropped at the end
+    uint64_t worldNs;      // Busy time of each side
+    uint64_t carNs;
+    uint64_t worldMaxNs;   // Longest tick of each side
+    uint64_t carMaxNs;
+    uint64_t worldWaitNs;  // Threaded: world waiting for poses
+    uint64_t carWaitNs;    // Threaded: car side waiting for the world
+    uint64_t wallNs;
+} RunLog;
+
+//=============================================================================
+// STATE
+//=============================================================================
+static u32 ticks = 60 * RACE_TICK_FREQ * 3;  // A 3 minute race
+static u32 useEvery = 10;                    // Ticks between item uses
+
+// Race_GetState() of the calling thread: the live race on the car side, the
+// pose copy on the world side when threaded
+static __thread RaceState* threadRace;
+static RaceState worldRace;
+
+static int carWaypoint[CAR_COUNT];  // Car side: next waypoint of each car
+static RunLog* activeLog;
+static u32 carTick;                 // Car side: tick being applied
+
+static volatile u32 posesTick;      // Threaded: last tick whose poses are copied
+static volatile u32 worldTick;      // Threaded: last tick the world finished
+
+//=============================================================================
+// GAME STUBS (what the item sources call outside the item world)
+//=============================================================================
+
+RaceState* Race_GetState(void) {
+    return threadRace;
+}
+
+bool Replay_IsPlaying(void) {
+    return false;
+}
+
+bool Replay_Poll(ReplayPoll poll, SchedTaskId task) {
+    (void)poll;
+    (void)task;
+    return true;  // Retarget every tick: no frame budget on the host
+}
+
+bool Replay_IsPlayerConnected(int player) {
+    (void)player;
+    return true;
+}
+
+ItemPlacementData Replay_ReceiveItemPlacement(void) {
+    ItemPlacementData none = {.valid = false};
+    return none;
+}
+
+int Replay_ReceiveItemBoxPickup(void) {
+    return -1;
+}
+
+void Multiplayer_SendItemPlacement(Item itemType, Vec2 position, int angle512,
+                                   Q16_8 speed, int shooterCarIndex) {
+    (void)itemType;
+    (void)position;
+    (void)angle512;
+    (void)speed;
+    (void)shooterCarIndex;
+}
+
+void Multiplayer_SendItemBoxPickup(int boxIndex) {
+    (void)boxIndex;
+}
+
+void PlayBoxSFX(void) {}
+
+SchedTaskId Scheduler_Register(const char* name, SchedTaskFn fn, SchedPriority priority,
+                               int period, int budget) {
+    (void)name;
+    (void)fn;
+    (void)priority;
+    (void)period;
+    (void)budget;
+    return SCHED_NO_TASK;
+}
+
+// Logs what the car side receives (linked with --wrap=ItemLink_Receive)
+int __real_ItemLink_Receive(ItemMsg* out, int max);
+
+int __wrap_ItemLink_Receive(ItemMsg* out, int max) {
+    int count = __real_ItemLink_Receive(out, max);
+    for (int i = 0; i < count; i++) {
+        RunLog* log = activeLog;
+        if (log->msgCount == log->msgCapacity) {
+            log->msgCapacity = log->msgCapacity ? log->msgCapacity * 2 : 1024;
+            log->msgs = realloc(log->msgs, log->msgCapacity * sizeof(LoggedMsg));
+        }
+        log->msgs[log->msgCount++] = (LoggedMsg){carTick, out[i]};
+    }
+    return count;
+}
+
+//=============================================================================
+// HELPERS
+//=============================================================================
+
+static uint64_t NowNs(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+static u32 HashBytes(const void* data, size_t bytes) {
+    const u8* p = (const u8*)data;
+    u32 hash = FNV_OFFSET;
+    for (size_t i = 0; i < bytes; i++) {
+        hash ^= p[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static void AddTime(uint64_t* total, uint64_t* worst, uint64_t ns) {
+    *total += ns;
+    if (ns > *worst)
+        *worst = ns;
+}
+
+//=============================================================================
+// CAR SIDE
+//=============================================================================
+
+static void Cars_Init(void) {
+    SimState_Clear();
+    simState.rngState = SIM_RNG_SEED;
+
+    RaceState* race = &simState.race;
+    race->raceStarted = true;
+    race->gameMode = SinglePlayer;
+    race->currentMap = BENCH_MAP;
+    race->carCount = CAR_COUNT;
+    race->playerIndex = 0;
+    for (int i = 0; i < CAR_COUNT; i++) {
+        carWaypoint[i] = 0;
+        for (int w = 0; w < i * START_SPACING; w++)
+            carWaypoint[i] = ItemNav_GetNextWaypoint(carWaypoint[i], BENCH_MAP);
+
+        Car* car = &race->cars[i];
+        memset(car, 0, sizeof(*car));
+        car->position = ItemNav_GetWaypointPosition(carWaypoint[i], BENCH_MAP);
+        car->maxSpeed = IntToFixed(2) + i * (FIXED_ONE / 8);  // Cars spread out
+        car->accelRate = FIXED_ONE / 16;
+        car->rank = CAR_COUNT - i;
+        car->item = ITEM_NONE;
+    }
+}
+
+// Steers toward the next waypoint; hits (speed 0, spins) change the path
+static void Cars_Drive(Car* car, int index) {
+    Vec2 target = ItemNav_GetWaypointPosition(carWaypoint[index], BENCH_MAP);
+    if (ItemNav_IsWaypointReached(&car->position, &target)) {
+        carWaypoint[index] = ItemNav_GetNextWaypoint(carWaypoint[index], BENCH_MAP);
+        target = ItemNav_GetWaypointPosition(carWaypoint[index], BENCH_MAP);
+    }
+
+    Vec2 toTarget = Vec2_Sub(target, car->position);
+    int turn = ((Vec2_ToAngle(&toTarget) - car->angle512 + ANGLE_HALF) & ANGLE_MASK) -
+               ANGLE_HALF;
+    if (turn > CAR_TURN_STEP)
+        turn = CAR_TURN_STEP;
+    else if (turn < -CAR_TURN_STEP)
+        turn = -CAR_TURN_STEP;
+    car->angle512 = (car->angle512 + turn) & ANGLE_MASK;
+
+    car->speed += car->accelRate;
+    if (car->speed > car->maxSpeed)
+        car->speed = car->maxSpeed;
+    car->position =
+        Vec2_Add(car->position, Vec2_Scale(Vec2_FromAngle(car->angle512), car->speed));
+}
+
+static void Cars_Move(void) {
+    RaceState* race = &simState.race;
+    for (int i = 0; i < race->carCount; i++)
+        Cars_Drive(&race->cars[i], i);
+}
+
+static void Cars_EndTick(RunLog* log, u32 tick) {
+    RaceState* race = &simState.race;
+    Items_UpdatePlayerEffects(&race->cars[race->playerIndex], Items_GetPlayerEffects());
+    log->rngAfterTick[tick] = simState.rngState;
+    log->carsAfterTick[tick] = HashBytes(race->cars, sizeof(race->cars));
+}
+
+//=============================================================================
+// ITEM WORLD
+//=============================================================================
+
+// Item use arrives with the poses: one car every useEvery ticks
+static void World_UseItems(const RaceState* race, u32 tick) {
+    static const Item rotation[] = {ITEM_GREEN_SHELL, ITEM_BANANA, ITEM_RED_SHELL,
+                                    ITEM_OIL, ITEM_GREEN_SHELL, ITEM_BOMB};
+    if (tick % useEvery != 0)
+        return;
+
+    u32 use = tick / useEvery;
+    int carIndex = (int)(use % (u32)race->carCount);
+    const Car* car = &race->cars[carIndex];
+    Item type = rotation[(use / (u32)race->carCount) % (sizeof(rotation) /
+                                                         sizeof(rotation[0]))];
+
+    if (type == ITEM_GREEN_SHELL || type == ITEM_RED_SHELL) {
+        Vec2 ahead = Vec2_Scale(Vec2_FromAngle(car->angle512),
+                                IntToFixed(PROJECTILE_SPAWN_OFFSET));
+        Vec2 spawn = Vec2_Add(car->position, ahead);
+        Q16_8 mult = (type == ITEM_RED_SHELL) ? RED_SHELL_SPEED_MULT
+                                              : GREEN_SHELL_SPEED_MULT;
+        fireProjectileInternal(type, &spawn, car->angle512,
+                               FixedMul(car->maxSpeed, mult), INVALID_CAR_INDEX, false,
+                               carIndex);
+    } else {
+        int back = (car->angle512 + ANGLE_HALF) & ANGLE_MASK;
+        Vec2 behind = Vec2_Scale(Vec2_FromAngle(back), IntToFixed(HAZARD_DROP_OFFSET));
+        Vec2 drop = Vec2_Add(car->position, behind);
+        placeHazardInternal(type, &drop, false);
+    }
+}
+
+static void World_Tick(const RaceState* race, u32 tick) {
+    World_UseItems(race, tick);
+    Items_Update();
+
+    // Collisions are checked around the player's screen, as in Race_Tick
+    const Car* player = &race->cars[race->playerIndex];
+    int scrollX = FixedToInt(player->position.x) + CAR_SPRITE_CENTER_OFFSET -
+                  SCREEN_WIDTH / 2;
+    int scrollY = FixedToInt(player->position.y) + CAR_SPRITE_CENTER_OFFSET -
+                  SCREEN_HEIGHT / 2;
+    Items_CheckCollisions(race->cars, race->carCount, scrollX, scrollY);
+}
+
+//=============================================================================
+// RUNS
+//=============================================================================
+
+static void Run_Begin(RunLog* log, const char* name) {
+    memset(log, 0, sizeof(*log));
+    log->name = name;
+    log->rngAfterTick = calloc(ticks, sizeof(u32));
+    log->carsAfterTick = calloc(ticks, sizeof(u32));
+    activeLog = log;
+    threadRace = &simState.race;
+    Cars_Init();
+    Items_Init(BENCH_MAP);
+}
+
+static void Run_End(RunLog* log, uint64_t startNs) {
+    log->wallNs = NowNs() - startNs;
+    log->finalHash = SimState_Hash(&simState);
+    log->dropped = ItemLink_GetDropped();
+}
+
+static void Run_Loopback(RunLog* log) {
+    Run_Begin(log, "loopback");
+    uint64_t start = NowNs();
+    for (u32 t = 0; t < ticks; t++) {
+        carTick = t;
+        uint64_t t0 = NowNs();
+        Cars_Move();
+        uint64_t t1 = NowNs();
+        World_Tick(&simState.race, t);
+        uint64_t t2 = NowNs();
+        Items_ApplyEvents(simState.race.cars, simState.race.carCount);
+        Cars_EndTick(log, t);
+        uint64_t t3 = NowNs();
+        AddTime(&log->worldNs, &log->worldMaxNs, t2 - t1);
+        AddTime(&log->carNs, &log->carMaxNs, (t1 - t0) + (t3 - t2));
+    }
+    Run_End(log, start);
+}
+
+static void* World_Run(void* arg) {
+    RunLog* log = (RunLog*)arg;
+    threadRace = &worldRace;
+    for (u32 t = 0; t < ticks; t++) {
+        uint64_t waitStart = NowNs();
+        while (__atomic_load_n(&posesTick, __ATOMIC_ACQUIRE) != t + 1)
+            sched_yield();
+        uint64_t start = NowNs();
+        World_Tick(&worldRace, t);
+        uint64_t end = NowNs();
+        __atomic_store_n(&worldTick, t + 1, __ATOMIC_RELEASE);
+        log->worldWaitNs += start - waitStart;
+        AddTime(&log->worldNs, &log->worldMaxNs, end - start);
+    }
+    return NULL;
+}
+
+static void Run_Threaded(RunLog* log) {
+    Run_Begin(log, "threaded");
+    posesTick = 0;
+    worldTick = 0;
+    pthread_t world;
+    uint64_t start = NowNs();
+    pthread_create(&world, NULL, World_Run, log);
+
+    // This thread is the car side
+    for (u32 t = 0; t < ticks; t++) {
+        carTick = t;
+        uint64_t busy = 0, t0 = NowNs();
+        Cars_Move();
+        worldRace = simState.race;  // The poses the world sees this tick
+        __atomic_store_n(&posesTick, t + 1, __ATOMIC_RELEASE);
+        busy += NowNs() - t0;
+
+        // Apply while the world posts; after it finishes, one last drain
+        for (;;) {
+            bool worldDone = __atomic_load_n(&worldTick, __ATOMIC_ACQUIRE) == t + 1;
+            uint64_t applyStart = NowNs();
+            Items_ApplyEvents(simState.race.cars, simState.race.carCount);
+            uint64_t applyEnd = NowNs();
+            busy += applyEnd - applyStart;
+            if (worldDone)
+                break;
+            sched_yield();
+            log->carWaitNs += NowNs() - applyEnd;
+        }
+        uint64_t endStart = NowNs();
+        Cars_EndTick(log, t);
+        busy += NowNs() - endStart;
+        AddTime(&log->carNs, &log->carMaxNs, busy);
+    }
+
+    pthread_join(world, NULL);
+    Run_End(log, start);
+}
+
+//=============================================================================
+// CHECKS
+//=============================================================================
+
+static bool MsgEqual(const LoggedMsg* a, const LoggedMsg* b) {
+    return a->tick == b->tick && a->msg.type == b->msg.type &&
+           a->msg.car == b->msg.car && a->msg.item == b->msg.item &&
+           a->msg.index == b->msg.index && a->msg.dx == b->msg.dx &&
+           a->msg.dy == b->msg.dy;
+}
+
+static void PrintMsg(const char* label, const LoggedMsg* m) {
+    printf("    %s: tick %u %s car %u item %u box %u knockback (%d,%d)\n", label,
+           m->tick, m->msg.type == ITEM_MSG_HIT ? "hit" : "pickup", m->msg.car,
+           m->msg.item, m->msg.index, m->msg.dx, m->msg.dy);
+}
+
+static bool Compare(const RunLog* ref, const RunLog* run) {
+    bool ok = true;
+    u32 common = ref->msgCount < run->msgCount ? ref->msgCount : run->msgCount;
+    for (u32 i = 0; i < common; i++) {
+        if (!MsgEqual(&ref->msgs[i], &run->msgs[i])) {
+            printf("  messages differ at %u:\n", i);
+            PrintMsg(ref->name, &ref->msgs[i]);
+            PrintMsg(run->name, &run->msgs[i]);
+            ok = false;
+            break;
+        }
+    }
+    if (ref->msgCount != run->msgCount) {
+        printf("  message count: %u %s, %u %s\n", ref->msgCount, ref->name,
+               run->msgCount, run->name);
+        ok = false;
+    }
+
+    for (u32 t = 0; t < ticks; t++) {
+        if (ref->rngAfterTick[t] != run->rngAfterTick[t]) {
+            printf("  random generator differs after tick %u\n", t);
+            ok = false;
+            break;
+        }
+    }
+    for (u32 t = 0; t < ticks; t++) {
+        if (ref->carsAfterTick[t] != run->carsAfterTick[t]) {
+            printf("  cars differ after tick %u\n", t);
+            ok = false;
+            break;
+        }
+    }
+    if (ref->finalHash != run->finalHash || ref->dropped != run->dropped) {
+        printf("  final state %08x / %08x, dropped %u / %u\n", ref->finalHash,
+               run->finalHash, ref->dropped, run->dropped);
+        ok = false;
+    }
+    return ok;
+}
+
+static void PrintRun(const RunLog* log) {
+    printf("  %-8s world %6.2f us/tick (max %7.2f)  cars %6.2f us/tick (max %7.2f)"
+           "  wall %7.2f us/tick\n",
+           log->name, log->worldNs / 1e3 / ticks, log->worldMaxNs / 1e3,
+           log->carNs / 1e3 / ticks, log->carMaxNs / 1e3, log->wallNs / 1e3 / ticks);
+    if (log->worldWaitNs || log->carWaitNs)
+        printf("  %-8s world waited %6.2f us/tick for poses, cars waited %6.2f us/tick "
+               "for the world\n",
+               "", log->worldWaitNs / 1e3 / ticks, log->carWaitNs / 1e3 / ticks);
+}
+
+//=============================================================================
+// MAIN
+//=============================================================================
+
+int main(int argc, char** argv) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--ticks") == 0)
+            ticks = (u32)atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--use-every") == 0)
+            useEvery = (u32)atoi(argv[i + 1]);
+    }
+    if (ticks == 0 || useEvery == 0) {
+        fprintf(stderr, "usage: item_link_bench [--ticks n] [--use-every n]\n");
+        return 2;
+    }
+
+    static RunLog loopback, threaded;
+    Run_Loopback(&loopback);
+    Run_Threaded(&threaded);
+
+    u32 hits = 0, pickups = 0;
+    for (u32 i = 0; i < loopback.msgCount; i++) {
+        if (loopback.msgs[i].msg.type == ITEM_MSG_HIT)
+            hits++;
+        else
+            pickups++;
+    }
+    printf("%u ticks, %d cars, an item every %u ticks: %u hits, %u box pickups, "
+           "%u dropped on the link\n",
+           ticks, CAR_COUNT, useEvery, hits, pickups, loopback.dropped);
+    PrintRun(&loopback);
+    PrintRun(&threaded);
+
+    bool ok = Compare(&loopback, &threaded);
+    printf("threaded run: %s\n",
+           ok ? "same messages, order, random state and final state as loopback"
+              : "MISMATCH");
+    return ok ? 0 : 1;
+}
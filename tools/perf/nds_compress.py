@@ -0,0 +1,370 @@
+#!/usr/bin/env python3
+"""
+Host-side codec and benchmark for the Nintendo DS BIOS compression formats.
+
+Formats (same stream layout the BIOS and grit -gzl/-gzr produce):
+  - LZ77 (type 0x10): flag byte + 8 tokens, back-references of 3..18 bytes at
+    distance 1..4096. The VRAM-safe variant never uses distance 1, because
+    swiDecompressLZSSVram writes 16 bits at a time.
+  - RLE  (type 0x30): runs of 3..130 equal bytes or 1..128 literals.
+
+Subcommands:
+  encode  <in> <out> [--rle] [--wram]   compress a raw file
+  decode  <in> <out>                    decompress (auto-detects the type)
+  bench   [assets...]                   ratio + host decode throughput per asset
+
+`bench` with no arguments converts every data/**/<name>.png that has a .grit
+file to the raw layout grit would emit (bitmap or 8x8 tiles at 4/8 bpp, plus
+the tile map for -m assets), then reports sizes for raw, LZ77 (VRAM-safe) and
+RLE, the decoded/encoded check, and decode throughput of this reference
+decoder. Throughput is a host figure for comparing assets against each other;
+on hardware the BIOS routine is what runs.
+
+Usage:
+  cd tools/perf
+  python nds_compress.py bench
+  python nds_compress.py bench ../../data/ui/home_top.png --csv bench.csv
+  python nds_compress.py encode tiles.bin tiles.lz
+"""
+
+import argparse
+import csv
+import glob
+import os
+import sys
+import time
+
+REPO_ROOT = os.path.normpath(os.path.join(os.path.dirname(__file__), "..", ".."))
+
+LZ77_TYPE = 0x10
+RLE_TYPE = 0x30
+LZ_MIN, LZ_MAX = 3, 18
+LZ_WINDOW = 4096
+RLE_MIN_RUN, RLE_MAX_RUN = 3, 130
+RLE_MAX_LITERAL = 128
+
+
+# -----------------------------------------------------------------------------
+# Codec
+# -----------------------------------------------------------------------------
+def _header(kind, size):
+    if size >= 1 << 24:
+        raise ValueError("BIOS streams are limited to 16 MB")
+    return bytes([kind, size & 0xFF, (size >> 8) & 0xFF, (size >> 16) & 0xFF])
+
+
+def _pad4(out):
+    while len(out) % 4:
+        out.append(0)
+    return bytes(out)
+
+
+def lz77_encode(data, vram_safe=True):
+    """Greedy LZ77 with hash chains over 3-byte prefixes."""
+    min_disp = 2 if vram_safe else 1
+    out = bytearray(_header(LZ77_TYPE, len(data)))
+    chains = {}
+    pos, n = 0, len(data)
+
+    while pos < n:
+        flag_at = len(out)
+        out.append(0)
+        for bit in range(8):
+            if pos >= n:
+                break
+            best_len, best_disp = 0, 0
+            if pos + LZ_MIN <= n:
+                key = data[pos:pos + LZ_MIN]
+                for cand in reversed(chains.get(key, ())):
+                    disp = pos - cand
+                    if disp > LZ_WINDOW:
+                        break
+                    if disp < min_disp:
+                        continue
+                    length = 0
+                    limit = min(LZ_MAX, n - pos)
+                    while length < limit and data[cand + length] == data[pos + length]:
+                        length += 1
+                    if length > best_len:
+                        best_len, best_disp = length, disp
+                        if length == LZ_MAX:
+                            break
+
+            step = best_len if best_len >= LZ_MIN else 1
+            if best_len >= LZ_MIN:
+                out[flag_at] |= 0x80 >> bit
+                d = best_disp - 1
+                out.append(((best_len - LZ_MIN) << 4) | (d >> 8))
+                out.append(d & 0xFF)
+            else:
+                out.append(data[pos])
+
+            for p in range(pos, pos + step):
+                if p + LZ_MIN <= n:
+                    chain = chains.setdefault(data[p:p + LZ_MIN], [])
+                    chain.append(p)
+                    if len(chain) > 64:
+                        del chain[:32]
+            pos += step
+    return _pad4(out)
+
+
+def rle_encode(data):
+    out = bytearray(_header(RLE_TYPE, len(data)))
+    literals = bytearray()
+    pos, n = 0, len(data)
+
+    def flush():
+        while literals:
+            chunk = literals[:RLE_MAX_LITERAL]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+            del literals[:RLE_MAX_LITERAL]
+
+    while pos < n:
+        run = 1
+        while pos + run < n and run < RLE_MAX_RUN and data[pos + run] == data[pos]:
+            run += 1
+        if run >= RLE_MIN_RUN:
+            flush()
+            out.append(0x80 | (run - RLE_MIN_RUN))
+            out.append(data[pos])
+            pos += run
+        else:
+            literals.append(data[pos])
+            pos += 1
+    flush()
+    return _pad4(out)
+
+
+def decode(stream):
+    kind = stream[0] & 0xF0
+    size = stream[1] | (stream[2] << 8) | (stream[3] << 16)
+    out = bytearray()
+    pos = 4
+
+    if kind == LZ77_TYPE:
+        while len(out) < size:
+            flags = stream[pos]
+            pos += 1
+            for bit in range(8):
+                if len(out) >= size:
+                    break
+                if flags & (0x80 >> bit):
+                    b0, b1 = stream[pos], stream[pos + 1]
+                    pos += 2
+                    length = (b0 >> 4) + LZ_MIN
+                    start = len(out) - (((b0 & 0x0F) << 8) | b1) - 1
+                    for i in range(length):
+                        out.append(out[start + i])
+                else:
+                    out.append(stream[pos])
+                    pos += 1
+    elif kind == RLE_TYPE:
+        while len(out) < size:
+            flag = stream[pos]
+            pos += 1
+            if flag & 0x80:
+                out.extend(bytes([stream[pos]]) * ((flag & 0x7F) + RLE_MIN_RUN))
+                pos += 1
+            else:
+                count = (flag & 0x7F) + 1
+                out.extend(stream[pos:pos + count])
+                pos += count
+    else:
+        raise ValueError(f"unsupported stream type 0x{stream[0]:02X}")
+    return bytes(out[:size])
+
+
+def vram_safe(stream):
+    """True if an LZ77 stream never references distance 1."""
+    if stream[0] & 0xF0 != LZ77_TYPE:
+        return True
+    size = stream[1] | (stream[2] << 8) | (stream[3] << 16)
+    produced, pos = 0, 4
+    while produced < size:
+        flags = stream[pos]
+        pos += 1
+        for bit in range(8):
+            if produced >= size:
+                break
+            if flags & (0x80 >> bit):
+                b0, b1 = stream[pos], stream[pos + 1]
+                if (((b0 & 0x0F) << 8) | b1) == 0:
+                    return False
+                produced += (b0 >> 4) + LZ_MIN
+                pos += 2
+            else:
+                produced += 1
+                pos += 1
+    return True
+
+
+# -----------------------------------------------------------------------------
+# Asset conversion (grit-equivalent raw layouts, for benchmarking)
+# -----------------------------------------------------------------------------
+def read_grit_flags(png):
+    flags = set()
+    grit = os.path.splitext(png)[0] + ".grit"
+    if os.path.exists(grit):
+        with open(grit) as f:
+            flags = set(f.read().split())
+    return flags
+
+
+def png_to_raw(png):
+    """Returns [(label, bytes)] with the graphics (and map) grit would emit."""
+    from PIL import Image
+
+    flags = read_grit_flags(png)
+    img = Image.open(png)
+    if img.mode != "P":
+        img = img.convert("P", palette=Image.Palette.ADAPTIVE, colors=256)
+    w, h = img.size
+    px = img.load()
+    bpp = 4 if "-gB4" in flags else 8
+
+    if "-gb" in flags:
+        return [("bitmap", bytes(px[x, y] for y in range(h) for x in range(w)))]
+
+    tiles, tile_ids, entries = [], {}, []
+    for ty in range(0, h - h % 8, 8):
+        for tx in range(0, w - w % 8, 8):
+            rows = tuple(tuple(px[tx + x, ty + y] for x in range(8)) for y in range(8))
+            key, entry_flags = rows, 0
+            if "-m" in flags:
+                hrows = tuple(r[::-1] for r in rows)
+                for variant, fl in ((rows, 0), (hrows, 0x400), (rows[::-1], 0x800),
+                                    (hrows[::-1], 0xC00)):
+                    if variant in tile_ids:
+                        key, entry_flags = variant, fl
+                        break
+            if "-m" not in flags or key not in tile_ids:
+                tile_ids[key] = len(tiles)
+                tiles.append(key)
+            entries.append(tile_ids[key] | entry_flags)
+
+    gfx = bytearray()
+    for tile in tiles:
+        for row in tile:
+            if bpp == 8:
+                gfx.extend(row)
+            else:
+                gfx.extend((row[i] & 0xF) | ((row[i + 1] & 0xF) << 4) for i in range(0, 8, 2))
+    out = [("tiles", bytes(gfx))]
+    if "-m" in flags:
+        out.append(("map", b"".join(e.to_bytes(2, "little") for e in entries)))
+    return out
+
+
+def default_assets():
+    pngs = []
+    for png in sorted(glob.glob(os.path.join(REPO_ROOT, "data", "**", "*.png"), recursive=True)):
+        if os.path.exists(os.path.splitext(png)[0] + ".grit"):
+            pngs.append(png)
+    return pngs
+
+
+# -----------------------------------------------------------------------------
+# Benchmark
+# -----------------------------------------------------------------------------
+def time_decode(stream, min_seconds=0.05):
+    runs, start = 0, time.perf_counter()
+    while True:
+        decode(stream)
+        runs += 1
+        elapsed = time.perf_counter() - start
+        if elapsed >= min_seconds:
+            return elapsed / runs
+
+
+def bench(paths, csv_path):
+    rows = []
+    for path in paths:
+        if path.lower().endswith(".png"):
+            parts = png_to_raw(path)
+        else:
+            with open(path, "rb") as f:
+                parts = [("raw", f.read())]
+        name = os.path.relpath(path, REPO_ROOT)
+        for label, raw in parts:
+            if not raw:
+                continue
+            lz = lz77_encode(raw)
+            rle = rle_encode(raw)
+            assert decode(lz) == raw and decode(rle) == raw, f"round trip failed: {name}"
+            assert vram_safe(lz)
+            t_lz = time_decode(lz)
+            t_rle = time_decode(rle)
+            rows.append({
+                "asset": name, "part": label, "raw": len(raw),
+                "lz77": len(lz), "lz77_ratio": len(raw) / len(lz),
+                "lz77_MBps": len(raw) / t_lz / 1e6,
+                "rle": len(rle), "rle_ratio": len(raw) / len(rle),
+                "rle_MBps": len(raw) / t_rle / 1e6,
+            })
+
+    header = f"{'asset':44} {'part':6} {'raw':>7} {'lz77':>7} {'x':>5} {'MB/s':>6} {'rle':>7} {'x':>5} {'MB/s':>6}"
+    print(header)
+    print("-" * len(header))
+    for r in rows:
+        print(f"{r['asset'][:44]:44} {r['part']:6} {r['raw']:7d} {r['lz77']:7d} "
+              f"{r['lz77_ratio']:5.1f} {r['lz77_MBps']:6.2f} {r['rle']:7d} "
+              f"{r['rle_ratio']:5.1f} {r['rle_MBps']:6.2f}")
+    total_raw = sum(r["raw"] for r in rows)
+    total_lz = sum(r["lz77"] for r in rows)
+    total_rle = sum(r["rle"] for r in rows)
+    print("-" * len(header))
+    if rows:
+        print(f"{'total':51} {total_raw:7d} {total_lz:7d} {total_raw / total_lz:5.1f} "
+              f"{'':6} {total_rle:7d} {total_raw / total_rle:5.1f}")
+
+    if csv_path:
+        with open(csv_path, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=list(rows[0].keys()) if rows else ["asset"])
+            writer.writeheader()
+            writer.writerows(rows)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    enc = sub.add_parser("encode", help="compress a raw file")
+    enc.add_argument("input")
+    enc.add_argument("output")
+    enc.add_argument("--rle", action="store_true", help="RLE instead of LZ77")
+    enc.add_argument("--wram", action="store_true",
+                     help="allow distance-1 matches (not safe for VRAM destinations)")
+
+    dec = sub.add_parser("decode", help="decompress a BIOS stream")
+    dec.add_argument("input")
+    dec.add_argument("output")
+
+    ben = sub.add_parser("bench", help="compression ratio and decode throughput")
+    ben.add_argument("assets", nargs="*", help="PNG (with .grit) or raw files")
+    ben.add_argument("--csv", help="write results to CSV")
+
+    args = parser.parse_args()
+    if args.cmd == "encode":
+        with open(args.input, "rb") as f:
+            data = f.read()
+        stream = rle_encode(data) if args.rle else lz77_encode(data, vram_safe=not args.wram)
+        with open(args.output, "wb") as f:
+            f.write(stream)
+        print(f"{len(data)} -> {len(stream)} bytes ({len(data) / max(1, len(stream)):.2f}x)")
+    elif args.cmd == "decode":
+        with open(args.input, "rb") as f:
+            data = decode(f.read())
+        with open(args.output, "wb") as f:
+            f.write(data)
+    else:
+        paths = args.assets or default_assets()
+        if not paths:
+            sys.exit("no assets found")
+        bench(paths, args.csv)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,610 @@
+/**
+ * File: replay_tool.c
+ * -------------------
+ * Description: Headless host tool for race replays (source/gameplay/replay_format.h).
+ *              Prints a replay's layout, plays its timeline at 1x/4x/16x,
+ *              seeks the way the game does (index lookup, keyframe unpack,
+ *              records up to the target) and benchmarks index lookups and
+ *              decoding. `synth` writes a synthetic replay so the tool and
+ *              the format can be exercised without a DS.
+ *
+ * The race simulation needs libnds, so the host does not re-simulate: `play`
+ * and `seek` walk the recorded inputs and events and unpack the keyframes,
+ * which is the file-side work of a seek on the DS.
+ *
+ * Build (from the repository root):
+ *   gcc -O2 -Isource -o replay_tool tools/perf/replay_tool.c \
+ *       source/gameplay/replay_format.c
+ *
+ * Usage:
+ *   replay_tool info  last.kmr
+ *   replay_tool play  last.kmr [--speed 1|4|16] [--headless]
+ *   replay_tool seek  last.kmr <seconds>
+ *   replay_tool bench last.kmr [--seconds n]
+ *   replay_tool synth out.kmr  [--seconds n] [--state-bytes n] [--keyframe-ticks n]
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "gameplay/replay_format.h"
+
+//=============================================================================
+// CONSTANTS
+//=============================================================================
+#define TICK_FREQ 60  // RACE_TICK_FREQ
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+// keysHeld() bit names, bit 0 first
+static const char KeyNames[] = "ABsSRLUDrlXYTZ";
+
+//=============================================================================
+// TYPES
+//=============================================================================
+typedef struct {
+    u8* data;
+    long size;
+    ReplayHeader header;
+    const ReplayIndexEntry* index;
+    int keyframes;
+    u8* base;   // Keyframe 0, unpacked
+    u8* state;  // Scratch state
+} Replay;
+
+typedef struct {
+    u32 ticks;
+    u32 runs;
+    u32 inputs;
+    u32 events[8];  // By ReplayEvent
+    u32 keyframes;
+    u32 keyframeBytes;
+    u32 recordBytes;
+} Totals;
+
+//=============================================================================
+// HELPERS
+//=============================================================================
+
+static double Now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static u32 Hash(const u8* bytes, u32 size) {
+    u32 hash = FNV_OFFSET_BASIS;
+    for (u32 i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static void FormatInput(u16 input, char* out) {
+    int n = 0;
+    for (int bit = 0; bit < 14; bit++) {
+        if (input & (1u << bit))
+            out[n++] = KeyNames[bit];
+    }
+    if (n == 0)
+        out[n++] = '-';
+    out[n] = '\0';
+}
+
+static void FormatTime(u32 tick, char* out) {
+    u32 ms = tick * 1000u / TICK_FREQ;
+    sprintf(out, "%u:%02u.%03u", ms / 60000, ms / 1000 % 60, ms % 1000);
+}
+
+//=============================================================================
+// LOADING
+//=============================================================================
+
+static int Replay_Load(const char* path, Replay* replay) {
+    memset(replay, 0, sizeof(*replay));
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        perror(path);
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    replay->size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    replay->data = malloc(replay->size > 0 ? replay->size : 1);
+    size_t got = fread(replay->data, 1, replay->size, file);
+    fclose(file);
+
+    ReplayHeader* h = &replay->header;
+    if ((long)got != replay->size || replay->size < 2 * (long)sizeof(*h)) {
+        fprintf(stderr, "%s: truncated\n", path);
+        return 0;
+    }
+    memcpy(h, replay->data, sizeof(*h));
+    if (h->magic != REPLAY_MAGIC || h->version != REPLAY_VERSION ||
+        h->headerSize != sizeof(*h)) {
+        fprintf(stderr, "%s: not a version %d replay\n", path, REPLAY_VERSION);
+        return 0;
+    }
+
+    // The final header is the end of the file, right after the index
+    long trailer = replay->size - (long)sizeof(*h);
+    memcpy(h, replay->data + trailer, sizeof(*h));
+    uint64_t indexEnd =
+        h->indexOffset + (uint64_t)h->keyframes * sizeof(ReplayIndexEntry);
+    if (memcmp(h, replay->data, offsetof(ReplayHeader, ticks)) != 0 ||
+        h->indexOffset < sizeof(*h) || h->keyframes == 0 ||
+        indexEnd != (uint64_t)trailer) {
+        fprintf(stderr, "%s: not finalized (no index)\n", path);
+        return 0;
+    }
+    replay->index = (const ReplayIndexEntry*)(replay->data + h->indexOffset);
+    replay->keyframes = (int)h->keyframes;
+    replay->base = calloc(1, h->stateSize);
+    replay->state = calloc(1, h->stateSize);
+    return 1;
+}
+
+// Unpacks the keyframe of index entry `k` into `out`
+static int Replay_Keyframe(Replay* replay, int k, ReplayKeyframe* kf, u8* out,
+                           ReplayCoder* coder, long* next) {
+    ReplayRecord rec;
+    long at = replay->index[k].offset;
+    int used = ReplayFormat_Next(coder, replay->data + at, (int)(replay->size - at), true,
+                                 &rec);
+    if (used <= 0 || rec.type != REPLAY_REC_KEYFRAME)
+        return 0;
+    *kf = rec.keyframe;
+    const u8* packed = replay->data + at + used;
+    const u8* base = (k == 0) ? NULL : replay->base;
+    if (!ReplayFormat_UnpackState(packed, (int)kf->bytes, base,
+                                  (int)replay->header.stateSize, out))
+        return 0;
+    *next = at + used + kf->bytes;
+    return Hash(out, replay->header.stateSize) == kf->hash;
+}
+
+static int Replay_LoadBase(Replay* replay) {
+    ReplayKeyframe kf;
+    ReplayCoder coder;
+    long next;
+    ReplayFormat_Reset(&coder, 0, 0);
+    if (!Replay_Keyframe(replay, 0, &kf, replay->base, &coder, &next)) {
+        fprintf(stderr, "keyframe 0 is damaged\n");
+        return 0;
+    }
+    return 1;
+}
+
+// Walks every record; calls `onTick` per tick when given
+typedef void (*TickFn)(const ReplayRecord* rec, u32 tick, void* user);
+
+static int Replay_Walk(const Replay* replay, Totals* totals, TickFn onTick, void* user) {
+    ReplayCoder coder;
+    ReplayRecord rec;
+    ReplayFormat_Reset(&coder, 0, 0);
+    long at = replay->header.headerSize;
+    memset(totals, 0, sizeof(*totals));
+
+    while (at < (long)replay->header.indexOffset) {
+        int used = ReplayFormat_Next(&coder, replay->data + at,
+                                     (int)(replay->header.indexOffset - at), true, &rec);
+        if (used < 0) {
+            fprintf(stderr, "bad record at offset %ld\n", at);
+            return 0;
+        }
+        if (rec.type == REPLAY_REC_END)
+            return 1;
+        if (rec.type == REPLAY_REC_KEYFRAME) {
+            totals->keyframes++;
+            totals->keyframeBytes += used + rec.keyframe.bytes;
+            at += used + rec.keyframe.bytes;
+            continue;
+        }
+
+        totals->ticks++;
+        totals->recordBytes += used;
+        if (used == 0 || replay->data[at] < REPLAY_MAX_RUN)
+            totals->runs += (used > 0);
+        else
+            totals->inputs++;
+        for (int i = 1; i < rec.count; i++) {
+            u32 type = SPSC_EVENT_TYPE(rec.words[i]);
+            if (type < 8 && type != REPLAY_EV_TICK)
+                totals->events[type]++;
+        }
+        if (onTick)
+            onTick(&rec, coder.tick, user);
+        at += used;
+    }
+    fprintf(stderr, "records run into the index\n");
+    return 0;
+}
+
+//=============================================================================
+// COMMANDS
+//=============================================================================
+
+static int Cmd_Info(Replay* replay) {
+    const ReplayHeader* h = &replay->header;
+    Totals t;
+    if (!Replay_Walk(replay, &t, NULL, NULL))
+        return 1;
+
+    char length[32];
+    FormatTime(h->ticks, length);
+    printf("map %u, mode %u, %u ticks (%s), state %u bytes\n", h->map, h->mode, h->ticks,
+           length, h->stateSize);
+    printf("file %ld bytes: headers 2x%u, inputs+events %u, keyframes %u, index %zu\n",
+           replay->size, h->headerSize, t.recordBytes, t.keyframeBytes,
+           h->keyframes * sizeof(ReplayIndexEntry));
+    printf("keyframes %u every %u ticks, average %u bytes\n", h->keyframes,
+           h->keyframeTicks, t.keyframes ? t.keyframeBytes / t.keyframes : 0);
+    printf("ticks %u: %u run records, %u input changes, %.2f bytes/tick\n", t.ticks,
+           t.runs, t.inputs, t.ticks ? (double)t.recordBytes / t.ticks : 0.0);
+    printf("events: now_ms %u, car %u, item %u, box %u, connected %u\n",
+           t.events[REPLAY_EV_NOW_MS], t.events[REPLAY_EV_CAR], t.events[REPLAY_EV_ITEM],
+           t.events[REPLAY_EV_BOX], t.events[REPLAY_EV_CONNECTED]);
+    if (t.ticks != h->ticks)
+        printf("warning: header says %u ticks, records hold %u\n", h->ticks, t.ticks);
+    return 0;
+}
+
+typedef struct {
+    int speed;
+    int headless;
+    double start;
+    u16 input;
+    u32 events;
+} PlayState;
+
+static void Play_Tick(const ReplayRecord* rec, u32 tick, void* user) {
+    PlayState* play = user;
+    char time[32];
+    FormatTime(tick, time);
+
+    u16 input = (u16)REPLAY_TICK_INPUT(rec->words[0]);
+    if (input != play->input) {
+        char keys[16];
+        FormatInput(input, keys);
+        bool retarget = input & REPLAY_INPUT_POLL(REPLAY_POLL_RETARGET);
+        bool netSync = input & REPLAY_INPUT_POLL(REPLAY_POLL_NET_SYNC);
+        printf("%s  input %s%s%s\n", time, keys, retarget ? "" : " (retarget shed)",
+               netSync ? " +net" : "");
+        play->input = input;
+    }
+    for (int i = 1; i < rec->count; i++) {
+        u32 type = SPSC_EVENT_TYPE(rec->words[i]);
+        u32 payload = SPSC_EVENT_PAYLOAD(rec->words[i]);
+        play->events++;
+        switch (type) {
+            case REPLAY_EV_NOW_MS:
+                printf("%s  line crossed, chrono %u ms\n", time, rec->words[i + 1]);
+                i += 1;
+                break;
+            case REPLAY_EV_CAR:
+                printf("%s  car %u at (%d, %d)\n", time, payload,
+                       (s32)rec->words[i + 1] >> 8, (s32)rec->words[i + 2] >> 8);
+                i += 6;
+                break;
+            case REPLAY_EV_ITEM:
+                printf("%s  item %u placed by player %u\n", time, payload & 0xFF,
+                       payload >> 16);
+                i += 4;
+                break;
+            case REPLAY_EV_BOX:
+                printf("%s  box %u picked up\n", time, payload);
+                break;
+            case REPLAY_EV_CONNECTED:
+                printf("%s  connected players %02x\n", time, payload);
+                break;
+        }
+    }
+
+    if (!play->headless) {
+        // Hold the wall clock to the race clock at the chosen speed
+        double due = play->start + (double)tick / (TICK_FREQ * play->speed);
+        double wait = due - Now();
+        if (wait > 0) {
+            struct timespec ts = {(time_t)wait, (long)((wait - (time_t)wait) * 1e9)};
+            nanosleep(&ts, NULL);
+        }
+    }
+}
+
+static int Cmd_Play(Replay* replay, int speed, int headless) {
+    PlayState play = {speed, headless, Now(), 0xFFFF, 0};
+    Totals t;
+    if (!Replay_Walk(replay, &t, Play_Tick, &play))
+        return 1;
+    double took = Now() - play.start;
+    char length[32];
+    FormatTime(t.ticks, length);
+    printf("played %s at %dx in %.3f s, %u events\n", length, speed, took, play.events);
+    return 0;
+}
+
+// Seek: index lookup, keyframe unpack, records up to the target tick
+static int Replay_Seek(Replay* replay, u32 target, u32* from, u32* decoded) {
+    int k = ReplayFormat_FindKeyframe(replay->index, replay->keyframes, target);
+    if (k < 0)
+        return 0;
+    ReplayKeyframe kf;
+    ReplayCoder coder;
+    long at;
+    ReplayFormat_Reset(&coder, 0, 0);
+    if (!Replay_Keyframe(replay, k, &kf, replay->state, &coder, &at))
+        return 0;
+    *from = kf.tick;
+
+    ReplayRecord rec;
+    while (coder.tick < target) {
+        int used = ReplayFormat_Next(&coder, replay->data + at,
+                                     (int)(replay->header.indexOffset - at), true, &rec);
+        if (used < 0 || rec.type == REPLAY_REC_END)
+            break;
+        at += used;
+        if (rec.type == REPLAY_REC_KEYFRAME)
+            at += rec.keyframe.bytes;
+    }
+    *decoded = coder.tick - kf.tick;
+    return 1;
+}
+
+static int Cmd_Seek(Replay* replay, double seconds) {
+    u32 target = (u32)(seconds * TICK_FREQ);
+    if (target > replay->header.ticks)
+        target = replay->header.ticks;
+    u32 from, decoded;
+    double start = Now();
+    if (!Replay_Seek(replay, target, &from, &decoded)) {
+        fprintf(stderr, "seek failed\n");
+        return 1;
+    }
+    double took = Now() - start;
+    char at[32], kf[32];
+    FormatTime(target, at);
+    FormatTime(from, kf);
+    printf("seek %s: keyframe at %s (hash ok), %u ticks to re-simulate, %.1f us\n", at,
+           kf, decoded, took * 1e6);
+    return 0;
+}
+
+static int Cmd_Bench(Replay* replay, double seconds) {
+    const ReplayHeader* h = &replay->header;
+    Totals t;
+    srand(1);
+
+    // Index lookups
+    long lookups = 0;
+    double start = Now();
+    volatile int sink = 0;
+    while (Now() - start < seconds) {
+        for (int i = 0; i < 100000; i++)
+            sink += ReplayFormat_FindKeyframe(replay->index, replay->keyframes,
+                                              (u32)rand() % (h->ticks + 1));
+        lookups += 100000;
+    }
+    double lookupNs = (Now() - start) * 1e9 / lookups;
+
+    // Whole stream
+    long walks = 0;
+    start = Now();
+    while (Now() - start < seconds || walks == 0) {
+        if (!Replay_Walk(replay, &t, NULL, NULL))
+            return 1;
+        walks++;
+    }
+    double walk = (Now() - start) / walks;
+    double streamBytes = t.recordBytes + t.keyframeBytes;
+
+    // Keyframe unpacks
+    long unpacks = 0;
+    start = Now();
+    while (Now() - start < seconds || unpacks == 0) {
+        ReplayKeyframe kf;
+        ReplayCoder coder;
+        long next;
+        ReplayFormat_Reset(&coder, 0, 0);
+        int k = (int)(unpacks % replay->keyframes);
+        if (!Replay_Keyframe(replay, k, &kf, replay->state, &coder, &next))
+            return 1;
+        unpacks++;
+    }
+    double unpackUs = (Now() - start) * 1e6 / unpacks;
+
+    // Random seeks
+    long seeks = 0;
+    uint64_t decodedTotal = 0;
+    start = Now();
+    while (Now() - start < seconds || seeks == 0) {
+        u32 from, decoded;
+        if (!Replay_Seek(replay, (u32)rand() % (h->ticks + 1), &from, &decoded))
+            return 1;
+        decodedTotal += decoded;
+        seeks++;
+    }
+    double seekUs = (Now() - start) * 1e6 / seeks;
+
+    printf("index lookup   %8.1f ns   (%d keyframes)\n", lookupNs, replay->keyframes);
+    printf("stream decode  %8.1f MB/s %.1f Mticks/s (%u ticks, %.0f bytes)\n",
+           streamBytes / walk / 1e6, t.ticks / walk / 1e6, t.ticks, streamBytes);
+    printf("keyframe unpack%8.1f us   (%u bytes state, %u packed avg)\n", unpackUs,
+           h->stateSize, t.keyframes ? t.keyframeBytes / t.keyframes : 0);
+    printf("random seek    %8.1f us   (%.0f ticks decoded avg, re-simulated on the DS)\n",
+           seekUs, (double)decodedTotal / seeks);
+    return sink == -1;
+}
+
+//=============================================================================
+// SYNTHETIC REPLAY
+//=============================================================================
+
+static u32 rngState = 0x4B4D5241u;
+static u32 Random(void) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+// Stands in for a race tick: karts move, items come and go, the RNG rolls
+static void Synth_Step(u8* state, u32 size, u32 tick) {
+    memcpy(state, &tick, sizeof(tick));
+    memcpy(state + 4, &rngState, sizeof(rngState));
+    for (u32 car = 0; car < 8 && 64 + car * 64 + 16 <= size; car++) {
+        u8* c = state + 64 + car * 64;
+        c[0] += 3;                 // x
+        c[4] += (tick % 3) == 0;   // y
+        c[8] = (u8)(tick >> 2);    // speed
+        c[12] = (u8)(Random() & 1);
+    }
+    u32 slot = 1024 + (Random() % 32) * 24;
+    if (slot + 24 <= size && (Random() % 90) == 0)
+        state[slot] ^= 1;  // Item appears or disappears
+}
+
+static int Cmd_Synth(const char* path, double seconds, u32 stateSize, u32 keyframeTicks) {
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        perror(path);
+        return 1;
+    }
+    u32 ticks = (u32)(seconds * TICK_FREQ);
+    u8* base = calloc(1, stateSize);
+    u8* state = calloc(1, stateSize);
+    u8* out = malloc(REPLAY_PACK_BOUND(stateSize) + REPLAY_MAX_KEYFRAME_HEADER +
+                     REPLAY_MAX_TICK_BYTES);
+    u32 maxKeyframes = ticks / keyframeTicks + 2;
+    ReplayIndexEntry* index = calloc(maxKeyframes, sizeof(*index));
+
+    ReplayHeader h = {REPLAY_MAGIC, REPLAY_VERSION, sizeof(ReplayHeader), stateSize, 1, 0,
+                      (u16)keyframeTicks, 0, 0, 0, 0};
+    fwrite(&h, sizeof(h), 1, file);
+
+    ReplayCoder coder;
+    u16 input = REPLAY_INPUT_POLL(REPLAY_POLL_RETARGET) | 1;  // A held
+    u32 nextInput = 40;
+    u32 keyframes = 0;
+    for (u32 tick = 0; tick <= ticks; tick++) {
+        if (tick > 0) {
+            Synth_Step(state, stateSize, tick);
+            if (tick == nextInput) {
+                input ^= (u16)(1u << (4 + Random() % 2));  // Steering
+                if (Random() % 8 == 0)
+                    input ^= 1u << 9;  // L: item
+                nextInput += 10 + Random() % 50;
+            }
+            u32 words[4];
+            int count = 1;
+            if (tick % (45 * TICK_FREQ) == 0) {
+                words[count++] = SPSC_EVENT(REPLAY_EV_NOW_MS, 0);
+                words[count++] = tick * 1000 / TICK_FREQ + 3;
+            }
+            if (Random() % 600 == 0)
+                words[count++] = SPSC_EVENT(REPLAY_EV_BOX, Random() % 16);
+            words[0] = REPLAY_TICK_WORD(input, count - 1);
+            fwrite(out, 1, ReplayFormat_EncodeTick(&coder, words, count, out), file);
+        }
+
+        if (tick % keyframeTicks == 0) {
+            int n = (tick == 0) ? 0 : ReplayFormat_EndRun(&coder, out);
+            fwrite(out, 1, n, file);
+            index[keyframes].tick = tick;
+            index[keyframes].offset = (u32)ftell(file);
+            keyframes++;
+
+            u16 kfInput = (tick == 0) ? 0 : input;
+            ReplayKeyframe kf = {tick, kfInput, 1, Hash(state, stateSize), 0};
+            u8* packed = out + REPLAY_MAX_KEYFRAME_HEADER;
+            const u8* against = (tick == 0) ? NULL : base;
+            kf.bytes = ReplayFormat_PackState(state, against, stateSize, packed);
+            if (tick == 0)
+                memcpy(base, state, stateSize);
+            fwrite(out, 1, ReplayFormat_PutKeyframe(&coder, &kf, out), file);
+            fwrite(packed, 1, kf.bytes, file);
+        }
+    }
+    int n = ReplayFormat_EndRun(&coder, out);
+    out[n++] = REPLAY_TAG_END;
+    fwrite(out, 1, n, file);
+
+    h.ticks = ticks;
+    h.keyframes = keyframes;
+    h.indexOffset = (u32)ftell(file);
+    fwrite(index, sizeof(*index), keyframes, file);
+    fwrite(&h, sizeof(h), 1, file);  // Final header, appended like the DS does
+    fclose(file);
+    printf("wrote %s: %u ticks, %u keyframes\n", path, ticks, keyframes);
+    return 0;
+}
+
+//=============================================================================
+// MAIN
+//=============================================================================
+
+static double OptionValue(int argc, char** argv, const char* name, double fallback) {
+    for (int i = 3; i + 1 < argc; i++) {
+        if (strcmp(argv[i], name) == 0)
+            return atof(argv[i + 1]);
+    }
+    return fallback;
+}
+
+static int HasOption(int argc, char** argv, const char* name) {
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], name) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr,
+                "usage: %s info|play|seek|bench|synth <file.kmr> [options]\n"
+                "  play  [--speed 1|4|16] [--headless]\n"
+                "  seek  <seconds>\n"
+                "  bench [--seconds n]\n"
+                "  synth [--seconds n] [--state-bytes n] [--keyframe-ticks n]\n",
+                argv[0]);
+        return 2;
+    }
+    const char* cmd = argv[1];
+    const char* path = argv[2];
+
+    if (strcmp(cmd, "synth") == 0)
+        return Cmd_Synth(path, OptionValue(argc, argv, "--seconds", 180),
+                         (u32)OptionValue(argc, argv, "--state-bytes", 4096),
+                         (u32)OptionValue(argc, argv, "--keyframe-ticks", 120));
+
+    Replay replay;
+    if (!Replay_Load(path, &replay) || !Replay_LoadBase(&replay))
+        return 1;
+
+    if (strcmp(cmd, "info") == 0)
+        return Cmd_Info(&replay);
+    if (strcmp(cmd, "play") == 0) {
+        int speed = (int)OptionValue(argc, argv, "--speed", 1);
+        if (speed != 1 && speed != 4 && speed != 16) {
+            fprintf(stderr, "speed must be 1, 4 or 16\n");
+            return 2;
+        }
+        return Cmd_Play(&replay, speed, HasOption(argc, argv, "--headless"));
+    }
+    if (strcmp(cmd, "seek") == 0 && argc >= 4)
+        return Cmd_Seek(&replay, atof(argv[3]));
+    if (strcmp(cmd, "bench") == 0)
+        return Cmd_Bench(&replay, OptionValue(argc, argv, "--seconds", 0.5));
+
+    fprintf(stderr, "unknown command %s\n", cmd);
+    return 2;
+}
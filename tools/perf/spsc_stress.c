@@ -0,0 +1,308 @@
+/**
+ * File: spsc_stress.c
+ * -------------------
+ * Description: Host stress test for the SPSC event queue
+ *              (source/core/spsc_queue.h). A producer thread pushes numbered
+ *              events with SpscQueue_Push and SpscQueue_PushBatch while a
+ *              consumer thread drains them with SpscQueue_PopBatch, the way
+ *              an interrupt handler and the main loop share a queue on the
+ *              DS: the consumer takes one batch, then yields, and the
+ *              producer yields every few pushes. Both also run on a
+ *              one-core host.
+ *
+ * Every event carries its sequence number and its place in the push that
+ * sent it (a unit: one Push, or one PushBatch of 2-15 events). Some cases
+ * push a refused unit again instead, so every event must arrive. The consumer
+ * checks that:
+ *   - events arrive in push order, and units are never split or reordered
+ *   - a pop that empties the queue never ends inside a unit (PushBatch
+ *     publishes all of its events at once)
+ *   - the events missing from the sequence are exactly the ones the producer
+ *     saw refused, and SpscQueue_GetDropped() counts each refused push once
+ *
+ * Each case starts the indices just below 2^32 so they wrap during the run.
+ *
+ * Build (from the repository root):
+ *   gcc -O2 -pthread -Isource -o spsc_stress tools/perf/spsc_stress.c \
+ *       source/core/spsc_queue.c
+ *
+ * Usage:
+ *   spsc_stress [--events n] [--rounds n]
+ *
+ * Authors: Bahey Shalash, Hugo Svolgaard
+ * Version: 1.0
+ * Date: 17.10.2026
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "core/spsc_queue.h"
+
+//=============================================================================
+// CONSTANTS
+//=============================================================================
+#define MAX_CAPACITY 4096
+#define MAX_POP 256
+#define MAX_UNIT 15        // Events per PushBatch (fits the 4-bit length)
+#define SEQ_MASK 0x00FFFFFFu
+
+// Event: type byte = unit length << 4 | index in unit, payload = sequence
+#define STRESS_EVENT(len, index, seq) SPSC_EVENT(((len) << 4) | (index), (seq))
+#define STRESS_LEN(event) (SPSC_EVENT_TYPE(event) >> 4)
+#define STRESS_INDEX(event) (SPSC_EVENT_TYPE(event) & 0xF)
+
+//=============================================================================
+// TYPES
+//=============================================================================
+typedef struct {
+    const char* name;
+    u32 capacity;      // Slots, a power of two
+    int maxUnit;       // Largest PushBatch (1: Push only)
+    int popMax;        // PopBatch size
+    int producerYield; // Units between producer yields (0: never), the pace
+                       // of interrupts between main loop frames
+    bool retry;        // Push a refused unit again instead of dropping it
+} StressCase;
+
+typedef struct {
+    u32 pushedEvents;   // Events accepted
+    u32 refusedEvents;  // Events in refused pushes
+    u32 refusedPushes;  // Refused Push / PushBatch calls
+    u32 pushCalls;
+    u32 batchCalls;
+} ProducerStats;
+
+typedef struct {
+    u32 events;
+    u32 missing;        // Sequence numbers skipped at unit starts
+    u32 pops;
+    u32 emptyPops;
+    u32 orderErrors;
+    u32 splitErrors;    // A drained pop ended inside a unit
+    u32 firstError;     // Event count at the first error
+} ConsumerStats;
+
+//=============================================================================
+// STATE
+//=============================================================================
+static const StressCase cases[] = {
+    {"tiny queue, Push, retry", 16, 1, 4, 0, true},
+    {"tiny queue, batches, retry", 16, 8, 8, 0, true},
+    {"input queue, paced producer", 256, 15, 64, 4, false},
+    {"input queue, slow consumer", 256, 15, 16, 8, false},
+    {"large queue, paced producer", 4096, 15, 256, 32, false},
+    {"large queue, no pacing", 4096, 15, 256, 0, false},
+};
+
+static u32 slots[MAX_CAPACITY];
+static SpscQueue queue;
+static const StressCase* current;
+static u32 totalEvents;
+static volatile int producerDone;
+
+static ProducerStats producer;
+static ConsumerStats consumer;
+
+//=============================================================================
+// HELPERS
+//=============================================================================
+
+static uint64_t NowNs(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+// xorshift32: reproducible unit lengths without sharing rand() state
+static u32 NextRandom(u32* state) {
+    u32 x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+//=============================================================================
+// THREADS
+//=============================================================================
+
+static void* Producer_Run(void* arg) {
+    (void)arg;
+    u32 rng = 0x2545F491u;
+    u32 seq = 0;
+    u32 unit[MAX_UNIT];
+    u32 units = 0;
+
+    while (seq < totalEvents) {
+        int len = 1;
+        if (current->maxUnit > 1 && (NextRandom(&rng) & 1))
+            len = 2 + (int)(NextRandom(&rng) % (u32)(current->maxUnit - 1));
+        if ((u32)len > totalEvents - seq)
+            len = (int)(totalEvents - seq);
+
+        bool ok;
+        if (len == 1) {
+            producer.pushCalls++;
+            ok = SpscQueue_Push(&queue, STRESS_EVENT(1, 0, seq & SEQ_MASK));
+        } else {
+            for (int i = 0; i < len; i++)
+                unit[i] = STRESS_EVENT(len, i, (seq + (u32)i) & SEQ_MASK);
+            producer.batchCalls++;
+            ok = SpscQueue_PushBatch(&queue, unit, len);
+        }
+
+        if (ok) {
+            producer.pushedEvents += (u32)len;
+        } else {
+            producer.refusedPushes++;
+            if (current->retry) {
+                sched_yield();  // Let the consumer drain (a one-core host too)
+                continue;       // Same sequence numbers again
+            }
+            producer.refusedEvents += (u32)len;
+        }
+        seq += (u32)len;  // A dropped unit leaves its numbers out
+        if (current->producerYield > 0 && ++units % (u32)current->producerYield == 0)
+            sched_yield();
+    }
+
+    __atomic_store_n(&producerDone, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void Consumer_Error(u32* counter) {
+    if (consumer.orderErrors + consumer.splitErrors == 0)
+        consumer.firstError = consumer.events;
+    (*counter)++;
+}
+
+static void* Consumer_Run(void* arg) {
+    (void)arg;
+    u32 batch[MAX_POP];
+    u32 expected = 0;      // Next sequence number (masked)
+    u32 unitLen = 0;       // Length of the unit being read (0: at a boundary)
+    u32 unitIndex = 0;
+
+    for (;;) {
+        bool done = __atomic_load_n(&producerDone, __ATOMIC_ACQUIRE);
+        int count = SpscQueue_PopBatch(&queue, batch, current->popMax);
+        consumer.pops++;
+        if (count == 0) {
+            consumer.emptyPops++;
+            if (done && SpscQueue_IsEmpty(&queue)) {
+                // Units refused after the last one received
+                consumer.missing += (totalEvents - expected) & SEQ_MASK;
+                break;
+            }
+            sched_yield();
+            continue;
+        }
+
+        for (int i = 0; i < count; i++) {
+            u32 event = batch[i];
+            u32 seq = SPSC_EVENT_PAYLOAD(event);
+            u32 len = STRESS_LEN(event);
+            u32 index = STRESS_INDEX(event);
+
+            if (unitLen == 0) {
+                // Unit start: anything skipped was refused whole
+                if (index != 0 || len == 0)
+                    Consumer_Error(&consumer.orderErrors);
+                consumer.missing += (seq - expected) & SEQ_MASK;
+                unitLen = len;
+                unitIndex = 0;
+            } else if (len != unitLen || index != unitIndex || seq != expected) {
+                Consumer_Error(&consumer.orderErrors);
+            }
+
+            expected = (seq + 1) & SEQ_MASK;
+            consumer.events++;
+            if (++unitIndex >= unitLen)
+                unitLen = 0;
+        }
+
+        // A short pop read everything published; a push publishes whole units
+        if (count < current->popMax && unitLen != 0)
+            Consumer_Error(&consumer.splitErrors);
+        sched_yield();  // One batch per "frame"
+    }
+    return NULL;
+}
+
+//=============================================================================
+// MAIN
+//=============================================================================
+
+static bool RunCase(const StressCase* stress, u32 events, u32 round) {
+    current = stress;
+    totalEvents = events;
+    producerDone = 0;
+    memset(&producer, 0, sizeof(producer));
+    memset(&consumer, 0, sizeof(consumer));
+
+    SpscQueue_Init(&queue, slots, stress->capacity);
+    // Start just below the 2^32 wrap; nothing else runs yet
+    queue.head = queue.tail = 0u - (events / 2) - round * 977u;
+
+    pthread_t producerThread, consumerThread;
+    uint64_t start = NowNs();
+    pthread_create(&consumerThread, NULL, Consumer_Run, NULL);
+    pthread_create(&producerThread, NULL, Producer_Run, NULL);
+    pthread_join(producerThread, NULL);
+    pthread_join(consumerThread, NULL);
+    uint64_t elapsed = NowNs() - start;
+
+    bool countsOk = consumer.events == producer.pushedEvents &&
+                    consumer.missing == producer.refusedEvents &&
+                    SpscQueue_GetDropped(&queue) == producer.refusedPushes &&
+                    producer.pushedEvents + producer.refusedEvents == events;
+    bool ok = countsOk && consumer.orderErrors == 0 && consumer.splitErrors == 0;
+
+    printf("  %-28s cap %4u  %9u recv  %8u dropped (%5.1f%%)  %7u refused  "
+           "%6.1f Mev/s  %s\n",
+           stress->name, stress->capacity, consumer.events, producer.refusedEvents,
+           100.0 * producer.refusedEvents / events, producer.refusedPushes,
+           consumer.events / (elapsed / 1e3), ok ? "ok" : "FAIL");
+    if (!ok) {
+        printf("    order errors %u, split units %u (first after %u events)\n",
+               consumer.orderErrors, consumer.splitErrors, consumer.firstError);
+        printf("    producer: %u pushed %u refused in %u pushes; consumer: %u received "
+               "%u missing; queue dropped %u\n",
+               producer.pushedEvents, producer.refusedEvents, producer.refusedPushes,
+               consumer.events, consumer.missing, SpscQueue_GetDropped(&queue));
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    u32 events = 4000000;
+    u32 rounds = 3;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--events") == 0)
+            events = (u32)atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--rounds") == 0)
+            rounds = (u32)atoi(argv[i + 1]);
+    }
+    if (events == 0 || events > SEQ_MASK / 2) {
+        fprintf(stderr, "--events must be 1-%u\n", SEQ_MASK / 2);
+        return 2;
+    }
+
+    int failures = 0;
+    for (u32 round = 0; round < rounds; round++) {
+        printf("round %u: %u events per case\n", round + 1, events);
+        for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+            if (!RunCase(&cases[c], events, round))
+                failures++;
+        }
+    }
+
+    printf("%s\n", failures ? "FAILED" : "all cases passed");
+    return failures ? 1 : 0;
+}
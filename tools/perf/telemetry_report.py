@@ -0,0 +1,370 @@
+#!/usr/bin/env python3
+"""
+Analyzer for the race telemetry written by source/gameplay/telemetry.c
+(make TELEMETRY=1, optionally PROFILE=1 for zone times).
+
+Reads one race file (TELEMETRY_FILE, /kart-mania/race.kmt on the SD card) and
+prints:
+  laps      lap splits: time, speed, sand and wall time, item events, frames
+            over budget
+  speed     speed trace, one row per --step ticks (--csv dumps every tick)
+  frames    frame time histogram against the scanline budget, percentiles
+  hotspots  track cells and item counts where frames ran over, and the zones
+            that grew in those frames
+
+Layout (little-endian, byte-packed; mirrors telemetry_format.h):
+  header  "KMTL", version, header bytes, tick Hz, lines per frame, budget,
+          map, mode, cars, player, laps, flags, zone count, zone names
+  TICK    tag, flags, lap, item, x, y (1/16 px), angle, speed (Q16.8),
+          active items, hits, pickups, tick low byte
+  FRAME   tag, load level, lines, tick, packets sent/received, zone us
+  GAP     tag, dropped ticks, next tick
+  END     tag, ticks, dropped ticks, dropped frames
+
+Usage:
+  python telemetry_report.py race.kmt
+  python telemetry_report.py race.kmt --report frames,hotspots --cell 128
+  python telemetry_report.py race.kmt --report speed --step 30 --csv ticks.csv
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+MAGIC = 0x4C544D4B  # "KMTL"
+VERSION = 1
+ZONE_NAME_BYTES = 16
+
+TAG_TICK = 0x01
+TAG_FRAME = 0x02
+TAG_GAP = 0x03
+TAG_END = 0xFF
+
+HEADER = struct.Struct("<IHHHHHBBBBBBB3x")
+TICK = struct.Struct("<BBBBHHHhBBBB")
+FRAME = struct.Struct("<BBHIHHB")
+GAP = struct.Struct("<BxHI")
+END = struct.Struct("<B3xIII")
+
+HEADER_REPLAY = 0x01
+TICK_SAND = 0x01
+TICK_WALL = 0x02
+TICK_FINISHED = 0x04
+
+POS_SCALE = 16
+SPEED_SCALE = 256      # Q16.8
+US_PER_LINE = 63.5     # One of 263 scanlines at 59.8 Hz
+MAP_NAMES = {1: "Scorching Sands", 2: "Alpin Rush", 3: "Neon Circuit"}
+MODE_NAMES = {0: "single player", 1: "multiplayer"}
+REPORTS = ["laps", "speed", "frames", "hotspots"]
+
+
+# -----------------------------------------------------------------------------
+# File
+# -----------------------------------------------------------------------------
+class Race:
+    def __init__(self):
+        self.header = {}
+        self.zones = []
+        self.ticks = []    # dicts, in race order
+        self.frames = []
+        self.gaps = []
+        self.end = None    # None: cut short (power off, race still running)
+
+
+def parse(data):
+    if len(data) < HEADER.size:
+        sys.exit("file too short for a telemetry header")
+    fields = HEADER.unpack_from(data, 0)
+    (magic, version, header_bytes, tick_hz, lines_per_frame, budget, race_map, mode,
+     cars, player, laps, flags, zone_count) = fields
+    if magic != MAGIC:
+        sys.exit("not a telemetry file (bad magic)")
+    if version != VERSION:
+        sys.exit(f"unsupported telemetry version {version}")
+
+    race = Race()
+    race.header = dict(tick_hz=tick_hz, lines_per_frame=lines_per_frame, budget=budget,
+                       map=race_map, mode=mode, cars=cars, player=player, laps=laps,
+                       replay=bool(flags & HEADER_REPLAY))
+    for i in range(zone_count):
+        start = HEADER.size + i * ZONE_NAME_BYTES
+        raw = data[start:start + ZONE_NAME_BYTES]
+        race.zones.append(raw.split(b"\0", 1)[0].decode("ascii", errors="replace"))
+
+    offset = header_bytes
+    next_tick = 1
+    while offset < len(data):
+        tag = data[offset]
+        if tag == TAG_TICK and offset + TICK.size <= len(data):
+            (_, tflags, lap, item, x, y, angle, speed, active, hits, pickups,
+             sequence) = TICK.unpack_from(data, offset)
+            if sequence != next_tick & 0xFF:
+                print(f"warning: tick {next_tick} out of sequence", file=sys.stderr)
+            race.ticks.append(dict(tick=next_tick, lap=lap, item=item,
+                                   x=x / POS_SCALE, y=y / POS_SCALE, angle=angle,
+                                   speed=speed / SPEED_SCALE,
+                                   sand=bool(tflags & TICK_SAND),
+                                   wall=bool(tflags & TICK_WALL),
+                                   finished=bool(tflags & TICK_FINISHED),
+                                   active=active, hits=hits, pickups=pickups))
+            next_tick += 1
+            offset += TICK.size
+        elif tag == TAG_FRAME and offset + FRAME.size <= len(data):
+            _, load, lines, tick, sent, received, count = FRAME.unpack_from(data, offset)
+            if offset + FRAME.size + 2 * count > len(data):
+                print(f"warning: stream cut at byte {offset}", file=sys.stderr)
+                break
+            offset += FRAME.size
+            zone_us = list(struct.unpack_from(f"<{count}H", data, offset))
+            offset += 2 * count
+            race.frames.append(dict(load=load, lines=lines, tick=tick, sent=sent,
+                                    received=received, zones=zone_us))
+        elif tag == TAG_GAP and offset + GAP.size <= len(data):
+            _, dropped, tick = GAP.unpack_from(data, offset)
+            race.gaps.append(dict(at=next_tick, dropped=dropped, next=tick))
+            next_tick = tick
+            offset += GAP.size
+        elif tag == TAG_END and offset + END.size <= len(data):
+            _, ticks, dropped_ticks, dropped_frames = END.unpack_from(data, offset)
+            race.end = dict(ticks=ticks, dropped_ticks=dropped_ticks,
+                            dropped_frames=dropped_frames)
+            break
+        else:
+            print(f"warning: stream cut or unknown record {tag:#04x} at byte {offset}",
+                  file=sys.stderr)
+            break
+    return race
+
+
+# -----------------------------------------------------------------------------
+# Helpers
+# -----------------------------------------------------------------------------
+def seconds(race, ticks):
+    return ticks / race.header["tick_hz"]
+
+
+def percentile(values, p):
+    if not values:
+        return 0
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(p / 100 * len(ordered)))]
+
+
+def frame_ticks(race):
+    """Pairs every frame with the last tick it saw (None before the first)."""
+    by_tick = {t["tick"]: t for t in race.ticks}
+    last = None
+    for frame in race.frames:
+        last = by_tick.get(frame["tick"], last)
+        yield frame, last
+
+
+def over(race, frame):
+    return frame["lines"] > race.header["budget"]
+
+
+# -----------------------------------------------------------------------------
+# Reports
+# -----------------------------------------------------------------------------
+def report_summary(race, out):
+    h = race.header
+    name = MAP_NAMES.get(h["map"], f"map {h['map']}")
+    source = "replay" if h["replay"] else "live race"
+    out.write(f"{name}, {MODE_NAMES.get(h['mode'], 'mode ' + str(h['mode']))}, "
+              f"{h['cars']} cars, {h['laps']} laps ({source})\n")
+    out.write(f"{len(race.ticks)} ticks ({seconds(race, len(race.ticks)):.1f} s), "
+              f"{len(race.frames)} frames, budget {h['budget']} of "
+              f"{h['lines_per_frame']} lines, "
+              f"{len(race.zones) or 'no'} profiler zones\n")
+    if race.end is None:
+        out.write("no END record: the capture was cut short\n")
+    elif race.end["dropped_ticks"] or race.end["dropped_frames"]:
+        out.write(f"dropped: {race.end['dropped_ticks']} ticks, "
+                  f"{race.end['dropped_frames']} frames\n")
+    for gap in race.gaps:
+        out.write(f"gap at tick {gap['at']}: {gap['dropped']} dropped, "
+                  f"resumes at {gap['next']}\n")
+    out.write("\n")
+
+
+def report_laps(race, out):
+    laps = {}
+    for t in race.ticks:
+        laps.setdefault(t["lap"], []).append(t)
+    lap_of_tick = {t["tick"]: t["lap"] for t in race.ticks}
+    frames_by_lap = {}
+    for frame in race.frames:
+        lap = lap_of_tick.get(frame["tick"])
+        if lap is not None:
+            frames_by_lap.setdefault(lap, []).append(frame)
+
+    out.write("LAP SPLITS\n")
+    out.write(" lap   time s  avg px/t  max px/t  sand %  walls  hits  boxes"
+              "  frames  over  worst\n")
+    for lap in sorted(laps):
+        ticks = laps[lap]
+        frames = frames_by_lap.get(lap, [])
+        speeds = [t["speed"] for t in ticks]
+        out.write(f"{lap:4d} {seconds(race, len(ticks)):8.2f} "
+                  f"{sum(speeds) / len(speeds):9.2f} {max(speeds):9.2f} "
+                  f"{100 * sum(t['sand'] for t in ticks) / len(ticks):7.1f} "
+                  f"{sum(t['wall'] for t in ticks):6d} "
+                  f"{sum(t['hits'] for t in ticks):5d} "
+                  f"{sum(t['pickups'] for t in ticks):6d} {len(frames):7d} "
+                  f"{sum(over(race, f) for f in frames):5d} "
+                  f"{max((f['lines'] for f in frames), default=0):6d}\n")
+    finish = next((t for t in race.ticks if t["finished"]), None)
+    if finish is not None:
+        out.write(f"finished at tick {finish['tick']} "
+                  f"({seconds(race, finish['tick']):.2f} s)\n")
+    out.write("\n")
+
+
+def report_speed(race, out, step):
+    top = max((t["speed"] for t in race.ticks), default=0) or 1
+    out.write(f"SPEED TRACE (every {step} ticks)\n")
+    out.write("   time s  lap      x      y  px/t\n")
+    for t in race.ticks[::step]:
+        bar = "#" * max(0, int(30 * t["speed"] / top))
+        marks = ("S" if t["sand"] else " ") + ("W" if t["wall"] else " ")
+        out.write(f"{seconds(race, t['tick']):9.2f} {t['lap']:4d} {t['x']:6.0f} "
+                  f"{t['y']:6.0f} {t['speed']:5.2f} {marks} {bar}\n")
+    out.write("(S: sand, W: wall contact)\n\n")
+
+
+def report_frames(race, out, bin_lines):
+    budget = race.header["budget"]
+    lines = [f["lines"] for f in race.frames]
+    if not lines:
+        out.write("FRAME TIMES: no frames recorded\n\n")
+        return
+    out.write(f"FRAME TIMES ({len(lines)} frames, budget {budget} lines = "
+              f"{budget * US_PER_LINE / 1000:.1f} ms)\n")
+    counts = {}
+    for value in lines:
+        counts[value // bin_lines] = counts.get(value // bin_lines, 0) + 1
+    peak = max(counts.values())
+    for b in range(min(counts), max(counts) + 1):
+        low, high = b * bin_lines, (b + 1) * bin_lines - 1
+        n = counts.get(b, 0)
+        mark = "!" if high > budget else " "
+        out.write(f"{low:4d}-{high:4d} {low * US_PER_LINE / 1000:5.1f} ms{mark} "
+                  f"{n:6d} {'#' * (0 if n == 0 else max(1, 40 * n // peak))}\n")
+    over_count = sum(value > budget for value in lines)
+    out.write(f"p50 {percentile(lines, 50)}  p95 {percentile(lines, 95)}  "
+              f"p99 {percentile(lines, 99)}  max {max(lines)} lines; "
+              f"{over_count} over budget ({100 * over_count / len(lines):.1f}%), "
+              f"load level > 0 in {sum(f['load'] > 0 for f in race.frames)}\n")
+    if any(f["sent"] or f["received"] for f in race.frames):
+        out.write(f"network: {sum(f['sent'] for f in race.frames)} packets sent, "
+                  f"{sum(f['received'] for f in race.frames)} received\n")
+    out.write("(! bins above the budget)\n\n")
+
+
+def report_hotspots(race, out, cell, top):
+    cells, storms = {}, {}
+    over_frames, all_frames = [], []
+    for frame, tick in frame_ticks(race):
+        all_frames.append(frame)
+        is_over = over(race, frame)
+        if is_over:
+            over_frames.append(frame)
+        if tick is None:
+            continue
+        key = (int(tick["x"]) // cell, int(tick["y"]) // cell)
+        stats = cells.setdefault(key, [0, 0, 0, tick["lap"]])
+        stats[0] += 1
+        stats[1] += is_over
+        stats[2] = max(stats[2], frame["lines"])
+        items = storms.setdefault(tick["active"], [0, 0, 0])
+        items[0] += 1
+        items[1] += is_over
+        items[2] += frame["lines"]
+
+    out.write(f"HOTSPOTS: track cells of {cell} px by frames over budget\n")
+    out.write("   x-range    y-range  frames  over  over %  worst\n")
+    ranked = sorted(cells.items(), key=lambda kv: (kv[1][1], kv[1][2]), reverse=True)
+    for (cx, cy), (frames, bad, worst, _) in ranked[:top]:
+        if bad == 0:
+            break
+        out.write(f"{cx * cell:4d}-{(cx + 1) * cell - 1:4d}  {cy * cell:4d}-"
+                  f"{(cy + 1) * cell - 1:4d} {frames:7d} {bad:5d} "
+                  f"{100 * bad / frames:7.1f} {worst:6d}\n")
+    if not over_frames:
+        out.write("no frame went over budget\n")
+
+    out.write("\nITEMS ON TRACK vs frame cost\n")
+    out.write(" items  frames  avg lines  over %\n")
+    for count in sorted(storms):
+        frames, bad, total = storms[count]
+        out.write(f"{count:6d} {frames:7d} {total / frames:10.1f} "
+                  f"{100 * bad / frames:7.1f}\n")
+
+    if race.zones and over_frames:
+        out.write("\nZONES in frames over budget (us per frame)\n")
+        out.write("zone               all  over  growth\n")
+        rows = []
+        for i, name in enumerate(race.zones):
+            mean_all = sum(f["zones"][i] for f in all_frames) / len(all_frames)
+            mean_over = sum(f["zones"][i] for f in over_frames) / len(over_frames)
+            rows.append((mean_over - mean_all, name, mean_all, mean_over))
+        for growth, name, mean_all, mean_over in sorted(rows, reverse=True)[:top]:
+            if mean_over == 0:
+                continue
+            out.write(f"{name:16s} {mean_all:5.0f} {mean_over:5.0f} {growth:+7.0f}\n")
+    elif not race.zones:
+        out.write("\n(built without PROFILE=1: no zone times)\n")
+    out.write("\n")
+
+
+def write_csv(race, path):
+    with open(path, "w", newline="") as f:
+        writer = csv.writer(f)
+        columns = ["tick", "lap", "x", "y", "angle", "speed", "sand", "wall", "item",
+                   "active", "hits", "pickups"]
+        writer.writerow(columns)
+        for t in race.ticks:
+            writer.writerow([t[c] if not isinstance(t[c], bool) else int(t[c])
+                             for c in columns])
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Report on a Kart Mania race telemetry file")
+    parser.add_argument("file", help="telemetry file (race.kmt from the SD card)")
+    parser.add_argument("--report", default=",".join(REPORTS),
+                        help="comma-separated: " + ", ".join(REPORTS))
+    parser.add_argument("--step", type=int, default=60, help="speed trace step in ticks")
+    parser.add_argument("--bin", type=int, default=16, help="histogram bin in scanlines")
+    parser.add_argument("--cell", type=int, default=64,
+                        help="hotspot cell size in pixels")
+    parser.add_argument("--top", type=int, default=10, help="rows per hotspot table")
+    parser.add_argument("--csv", help="also write every tick to this CSV file")
+    args = parser.parse_args()
+
+    reports = args.report.split(",")
+    unknown = [r for r in reports if r not in REPORTS]
+    if unknown:
+        sys.exit(f"unknown report: {', '.join(unknown)}")
+
+    with open(args.file, "rb") as f:
+        race = parse(f.read())
+
+    out = sys.stdout
+    report_summary(race, out)
+    if "laps" in reports:
+        report_laps(race, out)
+    if "speed" in reports:
+        report_speed(race, out, max(1, args.step))
+    if "frames" in reports:
+        report_frames(race, out, max(1, args.bin))
+    if "hotspots" in reports:
+        report_hotspots(race, out, max(1, args.cell), args.top)
+    if args.csv:
+        write_csv(race, args.csv)
+
+
+if __name__ == "__main__":
+    main()